@@ -1,23 +1,25 @@
+#include <errno.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
 
+#include <fstream>
 #include <iostream>
+#include <thread>
 
 #include <boost/program_options.hpp>
 
-#include <boost/property_tree/info_parser.hpp>
-#include <boost/property_tree/json_parser.hpp>
-#include <boost/property_tree/xml_parser.hpp>
-
 #include "config/Configuration.hpp"
 
 
 int
 main(int argc, char *argv[])
 {
-  std::string output_file, db_name, classes, objects, files, format("json");
-  bool apply_fix(false);
+  std::string output_file, db_name, classes, objects, files, format("json"), since;
+  bool apply_fix(false), with_files(false);
+  unsigned int num_of_threads(std::max(std::thread::hardware_concurrency(), 1U));
 
-  boost::program_options::options_description desc("Export config data using boost property tree.\n\nOptions/Arguments");
+  boost::program_options::options_description desc("Export config data in json, xml or info format.\n\nOptions/Arguments");
 
   try
     {
@@ -42,15 +44,29 @@ main(int argc, char *argv[])
           boost::program_options::value<std::string>(&files),
           "regex defining data files; ignore if empty"
         )
+        (
+          "since,s",
+          boost::program_options::value<std::string>(&since),
+          "export only objects of data files changed by versions since given one and the list of these files as tombstones"
+        )
+        (
+          "with-files,w",
+          "add data file of each object as \"#file\" value; always added by incremental export"
+        )
         (
           "output,o",
           boost::program_options::value<std::string>(&output_file),
-          "output file name; print to standard out, if not defined"
+          "output file name; print to standard out, if not defined; output directory for \"columns\" format"
         )
         (
           "format,t",
           boost::program_options::value<std::string>(&format)->default_value(format),
-          "output format (\"json\", \"xml\" or \"info\")"
+          "output format (\"json\", \"xml\", \"info\" or \"columns\" to write a columnar file per class)"
+        )
+        (
+          "threads,n",
+          boost::program_options::value<unsigned int>(&num_of_threads)->default_value(num_of_threads),
+          "number of threads reading objects in parallel"
         )
         (
           "fix,x",
@@ -75,9 +91,21 @@ main(int argc, char *argv[])
       if (vm.count("fix"))
         apply_fix = true;
 
-      auto valid_formats = {"json", "xml", "info"};
+      if (vm.count("with-files"))
+        with_files = true;
+
+      if (num_of_threads == 0)
+        throw std::runtime_error("number of threads cannot be 0");
+
+      auto valid_formats = {"json", "xml", "info", "columns"};
       if (std::none_of(valid_formats.begin(), valid_formats.end(), [&format](auto p){ return p == format; }))
         throw std::runtime_error("unsupported format \"" + format + '\"');
+
+      if (format == "columns" && output_file.empty())
+        throw std::runtime_error("output directory is required for \"columns\" format");
+
+      if (format == "columns" && !since.empty())
+        throw std::runtime_error("incremental export is not supported for \"columns\" format");
     }
   catch (std::exception& ex)
     {
@@ -89,78 +117,24 @@ main(int argc, char *argv[])
     {
       Configuration db(db_name);
 
-      boost::property_tree::ptree pt;
-      std::string fix_empty_arrays((apply_fix && format == "json") ? "<-- empty-p3-element -->" : "");
-
-      db.export_data(pt, classes, objects, files, fix_empty_arrays);
-
-      std::string in, out;
-
+      if (format == "columns")
         {
-          std::ostringstream buf;
-          if  (format == "json")
-            boost::property_tree::json_parser::write_json(buf, pt);
-          else if (format == "xml")
-            boost::property_tree::xml_parser::write_xml(buf, pt, boost::property_tree::xml_writer_make_settings<std::string>(' ', 4));
-          else
-            boost::property_tree::info_parser::write_info(buf, pt, boost::property_tree::info_writer_make_settings(' ', 4));
-
-          in = buf.str();
-        }
+          if (mkdir(output_file.c_str(), 0755) != 0 && errno != EEXIST)
+            throw std::runtime_error("cannot create directory \"" + output_file + "\": " + strerror(errno));
 
-      if (!apply_fix || format == "info")
-        out = std::move(in);
-      else
-        {
-          out.reserve(in.size());
-          std::string::size_type pos = 0, fix_pos;
-
-          if (format == "json")
-            {
-              while ((fix_pos = in.find(fix_empty_arrays, pos)) != std::string::npos)
-                {
-                  std::string::size_type start = in.rfind('[', fix_pos);
-                  std::string::size_type end = in.find(']', fix_pos);
-
-                  if (start != std::string::npos && end != std::string::npos)
-                    {
-                      out.append(in, pos, start + 1 - pos);
-                      pos = end;
-                    }
-                  else
-                    break;
-                }
-            }
-          else
-            {
-              // remove unnamed xml tags: replace "<>FOO</>" by "FOO"
-              while ((fix_pos = in.find("<>", pos)) != std::string::npos)
-                {
-                  std::string::size_type next = in.find("</>", fix_pos);
-
-                  if (next != std::string::npos)
-                    {
-                      out.append(in, pos, fix_pos - pos);
-                      out.append(in, fix_pos+2, next - fix_pos - 2);
-                      pos = next + 3;
-                    }
-                  else
-                    break;
-                }
-            }
-
-          out.append(in, pos);
-        }
+          const uint64_t number_of_objects = db.export_columns(output_file, classes, objects, files, num_of_threads);
 
-      if (!output_file.empty())
+          std::cout << "wrote " << number_of_objects << " objects to directory \"" << output_file << '\"' << std::endl;
+        }
+      else if (!output_file.empty())
         {
           std::ofstream f(output_file);
           f.exceptions ( std::ifstream::failbit | std::ifstream::badbit );
-          f << out;
+          db.export_data(f, format, classes, objects, files, apply_fix, num_of_threads, since, with_files);
           f.close();
         }
       else
-        std::cout << out;
+        db.export_data(std::cout, format, classes, objects, files, apply_fix, num_of_threads, since, with_files);
 
       return EXIT_SUCCESS;
     }
@@ -168,10 +142,6 @@ main(int argc, char *argv[])
     {
       std::cout << "config error: " << ex << std::endl;
     }
-  catch (const boost::property_tree::json_parser_error &ex)
-    {
-      std::cout << "ptree json error: " << ex.what() << std::endl;
-    }
   catch (const std::exception &ex)
     {
       std::cout << "error: " << ex.what() << std::endl;
@@ -0,0 +1,421 @@
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <map>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+#include "config/PluginRegistry.hpp"
+#include "config/ProxyConfiguration.hpp"
+#include "config/Schema.hpp"
+#include "config/Trace.hpp"
+
+using namespace config::proxy;
+
+
+namespace
+{
+
+    // measures latency of the replayed database in the same way as the recordconfig does
+
+  class ReplayConfiguration : public ProxyConfiguration
+  {
+
+  public:
+
+    static ReplayConfiguration * s_instance;
+
+    bool m_enabled = false;
+    std::vector<uint64_t> m_durations[number_of_call_types];
+
+  protected:
+
+    virtual void
+    called(CallType type, const std::string&, const std::string&, const std::string&, uint64_t, std::chrono::steady_clock::time_point, std::chrono::nanoseconds duration, bool) noexcept
+    {
+      if (m_enabled)
+        m_durations[type].push_back(duration.count());
+    }
+
+  };
+
+  ReplayConfiguration * ReplayConfiguration::s_instance = nullptr;
+
+  ConfigurationImpl *
+  _replayconfig_creator_(const std::string& spec)
+  {
+    std::unique_ptr<ReplayConfiguration> impl(new ReplayConfiguration());
+    impl->open_db(spec);
+    ReplayConfiguration::s_instance = impl.get();
+    return impl.release();
+  }
+
+}
+
+CONFIG_REGISTER_PLUGIN(replayconfig, _replayconfig_creator_)
+
+
+namespace
+{
+
+  struct Statistics
+  {
+    std::vector<uint64_t> m_recorded;
+    uint64_t m_recorded_failures = 0;
+    uint64_t m_replay_failures = 0;
+    uint64_t m_skipped = 0;
+  };
+
+  void
+  print_distribution(std::vector<uint64_t>& durations)
+  {
+    std::cout << std::setw(9) << durations.size();
+
+    if (durations.empty())
+      {
+        std::cout << std::setw(50) << "";
+        return;
+      }
+
+    std::sort(durations.begin(), durations.end());
+
+    uint64_t total = 0;
+    for (const auto& x : durations)
+      total += x;
+
+    auto percentile = [&durations](double p) {
+      return durations[std::min<size_t>(durations.size() - 1, static_cast<size_t>(p * durations.size()))] / 1000.;
+    };
+
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(10) << total / 1000. / durations.size()
+              << std::setw(10) << percentile(0.5)
+              << std::setw(10) << percentile(0.9)
+              << std::setw(10) << percentile(0.99)
+              << std::setw(10) << durations.back() / 1000.;
+  }
+
+  template<class T>
+    void
+    read_value(ConfigObject& obj, const std::string& name, bool is_multi_value)
+    {
+      if (is_multi_value)
+        {
+          std::vector<T> value;
+          obj.get(name, value);
+        }
+      else
+        {
+          T value;
+          obj.get(name, value);
+        }
+    }
+
+  void
+  read_attribute(ConfigObject& obj, const daq::config::attribute_t& a)
+  {
+    switch (a.p_type)
+      {
+        case daq::config::bool_type:   read_value<bool>(obj, a.p_name, a.p_is_multi_value); break;
+        case daq::config::s8_type:     read_value<int8_t>(obj, a.p_name, a.p_is_multi_value); break;
+        case daq::config::u8_type:     read_value<uint8_t>(obj, a.p_name, a.p_is_multi_value); break;
+        case daq::config::s16_type:    read_value<int16_t>(obj, a.p_name, a.p_is_multi_value); break;
+        case daq::config::u16_type:    read_value<uint16_t>(obj, a.p_name, a.p_is_multi_value); break;
+        case daq::config::s32_type:    read_value<int32_t>(obj, a.p_name, a.p_is_multi_value); break;
+        case daq::config::u32_type:    read_value<uint32_t>(obj, a.p_name, a.p_is_multi_value); break;
+        case daq::config::s64_type:    read_value<int64_t>(obj, a.p_name, a.p_is_multi_value); break;
+        case daq::config::u64_type:    read_value<uint64_t>(obj, a.p_name, a.p_is_multi_value); break;
+        case daq::config::float_type:  read_value<float>(obj, a.p_name, a.p_is_multi_value); break;
+        case daq::config::double_type: read_value<double>(obj, a.p_name, a.p_is_multi_value); break;
+        default:                       read_value<std::string>(obj, a.p_name, a.p_is_multi_value); break;
+      }
+  }
+
+}
+
+
+int
+main(int argc, char *argv[])
+{
+  std::string trace_file, db_name;
+  bool verbose(false);
+
+  boost::program_options::options_description desc(
+    "Replay calls recorded by the recordconfig plug-in against another database and report latency distributions (in microseconds) of recorded and replayed calls.\n"
+    "The read calls are replayed sequentially in order of recording; the modifications of database are not replayed.\n\n"
+    "Options/Arguments");
+
+  try
+    {
+      desc.add_options()
+        (
+          "trace,t",
+          boost::program_options::value<std::string>(&trace_file)->required(),
+          "trace file written by the recordconfig plug-in"
+        )
+        (
+          "database,d",
+          boost::program_options::value<std::string>(&db_name),
+          "database specification in format plugin-name:parameters; by default the recorded database is used"
+        )
+        (
+          "verbose,v",
+          "report failures of replayed calls"
+        )
+        (
+          "help,h",
+          "Print help message"
+        );
+
+      boost::program_options::variables_map vm;
+      boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
+
+      if (vm.count("help"))
+        {
+          std::cout << desc << std::endl;
+          return EXIT_SUCCESS;
+        }
+
+      verbose = vm.count("verbose");
+
+      boost::program_options::notify(vm);
+    }
+  catch (std::exception& ex)
+    {
+      std::cerr << "command line error: " << ex.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  try
+    {
+      config::trace::Reader trace(trace_file);
+
+      if (db_name.empty())
+        db_name = trace.get_spec();
+
+      Configuration db(std::string("replayconfig:") + db_name);
+
+      ReplayConfiguration& replay(*ReplayConfiguration::s_instance);
+
+      Statistics stat[number_of_call_types];
+
+      // the objects are searched, when replay is disabled
+
+      std::map<std::pair<std::string, std::string>, ConfigObject> objects;
+
+      auto get_object = [&](const std::string& class_name, const std::string& id) -> ConfigObject& {
+        auto it = objects.find(std::make_pair(class_name, id));
+
+        if (it != objects.end())
+          return it->second;
+
+        ConfigObject obj;
+        db.get(class_name, id, obj);
+        return objects.emplace(std::make_pair(class_name, id), obj).first->second;
+      };
+
+      auto get_class = [&](const std::string& class_name) -> const daq::config::class_t& {
+        return db.get_class_info(class_name);
+      };
+
+      config::trace::Record r;
+      uint64_t count(0);
+
+      const auto start = std::chrono::steady_clock::now();
+
+      while (trace.next(r))
+        {
+          Statistics& s(stat[r.m_type]);
+
+          count++;
+          s.m_recorded.push_back(r.m_duration);
+
+          if (r.m_failed)
+            s.m_recorded_failures++;
+
+          try
+            {
+              replay.m_enabled = false;
+
+              ConfigObject obj;
+
+              if (!r.m_id->empty() && r.m_type >= get_attribute && r.m_type <= contained_in)
+                obj = get_object(*r.m_class_name, *r.m_id);
+
+              const daq::config::class_t * c = ((r.m_type == get_attribute || r.m_type == get_relationship) ? &get_class(*r.m_class_name) : nullptr);
+
+              replay.m_enabled = true;
+
+              switch (r.m_type)
+                {
+                  case config::proxy::get_object:
+                    {
+                      ConfigObject o;
+                      db.get(*r.m_class_name, *r.m_id, o);
+                    }
+                    break;
+
+                  case config::proxy::get_objects:
+                    {
+                      std::vector<ConfigObject> objs;
+                      db.get(*r.m_class_name, objs, *r.m_name);
+                    }
+                    break;
+
+                  case config::proxy::get_path:
+                    {
+                      replay.m_enabled = false;
+                      ConfigObject& from(get_object(*r.m_class_name, *r.m_id));
+                      replay.m_enabled = true;
+
+                      std::vector<ConfigObject> objs;
+                      db.get(from, *r.m_name, objs);
+                    }
+                    break;
+
+                  case config::proxy::test_object:
+                    db.test_object(*r.m_class_name, *r.m_id);
+                    break;
+
+                  case config::proxy::get_class:
+                    db.get_class_info(*r.m_class_name);
+                    break;
+
+                  case config::proxy::is_writable:
+                    db.is_writable(*r.m_name);
+                    break;
+
+                  case config::proxy::get_includes:
+                    {
+                      std::list<std::string> includes;
+                      db.get_includes(*r.m_name, includes);
+                    }
+                    break;
+
+                  case config::proxy::get_updated_dbs:
+                    {
+                      std::list<std::string> dbs;
+                      db.get_updated_dbs(dbs);
+                    }
+                    break;
+
+                  case config::proxy::get_changes:
+                    db.get_changes();
+                    break;
+
+                  case config::proxy::prefetch_all_data:
+                    db.prefetch_all_data();
+                    break;
+
+                  case config::proxy::get_attribute:
+                    {
+                      auto a = std::find_if(c->p_attributes.begin(), c->p_attributes.end(), [&r](const daq::config::attribute_t& x) { return x.p_name == *r.m_name; });
+
+                      if (a == c->p_attributes.end())
+                        throw daq::config::Generic(ERS_HERE, ("class " + *r.m_class_name + " has no attribute " + *r.m_name).c_str());
+
+                      read_attribute(obj, *a);
+                    }
+                    break;
+
+                  case config::proxy::get_relationship:
+                    {
+                      auto rel = std::find_if(c->p_relationships.begin(), c->p_relationships.end(), [&r](const daq::config::relationship_t& x) { return x.p_name == *r.m_name; });
+
+                      if (rel == c->p_relationships.end())
+                        throw daq::config::Generic(ERS_HERE, ("class " + *r.m_class_name + " has no relationship " + *r.m_name).c_str());
+
+                      if (rel->p_cardinality == daq::config::zero_or_many || rel->p_cardinality == daq::config::one_or_many)
+                        {
+                          std::vector<ConfigObject> value;
+                          obj.get(*r.m_name, value);
+                        }
+                      else
+                        {
+                          ConfigObject value;
+                          obj.get(*r.m_name, value);
+                        }
+                    }
+                    break;
+
+                  case config::proxy::get_rel:
+                    {
+                      std::vector<ConfigObject> value;
+                      obj.rel(*r.m_name, value);
+                    }
+                    break;
+
+                  case config::proxy::referenced_by:
+                    {
+                      std::vector<ConfigObject> value;
+                      obj.referenced_by(value, *r.m_name);
+                    }
+                    break;
+
+                  case config::proxy::contained_in:
+                    obj.contained_in();
+                    break;
+
+                  default:
+                    s.m_skipped++;
+                    break;
+                }
+            }
+          catch (daq::config::Exception& ex)
+            {
+              s.m_replay_failures++;
+
+              if (verbose)
+                std::cerr << "replay of \"" << call2str(r.m_type) << "\" call failed: " << ex << std::endl;
+            }
+        }
+
+      replay.m_enabled = false;
+
+      const double interval = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000000.;
+
+      std::cout << "replayed " << count << " calls recorded on database \"" << trace.get_spec() << "\" against database \"" << db_name << "\" in " << interval << " s\n\n";
+
+      std::cout << std::left << std::setw(20) << "call" << std::right
+                << std::setw(9) << "calls" << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "max"
+                << std::setw(10) << "failed" << std::setw(10) << "skipped" << '\n';
+
+      for (unsigned int i = 0; i < number_of_call_types; ++i)
+        {
+          if (stat[i].m_recorded.empty())
+            continue;
+
+          std::cout << call2str(static_cast<CallType>(i)) << '\n';
+
+          std::cout << std::left << std::setw(20) << "  recorded" << std::right;
+          print_distribution(stat[i].m_recorded);
+          std::cout << std::setw(10) << stat[i].m_recorded_failures << '\n';
+
+          std::cout << std::left << std::setw(20) << "  replayed" << std::right;
+          print_distribution(replay.m_durations[i]);
+          std::cout << std::setw(10) << stat[i].m_replay_failures << std::setw(10) << stat[i].m_skipped << '\n';
+        }
+
+      std::cout.flush();
+
+      return EXIT_SUCCESS;
+    }
+  catch (const daq::config::Exception &ex)
+    {
+      std::cout << "config error: " << ex << std::endl;
+    }
+  catch (const std::exception &ex)
+    {
+      std::cout << "error: " << ex.what() << std::endl;
+    }
+
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,183 @@
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include <boost/program_options.hpp>
+
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+#include "config/Filter.hpp"
+#include "config/Snapshot.hpp"
+
+
+int
+main(int argc, char *argv[])
+{
+  std::string output_file, shm_name, db_name, classes, objects, files;
+  unsigned int num_of_threads(std::max(std::thread::hardware_concurrency(), 1U));
+
+  boost::program_options::options_description desc("Compile config database into binary snapshot file or shared memory segment, that can be used by the snapconfig or shmconfig plug-ins.\n\nOptions/Arguments");
+
+  try
+    {
+      desc.add_options()
+        (
+          "database,d",
+          boost::program_options::value<std::string>(&db_name)->required(),
+          "database specification in format plugin-name:parameters"
+        )
+        (
+          "classes,c",
+          boost::program_options::value<std::string>(&classes),
+          "regex defining class names; ignore if empty"
+        )
+        (
+          "objects,i",
+          boost::program_options::value<std::string>(&objects),
+          "regex defining object IDs; ignore if empty"
+        )
+        (
+          "files,f",
+          boost::program_options::value<std::string>(&files),
+          "regex defining data files; ignore if empty"
+        )
+        (
+          "output,o",
+          boost::program_options::value<std::string>(&output_file),
+          "output snapshot file name"
+        )
+        (
+          "shared-memory,s",
+          boost::program_options::value<std::string>(&shm_name),
+          "publish snapshot in POSIX shared memory segment with given name (e.g. /daq-config) for the shmconfig plug-in"
+        )
+        (
+          "threads,t",
+          boost::program_options::value<unsigned int>(&num_of_threads)->default_value(num_of_threads),
+          "number of threads reading classes in parallel"
+        )
+        (
+          "help,h",
+          "Print help message"
+        );
+
+      boost::program_options::variables_map vm;
+      boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
+
+      if (vm.count("help"))
+        {
+          std::cout << desc << std::endl;
+          return EXIT_SUCCESS;
+        }
+
+      boost::program_options::notify(vm);
+
+      if (num_of_threads == 0)
+        throw std::runtime_error("number of threads cannot be 0");
+
+      if (output_file.empty() && shm_name.empty())
+        throw std::runtime_error("either output file or shared memory segment name is required");
+    }
+  catch (std::exception& ex)
+    {
+      std::cerr << "command line error: " << ex.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  try
+    {
+      const config::Filter classes_filter(classes), objects_filter(objects), files_filter(files);
+
+      Configuration db(db_name);
+
+      auto start = std::chrono::steady_clock::now();
+
+      // the writer reads descriptions of all classes, so the relationship types are always known
+
+      config::snapshot::Writer writer(db);
+
+      std::vector<const std::string *> selected_classes;
+
+      for (const auto &c : db.superclasses())
+        if (classes_filter.match(*c.first))
+          selected_classes.push_back(c.first);
+
+      std::atomic<size_t> next_class(0);
+      std::exception_ptr error;
+      std::mutex error_mutex;
+
+      auto worker = [&]() {
+        try
+          {
+            for (size_t idx = next_class++; idx < selected_classes.size(); idx = next_class++)
+              {
+                const std::string& c(*selected_classes[idx]);
+
+                std::vector<ConfigObject> objs;
+                db.get(c, objs);
+
+                for (const auto& x : objs)
+                  if (x.class_name() == c)
+                    if (objects_filter.match(x.UID()))
+                      if (files_filter.match(x.contained_in()))
+                        writer.add(x);
+              }
+          }
+        catch (...)
+          {
+            std::lock_guard<std::mutex> scoped_lock(error_mutex);
+
+            if (!error)
+              error = std::current_exception();
+
+            next_class = selected_classes.size();
+          }
+      };
+
+      std::vector<std::thread> threads;
+
+      for (unsigned int i = 1; i < std::min<size_t>(num_of_threads, selected_classes.size()); ++i)
+        threads.emplace_back(worker);
+
+      worker();
+
+      for (auto& t : threads)
+        t.join();
+
+      if (error)
+        std::rethrow_exception(error);
+
+      if (!output_file.empty())
+        writer.write(output_file);
+
+      if (!shm_name.empty())
+        writer.publish(shm_name);
+
+      const double interval = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000000.;
+
+      std::cout << "wrote " << writer.get_number_of_objects() << " objects of " << selected_classes.size() << " classes to snapshot \"" << (output_file.empty() ? shm_name : output_file) << "\" (format version " << config::snapshot::format_version << ") in " << interval << " s";
+
+      if (interval > 0)
+        std::cout << " (" << static_cast<uint64_t>(writer.get_number_of_objects() / interval) << " objects/s)";
+
+      std::cout << std::endl;
+
+      return EXIT_SUCCESS;
+    }
+  catch (const daq::config::Exception &ex)
+    {
+      std::cout << "config error: " << ex << std::endl;
+    }
+  catch (const std::exception &ex)
+    {
+      std::cout << "error: " << ex.what() << std::endl;
+    }
+
+  return EXIT_FAILURE;
+}
@@ -8,9 +8,15 @@
 #ifndef CONFIG_CONFIGURATION__CHANGE_H_
 #define CONFIG_CONFIGURATION__CHANGE_H_
 
+#include <stdint.h>
+
 #include <string>
 #include <vector>
 #include <iostream>
+#include <memory>
+
+#include "config/map.hpp"
+#include "config/set.hpp"
 
 
   /**
@@ -28,12 +34,17 @@
    *  - modified objects (i.e. one or more attributes/relationships values were modified)
    *  - created objects
    *  - removed objects
+   *
+   *  A plug-in knowing what was changed may also report the names of modified attributes and relationships
+   *  of modified objects (see get_modified_attributes()), so the subscriber may refresh only those.
    */
 
 class ConfigurationChange {
 
   friend class Configuration;
   friend class ConfigurationImpl;
+  friend class ConfigurationChangeBuilder;
+  friend class ConfigurationChangeView;
 
   public:
 
@@ -57,6 +68,22 @@ class ConfigurationChange {
     const std::vector<std::string>& get_removed_objs() const {return m_removed;}
 
 
+     /**
+      *  \brief Return names of modified attributes and relationships of modified object.
+      *
+      *  Return nullptr, if the names are not reported by the plug-in; in such case any
+      *  attribute or relationship of the object may be modified.
+      *
+      *  \param obj_id      id of modified object
+      */
+
+    const std::vector<std::string> * get_modified_attributes(const std::string& obj_id) const
+    {
+      config::map<std::vector<std::string>>::const_iterator i = m_modified_attributes.find(obj_id);
+      return (i != m_modified_attributes.end() ? &i->second : nullptr);
+    }
+
+
      /**
       *  \brief Helper method to add object to the vector of existing changes.
       *
@@ -66,6 +93,9 @@ class ConfigurationChange {
       *  The method adds object described by the 'class_name' and 'obj_name' to the changes.
       *  New ConfigurationChange object is created if required.
       *
+      *  The method searches the class in the changes linearly; use ConfigurationChangeBuilder
+      *  to describe large number of changes.
+      *
       *  \param changes      description of existing changes
       *  \param class_name   name of the object's class
       *  \param obj_id       object's id
@@ -80,6 +110,23 @@ class ConfigurationChange {
                     const std::string& obj_id,
                     const char action);
 
+     /**
+      *  \brief Helper method to add modified object with names of its modified attributes and relationships.
+      *
+      *  If the object is already reported as modified, the names are merged with already reported ones;
+      *  if the object was reported as modified without names, the names remain unknown.
+      *
+      *  \param changes      description of existing changes
+      *  \param class_name   name of the object's class
+      *  \param obj_id       object's id
+      *  \param names        names of modified attributes and relationships
+      */
+
+    static void add(std::vector<ConfigurationChange *>& changes,
+                    const std::string& class_name,
+                    const std::string& obj_id,
+                    const std::vector<std::string>& names);
+
      /**
       *  \brief Helper method to clear vector of changes (pointers).
       *
@@ -107,8 +154,269 @@ class ConfigurationChange {
     std::vector<std::string> m_created;
     std::vector<std::string> m_removed;
 
+    config::map<std::vector<std::string>> m_modified_attributes;   // modified object => names of modified attributes and relationships, if known
+
+      // add object to modified ones; append the names to known names, if any
+
+    void add_modified(const std::string& obj_id, const std::vector<std::string> * names, bool is_new);
+
 };
 
+  /**
+   *  \brief Builds description of large number of changes.
+   *
+   *  Unlike ConfigurationChange::add(), the builder searches changes of the class using hash map
+   *  and ignores duplicated object identities, so the cost of adding an object does not depend
+   *  on the number of changes. The classes and objects are reported in order of their addition.
+   */
+
+class ConfigurationChangeBuilder {
+
+  public:
+
+    ConfigurationChangeBuilder() {}
+
+      /// Destroy changes which were not built.
+
+    ~ConfigurationChangeBuilder();
+
+
+     /**
+      *  \brief Add object to the changes.
+      *
+      *  \param class_name   name of the object's class
+      *  \param obj_id       object's id
+      *  \param action       requested action:
+      *                      - '+' created
+      *                      - '~' changed
+      *                      - '-' removed
+      */
+
+    void add(const std::string& class_name, const std::string& obj_id, const char action);
+
+
+     /**
+      *  \brief Add modified object with names of its modified attributes and relationships.
+      *
+      *  The names of object added several times are merged; they remain unknown,
+      *  if the object was added as modified without names.
+      *
+      *  \param class_name   name of the object's class
+      *  \param obj_id       object's id
+      *  \param names        names of modified attributes and relationships
+      */
+
+    void add(const std::string& class_name, const std::string& obj_id, const std::vector<std::string>& names);
+
+
+      /// Return true, if there are no changes.
+
+    bool empty() const {return m_changes.empty();}
+
+
+     /**
+      *  \brief Append changes to the vector and reset the builder.
+      *
+      *  The caller is responsible to destroy the changes, e.g. using ConfigurationChange::clear().
+      *
+      *  \param changes      description of changes
+      */
+
+    void build(std::vector<ConfigurationChange *>& changes);
+
+
+  private:
+
+    ConfigurationChangeBuilder( const ConfigurationChangeBuilder & );
+    ConfigurationChangeBuilder& operator= ( const ConfigurationChangeBuilder & );
+
+    struct ClassChanges {
+      ConfigurationChange * m_change = nullptr;
+      config::set m_modified;
+      config::set m_created;
+      config::set m_removed;
+    };
+
+    ClassChanges& get(const std::string& class_name);
+
+    config::map<ClassChanges> m_classes;
+    std::vector<ConfigurationChange *> m_changes;
+
+};
+
+
+  /**
+   *  \brief Immutable description of changes shared by subscribers.
+   *
+   *  The set takes ownership of the changes and destroys them, when the last
+   *  reference is released. The subscribers access the set via ConfigurationChangeView.
+   */
+
+class ConfigurationChangeSet {
+
+  public:
+
+      /// Take ownership of the changes; the vector becomes empty.
+
+    explicit ConfigurationChangeSet(std::vector<ConfigurationChange *>& changes) { m_changes.swap(changes); }
+
+    ~ConfigurationChangeSet() { ConfigurationChange::clear(m_changes); }
+
+
+      /// Return the changes of all classes.
+
+    const std::vector<ConfigurationChange *>& get_changes() const {return m_changes;}
+
+
+  private:
+
+    ConfigurationChangeSet( const ConfigurationChangeSet & );
+    ConfigurationChangeSet& operator= ( const ConfigurationChangeSet & );
+
+    std::vector<ConfigurationChange *> m_changes;
+
+};
+
+
+  /**
+   *  \brief Filtered view into shared changes passed to a subscriber.
+   *
+   *  The view references the changes of classes of the set either completely or partially,
+   *  e.g. when a subscriber is only interested in changes of some objects. The partial changes
+   *  are described by indices of objects, so filtering of changes for many subscribers does
+   *  not copy identities of objects.
+   *
+   *  The get_changes() method adapts the view to the vector of ConfigurationChange objects
+   *  used by the notification callbacks: the changes of completely referenced classes are
+   *  taken from the set, the partial ones are created on first call and destroyed together
+   *  with the view. The view is not thread-safe.
+   */
+
+class ConfigurationChangeView {
+
+  public:
+
+      /// Create empty view of the set.
+
+    explicit ConfigurationChangeView(const std::shared_ptr<const ConfigurationChangeSet>& set) : m_set(set) {}
+
+
+      /// Create new set taking ownership of the changes (the vector becomes empty) and view all of them.
+
+    explicit ConfigurationChangeView(std::vector<ConfigurationChange *>& changes);
+
+    ConfigurationChangeView(ConfigurationChangeView&& other) = default;
+
+    ~ConfigurationChangeView();
+
+
+      /// Return number of classes in the view.
+
+    size_t size() const {return m_classes.size();}
+
+
+      /// Return true, if there are no changes in the view.
+
+    bool empty() const {return m_classes.empty();}
+
+
+      /// Return changes of i-th class of the view as stored by the set; unless is_complete(i), the view includes only part of them.
+
+    const ConfigurationChange& get_change(size_t i) const {return *m_set->get_changes()[m_classes[i].m_class];}
+
+
+      /// Return name of i-th class of the view.
+
+    const std::string& get_class_name(size_t i) const {return get_change(i).get_class_name();}
+
+
+      /// Return true, if the view includes all changes of i-th class.
+
+    bool is_complete(size_t i) const {return m_classes[i].m_complete;}
+
+
+     /**
+      *  \brief Call function for each object changed in i-th class of the view.
+      *
+      *  The function is called with object id and action ('+' created, '~' modified, '-' removed).
+      *  The objects are reported in order created, modified, removed.
+      */
+
+    template<class F>
+      void
+      for_each_object(size_t i, F function) const
+      {
+        const ClassView& v(m_classes[i]);
+        const ConfigurationChange& c(get_change(i));
+
+        if (v.m_complete)
+          {
+            for (const auto& id : c.m_created)
+              function(id, '+');
+
+            for (const auto& id : c.m_modified)
+              function(id, '~');
+
+            for (const auto& id : c.m_removed)
+              function(id, '-');
+          }
+        else
+          {
+            for (const auto& x : v.m_modified)
+              function(c.m_modified[x], '~');
+
+            for (const auto& x : v.m_removed)
+              function(c.m_removed[x], '-');
+          }
+      }
+
+
+      /// Adapt the view to vector of changes; it is valid until the view is destroyed.
+
+    const std::vector<ConfigurationChange *>& get_changes() const;
+
+
+      /// Include all changes of class with given index in the set; the classes have to be added in order of the set.
+
+    void add(uint32_t cls);
+
+
+      /// Include modified object with given index of class with given index in the set.
+
+    void add_modified(uint32_t cls, uint32_t obj);
+
+
+      /// Include removed object with given index of class with given index in the set.
+
+    void add_removed(uint32_t cls, uint32_t obj);
+
+
+  private:
+
+    ConfigurationChangeView( const ConfigurationChangeView & );
+    ConfigurationChangeView& operator= ( const ConfigurationChangeView & );
+
+    struct ClassView {
+      uint32_t m_class;                      // index of class in the set
+      bool m_complete;                       // all changes of the class are included
+      std::vector<uint32_t> m_modified;      // indices of included modified objects
+      std::vector<uint32_t> m_removed;       // indices of included removed objects
+    };
+
+    ClassView * get(uint32_t cls);
+
+    void clear_adapted();
+
+    std::shared_ptr<const ConfigurationChangeSet> m_set;
+    std::vector<ClassView> m_classes;
+
+    mutable std::vector<ConfigurationChange *> m_changes;    // adapted changes
+    mutable std::vector<ConfigurationChange *> m_owned;      // adapted changes of partially included classes
+    mutable bool m_adapted = false;
+
+};
+
+
   /** Operator prints out to stream details of configuration change. **/
 
 std::ostream& operator<<(std::ostream&, const ConfigurationChange&);
@@ -118,4 +426,9 @@ std::ostream& operator<<(std::ostream&, const ConfigurationChange&);
 
 std::ostream& operator<<(std::ostream&, const std::vector<ConfigurationChange *>&);
 
+
+  /** Operator prints out to stream details of changes included by the view. **/
+
+std::ostream& operator<<(std::ostream&, const ConfigurationChangeView&);
+
 #endif // CONFIG_CONFIGURATION__CHANGE_H_
@@ -0,0 +1,232 @@
+  /**
+   *  \file Columns.hpp This file contains description of the columnar export format
+   *  and the function to write objects of a class into columnar file.
+   *  \brief columnar export of config data
+   */
+
+#ifndef CONFIG_COLUMNS_H_
+#define CONFIG_COLUMNS_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "config/Schema.hpp"
+
+class ConfigObject;
+
+  /**
+   *  \brief The columnar file with objects of one class.
+   *
+   *  The file is designed to be memory-mapped and loaded into data frames without parsing:
+   *  the values of a column are stored in one array. All numbers are stored using native
+   *  byte order, all offsets are given in bytes from the beginning of the file and all sections
+   *  are 8-bytes aligned.
+   *
+   *  The file starts from the Header followed by the array of Table records. The first table
+   *  is named after the class and has a row per object sorted by id; its first columns "#id"
+   *  and "#file" contain the object ids and the data files, the next columns contain the attributes
+   *  of the class in order of the schema. Each relationship of the class is stored in a table
+   *  named "<class>.<relationship>", that has a row per reference and the "source" (referencing object id),
+   *  "target" (referenced object id) and "target_class" (class of referenced object) columns.
+   *
+   *  The values of a column are stored in an array of the column type (bool is stored as uint8_t).
+   *  The strings (also dates, times, enums and class references) are stored as array of count + 1
+   *  uint64_t offsets of the beginnings of strings in the characters array, the last one is the
+   *  size of the characters array; the characters of strings are not terminated by zero.
+   *  The values of multi-value column are stored the same way, and the column has an array of
+   *  rows + 1 uint64_t indices of the first values of rows, the last one is the number of values.
+   *  The names are stored as zero-terminated strings.
+   */
+
+namespace config
+{
+  namespace columns
+  {
+
+      /// The format version; increase on any incompatible change
+
+    const uint32_t format_version = 1;
+
+      /// The value used to detect byte order mismatch
+
+    const uint32_t byte_order_mark = 0x01020304;
+
+      /// The columnar file signature
+
+    const char magic[8] = { 'C', 'O', 'N', 'F', 'C', 'O', 'L', 'S' };
+
+
+    struct Header
+    {
+      char m_magic[8];
+      uint32_t m_version;
+      uint32_t m_byte_order;
+      uint64_t m_size;                // total size of the file
+      uint32_t m_tables_count;
+      uint32_t m_pad;
+      uint64_t m_tables;              // offset of the array of Table records
+    };
+
+    struct Table
+    {
+      uint64_t m_name;                // offset of the name
+      uint64_t m_rows;                // number of rows
+      uint32_t m_columns_count;
+      uint32_t m_pad;
+      uint64_t m_columns;             // offset of the array of Column records
+    };
+
+    struct Column
+    {
+      enum { multi_value_flag = 1 };
+
+      uint64_t m_name;                // offset of the name
+      uint8_t m_type;                 // daq::config::type_t
+      uint8_t m_flags;
+      uint8_t m_pad[6];
+      uint64_t m_count;               // number of values
+      uint64_t m_rows;                // offset of the array of rows + 1 uint64_t first value indices (multi-value column only)
+      uint64_t m_values;              // offset of the array of values (or string offsets)
+      uint64_t m_chars;               // offset of the characters of strings
+      uint64_t m_chars_size;          // size of the characters of strings
+    };
+
+
+      /**
+       *  \brief Write objects of class into columnar file.
+       *
+       *  The attribute values are read column by column for all objects, the file is
+       *  written under temporary name and renamed when completed.
+       *
+       *  \param  info       description of the class including all attributes and relationships
+       *  \param  objects    objects of the class sorted by id
+       *  \param  file_name  name of the file
+       *
+       *  \throw daq::config::Generic in case of a problem
+       */
+
+    void
+    write(const daq::config::class_t& info, const std::vector<ConfigObject>& objects, const std::string& file_name);
+
+
+      /**
+       *  \brief Reads columnar file.
+       *
+       *  The file is read into memory. The constructor checks the signature, the version and
+       *  the byte order, and that all tables, columns, names and values are inside the file.
+       */
+
+    class Reader
+    {
+
+    public:
+
+        /// Read and check file; throw daq::config::Generic in case of a problem
+
+      explicit Reader(const std::string& file_name);
+
+
+        /// Return number of tables
+
+      uint32_t
+      get_tables_count() const noexcept
+      {
+        return header().m_tables_count;
+      }
+
+
+        /// Return i-th table
+
+      const Table&
+      get_table(uint32_t i) const noexcept
+      {
+        return at<Table>(header().m_tables)[i];
+      }
+
+
+        /// Return table with given name or nullptr
+
+      const Table *
+      find_table(const std::string& name) const noexcept;
+
+
+        /// Return column of the table with given name or nullptr
+
+      const Column *
+      find_column(const Table& table, const std::string& name) const noexcept;
+
+
+        /// Return name stored by given offset
+
+      const char *
+      get_name(uint64_t offset) const noexcept
+      {
+        return m_data.data() + offset;
+      }
+
+
+        /// Return array of values of number column (the T has to match the type of the column, uint8_t for bool)
+
+      template<class T>
+      const T *
+      get_values(const Column& column) const noexcept
+      {
+        return at<T>(column.m_values);
+      }
+
+
+        /// Return i-th value of string column
+
+      std::string
+      get_string(const Column& column, uint64_t i) const
+      {
+        const uint64_t * offsets = at<uint64_t>(column.m_values);
+        return std::string(m_data.data() + column.m_chars + offsets[i], offsets[i + 1] - offsets[i]);
+      }
+
+
+        /// Return array of rows + 1 indices of the first values of rows of multi-value column
+
+      const uint64_t *
+      get_rows(const Column& column) const noexcept
+      {
+        return at<uint64_t>(column.m_rows);
+      }
+
+
+    private:
+
+      const Header&
+      header() const noexcept
+      {
+        return *at<Header>(0);
+      }
+
+      template<class T>
+      const T *
+      at(uint64_t offset) const noexcept
+      {
+        return reinterpret_cast<const T *>(m_data.data() + offset);
+      }
+
+        // check the section is inside the file; return false, if it is not
+
+      bool
+      check(uint64_t offset, uint64_t size) const noexcept
+      {
+        return (offset <= m_data.size() && size <= m_data.size() - offset && (offset & 7) == 0);
+      }
+
+      bool
+      check_name(uint64_t offset) const noexcept;
+
+      std::vector<char> m_data;
+
+    };
+
+  }
+}
+
+#endif // CONFIG_COLUMNS_H_
@@ -171,6 +171,21 @@ class ConfigObject {
     const std::string& class_name() const noexcept { return *m_impl->m_class_name; }
 
 
+     /**
+      *  \brief Return generation of object.
+      *
+      *  The generation is incremented, when the object is modified by user's
+      *  set methods or rename(), when it is created, modified or removed by
+      *  notification, or when the implementation objects are unread.
+      *  A user may store the generation together with values read from the object
+      *  and compare it with the current one to detect, if the values are still valid.
+      *
+      *  The null object has generation 0.
+      */
+
+    uint64_t generation() const noexcept { return (m_impl ? m_impl->generation() : 0); }
+
+
      /**
       *  \brief Return full object name.
       *
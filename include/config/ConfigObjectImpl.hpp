@@ -8,6 +8,8 @@
 #ifndef CONFIG_CONFIGOBJECTIMPL_H_
 #define CONFIG_CONFIGOBJECTIMPL_H_
 
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -97,6 +99,13 @@ class ConfigObjectImpl {
       /// Virtual method to get object's database file name
     virtual const std::string contained_in() const = 0;
 
+      /// Get generation of object; it is incremented, when the object is changed by user or by notification, or is unread
+    uint64_t
+    generation() const noexcept
+    {
+      return m_generation;
+    }
+
   public:
 
       /// Virtual method to read boolean attribute value
@@ -329,6 +338,16 @@ class ConfigObjectImpl {
     std::string m_id;                         /*!< Object ID */
     const std::string * m_class_name;         /*!< Name of object's class */
     mutable std::mutex m_mutex;               /*!< Mutex protecting concurrent access to this object */
+    std::atomic<uint_least64_t> m_generation; /*!< Generation of object incremented on any change of it */
+
+
+  private:
+
+    mutable std::atomic<bool> m_referenced;   /*!< Is set when object is accessed via cache; is reset by the cache eviction clock */
+    std::atomic<uint32_t> m_pins;             /*!< Number of ConfigObject instances using this object; pinned object is never evicted from cache */
+
+    void pin() noexcept { m_pins.fetch_add(1, std::memory_order_relaxed); }
+    void unpin() noexcept { m_pins.fetch_sub(1, std::memory_order_release); }
 
 
   protected:
@@ -12,10 +12,12 @@
 #include <string.h>
 
 #include <atomic>
+#include <chrono>
 #include <typeinfo>
 #include <string>
 #include <vector>
 #include <list>
+#include <memory>
 #include <set>
 
 #include <mutex>
@@ -24,6 +26,8 @@
 
 #include "ers/ers.hpp"
 
+#include "config/Change.hpp"
+#include "config/NotificationLatency.hpp"
 #include "config/SubscriptionCriteria.hpp"
 #include "config/ConfigObject.hpp"
 #include "config/ConfigVersion.hpp"
@@ -36,7 +40,13 @@
 class DalObject;
 class ConfigAction;
 class ConfigurationImpl;
-class ConfigurationChange;
+
+namespace config
+{
+  class DataWriter;
+  class NotificationDispatcher;
+  struct NotificationMetrics;
+}
 
 namespace daq {
   namespace config {
@@ -79,6 +89,21 @@ protected:
     ;
   }
 
+  /** Number of template objects in cache */
+
+  virtual size_t
+  size() const noexcept = 0;
+
+  /**
+   *  Destroy template objects (is used by the bounded cache).
+   *  \param num                maximum number of objects to destroy
+   *  \param unreferenced_only  if true, destroy only objects not accessed since previous call; otherwise reset access flag of remaining objects
+   *  \return number of destroyed objects
+   */
+
+  virtual size_t
+  release(size_t num, bool unreferenced_only) noexcept = 0;
+
 protected:
 
   const DalFactoryFunctions& m_functions;
@@ -278,6 +303,21 @@ class Configuration {
       void * parameter
     );
 
+      /**
+       *  \brief The user notification callback function which
+       *  is invoked in case of changes with view into changes shared by subscribers.
+       *
+       *  The view is only valid during the callback.
+       *
+       *  \param changes            changes matching subscription criteria
+       *  \param parameter          user-defined parameter
+       */
+
+    typedef void (*notify_view)(
+      const ConfigurationChangeView & changes,
+      void * parameter
+    );
+
       /**
        *  \brief The user notification callback function which
        *  is invoked before changes are going to be applied.
@@ -296,8 +336,13 @@ class Configuration {
 
     struct CallbackSubscription {
       notify m_cb;
+      notify_view m_view_cb;
       void * m_param;
       ConfigurationSubscriptionCriteria m_criteria;
+      uint64_t m_queue;    // key of notification queue in case of asynchronous notification
+      std::chrono::milliseconds m_window;    // coalescing window
+      unsigned int m_max_changes;            // maximum number of coalesced object changes
+      config::LatencyHistogram m_latency;    // durations of synchronous invocations of callback
     };
 
     struct CallbackPreSubscription {
@@ -340,6 +385,53 @@ class Configuration {
     CallbackId subscribe(const ::ConfigurationSubscriptionCriteria& criteria, notify user_cb, void * user_param = nullptr);
 
 
+      /**
+       *  \brief Subscribe on configuration changes coalescing bursts of notifications.
+       *
+       *  Same as above, but the changes notified during the window starting with the first of them
+       *  are merged per class and passed to the user callback function in one go, so the reaction
+       *  on a burst of commits runs once. The changes are delivered earlier, if the number of
+       *  merged object changes reaches non-zero limit. An object created and removed inside the window
+       *  is not reported; an object removed and created again is reported as modified.
+       *
+       *  The coalesced notifications are delivered by the threads of asynchronous notification
+       *  (see set_async_notification()); if it is not set, a single thread is started for them.
+       *
+       *  \param criteria     subscription criteria
+       *  \param user_cb      user-defined callback function
+       *  \param user_param   user-defined parameter
+       *  \param window       coalescing window (e.g. 50 ms); no coalescing, if 0
+       *  \param max_changes  deliver merged changes, when given number of object changes is reached (0 means no limit)
+       *
+       *  \return \b non-null value in case of success (the value to be used for unsubscribe() method).
+       *
+       *  \throw daq::config::Generic in case of an error
+       */
+
+    CallbackId subscribe(const ::ConfigurationSubscriptionCriteria& criteria, notify user_cb, void * user_param, std::chrono::milliseconds window, unsigned int max_changes = 0);
+
+
+      /**
+       *  \brief Subscribe on configuration changes receiving view into shared changes.
+       *
+       *  Same as above, but the user callback function gets the view into changes shared by all subscribers,
+       *  so the changes are not copied for each subscription on part of them. The view can also be adapted
+       *  to the vector of changes passed to the notify callbacks (see ConfigurationChangeView::get_changes()).
+       *
+       *  \param criteria     subscription criteria
+       *  \param user_cb      user-defined callback function
+       *  \param user_param   optional user-defined parameter
+       *  \param window       coalescing window; no coalescing, if 0
+       *  \param max_changes  deliver merged changes, when given number of object changes is reached (0 means no limit)
+       *
+       *  \return \b non-null value in case of success (the value to be used for unsubscribe() method).
+       *
+       *  \throw daq::config::Generic in case of an error
+       */
+
+    CallbackId subscribe(const ::ConfigurationSubscriptionCriteria& criteria, notify_view user_cb, void * user_param = nullptr, std::chrono::milliseconds window = std::chrono::milliseconds(0), unsigned int max_changes = 0);
+
+
       /**
        *  \brief Subscribe on pre-notification on configuration changes.
        *
@@ -376,6 +468,70 @@ class Configuration {
     void unsubscribe(CallbackId cb_handler = 0);
 
 
+      /**
+       *  \brief Set asynchronous invocation of user callbacks.
+       *
+       *  By default the user callbacks are invoked one by one by the notification thread of the database
+       *  implementation, so a slow callback delays all others. When the number of threads is not 0, each
+       *  subscription gets a queue of notifications drained by given number of threads; the notifications
+       *  of the same subscription are delivered in order, while different subscriptions are notified in parallel.
+       *  When the queue of a subscription is full, the notification thread waits.
+       *  When the number of threads is 0, the already queued notifications are delivered and the synchronous
+       *  invocation is restored for subscriptions without coalescing window. The pre-notification callbacks
+       *  are always invoked synchronously.
+       *
+       *  When the dispatcher is replaced, the notifications queued by the previous one are delivered before
+       *  any new notification is queued, so a subscription is never notified concurrently or out of order.
+       *  The method waits for that and must not be called from a user callback.
+       *
+       *  The asynchronous invocation can also be set by the TDAQ_DB_NOTIFICATION_THREADS environment variable.
+       *
+       *  \param num_of_threads  number of threads invoking user callbacks (0 means synchronous invocation)
+       *  \param queue_limit     maximum number of queued notifications per subscription
+       */
+
+    void set_async_notification(unsigned int num_of_threads, unsigned int queue_limit = 1024);
+
+
+      /**
+       *  \brief Get metrics of notification queue of subscription.
+       *
+       *  \param cb_handler  the subscription
+       *  \param metrics     returned queue depth, lag, etc.
+       *
+       *  \return \b false, if the notification of subscription is synchronous or there is no such subscription
+       */
+
+    bool get_notification_metrics(CallbackId cb_handler, config::NotificationMetrics& metrics) const;
+
+
+      /**
+       *  \brief Get histograms of durations of notification processing stages.
+       *
+       *  The stages are invocation of pre-notification callbacks, invocation of config actions, update of objects in cache
+       *  and invocation of synchronous user callbacks; the total processing time of notification is also measured.
+       *  The histograms are printed by print_profiling_info().
+       *
+       *  \param latency     returned histograms
+       */
+
+    void get_notification_latency(config::NotificationLatency& latency) const;
+
+
+      /**
+       *  \brief Get histogram of durations of user callback of subscription.
+       *
+       *  Both synchronous and asynchronous invocations are included.
+       *
+       *  \param cb_handler  the subscription
+       *  \param latency     returned histogram
+       *
+       *  \return \b false, if there is no such subscription
+       */
+
+    bool get_callback_latency(CallbackId cb_handler, config::LatencyHistogram& latency) const;
+
+
 
       /**
        *  \brief Checks validity of pointer to an objects of given user class.
@@ -413,6 +569,19 @@ class Configuration {
 				  const std::vector<std::string>& created) noexcept;
 
 
+      /**
+       *  \brief Update cache of objects in case of modification.
+       *
+       *  Same as above, but the modified objects, which attributes and relationships were not changed
+       *  according to reported names of modified attributes (e.g. the object was moved to another file),
+       *  are not re-read.
+       *
+       *  \param change  changes of objects of given user class
+       */
+
+    template<class T> void update(const ConfigurationChange& change) noexcept;
+
+
       /**
        *  \brief System function invoked in case of modifications.
        *
@@ -505,6 +674,24 @@ class Configuration {
     unread_all_objects(bool unread_implementation_objs = false) noexcept;
 
 
+      /**
+       *  \brief Get generation of database.
+       *
+       *  The generation is incremented on any change of database data known by this process:
+       *  load and unload, abort, unread of objects, create, destroy, set and rename of objects by user's code
+       *  and on every notification about changes made by other processes.
+       *  A user may store the generation together with values calculated from database
+       *  and compare it with the current one to detect, if the values have to be re-calculated.
+       *  See also ConfigObject::generation() and DalObject::generation() to detect changes of single object.
+       */
+
+    uint64_t
+    generation() const noexcept
+    {
+      return p_generation;
+    }
+
+
       /**
        *  \brief Unread all template (i.e. set their state as uninitialized) objects.
        *
@@ -1215,6 +1402,46 @@ class Configuration {
     void prefetch_all_data();
 
 
+    /**
+     *  \brief Limit number of implementation objects in client cache.
+     *
+     *  By default the cache of implementation objects grows without limit for the life of the configuration object.
+     *  When the limit is set, the least recently used implementation objects are removed from cache and destroyed,
+     *  as soon as the number of objects exceeds the limit. An implementation object used by a ConfigObject
+     *  (including ones of template objects) is pinned and never destroyed; the destroyed objects are re-read
+     *  from the implementation on next access.
+     *
+     *  The template objects are not destroyed automatically, since user code keeps pointers to them; see shrink_cache().
+     *
+     *  The limit can also be set by the TDAQ_DB_CACHE_LIMIT environment variable.
+     *
+     *  \param max_objects  maximum number of implementation objects; 0 means unlimited
+     */
+
+    void set_cache_limit(unsigned long max_objects) noexcept;
+
+
+    /**
+     *  \brief Destroy template objects exceeding the cache limit.
+     *
+     *  If the cache limit is set and the number of template objects exceeds it, the method destroys template objects
+     *  not accessed since previous call of the method and, if this is not enough, other template objects. The remaining
+     *  template objects are unread to forget pointers to destroyed ones. Then implementation objects used by the
+     *  destroyed template objects are released.
+     *
+     *  \warning The method may only be called, when user code does not keep pointers to template objects.
+     *
+     *  \return number of destroyed template objects
+     */
+
+    unsigned long shrink_cache() noexcept;
+
+
+    /// Get number of implementation objects in client cache
+
+    unsigned long get_cache_size() const noexcept;
+
+
     // access versions
 
   public:
@@ -1305,6 +1532,84 @@ class Configuration {
     export_data(boost::property_tree::ptree& tree, const std::string& classes = "", const std::string& objects = "", const std::string& files = "", const std::string& empty_array_item = "");
 
 
+    /**
+     *  \brief Export configuration data into output stream.
+     *
+     *  The data are written one object at a time without building ptree of whole database.
+     *  The output is the same as one produced by boost::property_tree writers for the ptree
+     *  filled by the export_data(ptree&) method.
+     *
+     *  \param  s                  output stream
+     *  \param  format             output format ("json", "xml" or "info")
+     *  \param  classes            regex defining class names; ignore if empty
+     *  \param  objects            regex defining object IDs; ignore if empty
+     *  \param  files              regex defining data file names; ignore if empty
+     *  \param  fix_arrays         if true, write empty json arrays as [] and xml array items without unnamed tags
+     *  \param  num_of_threads     number of threads reading objects in parallel; the output does not depend on it
+     *  \param  since              if not empty, export only objects of data files changed by versions since given one (see export_data(DataWriter&))
+     *  \param  with_files         if true, add data file of each object (see export_data(DataWriter&))
+     *
+     *  \throw daq::config::Generic in case of a problem
+     */
+
+    void
+    export_data(std::ostream& s, const std::string& format = "json", const std::string& classes = "", const std::string& objects = "", const std::string& files = "", bool fix_arrays = false, unsigned int num_of_threads = 1, const std::string& since = "", bool with_files = false);
+
+
+    /**
+     *  \brief Export configuration data using user-defined writer.
+     *
+     *  If the number of threads is greater than 1, the objects are read in parallel by chunks,
+     *  which are passed to the writer in order of classes and objects. The methods of the writer
+     *  are always called by the calling thread and in the same order as for single thread.
+     *
+     *  If the version is given, the data files changed by the versions since given one are reported
+     *  by the get_versions() method and passed to DataWriter::add_tombstones(), and only objects of
+     *  these files are exported. The implementations without versions history do not report changes,
+     *  so nothing is exported.
+     *
+     *  If the files of objects are exported, the data file of each object is passed to the writer as the first
+     *  value of the object named by DataWriter::file_key. The incremental export always adds them, so the objects
+     *  can be removed when their file is reported as tombstone; the full export used as base of incremental ones
+     *  has to add them as well.
+     *
+     *  \param  writer             the writer of data
+     *  \param  classes            regex defining class names; ignore if empty
+     *  \param  objects            regex defining object IDs; ignore if empty
+     *  \param  files              regex defining data file names; ignore if empty
+     *  \param  num_of_threads     number of threads reading objects in parallel
+     *  \param  since              if not empty, export only objects of data files changed by versions since given one
+     *  \param  with_files         if true, add data file of each object; ignored and considered as true, if the since is not empty
+     *
+     *  \throw daq::config::Generic in case of a problem
+     */
+
+    void
+    export_data(config::DataWriter& writer, const std::string& classes = "", const std::string& objects = "", const std::string& files = "", unsigned int num_of_threads = 1, const std::string& since = "", bool with_files = false);
+
+
+    /**
+     *  \brief Export configuration data into columnar files.
+     *
+     *  Write a file per class named after the class with ".columns" extension containing
+     *  selected objects of the class, see config::columns namespace for description of the format.
+     *  The classes are written in parallel.
+     *
+     *  \param  directory          output directory
+     *  \param  classes            regex defining class names; ignore if empty
+     *  \param  objects            regex defining object IDs; ignore if empty
+     *  \param  files              regex defining data file names; ignore if empty
+     *  \param  num_of_threads     number of threads writing classes in parallel
+     *
+     *  \return number of written objects
+     *
+     *  \throw daq::config::Generic in case of a problem
+     */
+
+    uint64_t
+    export_columns(const std::string& directory, const std::string& classes = "", const std::string& objects = "", const std::string& files = "", unsigned int num_of_threads = 1);
+
+
     // user-defined converters
 
   public:
@@ -1403,15 +1708,21 @@ class Configuration {
     std::atomic<uint_least64_t> p_number_of_cache_hits;
     std::atomic<uint_least64_t> p_number_of_template_object_created;
     std::atomic<uint_least64_t> p_number_of_template_object_read;
+    std::atomic<uint_least64_t> p_generation;
 
 
   private:
 
     config::fmap<config::fset> p_superclasses;
     config::fmap<config::fset> p_subclasses;
+    config::map<const std::string *> p_class_names;   // references on names of classes known by schema
 
     void set_subclasses() noexcept;
 
+      // return reference on class name; the DalFactory (and its mutex) is only used for class unknown to schema
+
+    const std::string * get_class_name_ref(const std::string& class_name) const noexcept;
+
   public:
 
       /** Get names of superclasses for each class **/
@@ -1553,6 +1864,17 @@ class Configuration {
           get(Configuration& config, ConfigObject& obj, const std::string& id);
 
 
+        virtual size_t
+        size() const noexcept
+        {
+          return m_cache.size();
+        }
+
+
+        virtual size_t
+        release(size_t num, bool unreferenced_only) noexcept;
+
+
       private:
 
         config::map<T*> m_cache;
@@ -1573,28 +1895,35 @@ class Configuration {
 
     template<class T>
     void
-    set_cache_unread(const std::vector<std::string>& objects, Cache<T>& c) noexcept
+    set_cache_unread(const std::string& id, Cache<T>& c) noexcept
     {
-      for (const auto& i : objects)
+      // unread template objects
+      auto x = c.m_cache.find(id);
+      if (x != c.m_cache.end())
         {
-          // unread template objects
-          auto x = c.m_cache.find(i);
-          if (x != c.m_cache.end())
-            {
-              std::lock_guard<std::mutex> scoped_lock(x->second->m_mutex);
-              x->second->p_was_read = false;
-            }
-
-          // unread generated objects if any
-          auto range = c.m_t_cache.equal_range(i);
-          for (auto it = range.first; it != range.second; it++)
-            {
-              std::lock_guard<std::mutex> scoped_lock(it->second->m_mutex);
-              it->second->p_was_read = false;
-            }
+          std::lock_guard<std::mutex> scoped_lock(x->second->m_mutex);
+          x->second->p_was_read = false;
+          x->second->p_generation++;
+        }
+
+      // unread generated objects if any
+      auto range = c.m_t_cache.equal_range(id);
+      for (auto it = range.first; it != range.second; it++)
+        {
+          std::lock_guard<std::mutex> scoped_lock(it->second->m_mutex);
+          it->second->p_was_read = false;
+          it->second->p_generation++;
         }
     }
 
+    template<class T>
+    void
+    set_cache_unread(const std::vector<std::string>& objects, Cache<T>& c) noexcept
+    {
+      for (const auto& i : objects)
+        set_cache_unread(i, c);
+    }
+
 
   public:
 
@@ -1619,7 +1948,6 @@ class Configuration {
     std::string m_impl_spec;
     std::string m_impl_name;
     std::string m_impl_param;
-    void * m_shlib_h;
 
 
     // user notification
@@ -1635,6 +1963,58 @@ class Configuration {
     PreCallbackSet m_pre_callbacks;
 
 
+      // dispatcher of asynchronous notifications (null, if the notification is synchronous)
+
+    std::shared_ptr<config::NotificationDispatcher> m_dispatcher;
+    unsigned int m_async_threads;       // number of threads set by set_async_notification()
+    unsigned int m_async_queue_limit;
+
+      // serialises queueing of notifications by system_cb() and replacement of dispatcher;
+      // lock it before m_else_mutex
+
+    std::mutex m_dispatch_mutex;
+
+
+      // add queue of asynchronous notification for subscription, if needed; the dispatcher is created, if there is none
+
+    void add_queue(CallbackSubscription * cs);
+
+
+      // inverted index of subscriptions rebuilt from user callbacks by reset_subscription()
+
+    std::vector<CallbackSubscription *> m_subscribe_all;                                     // subscriptions on any changes
+    config::map<std::vector<CallbackSubscription *>> m_class_subscriptions;                  // class => subscriptions on class
+    config::map<config::map<std::vector<CallbackSubscription *>>> m_object_subscriptions;    // class => object ID => subscriptions on object
+
+    void index_subscriptions();
+
+
+      // views into shared changes routed to subscriptions
+
+    typedef std::unordered_map<CallbackSubscription *, ConfigurationChangeView> RoutedChanges;
+
+
+      // route changes to matching subscriptions using above index; the synchronous subscriptions on any changes are not included
+
+    void route_changes(const std::shared_ptr<const ConfigurationChangeSet>& changes, RoutedChanges& result) const;
+
+
+      // create and add subscription
+
+    CallbackId add_subscription(const ::ConfigurationSubscriptionCriteria& criteria, notify user_cb, notify_view user_view_cb, void * user_param, std::chrono::milliseconds window, unsigned int max_changes);
+
+
+      // invoke user callback catching any exceptions
+
+    static void invoke(CallbackSubscription * cs, const ConfigurationChangeView& changes) noexcept;
+
+
+      // histograms of notification processing stages
+
+    config::NotificationLatency m_latency;
+    mutable std::mutex m_latency_mutex;
+
+
       // method to find callback by handler
 
     CallbackSubscription * find_callback(CallbackId cb_handler) const;
@@ -1854,6 +2234,47 @@ template<class T>
   }
 
 
+template<class T>
+  size_t
+  Configuration::Cache<T>::release(size_t num, bool unreferenced_only) noexcept
+  {
+    size_t count = 0;
+
+    for (auto i = m_cache.begin(); i != m_cache.end();)
+      {
+        T * o = i->second;
+
+        if (count < num && (!unreferenced_only || !o->p_referenced))
+          {
+            // remove generated object
+            if (o->p_UID != o->p_obj.UID())
+              {
+                auto range = m_t_cache.equal_range(o->p_obj.UID());
+                for (auto it = range.first; it != range.second; ++it)
+                  if (it->second == o)
+                    {
+                      m_t_cache.erase(it);
+                      break;
+                    }
+              }
+
+            i = m_cache.erase(i);
+            delete o;
+            count++;
+          }
+        else
+          {
+            if (!unreferenced_only)
+              o->p_referenced = false;
+
+            ++i;
+          }
+      }
+
+    return count;
+  }
+
+
 template<class T>
   T *
   Configuration::Cache<T>::get(Configuration& config, ConfigObject& obj, bool init_children, bool init_object)
@@ -1873,6 +2294,7 @@ template<class T>
         std::lock_guard<std::mutex> scoped_lock(result->m_mutex);
         result->set(obj); // update implementation object; to be used in case if the object is re-created
       }
+    result->p_referenced = true;
     increment_gets(config);
     return result;
   }
@@ -1882,7 +2304,12 @@ template<class T>
   Configuration::Cache<T>::find(const std::string& id)
   {
     auto it = m_cache.find(id);
-    return (it != m_cache.end() ? it->second : nullptr);
+
+    if (it == m_cache.end())
+      return nullptr;
+
+    it->second->p_referenced = true;
+    return it->second;
   }
 
 template<class T>
@@ -1904,6 +2331,7 @@ template<class T>
         std::lock_guard<std::mutex> scoped_lock(result->m_mutex);
         result->set(obj); // update implementation object; to be used in case if the object is re-created
       }
+    result->p_referenced = true;
     increment_gets(db);
     return result;
   }
@@ -1932,6 +2360,7 @@ Configuration::Cache<T>::get(Configuration& config, const std::string& name, boo
       }
     }
   }
+  i->second->p_referenced = true;
   increment_gets(config);
   return i->second;
 }
@@ -1978,6 +2407,29 @@ Configuration::update(const std::vector<std::string>& modified,
       }
   }
 
+template<class T> void
+Configuration::update(const ConfigurationChange& change) noexcept
+  {
+    auto j = m_cache_map.find(&T::s_class_name);
+
+    TLOG_DEBUG(4) << "call for class \'" << T::s_class_name << '\'';
+
+    if (j != m_cache_map.end())
+      {
+        Cache<T> *c = static_cast<Cache<T>*>(j->second);
+        set_cache_unread(change.get_removed_objs(), *c);
+        set_cache_unread(change.get_created_objs(), *c);
+
+        for (const auto& i : change.get_modified_objs())
+          {
+            const std::vector<std::string> * names = change.get_modified_attributes(i);
+
+            if (names == nullptr || !names->empty())
+              set_cache_unread(i, *c);
+          }
+      }
+  }
+
 template<class T> void
 Configuration::_reset_objects() noexcept
   {
@@ -1998,6 +2450,7 @@ template<class T>
     for (auto& i : c->m_cache)
       {
         i.second->p_was_read = false;
+        i.second->p_generation++;
       }
   }
 
@@ -2011,11 +2464,13 @@ Configuration::_rename_object(CacheBase* x, const std::string& old_id, const std
   if (it != c->m_cache.end())
     {
       TLOG_DEBUG(3) << " * rename \'" << old_id << "\' to \'" << new_id << "\' in class \'" << T::s_class_name << "\')";
-      c->m_cache[new_id] = it->second;
+      T * o = it->second;
       c->m_cache.erase(it);
+      c->m_cache[new_id] = o;
 
-      std::lock_guard<std::mutex> scoped_lock(it->second->m_mutex);
-      it->second->p_UID = new_id;
+      std::lock_guard<std::mutex> scoped_lock(o->m_mutex);
+      o->p_UID = new_id;
+      o->p_generation++;
     }
 
   // rename generated objects if any
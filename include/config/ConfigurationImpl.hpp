@@ -13,6 +13,7 @@
 #include <list>
 #include <set>
 #include <map>
+#include <mutex>
 
 #include "config/map.hpp"
 #include "config/set.hpp"
@@ -177,7 +178,14 @@ class ConfigurationImpl {
 
   public:
 
-      /// Callback to notify database changes
+      /**
+       *  \brief Callback to notify database changes.
+       *
+       *  The callback may take ownership of the changes moving them out of the vector
+       *  (the Configuration's callback always does this and leaves the vector empty).
+       *  After the callback returns, the plug-in destroys the changes left in the vector,
+       *  e.g. using ConfigurationChange::clear().
+       */
 
     typedef void (*notify)(std::vector<ConfigurationChange *> & changes, Configuration *);
 
@@ -202,6 +210,21 @@ class ConfigurationImpl {
     void print_cache_info() noexcept;
 
 
+      /// Set maximum number of implementation objects keeping data in cache (0 means unlimited)
+
+    void set_cache_limit(unsigned long limit) noexcept;
+
+
+      /// Destroy least recently used implementation objects not used by any config object, if the cache limit is exceeded (if force is false, the sweep can be delayed)
+
+    void shrink_cache(bool force = false) noexcept;
+
+
+      /// Get number of implementation objects in cache
+
+    unsigned long get_cache_size() const noexcept;
+
+
       /// cache of implementation objects (class-name::->object_id->implementation)
 
   private:
@@ -211,6 +234,20 @@ class ConfigurationImpl {
 
     mutable unsigned long p_number_of_cache_hits;
     mutable unsigned long p_number_of_object_read;
+    unsigned long p_number_of_evicted_objects;
+
+
+      /// bounded cache: implementation objects swept by the eviction clock; the sweep is skipped until the number of objects exceeds the threshold
+
+    unsigned long m_cache_limit;
+    unsigned long m_cache_threshold;
+    std::vector<ConfigObjectImpl *> m_cache_clock;
+    std::vector<ConfigObjectImpl *>::size_type m_cache_clock_hand;
+    std::mutex m_cache_clock_mutex;
+
+    void track_impl_object(ConfigObjectImpl * obj) noexcept;
+
+    static void destroy_impl_object(ConfigObjectImpl * obj) noexcept;
 
 
   protected:
@@ -265,11 +302,20 @@ class ConfigurationImpl {
     std::mutex& get_conf_impl_mutex() const;
 
 
+      /// Get implementation of configuration (e.g. to find proxy implementation from notification callback)
+
+    static ConfigurationImpl * get_impl(Configuration * db) noexcept;
+
+      /// Get implementation owning implementation object (e.g. to find shard of federated database owning the object)
+
+    static ConfigurationImpl * get_impl(const ConfigObjectImpl * obj) noexcept;
+
+
   public:
 
       /// set configuration object
 
-    void set(Configuration * db) noexcept { m_conf = db; }
+    virtual void set(Configuration * db) noexcept { m_conf = db; }
 
 
   public:
@@ -278,6 +324,48 @@ class ConfigurationImpl {
 
     void rename_impl_object(const std::string * class_name, const std::string& old_id, const std::string& new_id) noexcept;
 
+
+    // methods used by implementations proxying other implementation, which objects are not known by the Configuration
+
+  public:
+
+      /// rename implementation object and update cache
+
+    void rename_impl(ConfigObjectImpl * obj, const std::string& new_id);
+
+      /// update cached implementation objects of changed classes, their superclasses and subclasses
+
+    void update_impl_objects(std::vector<ConfigurationChange *>& changes) noexcept;
+
+      /// clear cached implementation objects and set their state to unknown (e.g. after abort)
+
+    void unread_impl_objects() noexcept;
+
+
+    // search of objects referenced by the implementation, but stored by another one (e.g. by another shard of federated database)
+
+  public:
+
+      /// set implementation searching referenced objects not found by this implementation
+
+    virtual void set_resolver(ConfigurationImpl * impl) noexcept { m_resolver = impl; }
+
+      /// search object for another implementation; return nullptr, if the object is not found (the caller has to lock configuration implementation mutex)
+
+    virtual ConfigObjectImpl * resolve(const std::string& /*class_name*/, const std::string& /*id*/) noexcept { return nullptr; }
+
+
+  protected:
+
+      /// search referenced object not found by this implementation using the resolver, if any (the caller has to lock configuration implementation mutex)
+
+    ConfigObjectImpl * resolve_external(const std::string& class_name, const std::string& id) noexcept
+    {
+      return (m_resolver ? m_resolver->resolve(class_name, id) : nullptr);
+    }
+
+    ConfigurationImpl * m_resolver;
+
 };
 
 
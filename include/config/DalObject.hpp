@@ -8,6 +8,7 @@
 #ifndef CONFIG_DAL_OBJECT_H_
 #define CONFIG_DAL_OBJECT_H_
 
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -52,7 +53,7 @@ protected:
    */
 
   DalObject(Configuration& db, const ::ConfigObject& o) noexcept :
-    p_was_read(false), p_db(db), p_obj(o), p_UID(p_obj.UID())
+    p_was_read(false), p_referenced(true), p_generation(0), p_db(db), p_obj(o), p_UID(p_obj.UID())
     {
       increment_created();
     }
@@ -70,6 +71,7 @@ protected:
   void clear() noexcept
     {
       p_obj._clear();
+      p_generation++;
     }
 
   /**
@@ -104,6 +106,12 @@ protected:
   /// is true, if the object was read
   bool p_was_read;
 
+  /// is set when the object is accessed via cache; is reset by Configuration::shrink_cache()
+  std::atomic<bool> p_referenced;
+
+  /// is incremented, when the object is changed or unread
+  std::atomic<uint_least64_t> p_generation;
+
   /// Configuration object
   Configuration& p_db;
 
@@ -133,6 +141,18 @@ public:
       return p_obj.class_name();
     }
 
+  /**
+   *  Returns generation of the template object.
+   *  It is incremented, when the object is changed by generated set methods, renamed,
+   *  or unread (e.g. on notification about changes of the object or on abort).
+   *  Compare it with previously stored value to detect, if values read from the object are still valid.
+   */
+
+  uint64_t generation() const noexcept
+    {
+      return p_generation;
+    }
+
   /**
    *  Check possibility to cast given object to a new class.
    *  The method returns true, if given object can be casted to target class
@@ -217,6 +237,7 @@ public:
       std::lock_guard<std::mutex> scoped_lock(m_mutex);
       check();
       p_was_read = false;
+      p_generation++;
     }
 
 
@@ -228,6 +249,7 @@ public:
   void set(const ConfigObject& o) noexcept
     {
       p_obj = o;
+      p_generation++;
     }
 
 
@@ -347,7 +369,7 @@ private:
   template<typename T>
   static void update(::Configuration& db, const ::ConfigurationChange * change) noexcept
     {
-      db.update<T>(change->get_modified_objs(), change->get_removed_objs(), change->get_created_objs());
+      db.update<T>(*change);
     }
 
   template<typename T>
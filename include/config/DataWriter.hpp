@@ -0,0 +1,139 @@
+  /**
+   *  \file DataWriter.hpp This file contains DataWriter class used by
+   *  Configuration::export_data() to write exported configuration data.
+   *  \brief writers of exported configuration data
+   */
+
+#ifndef CONFIG_DATAWRITER_H_
+#define CONFIG_DATAWRITER_H_
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree_fwd.hpp>
+
+namespace config
+{
+
+    /**
+     *  \brief Writes exported configuration data.
+     *
+     *  The Configuration::export_data() calls methods of the writer for each selected class in order of names
+     *  and for each selected object of the class in order of ids. The values of attributes and relationships
+     *  are passed converted to strings, the multi-value ones are passed as arrays. The writer is called for
+     *  one object at a time and does not need to keep the data already written.
+     *
+     *  The writers created by the create() methods produce the same output as the boost::property_tree
+     *  json, xml and info writers for the tree filled by the Configuration::export_data(ptree&) method.
+     */
+
+  class DataWriter
+  {
+
+  public:
+
+      /// The name of tombstones array written by the json, xml and info writers; it cannot be a class name
+
+    static const char * const tombstones_key;
+
+
+      /// The name of value containing data file of object, if files of objects are exported; it cannot be an attribute or relationship name
+
+    static const char * const file_key;
+
+
+    virtual ~DataWriter() = default;
+
+
+      /// Called before any data
+
+    virtual void
+    begin() {}
+
+
+      /// Called after all data
+
+    virtual void
+    end() {}
+
+
+      /**
+       *  \brief Add tombstones of incremental export.
+       *
+       *  Called before any class, if the data are exported since given version. The objects previously
+       *  exported from given data files have to be removed and replaced by the exported objects of these files.
+       *  The data file of each object is passed as the first value of the object named by file_key.
+       *  The writers created by the create() methods write the files as array named by tombstones_key.
+       */
+
+    virtual void
+    add_tombstones(const std::vector<std::string>& /*files*/) {}
+
+
+      /// Start objects of class
+
+    virtual void
+    begin_class(const std::string& name) = 0;
+
+
+      /// Finish objects of class
+
+    virtual void
+    end_class() = 0;
+
+
+      /// Start attributes and relationships of object
+
+    virtual void
+    begin_object(const std::string& id) = 0;
+
+
+      /// Finish attributes and relationships of object
+
+    virtual void
+    end_object() = 0;
+
+
+      /// Add single-value attribute or relationship
+
+    virtual void
+    add_value(const std::string& name, const std::string& value) = 0;
+
+
+      /// Add multi-value attribute or relationship
+
+    virtual void
+    add_array(const std::string& name, const std::vector<std::string>& values) = 0;
+
+
+      /**
+       *  \brief Create writer of given format to output stream.
+       *
+       *  \param  format      output format ("json", "xml" or "info")
+       *  \param  s           output stream
+       *  \param  fix_arrays  if true, write empty json arrays as [] (instead of empty strings) and xml array items without unnamed tags
+       *
+       *  \throw daq::config::Generic if the format is not supported
+       */
+
+    static std::unique_ptr<DataWriter>
+    create(const std::string& format, std::ostream& s, bool fix_arrays = false);
+
+
+      /**
+       *  \brief Create writer filling ptree.
+       *
+       *  \param  tree               output ptree object
+       *  \param  empty_array_item   if provided, add this item to mark empty arrays
+       */
+
+    static std::unique_ptr<DataWriter>
+    create(boost::property_tree::ptree& tree, const std::string& empty_array_item = "");
+
+  };
+
+}
+
+#endif // CONFIG_DATAWRITER_H_
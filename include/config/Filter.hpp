@@ -0,0 +1,101 @@
+  /**
+   *  \file Filter.hpp This file contains Filter class used to select classes,
+   *  objects and files by regular expressions.
+   *  \brief compiled regex filter
+   */
+
+#ifndef CONFIG_FILTER_H_
+#define CONFIG_FILTER_H_
+
+#include <memory>
+#include <regex>
+#include <string>
+
+namespace config
+{
+
+    /**
+     *  \brief Matches strings against regular expression.
+     *
+     *  The filter has the same result as the std::regex_match() with ECMAScript regular expression, but
+     *  it detects the patterns which are a literal string, a prefix, a suffix or a substring (e.g. "foo",
+     *  "foo.*", ".*foo" or ".*foo.*") and the glob-like patterns using only "." and ".*" wildcards
+     *  (e.g. "foo-.*-bar.") and matches them without std::regex. Only the other patterns are
+     *  matched using std::regex. An empty pattern matches any string.
+     */
+
+  class Filter
+  {
+
+  public:
+
+    enum Type
+    {
+      All,          ///< empty pattern
+      Literal,      ///< string without wildcards
+      Prefix,       ///< string followed by .*
+      Suffix,       ///< string preceded by .*
+      Substring,    ///< string between .*
+      Glob,         ///< strings with . and .* wildcards
+      Regex         ///< any other regular expression
+    };
+
+
+      /// Compile pattern; throw std::regex_error, if the pattern is not valid regular expression
+
+    explicit Filter(const std::string& pattern = "");
+
+
+      /// Return true, if whole string matches the pattern
+
+    bool
+    match(const std::string& str) const
+    {
+      switch (m_type)
+        {
+          case All:       return true;
+          case Literal:   return (str == m_literal);
+          case Prefix:    return match_prefix(str);
+          case Suffix:    return match_suffix(str);
+          case Substring: return match_substring(str);
+          case Glob:      return match_glob(str);
+          default:        return std::regex_match(str, *m_regex);
+        }
+    }
+
+
+      /// Return type of pattern
+
+    Type
+    get_type() const noexcept
+    {
+      return m_type;
+    }
+
+
+      /// Return true, if the filter matches any string
+
+    bool
+    empty() const noexcept
+    {
+      return (m_type == All);
+    }
+
+
+  private:
+
+    bool match_prefix(const std::string& str) const noexcept;
+    bool match_suffix(const std::string& str) const noexcept;
+    bool match_substring(const std::string& str) const noexcept;
+    bool match_glob(const std::string& str) const noexcept;
+
+    Type m_type;
+    std::string m_literal;               // literal, prefix, suffix, substring or glob characters
+    std::string m_wildcards;             // for glob: '.' (any character), '*' (any characters) or 0 (character of literal) per position
+    std::unique_ptr<std::regex> m_regex;
+
+  };
+
+}
+
+#endif // CONFIG_FILTER_H_
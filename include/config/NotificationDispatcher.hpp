@@ -0,0 +1,208 @@
+  /**
+   *  \file NotificationDispatcher.hpp This file contains NotificationDispatcher class,
+   *  that invokes user notification callbacks by pool of threads.
+   *  \brief asynchronous dispatch of notifications
+   */
+
+#ifndef CONFIG_NOTIFICATIONDISPATCHER_H_
+#define CONFIG_NOTIFICATIONDISPATCHER_H_
+
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "config/Change.hpp"
+#include "config/NotificationLatency.hpp"
+#include "config/map.hpp"
+
+namespace config
+{
+
+    /// Metrics of subscriber's queue of notifications
+
+  struct NotificationMetrics
+  {
+    uint64_t m_queue_depth;                 ///< number of queued notifications
+    uint64_t m_max_queue_depth;             ///< maximum number of queued notifications
+    uint64_t m_number_of_notifications;     ///< number of delivered notifications
+    uint64_t m_number_of_waits;             ///< number of times the notification thread waited for space in full queue
+    uint64_t m_number_of_coalesced;         ///< number of notifications merged with previous ones
+    std::chrono::nanoseconds m_lag;         ///< age of the oldest queued notification
+    std::chrono::nanoseconds m_max_lag;     ///< maximum time between queueing and invocation of callback
+    std::chrono::nanoseconds m_total_lag;   ///< total time between queueing and invocation of callback
+    LatencyHistogram m_duration;            ///< durations of callback
+  };
+
+
+    /**
+     *  \brief Invokes user notification callbacks by pool of threads.
+     *
+     *  Each subscriber has a bounded queue of notifications. The notifications of a subscriber
+     *  are delivered in order of queueing by one thread at a time, while the notifications of
+     *  different subscribers are delivered in parallel, so a slow subscriber does not delay
+     *  the others and the notification thread of the database implementation. When the queue
+     *  of a subscriber is full, the push() waits until the subscriber takes the oldest notification.
+     *
+     *  A subscriber may coalesce bursts of notifications: the changes pushed during the window starting
+     *  with the first of them (or until given number of object changes is reached) are merged per class
+     *  and delivered as one notification. An object created and removed inside the window is not reported,
+     *  an object removed and created again is reported as modified. The names of modified attributes and
+     *  relationships are merged, if they are reported by every change of the object. If the queue is full, the changes are
+     *  merged until the subscriber takes the oldest notification, so the push() never waits.
+     */
+
+  class NotificationDispatcher
+  {
+
+  public:
+
+    typedef void (*notify)(const std::vector<ConfigurationChange *>& changes, void * parameter);
+    typedef void (*notify_view)(const ConfigurationChangeView& changes, void * parameter);
+
+
+      /// Start threads
+
+    NotificationDispatcher(unsigned int num_of_threads, unsigned int queue_limit);
+
+
+      /// Deliver queued notifications and stop threads
+
+    ~NotificationDispatcher();
+
+
+      /// Deliver queued notifications and stop threads; the notifications pushed later are not delivered
+
+    void
+    stop() noexcept;
+
+
+      /// Add subscriber and return its key; the keys are never reused; the notifications are coalesced, if the window is not 0
+
+    uint64_t
+    add(std::chrono::milliseconds window = std::chrono::milliseconds(0), unsigned int max_changes = 0);
+
+
+      /// Remove subscriber and drop its queued notifications; wait callback in progress, unless called from it
+
+    void
+    remove(uint64_t subscriber) noexcept;
+
+
+      /// Queue notification invoking one of callbacks; the notifications of removed subscribers are ignored
+
+    void
+    push(uint64_t subscriber, notify cb, notify_view view_cb, void * parameter, ConfigurationChangeView&& changes) noexcept;
+
+
+      /// Get metrics of subscriber; return false, if there is no such subscriber
+
+    bool
+    get_metrics(uint64_t subscriber, NotificationMetrics& metrics) const noexcept;
+
+
+      /// Print metrics of all subscribers
+
+    void
+    print(std::ostream& s) const noexcept;
+
+
+      /// Return number of threads
+
+    unsigned int
+    get_number_of_threads() const noexcept
+    {
+      return m_threads.size();
+    }
+
+
+  private:
+
+    struct Notification
+    {
+      notify m_cb;
+      notify_view m_view_cb;
+      void * m_parameter;
+      ConfigurationChangeView m_changes;
+      std::chrono::steady_clock::time_point m_queued;
+    };
+
+      /// The changes merged during coalescing window
+
+    struct Coalescing
+    {
+      struct ClassChanges
+      {
+        std::vector<std::string> m_ids;      // objects in order of changes
+        config::map<char> m_actions;         // object => '+' (created), '~' (modified) or '-' (removed)
+        config::map<std::vector<std::string>> m_attributes;  // modified object => modified attributes and relationships, if known
+      };
+
+      const std::chrono::milliseconds m_window;
+      const unsigned int m_max_changes;
+
+      notify m_cb = nullptr;
+      notify_view m_view_cb = nullptr;
+      void * m_parameter = nullptr;
+      std::chrono::steady_clock::time_point m_queued;
+      std::chrono::steady_clock::time_point m_deadline;
+      std::vector<std::string> m_classes;    // classes in order of changes
+      config::map<ClassChanges> m_changes;
+      unsigned int m_number_of_changes = 0;
+
+      Coalescing(std::chrono::milliseconds window, unsigned int max_changes) : m_window(window), m_max_changes(max_changes) {}
+
+      bool empty() const { return m_classes.empty(); }
+
+      void merge(const ConfigurationChangeView& changes);
+      void merge(ClassChanges& c, const std::string& id, char action, const std::vector<std::string> * names = nullptr);
+      void build(std::vector<ConfigurationChange *>& changes);
+    };
+
+    struct Queue
+    {
+      std::deque<Notification> m_notifications;
+      bool m_removed = false;
+      bool m_running = false;
+      std::thread::id m_thread;
+      NotificationMetrics m_metrics {};
+      std::unique_ptr<Coalescing> m_coalescing;
+    };
+
+    void
+    run() noexcept;
+
+      // queue merged changes, if the queue is not full or force is set; return false, if the queue is full
+
+    bool
+    flush(const std::shared_ptr<Queue>& q, bool force) noexcept;
+
+      // flush merged changes with expired window and return nearest deadline of others
+
+    std::chrono::steady_clock::time_point
+    flush_expired() noexcept;
+
+    const unsigned int m_queue_limit;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_ready_cond;     // a queue is ready or stop is requested
+    std::condition_variable m_done_cond;      // a callback is done
+    std::map<uint64_t, std::shared_ptr<Queue>> m_queues;
+    uint64_t m_last_key;
+    std::deque<std::shared_ptr<Queue>> m_ready;
+    bool m_stop;
+
+    std::vector<std::thread> m_threads;
+
+  };
+
+}
+
+#endif // CONFIG_NOTIFICATIONDISPATCHER_H_
@@ -0,0 +1,76 @@
+  /**
+   *  \file NotificationLatency.hpp This file contains histograms of durations
+   *  of notification processing stages.
+   *  \brief notification latency histograms
+   */
+
+#ifndef CONFIG_NOTIFICATIONLATENCY_H_
+#define CONFIG_NOTIFICATIONLATENCY_H_
+
+#include <stdint.h>
+
+#include <chrono>
+#include <iostream>
+
+namespace config
+{
+
+    /**
+     *  \brief Histogram of durations.
+     *
+     *  The bins have logarithmic size: the first bin counts durations shorter than 1 microsecond,
+     *  the bin i counts durations from 2^(i-1) to 2^i microseconds and the last bin counts all longer durations.
+     */
+
+  struct LatencyHistogram
+  {
+    static const unsigned int s_number_of_bins = 24;
+
+    uint64_t m_count = 0;                           ///< number of measurements
+    std::chrono::nanoseconds m_total {0};           ///< total duration
+    std::chrono::nanoseconds m_max {0};             ///< maximum duration
+    uint64_t m_bins[s_number_of_bins] = {};         ///< number of measurements per bin
+
+
+      /// Add duration to the histogram
+
+    void
+    add(std::chrono::nanoseconds duration) noexcept;
+
+
+      /// Add measurements of other histogram
+
+    void
+    merge(const LatencyHistogram& other) noexcept;
+
+
+      /// Return upper limit of the bin in microseconds (the last bin has no limit)
+
+    static uint64_t
+    get_bin_limit(unsigned int bin) noexcept
+    {
+      return (uint64_t(1) << bin);
+    }
+
+
+      /// Print number of measurements, average and maximum durations and non-empty bins
+
+    void
+    print(std::ostream& s) const noexcept;
+  };
+
+
+    /// Histograms of durations of notification processing stages
+
+  struct NotificationLatency
+  {
+    LatencyHistogram m_pre_notify;       ///< invocation of pre-notification callbacks
+    LatencyHistogram m_actions;          ///< invocation of config actions
+    LatencyHistogram m_cache_update;     ///< update of implementation and template objects
+    LatencyHistogram m_callbacks;        ///< invocation of synchronous user callbacks and queueing of asynchronous ones
+    LatencyHistogram m_total;            ///< processing of changes from notification by the plug-in until return to it
+  };
+
+}
+
+#endif // CONFIG_NOTIFICATIONLATENCY_H_
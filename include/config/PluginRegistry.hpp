@@ -0,0 +1,116 @@
+  /**
+   *  \file PluginRegistry.hpp This file contains PluginRegistry class,
+   *  that keeps creators of config implementations.
+   *  \brief config plug-ins registry
+   */
+
+#ifndef CONFIG_PLUGIN_REGISTRY_H_
+#define CONFIG_PLUGIN_REGISTRY_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ConfigurationImpl;
+
+
+  /**
+   *  \brief Process-wide registry of config implementation plug-ins.
+   *
+   *  The registry maps name of implementation (e.g. "oksconfig") to its creator function.
+   *  When the Configuration is created for an unknown implementation, the registry loads
+   *  shared library lib<name>.so and searches there the _<name>_creator_ function; the library
+   *  is loaded once per process and is never unloaded.
+   *
+   *  An implementation linked into the application can be registered statically
+   *  using the CONFIG_REGISTER_PLUGIN macro, then the dynamic loader is not used at all.
+   */
+
+class PluginRegistry
+{
+
+public:
+
+  /// The implementation creator function; the parameter is the database specification without plug-in name.
+
+  typedef ConfigurationImpl * (*creator_fn)(const std::string& spec);
+
+
+  /** return the singleton */
+  static PluginRegistry &
+  instance();
+
+
+  /**
+   * \brief Register implementation creator
+   *
+   * \param name     name of implementation
+   * \param creator  creator function
+   */
+
+  void
+  register_plugin(const std::string& name, creator_fn creator) noexcept;
+
+
+  /**
+   * \brief Get implementation creator
+   *
+   * Return registered creator or load it from the lib<name>.so plug-in.
+   *
+   * \param name     name of implementation
+   * \return         the creator function
+   *
+   * \throw daq::config::Generic exception if the plug-in cannot be loaded
+   */
+
+  creator_fn
+  get(const std::string& name);
+
+
+  /**
+   * \brief Create implementation
+   *
+   * \param spec     database specification in format "plugin-name[:parameter]"
+   * \return         new implementation (to be deleted by user)
+   *
+   * \throw daq::config::Generic exception if the plug-in cannot be loaded or the implementation cannot be created
+   */
+
+  ConfigurationImpl *
+  create(const std::string& spec);
+
+
+  /** return names of registered implementations */
+  std::vector<std::string>
+  get_names() const;
+
+
+private:
+
+  // a plug-in library may register itself when loaded by the get() method
+
+  mutable std::recursive_mutex m_mutex;
+  std::map<std::string, creator_fn> m_creators;
+
+};
+
+
+  /**
+   *  \brief Statically register config implementation.
+   *
+   *  Use in the source file of implementation, e.g. CONFIG_REGISTER_PLUGIN(memconfig, _memconfig_creator_).
+   *  Note, when the implementation is linked from static library, the object file containing the registration
+   *  has to be linked completely (e.g. using --whole-archive linker option).
+   */
+
+#define CONFIG_REGISTER_PLUGIN(NAME, CREATOR)                                   \
+  namespace {                                                                   \
+    struct ConfigRegisterPlugin_##NAME {                                        \
+      ConfigRegisterPlugin_##NAME() {                                           \
+        PluginRegistry::instance().register_plugin(#NAME, CREATOR);             \
+      }                                                                         \
+    } s_config_register_plugin_##NAME;                                          \
+  }
+
+#endif // CONFIG_PLUGIN_REGISTRY_H_
@@ -0,0 +1,137 @@
+  /**
+   *  \file ProxyConfigObject.hpp This file contains ProxyConfigObject class,
+   *  that forwards calls to object of another config implementation.
+   *  \brief proxy config object
+   */
+
+#ifndef CONFIG_PROXYCONFIGOBJECT_H_
+#define CONFIG_PROXYCONFIGOBJECT_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "config/ConfigObjectImpl.hpp"
+#include "config/ProxyConfiguration.hpp"
+
+
+  /**
+   *  \brief Implements object of proxy configuration database.
+   *
+   *  The object wraps implementation object of the proxied database and forwards to it all calls,
+   *  that are reported by the ProxyConfiguration.
+   */
+
+class ProxyConfigObject : public ConfigObjectImpl {
+
+  friend class ProxyConfiguration;
+
+  public:
+
+    ProxyConfigObject(ConfigObjectImpl * obj, ConfigurationImpl * impl) noexcept;
+
+    virtual ~ProxyConfigObject() noexcept;
+
+
+  public:
+
+    virtual const std::string contained_in() const;
+
+    virtual void get(const std::string& attribute, bool&           value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint8_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int8_t&         value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint16_t&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int16_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint32_t&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int32_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint64_t&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int64_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, float&          value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, double&         value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::string&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& association, ConfigObject& value);
+
+    virtual void get(const std::string& attribute, std::vector<bool>&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint8_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int8_t>&      value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint16_t>&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int16_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint32_t>&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int32_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint64_t>&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int64_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<float>&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<double>&      value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<std::string>& value) { get_value(attribute, value); }
+    virtual void get(const std::string& association, std::vector<ConfigObject>& value);
+
+    virtual bool rel(const std::string& name, std::vector<ConfigObject>& value);
+    virtual void referenced_by(std::vector<ConfigObject>& value, const std::string& association, bool check_composite_only, unsigned long rlevel, const std::vector<std::string> * rclasses) const;
+
+    virtual void set(const std::string& attribute, bool               value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, uint8_t            value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, int8_t             value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, uint16_t           value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, int16_t            value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, uint32_t           value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, int32_t            value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, uint64_t           value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, int64_t            value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, float              value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, double             value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::string& value) { set_value(attribute, value); }
+
+    virtual void set_enum(const std::string& attribute, const std::string& value);
+    virtual void set_date(const std::string& attribute, const std::string& value);
+    virtual void set_time(const std::string& attribute, const std::string& value);
+    virtual void set_class(const std::string& attribute, const std::string& value);
+
+    virtual void set(const std::string& attribute, const std::vector<bool>&        value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<uint8_t>&     value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<int8_t>&      value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<uint16_t>&    value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<int16_t>&     value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<uint32_t>&    value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<int32_t>&     value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<uint64_t>&    value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<int64_t>&     value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<float>&       value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<double>&      value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<std::string>& value) { set_value(attribute, value); }
+
+    virtual void set_enum(const std::string& attribute, const std::vector<std::string>& value);
+    virtual void set_date(const std::string& attribute, const std::vector<std::string>& value);
+    virtual void set_time(const std::string& attribute, const std::vector<std::string>& value);
+    virtual void set_class(const std::string& attribute, const std::vector<std::string>& value);
+
+    virtual void set(const std::string& association, const ConfigObject * value, bool skip_non_null_check);
+    virtual void set(const std::string& association, const std::vector<const ConfigObject*>& value, bool skip_non_null_check);
+
+    virtual void move(const std::string& at);
+    virtual void rename(const std::string& new_id);
+
+    virtual void reset();
+
+
+  public:
+
+      /// Used by ConfigurationImpl::insert_object() when the implementation object is re-used
+
+    void set(ConfigObjectImpl * obj) noexcept { m_obj = obj; }
+
+
+  private:
+
+    ConfigObjectImpl * m_obj;
+
+    ProxyConfiguration * db() const noexcept { return static_cast<ProxyConfiguration *>(m_impl); }
+
+    void check() const;
+
+    template<class T> void get_value(const std::string& name, T& value);
+    template<class T> void set_value(const std::string& name, const T& value);
+
+};
+
+#endif // CONFIG_PROXYCONFIGOBJECT_H_
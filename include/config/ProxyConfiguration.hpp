@@ -0,0 +1,259 @@
+  /**
+   *  \file ProxyConfiguration.hpp This file contains ProxyConfiguration class,
+   *  that forwards calls to another config implementation.
+   *  \brief base class of proxy config plug-ins
+   */
+
+#ifndef CONFIG_PROXYCONFIGURATION_H_
+#define CONFIG_PROXYCONFIGURATION_H_
+
+#include <stdint.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "config/ConfigObject.hpp"
+#include "config/ConfigObjectImpl.hpp"
+#include "config/ConfigurationImpl.hpp"
+
+class ProxyConfigObject;
+
+namespace config
+{
+  namespace proxy
+  {
+
+      /// The calls of config implementation forwarded by the proxy
+
+    enum CallType : uint8_t
+    {
+      get_object,        ///< get object by class and ID
+      get_objects,       ///< get objects of class
+      get_path,          ///< get objects by path query
+      test_object,       ///< test object existence
+      get_class,         ///< get class description
+      get_superclasses,  ///< get superclasses of all classes
+      create_db,         ///< create new database file
+      is_writable,       ///< test if database file is writable
+      add_include,       ///< add include to database file
+      remove_include,    ///< remove include from database file
+      get_includes,      ///< get includes of database file
+      get_updated_dbs,   ///< get updated database files
+      create_object,     ///< create new object
+      destroy_object,    ///< destroy object
+      commit,            ///< commit changes
+      abort,             ///< abort changes
+      get_changes,       ///< get new versions of repository
+      get_versions,      ///< get versions of repository
+      prefetch_all_data, ///< prefetch all objects
+      get_attribute,     ///< read attribute value
+      get_relationship,  ///< read relationship value
+      get_rel,           ///< read relationship value, if any
+      referenced_by,     ///< get objects referencing object
+      contained_in,      ///< get file containing object
+      set_attribute,     ///< set attribute value
+      set_relationship,  ///< set relationship value
+      move,              ///< move object to another file
+      rename,            ///< rename object
+      number_of_call_types
+    };
+
+      /// Return name of call type
+
+    const char *
+    call2str(CallType type) noexcept;
+
+
+      /// Approximate size of returned data in bytes; an object is counted by the size of its identity
+
+    template<class T>
+      inline uint64_t
+      size_of(const T&) noexcept
+      {
+        return sizeof(T);
+      }
+
+    inline uint64_t
+    size_of(const std::string& value) noexcept
+    {
+      return value.size();
+    }
+
+    inline uint64_t
+    size_of(const ConfigObject& value) noexcept
+    {
+      return value.is_null() ? 0 : (value.UID().size() + value.class_name().size());
+    }
+
+    template<class T>
+      inline uint64_t
+      size_of(const std::vector<T>& value) noexcept
+      {
+        uint64_t size = 0;
+
+        for (const auto& x : value)
+          size += size_of(x);
+
+        return size;
+      }
+
+  }
+}
+
+
+  /**
+   *  \brief Base class of implementations forwarding calls to another config implementation.
+   *
+   *  The plug-in parameter is the specification of the proxied database, e.g. "recordconfig:oksconfig:daq/partitions/test.data.xml".
+   *  The proxied (inner) implementation is created by the same plug-in registry as used by the Configuration;
+   *  it shares the mutexes and the notification path of the Configuration owning the proxy.
+   *
+   *  Every forwarded call is reported to the derived class by the called() method with the size of the
+   *  returned data and the latency of the proxied implementation. The objects returned by the proxied
+   *  implementation are wrapped by the ProxyConfigObject, so that calls of the object methods are
+   *  reported in the same way.
+   *
+   *  The proxy implementations can be nested, e.g. "recordconfig:latencyconfig:jsonconfig:test.data.json".
+   */
+
+class ProxyConfiguration : public ConfigurationImpl {
+
+  friend class ProxyConfigObject;
+
+  public:
+
+    ProxyConfiguration() noexcept;
+
+    virtual ~ProxyConfiguration();
+
+
+  public:
+
+    virtual void open_db(const std::string& spec);
+    virtual void close_db();
+    virtual bool loaded() const noexcept;
+    virtual void create(const std::string& db_name, const std::list<std::string>& includes);
+    virtual bool is_writable(const std::string& db_name);
+    virtual void add_include(const std::string& db_name, const std::string& include);
+    virtual void remove_include(const std::string& db_name, const std::string& include);
+    virtual void get_includes(const std::string& db_name, std::list<std::string>& includes) const;
+    virtual void get_updated_dbs(std::list<std::string>& dbs) const;
+    virtual void set_commit_credentials(const std::string& user, const std::string& password);
+    virtual void commit(const std::string& log_message);
+    virtual void abort();
+    virtual void prefetch_all_data();
+    virtual std::vector<daq::config::Version> get_changes();
+    virtual std::vector<daq::config::Version> get_versions(const std::string& since, const std::string& until, daq::config::Version::QueryType type, bool skip_irrelevant);
+
+    virtual void get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual void get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual void get(const ConfigObject& obj_from, const std::string& query, std::vector<ConfigObject>& objects, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual bool test_object(const std::string& class_name, const std::string& id, unsigned long rlevel, const std::vector<std::string> * rclasses);
+
+    virtual void create(const std::string& at, const std::string& class_name, const std::string& id, ConfigObject& object);
+    virtual void create(const ConfigObject& at, const std::string& class_name, const std::string& id, ConfigObject& object);
+    virtual void destroy(ConfigObject& object);
+
+    virtual daq::config::class_t * get(const std::string& class_name, bool direct_only);
+    virtual void get_superclasses(config::fmap<config::fset>& schema);
+
+    virtual void subscribe(const std::set<std::string>& class_names, const std::map< std::string, std::set<std::string> >& objs, ConfigurationImpl::notify cb, ConfigurationImpl::pre_notify pre_cb);
+    virtual void unsubscribe();
+
+    virtual void print_profiling_info() noexcept;
+
+    virtual void set(Configuration * db) noexcept;
+    virtual void set_resolver(ConfigurationImpl * impl) noexcept;
+
+
+  protected:
+
+    /**
+     *  \brief Report forwarded call.
+     *
+     *  The method is called after each call of proxied implementation; by default it does nothing.
+     *
+     *  \param type         the call type
+     *  \param class_name   name of class (empty, if not applicable)
+     *  \param id           object ID (empty, if not applicable)
+     *  \param name         name of attribute or relationship, query, file or repository version (empty, if not applicable)
+     *  \param result_size  approximate size of returned data in bytes
+     *  \param start        time when the call was started
+     *  \param duration     latency of proxied implementation
+     *  \param failed       true, if the proxied implementation has thrown an exception
+     */
+
+    virtual void called(config::proxy::CallType type, const std::string& class_name, const std::string& id, const std::string& name,
+                        uint64_t result_size, std::chrono::steady_clock::time_point start, std::chrono::nanoseconds duration, bool failed) noexcept;
+
+
+      /// Forward call to proxied implementation and report it; the function returns size of returned data
+
+    template<class F>
+      void
+      call(config::proxy::CallType type, const std::string& class_name, const std::string& id, const std::string& name, F function)
+      {
+        const auto start = std::chrono::steady_clock::now();
+        uint64_t size;
+
+        try
+          {
+            size = function();
+          }
+        catch (...)
+          {
+            called(type, class_name, id, name, 0, start, std::chrono::steady_clock::now() - start, true);
+            throw;
+          }
+
+        called(type, class_name, id, name, size, start, std::chrono::steady_clock::now() - start, false);
+      }
+
+
+      /// Return true, if the implementation is proxied by this one
+
+    virtual bool is_inner(const ConfigurationImpl * impl) const noexcept;
+
+
+      /// Replace objects of proxied implementation by proxy objects (the caller has to lock configuration implementation mutex);
+      /// the objects of other implementations (e.g. found by the resolver) are not replaced
+
+    void wrap(ConfigObject& obj) noexcept;
+    void wrap(std::vector<ConfigObject>& objs) noexcept;
+
+
+      /// Return object of proxied implementation wrapped by the proxy object (or null object)
+
+    ConfigObject unwrap(const ConfigObject& obj) const;
+
+
+      /// Rename object of proxied implementation
+
+    virtual void rename_inner(ConfigObjectImpl * obj, const std::string& new_id);
+
+
+      /// Update cached objects of proxied implementation(s) on notification (the caller has to lock configuration implementation mutex)
+
+    virtual void update_inner_objects(std::vector<ConfigurationChange *>& changes) noexcept;
+
+
+      /// Update cached objects of implementation and, if it is a proxy, of implementation(s) proxied by it
+
+    static void update_objects(ConfigurationImpl * impl, std::vector<ConfigurationChange *>& changes) noexcept;
+
+
+  protected:
+
+    std::string m_spec;
+    std::unique_ptr<ConfigurationImpl> m_inner;
+
+
+    ConfigurationImpl::notify m_cb;
+
+    static void notify_cb(std::vector<ConfigurationChange *>& changes, Configuration * db) noexcept;
+
+};
+
+#endif // CONFIG_PROXYCONFIGURATION_H_
@@ -95,6 +95,12 @@ namespace daq {
       /** Return string corresponding to given integer value representation format */
       static const char * format2str(int_format_t format /*!< the integer value representation format */);
 
+      /** Return data type corresponding to given short string; throw daq::config::Generic if the string is not a valid type */
+      static type_t str2type(const std::string& type /*!< the short string produced by the type() method */);
+
+      /** Return integer value representation format corresponding to given string; throw daq::config::Generic if the string is not a valid format */
+      static int_format_t str2format(const std::string& format /*!< the string produced by the format2str() method */);
+
     };
 
 
@@ -147,6 +153,11 @@ namespace daq {
 
       static const char * card2str(cardinality_t cardinality);
 
+
+        /** Return cardinality corresponding to given string; throw daq::config::Generic if the string is not a valid cardinality */
+
+      static cardinality_t str2card(const std::string& cardinality);
+
     };
 
 
@@ -0,0 +1,260 @@
+  /**
+   *  \file Snapshot.hpp This file contains description of the binary snapshot format
+   *  and the Writer class to create snapshot files.
+   *  \brief binary snapshot of config database
+   */
+
+#ifndef CONFIG_SNAPSHOT_H_
+#define CONFIG_SNAPSHOT_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "config/Schema.hpp"
+#include "config/map.hpp"
+
+class Configuration;
+class ConfigObject;
+
+  /**
+   *  \brief The binary snapshot of a config database.
+   *
+   *  The snapshot file is designed to be memory-mapped and used without parsing or copying.
+   *  All numbers are stored using native byte order, all offsets are given in bytes from the
+   *  beginning of the file and all sections are 8-bytes aligned.
+   *
+   *  The file starts from the Header followed by sections:
+   *  - array of Class records; the classes are sorted by name;
+   *  - per-class arrays of superclass and subclass indices, Attribute and Relationship records;
+   *  - per-class arrays of Object records sorted by id (to be used for binary search);
+   *  - the object data: for every object there are 8-bytes slots for each attribute and relationship;
+   *  - the file names array (string references);
+   *  - the string table.
+   *
+   *  The object data slot of single-value attribute contains value of the attribute type
+   *  (bool is stored as uint8_t, strings, enums, dates, times and class references are stored
+   *  as string reference). The slot of multi-value attribute or relationship contains offset
+   *  of the array (0, if the array is empty) starting from uint64_t number of items followed by
+   *  the values. The value of relationship is uint64_t object reference (the class index in
+   *  high 32 bits and the object index in low 32 bits).
+   *
+   *  A string reference is an offset in the string table of a string stored as
+   *  uint32_t length followed by the characters and the terminating zero.
+   */
+
+namespace config
+{
+  namespace snapshot
+  {
+
+      /// The format version; increase on any incompatible change
+
+    const uint32_t format_version = 1;
+
+      /// The value used to detect byte order mismatch
+
+    const uint32_t byte_order_mark = 0x01020304;
+
+      /// The snapshot file signature
+
+    const char magic[8] = { 'C', 'O', 'N', 'F', 'S', 'N', 'A', 'P' };
+
+      /// Bit set for direct superclasses and subclasses in the class indices arrays
+
+    const uint32_t direct_class_bit = 0x80000000;
+
+
+    struct Header
+    {
+      char m_magic[8];
+      uint32_t m_version;
+      uint32_t m_byte_order;
+      uint64_t m_size;                // total size of the file
+      uint64_t m_checksum;            // checksum of the file after header
+      int64_t m_created;              // creation time (seconds since Epoch)
+      uint64_t m_strings;             // offset of the string table
+      uint64_t m_strings_size;        // size of the string table
+      uint64_t m_files;               // offset of the array of uint32_t string references
+      uint32_t m_files_count;
+      uint32_t m_classes_count;
+      uint64_t m_classes;             // offset of the array of Class records
+      uint64_t m_objects_count;       // total number of objects
+    };
+
+    struct Class
+    {
+      enum { abstract_flag = 1 };
+
+      uint32_t m_name;
+      uint32_t m_description;
+      uint32_t m_flags;
+      uint32_t m_superclasses_count;
+      uint64_t m_superclasses;        // offset of the array of uint32_t class indices (all superclasses)
+      uint32_t m_subclasses_count;
+      uint32_t m_attributes_count;
+      uint64_t m_subclasses;          // offset of the array of uint32_t class indices (all subclasses)
+      uint64_t m_attributes;          // offset of the array of Attribute records (all attributes)
+      uint32_t m_relationships_count;
+      uint32_t m_objects_count;
+      uint64_t m_relationships;       // offset of the array of Relationship records (all relationships)
+      uint64_t m_objects;             // offset of the array of Object records sorted by id
+    };
+
+    struct Attribute
+    {
+      enum { not_null_flag = 1, multi_value_flag = 2, direct_flag = 4 };
+
+      uint32_t m_name;
+      uint32_t m_range;
+      uint32_t m_default_value;
+      uint32_t m_description;
+      uint8_t m_type;
+      uint8_t m_int_format;
+      uint8_t m_flags;
+      uint8_t m_pad[5];
+    };
+
+    struct Relationship
+    {
+      enum { aggregation_flag = 1, direct_flag = 4 };
+
+      uint32_t m_name;
+      uint32_t m_type;                // class index
+      uint32_t m_description;
+      uint8_t m_cardinality;
+      uint8_t m_flags;
+      uint8_t m_pad[2];
+    };
+
+    struct Object
+    {
+      uint32_t m_id;
+      uint32_t m_file;                // index in the files array
+      uint64_t m_data;                // offset of attribute and relationship slots
+    };
+
+    static_assert(sizeof(Header) == 88 && sizeof(Class) == 72 && sizeof(Attribute) == 24 && sizeof(Relationship) == 16 && sizeof(Object) == 16, "unexpected size of snapshot record");
+
+
+      /// Calculate FNV-1a checksum of data
+
+    uint64_t
+    checksum(const void * data, uint64_t size) noexcept;
+
+
+      /// Encode object reference
+
+    inline uint64_t
+    make_ref(uint32_t class_idx, uint32_t object_idx) noexcept
+    {
+      return ((static_cast<uint64_t>(class_idx) << 32) | object_idx);
+    }
+
+
+      /// The attribute value read by the Writer
+
+    typedef std::variant<
+      bool, uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, uint64_t, int64_t, float, double, std::string,
+      std::vector<bool>, std::vector<uint8_t>, std::vector<int8_t>, std::vector<uint16_t>, std::vector<int16_t>,
+      std::vector<uint32_t>, std::vector<int32_t>, std::vector<uint64_t>, std::vector<int64_t>,
+      std::vector<float>, std::vector<double>, std::vector<std::string>
+    > Value;
+
+
+      /**
+       *  \brief Creates snapshot file.
+       *
+       *  The writer reads the schema of all classes from the database.
+       *  The objects added by the add() method are read using the config API
+       *  and stored in memory until the write() method is called.
+       *  The add() method can be called concurrently from several threads.
+       *
+       *  The relationships referencing objects, which are not added, are ignored.
+       *  The writer uses schema descriptions cached by the database and must not outlive it.
+       *
+       *  \throw daq::config::Generic in case of an error
+       */
+
+    class Writer
+    {
+
+    public:
+
+      Writer(Configuration& db);
+
+      ~Writer();
+
+        /// Read attributes and relationships of the object
+
+      void
+      add(const ConfigObject& obj);
+
+        /// Write snapshot file (the file is written under temporary name and renamed when completed)
+
+      void
+      write(const std::string& file_name);
+
+        /// Publish snapshot in POSIX shared memory segment (the previous segment with the same name is replaced)
+
+      void
+      publish(const std::string& shm_name);
+
+        /// Return number of added objects
+
+      uint64_t
+      get_number_of_objects() const noexcept
+      {
+        return m_number_of_objects;
+      }
+
+        /// Return number of references to objects, which were not added, ignored by last write()
+
+      uint64_t
+      get_number_of_dangling_references() const noexcept
+      {
+        return m_number_of_dangling_references;
+      }
+
+
+    private:
+
+        /// Build snapshot image; the name is used in messages
+
+      std::vector<char>
+      serialize(const std::string& name);
+
+      struct ObjectData
+      {
+        std::string m_id;
+        std::string m_file;
+        std::vector<Value> m_attributes;
+        std::vector<std::vector<std::pair<std::string, std::string>>> m_relationships;  // class name and object id
+      };
+
+      struct ClassData
+      {
+        ClassData(const daq::config::class_t& all, const daq::config::class_t& direct) : m_info(all), m_direct(direct) { ; }
+
+        const daq::config::class_t& m_info;    // all superclasses, subclasses, attributes and relationships
+        const daq::config::class_t& m_direct;  // direct ones only
+        std::mutex m_mutex;
+        std::vector<ObjectData> m_objects;
+      };
+
+      std::vector<std::unique_ptr<ClassData>> m_classes;
+      config::map<uint32_t> m_class_index;
+      std::atomic<uint64_t> m_number_of_objects;
+      uint64_t m_number_of_dangling_references;
+
+    };
+
+  }
+}
+
+#endif // CONFIG_SNAPSHOT_H_
@@ -0,0 +1,217 @@
+  /**
+   *  \file Trace.hpp This file contains description of the binary trace format
+   *  and the Writer and Reader classes to record and read calls of config implementation.
+   *  \brief binary trace of config implementation calls
+   */
+
+#ifndef CONFIG_TRACE_H_
+#define CONFIG_TRACE_H_
+
+#include <stdint.h>
+
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "config/ProxyConfiguration.hpp"
+
+  /**
+   *  \brief The binary trace of config implementation calls.
+   *
+   *  All numbers are stored using native byte order. The file starts from the Header followed
+   *  by the specification of the traced database and by the sequence of records. Each record
+   *  starts from one byte tag:
+   *  - string record: uint32_t length followed by the characters; the strings are numbered from 1
+   *    in order of appearance and the number 0 is used for the empty string;
+   *  - call record: the Call structure, that refers strings by their numbers.
+   *
+   *  A string is written once before the first call using it, so the trace stays compact
+   *  when the same classes, objects and attributes are accessed repeatedly.
+   */
+
+namespace config
+{
+  namespace trace
+  {
+
+      /// The format version; increase on any incompatible change
+
+    const uint32_t format_version = 1;
+
+      /// The value used to detect byte order mismatch
+
+    const uint32_t byte_order_mark = 0x01020304;
+
+      /// The trace file signature
+
+    const char magic[8] = { 'C', 'O', 'N', 'F', 'T', 'R', 'A', 'C' };
+
+      /// The record tags
+
+    const uint8_t string_tag = 'S';
+    const uint8_t call_tag = 'C';
+
+
+    struct Header
+    {
+      char m_magic[8];
+      uint32_t m_version;
+      uint32_t m_byte_order;
+      int64_t m_created;              // creation time (seconds since Epoch)
+      uint32_t m_spec_length;         // length of database specification following the header
+      uint32_t m_reserved;
+    };
+
+    struct Call
+    {
+      uint64_t m_start;               // nanoseconds since the trace was started
+      uint64_t m_duration;            // latency in nanoseconds
+      uint64_t m_result_size;         // approximate size of returned data in bytes
+      uint32_t m_class_name;          // string number
+      uint32_t m_id;                  // string number
+      uint32_t m_name;                // string number
+      uint16_t m_thread;              // thread number, in order of appearance
+      uint8_t m_type;                 // config::proxy::CallType
+      uint8_t m_failed;               // 1, if the call has thrown an exception
+    };
+
+
+      /**
+       *  \brief Writes trace file.
+       *
+       *  The add() method can be called concurrently from several threads.
+       *  The records are buffered and written when the buffer is full, on flush() and by destructor.
+       *
+       *  \throw daq::config::Generic if the file cannot be created
+       */
+
+    class Writer
+    {
+
+    public:
+
+      Writer(const std::string& file_name, const std::string& spec);
+
+      ~Writer();
+
+        /// Add call record
+
+      void
+      add(config::proxy::CallType type, const std::string& class_name, const std::string& id, const std::string& name,
+          uint64_t result_size, std::chrono::steady_clock::time_point start, std::chrono::nanoseconds duration, bool failed) noexcept;
+
+        /// Write buffered records to file
+
+      void
+      flush() noexcept;
+
+        /// Return number of added calls
+
+      uint64_t
+      get_number_of_calls() const noexcept
+      {
+        return m_number_of_calls;
+      }
+
+        /// Return name of the file
+
+      const std::string&
+      get_file_name() const noexcept
+      {
+        return m_file_name;
+      }
+
+
+    private:
+
+      uint32_t
+      get_string(const std::string& s);
+
+      void
+      check() noexcept;
+
+      std::mutex m_mutex;
+      std::string m_file_name;
+      std::ofstream m_file;
+      bool m_failed;
+      std::chrono::steady_clock::time_point m_origin;
+      std::unordered_map<std::string, uint32_t> m_strings;
+      std::map<std::thread::id, uint16_t> m_threads;
+      uint64_t m_number_of_calls;
+
+    };
+
+
+      /// The call read from trace file
+
+    struct Record
+    {
+      config::proxy::CallType m_type;
+      bool m_failed;
+      uint16_t m_thread;
+      const std::string * m_class_name;
+      const std::string * m_id;
+      const std::string * m_name;
+      uint64_t m_result_size;
+      uint64_t m_start;
+      uint64_t m_duration;
+    };
+
+
+      /**
+       *  \brief Reads trace file.
+       *
+       *  \throw daq::config::Generic if the file cannot be read or it is corrupted
+       */
+
+    class Reader
+    {
+
+    public:
+
+      Reader(const std::string& file_name);
+
+        /// Return specification of traced database
+
+      const std::string&
+      get_spec() const noexcept
+      {
+        return m_spec;
+      }
+
+        /// Return creation time of the trace (seconds since Epoch)
+
+      int64_t
+      get_created() const noexcept
+      {
+        return m_created;
+      }
+
+        /// Read next call; return false at the end of file
+
+      bool
+      next(Record& record);
+
+
+    private:
+
+      [[noreturn]] void
+      throw_corrupted(const char * reason) const;
+
+      std::string m_file_name;
+      std::ifstream m_file;
+      std::string m_spec;
+      int64_t m_created;
+      std::deque<std::string> m_strings;
+
+    };
+
+  }
+}
+
+#endif // CONFIG_TRACE_H_
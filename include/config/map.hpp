@@ -2,6 +2,7 @@
 #define CONFIG_MAP_H_
 
 #include "config/string_ptr.hpp"
+#include <map>
 #include <unordered_map>
 
 
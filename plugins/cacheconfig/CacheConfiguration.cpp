@@ -0,0 +1,294 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+#include "config/PluginRegistry.hpp"
+#include "config/Snapshot.hpp"
+#include "config/SubscriptionCriteria.hpp"
+
+#include "CacheConfiguration.hpp"
+
+
+  // to be used as plug-in
+
+extern "C" ConfigurationImpl * _cacheconfig_creator_ (const std::string& spec) {
+  try {
+    std::unique_ptr<CacheConfiguration> impl(new CacheConfiguration());
+    if(!spec.empty()) { impl->open_db(spec); }
+    return impl.release();
+  }
+  catch(daq::config::Exception& ex) {
+    throw daq::config::Generic(ERS_HERE, "cacheconfig initialization error", ex);
+  }
+  catch(...) {
+    throw daq::config::Generic(ERS_HERE, "cacheconfig initialization error:\n***** caught unknown exception *****");
+  }
+}
+
+CONFIG_REGISTER_PLUGIN(cacheconfig, _cacheconfig_creator_)
+
+
+CacheConfiguration::CacheConfiguration() noexcept :
+  m_inner_cb(nullptr),
+  p_cache_hit(false),
+  p_fill_time(0),
+  p_number_of_invalidations(0)
+{
+}
+
+CacheConfiguration::~CacheConfiguration()
+{
+  close_db();
+}
+
+
+static std::string
+hash_str(const std::string& s)
+{
+  std::ostringstream text;
+  text << std::hex << std::setw(16) << std::setfill('0') << config::snapshot::checksum(s.data(), s.size());
+  return text.str();
+}
+
+std::string
+CacheConfiguration::make_key(Configuration& db, const std::string& spec)
+{
+  std::ostringstream version;
+
+  // use the latest version of the repository, if any
+
+  try
+    {
+      std::vector<daq::config::Version> versions = db.get_versions("", "", daq::config::Version::query_by_date, false);
+
+      const daq::config::Version * latest = nullptr;
+
+      for (const auto& x : versions)
+        if (latest == nullptr || x.get_timestamp() >= latest->get_timestamp())
+          latest = &x;
+
+      if (latest)
+        version << "id:" << latest->get_id();
+    }
+  catch (daq::config::Exception& ex)
+    {
+      TLOG_DEBUG(1) << "cannot get versions of database \"" << spec << "\": " << ex;
+    }
+
+  // otherwise use the modification times of all database files
+
+  if (version.tellp() == 0)
+    {
+      std::list<std::string> files;
+      db.get_includes("", files);
+
+      for (auto i = files.begin(); i != files.end(); ++i)
+        {
+          struct stat st;
+
+          if (stat(i->c_str(), &st) != 0)
+            {
+              std::ostringstream text;
+              text << "cannot determine version of database \"" << spec << "\": cannot stat file \"" << *i << "\": " << strerror(errno);
+              throw daq::config::Generic(ERS_HERE, text.str().c_str());
+            }
+
+          version << *i << ':' << st.st_mtime << '.' << st.st_mtim.tv_nsec << ':' << st.st_size << ';';
+
+          std::list<std::string> includes;
+          db.get_includes(*i, includes);
+
+          for (const auto& x : includes)
+            if (std::find(files.begin(), files.end(), x) == files.end())
+              files.push_back(x);
+        }
+
+      if (files.empty())
+        {
+          std::ostringstream text;
+          text << "cannot determine version of database \"" << spec << "\": there are neither versions nor files";
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+    }
+
+  return hash_str(spec) + '.' + hash_str(version.str()) + ".v" + std::to_string(config::snapshot::format_version);
+}
+
+void
+CacheConfiguration::fill(Configuration& db, const std::string& file_name)
+{
+  auto start = std::chrono::steady_clock::now();
+
+  config::snapshot::Writer writer(db);
+
+  for (const auto& c : db.superclasses())
+    {
+      std::vector<ConfigObject> objs;
+      db.get(*c.first, objs);
+
+      for (const auto& x : objs)
+        if (x.class_name() == *c.first)
+          writer.add(x);
+    }
+
+  writer.write(file_name);
+
+  p_fill_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000000.;
+
+  TLOG_DEBUG(1) << "wrote " << writer.get_number_of_objects() << " objects to cache file \"" << file_name << "\" in " << p_fill_time << " s";
+}
+
+void
+CacheConfiguration::open_db(const std::string& spec)
+{
+  close_db();
+
+  std::unique_ptr<Configuration> inner(new Configuration(spec));
+
+  std::string dir;
+
+  if (const char * s = getenv("TDAQ_DB_CACHE_DIR"))
+    dir = s;
+  else
+    dir = "/tmp/config-cache-" + std::to_string(getuid());
+
+  if (mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST)
+    {
+      std::ostringstream text;
+      text << "cannot create cache directory \"" << dir << "\": " << strerror(errno);
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  const std::string file_name(dir + '/' + make_key(*inner, spec) + ".snapshot");
+
+  // only one process fills the cache entry, others wait and read it
+
+  const std::string lock_name(file_name + ".lock");
+
+  int fd = ::open(lock_name.c_str(), O_RDWR | O_CREAT, 0600);
+
+  if (fd < 0 || flock(fd, LOCK_EX) != 0)
+    {
+      std::ostringstream text;
+      text << "cannot lock cache file \"" << lock_name << "\": " << strerror(errno);
+      if (fd >= 0)
+        ::close(fd);
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  try
+    {
+      p_cache_hit = (access(file_name.c_str(), R_OK) == 0);
+
+      if (p_cache_hit)
+        {
+          try
+            {
+              SnapConfiguration::open_db(file_name);
+            }
+          catch (daq::config::Exception& ex)
+            {
+              std::ostringstream text;
+              text << "cannot read cache file \"" << file_name << "\" of database \"" << spec << "\", it will be refilled";
+              ers::warning(daq::config::Generic(ERS_HERE, text.str().c_str(), ex));
+              p_cache_hit = false;
+            }
+        }
+
+      if (!p_cache_hit)
+        {
+          fill(*inner, file_name);
+          SnapConfiguration::open_db(file_name);
+        }
+    }
+  catch (...)
+    {
+      ::close(fd);
+      throw;
+    }
+
+  ::close(fd);
+
+  m_inner = std::move(inner);
+  m_cache_file = file_name;
+
+  TLOG_DEBUG(1) << "use cache file \"" << file_name << "\" of database \"" << spec << "\" (" << (p_cache_hit ? "hit" : "miss") << ')';
+
+  // the changes of proxied database make the cache entry stale
+
+  m_inner_cb = m_inner->subscribe(ConfigurationSubscriptionCriteria(), invalidate, this);
+}
+
+void
+CacheConfiguration::close_db()
+{
+  if (m_inner)
+    {
+      if (m_inner_cb)
+        {
+          m_inner->unsubscribe(m_inner_cb);
+          m_inner_cb = nullptr;
+        }
+
+      m_inner.reset();
+    }
+
+  m_cache_file.clear();
+
+  SnapConfiguration::close_db();
+}
+
+void
+CacheConfiguration::invalidate(const std::vector<ConfigurationChange *>& /*changes*/, void * parameter)
+{
+  CacheConfiguration * impl = static_cast<CacheConfiguration *>(parameter);
+
+  if (unlink(impl->m_cache_file.c_str()) == 0)
+    TLOG_DEBUG(1) << "remove stale cache file \"" << impl->m_cache_file << '\"';
+
+  impl->p_number_of_invalidations++;
+}
+
+
+std::vector<daq::config::Version>
+CacheConfiguration::get_changes()
+{
+  return m_inner->get_changes();
+}
+
+std::vector<daq::config::Version>
+CacheConfiguration::get_versions(const std::string& since, const std::string& until, daq::config::Version::QueryType type, bool skip_irrelevant)
+{
+  return m_inner->get_versions(since, until, type, skip_irrelevant);
+}
+
+void
+CacheConfiguration::print_profiling_info() noexcept
+{
+  std::cout <<
+    "CacheConfiguration profiler report:\n"
+    "  cache file: \"" << m_cache_file << "\"\n"
+    "  cache hit: " << std::boolalpha << p_cache_hit << std::noboolalpha << "\n";
+
+  if (!p_cache_hit)
+    std::cout << "  time to fill cache: " << p_fill_time << " s\n";
+
+  std::cout << "  number of invalidations: " << p_number_of_invalidations << std::endl;
+
+  SnapConfiguration::print_profiling_info();
+}
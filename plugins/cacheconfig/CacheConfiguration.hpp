@@ -0,0 +1,84 @@
+  /**
+   *  \file CacheConfiguration.hpp This file contains CacheConfiguration class,
+   *  that is the read-only caching proxy for any other config implementation.
+   *  \brief cache config plug-in
+   */
+
+#ifndef CACHECONFIG_CACHECONFIGURATION_H_
+#define CACHECONFIG_CACHECONFIGURATION_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "config/Configuration.hpp"
+
+#include "SnapConfiguration.hpp"
+
+
+  /**
+   *  \brief Implements read-only caching proxy of configuration database.
+   *
+   *  The plug-in parameter is the specification of the proxied database, e.g. "cacheconfig:rdbconfig:RDB".
+   *  The database is opened to read its version; when the local cache already contains a snapshot of
+   *  this version, the objects are read from the memory-mapped snapshot file only.
+   *  Otherwise all objects are read from the proxied database and stored in the cache, so that other
+   *  processes on the same host read them from the local disk. The concurrent processes wait while
+   *  one of them is filling the cache.
+   *
+   *  The cache entry is identified by the database specification and by its version, that is the
+   *  latest version reported by get_versions() or, if there is none, the modification times of
+   *  database files. The cache directory is defined by the TDAQ_DB_CACHE_DIR environment variable
+   *  (by default /tmp/config-cache-<uid>).
+   *
+   *  The process reads the version of the database, that was current when it was opened.
+   *  When the proxied database notifies about changes, the stale cache entry is removed,
+   *  so that the processes started later read the new version.
+   */
+
+class CacheConfiguration : public SnapConfiguration {
+
+  public:
+
+    CacheConfiguration() noexcept;
+
+    virtual ~CacheConfiguration();
+
+
+  public:
+
+    virtual void open_db(const std::string& db_name);
+    virtual void close_db();
+    virtual std::vector<daq::config::Version> get_changes();
+    virtual std::vector<daq::config::Version> get_versions(const std::string& since, const std::string& until, daq::config::Version::QueryType type, bool skip_irrelevant);
+    virtual void print_profiling_info() noexcept;
+
+
+  protected:
+
+      /// Return cache key made of the database specification and version
+
+    static std::string make_key(Configuration& db, const std::string& spec);
+
+      /// Write snapshot of proxied database into cache file
+
+    void fill(Configuration& db, const std::string& file_name);
+
+      /// Remove stale cache entry on changes of proxied database
+
+    static void invalidate(const std::vector<ConfigurationChange *>& changes, void * parameter);
+
+
+  protected:
+
+    std::unique_ptr<Configuration> m_inner;
+    Configuration::CallbackId m_inner_cb;
+    std::string m_cache_file;
+
+    bool p_cache_hit;
+    double p_fill_time;
+    unsigned long p_number_of_invalidations;
+
+};
+
+#endif // CACHECONFIG_CACHECONFIGURATION_H_
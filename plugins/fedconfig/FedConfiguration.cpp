@@ -0,0 +1,751 @@
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <utility>
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+#include "config/DalFactory.hpp"
+#include "config/PluginRegistry.hpp"
+
+#include "FedConfiguration.hpp"
+
+
+  // to be used as plug-in
+
+extern "C" ConfigurationImpl * _fedconfig_creator_ (const std::string& spec) {
+  try {
+    std::unique_ptr<FedConfiguration> impl(new FedConfiguration());
+    if(!spec.empty()) { impl->open_db(spec); }
+    return impl.release();
+  }
+  catch(daq::config::Exception& ex) {
+    throw daq::config::Generic(ERS_HERE, "fedconfig initialization error", ex);
+  }
+  catch(...) {
+    throw daq::config::Generic(ERS_HERE, "fedconfig initialization error:\n***** caught unknown exception *****");
+  }
+}
+
+CONFIG_REGISTER_PLUGIN(fedconfig, _fedconfig_creator_)
+
+
+FedConfiguration::FedConfiguration() noexcept :
+  m_file_shards_read(false),
+  p_number_of_routed_calls(0),
+  p_number_of_index_hits(0),
+  p_number_of_fan_outs(0)
+{
+}
+
+FedConfiguration::~FedConfiguration()
+{
+  close_db();
+}
+
+
+void
+FedConfiguration::open_db(const std::string& spec)
+{
+  close_db();
+
+  std::string::size_type start = 0;
+
+  while (true)
+    {
+      std::string::size_type idx = spec.find('|', start);
+      m_shard_specs.push_back(spec.substr(start, idx == std::string::npos ? std::string::npos : idx - start));
+
+      if (m_shard_specs.back().empty())
+        {
+          std::ostringstream text;
+          text << "bad specification of federated database \"" << spec << "\": empty specification of shard #" << m_shard_specs.size() - 1;
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      if (idx == std::string::npos)
+        break;
+
+      start = idx + 1;
+    }
+
+  m_shards.resize(m_shard_specs.size());
+
+  // the shards are independent, so open them in parallel
+
+  std::vector<unsigned int> shards;
+  for (unsigned int i = 0; i < m_shards.size(); ++i)
+    shards.push_back(i);
+
+  auto open = [&](unsigned int i) {
+    m_shards[i].reset(PluginRegistry::instance().create(m_shard_specs[i]));
+
+    if (!m_shards[i])
+      {
+        std::ostringstream text;
+        text << "cannot create implementation of shard \"" << m_shard_specs[i] << '\"';
+        throw daq::config::Generic(ERS_HERE, text.str().c_str());
+      }
+  };
+
+  if (shards.size() == 1)
+    open(0);
+  else
+    fan_out(shards, open);
+
+  for (auto& x : m_shards)
+    {
+      if (m_conf)
+        x->set(m_conf);
+
+      x->set_resolver(this);
+    }
+
+  read_schema();
+
+  m_spec = spec;
+
+  TLOG_DEBUG(1) << "open federated database \"" << spec << "\" with " << m_shards.size() << " shards";
+}
+
+void
+FedConfiguration::close_db()
+{
+  // federation objects refer objects of shards
+  clean();
+
+  while (!m_shards.empty())
+    m_shards.pop_back();
+
+  m_shard_specs.clear();
+  m_superclasses.clear();
+  m_class_shards.clear();
+  m_file_shards.clear();
+  m_file_shards_read = false;
+  clear_index();
+  m_spec.clear();
+}
+
+bool
+FedConfiguration::loaded() const noexcept
+{
+  if (m_shards.empty())
+    return false;
+
+  for (const auto& x : m_shards)
+    if (!x->loaded())
+      return false;
+
+  return true;
+}
+
+void
+FedConfiguration::set(Configuration * db) noexcept
+{
+  ConfigurationImpl::set(db);
+
+  for (auto& x : m_shards)
+    x->set(db);
+}
+
+  // the shards always use the federation to resolve references; the resolver of federation is used for objects not found by any shard
+
+void
+FedConfiguration::set_resolver(ConfigurationImpl * impl) noexcept
+{
+  ConfigurationImpl::set_resolver(impl);
+}
+
+bool
+FedConfiguration::is_inner(const ConfigurationImpl * impl) const noexcept
+{
+  for (const auto& x : m_shards)
+    if (x.get() == impl)
+      return true;
+
+  return false;
+}
+
+
+void
+FedConfiguration::read_schema()
+{
+  m_superclasses.clear();
+  m_class_shards.clear();
+
+  for (unsigned int i = 0; i < m_shards.size(); ++i)
+    {
+      config::fmap<config::fset> schema;
+      m_shards[i]->get_superclasses(schema);
+
+      for (const auto& x : schema)
+        {
+          m_class_shards[x.first].push_back(i);
+          m_superclasses[x.first].insert(x.second.begin(), x.second.end());
+        }
+    }
+}
+
+const std::vector<unsigned int>&
+FedConfiguration::get_class_shards(const std::string& class_name) const
+{
+  auto it = m_class_shards.find(&DalFactory::instance().get_known_class_name_ref(class_name));
+
+  if (it == m_class_shards.end())
+    throw daq::config::NotFound(ERS_HERE, "class", class_name.c_str());
+
+  return it->second;
+}
+
+unsigned int
+FedConfiguration::get_shard(const ConfigObjectImpl * obj) const
+{
+  const ConfigurationImpl * impl = get_impl(obj);
+
+  for (unsigned int i = 0; i < m_shards.size(); ++i)
+    if (m_shards[i].get() == impl)
+      return i;
+
+  std::ostringstream text;
+  text << "object " << obj->UID() << '@' << obj->class_name() << " does not belong to any shard of federated database \"" << m_spec << '\"';
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+  // the files of shards are read on first use and after changes of includes
+
+unsigned int
+FedConfiguration::get_file_shard(const std::string& db_name) const
+{
+  auto it = m_file_shards.find(db_name);
+
+  if (it != m_file_shards.end())
+    return it->second;
+
+  if (!m_file_shards_read)
+    {
+      for (unsigned int i = 0; i < m_shards.size(); ++i)
+        {
+          std::list<std::string> files;
+          m_shards[i]->get_includes("", files);
+
+          config::set known;
+
+          while (!files.empty())
+            {
+              const std::string file(files.front());
+              files.pop_front();
+
+              if (known.insert(file).second)
+                {
+                  m_file_shards.emplace(file, i);
+
+                  std::list<std::string> includes;
+                  m_shards[i]->get_includes(file, includes);
+                  files.splice(files.end(), includes);
+                }
+            }
+        }
+
+      m_file_shards_read = true;
+    }
+
+  it = m_file_shards.find(db_name);
+
+  return (it != m_file_shards.end() ? it->second : m_shards.size());
+}
+
+unsigned int
+FedConfiguration::get_loaded_file_shard(const std::string& db_name) const
+{
+  const unsigned int shard = get_file_shard(db_name);
+
+  if (shard == m_shards.size())
+    {
+      std::ostringstream text;
+      text << "file \"" << db_name << "\" is not loaded by any shard of federated database \"" << m_spec << '\"';
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  return shard;
+}
+
+
+unsigned int
+FedConfiguration::find_in_index(const std::string * class_name, const std::string& id) const noexcept
+{
+  unsigned int shard = m_shards.size();
+
+  auto it = m_index.find(id);
+
+  if (it != m_index.end())
+    for (const auto& x : it->second)
+      if (x.m_shard < shard)
+        {
+          if (x.m_class_name != class_name)
+            {
+              auto sc = m_superclasses.find(x.m_class_name);
+
+              if (sc == m_superclasses.end() || sc->second.find(class_name) == sc->second.end())
+                continue;
+            }
+
+          shard = x.m_shard;
+        }
+
+  return shard;
+}
+
+void
+FedConfiguration::add_to_index(const ConfigObject& obj, unsigned int shard)
+{
+  const std::string * class_name = &obj.class_name();
+  std::vector<Location>& locations(m_index[obj.UID()]);
+
+  for (const auto& x : locations)
+    if (x.m_class_name == class_name && x.m_shard == shard)
+      return;
+
+  locations.push_back(Location { class_name, shard });
+}
+
+void
+FedConfiguration::remove_from_index(const std::string& class_name, const std::string& id) noexcept
+{
+  auto it = m_index.find(id);
+
+  if (it == m_index.end())
+    return;
+
+  const std::string * c = &DalFactory::instance().get_known_class_name_ref(class_name);
+
+  std::vector<Location>& locations(it->second);
+
+  for (auto x = locations.begin(); x != locations.end();)
+    {
+      auto sc = m_superclasses.find(x->m_class_name);
+
+      if (x->m_class_name == c || (sc != m_superclasses.end() && sc->second.find(c) != sc->second.end()))
+        x = locations.erase(x);
+      else
+        ++x;
+    }
+
+  if (locations.empty())
+    m_index.erase(it);
+}
+
+void
+FedConfiguration::clear_index() noexcept
+{
+  m_index.clear();
+  m_indexed_classes.clear();
+}
+
+  // ask the shard known by the index; otherwise, if the class is defined by several shards, read all objects of the class
+  // from them in parallel once, so the next searches (e.g. resolving of references) use the index and do not start threads
+
+ConfigObject
+FedConfiguration::find(const std::string& class_name, const std::string& id, unsigned long rlevel, const std::vector<std::string> * rclasses)
+{
+  p_number_of_routed_calls++;
+
+  const std::vector<unsigned int>& shards(get_class_shards(class_name));
+  const std::string * c = &DalFactory::instance().get_known_class_name_ref(class_name);
+
+  const unsigned int shard = find_in_index(c, id);
+
+  if (shard < m_shards.size())
+    {
+      p_number_of_index_hits++;
+
+      try
+        {
+          ConfigObject obj;
+          m_shards[shard]->get(class_name, id, obj, rlevel, rclasses);
+          return obj;
+        }
+      catch (daq::config::NotFound&)
+        {
+          TLOG_DEBUG(2) << "object " << id << '@' << class_name << " was removed from shard \"" << m_shard_specs[shard] << '\"';
+          remove_from_index(class_name, id);
+        }
+    }
+
+  if (m_indexed_classes.find(c) != m_indexed_classes.end())
+    return ConfigObject();
+
+  unsigned int from = shards.front();
+
+  if (shards.size() > 1)
+    {
+      std::vector<ConfigObject> objects;
+      read_objects(class_name, shards, objects, "", 0, nullptr);
+
+      from = find_in_index(c, id);
+
+      if (from == m_shards.size())
+        return ConfigObject();
+    }
+
+  try
+    {
+      ConfigObject obj;
+      m_shards[from]->get(class_name, id, obj, rlevel, rclasses);
+      add_to_index(obj, from);
+      return obj;
+    }
+  catch (daq::config::NotFound&)
+    {
+      return ConfigObject();
+    }
+}
+
+void
+FedConfiguration::read_objects(const std::string& class_name, const std::vector<unsigned int>& shards, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses)
+{
+  std::vector<std::vector<ConfigObject>> found(m_shards.size());
+
+  fan_out(shards, [&](unsigned int i) { m_shards[i]->get(class_name, found[i], query, rlevel, rclasses); });
+
+  std::set<std::pair<const std::string *, std::string>> known;
+
+  for (const auto& i : shards)
+    for (const auto& x : found[i])
+      if (known.emplace(&x.class_name(), x.UID()).second)
+        {
+          add_to_index(x, i);
+          objects.push_back(x);
+        }
+
+  if (query.empty())
+    m_indexed_classes.insert(&DalFactory::instance().get_known_class_name_ref(class_name));
+}
+
+
+void
+FedConfiguration::create(const std::string& db_name, const std::list<std::string>& includes)
+{
+  unsigned int shard = (includes.empty() ? 0 : get_file_shard(includes.front()));
+
+  if (shard == m_shards.size())
+    shard = 0;
+
+  m_shards[shard]->create(db_name, includes);
+  m_file_shards.clear();
+  m_file_shards_read = false;
+  read_schema();
+}
+
+bool
+FedConfiguration::is_writable(const std::string& db_name)
+{
+  const unsigned int shard = get_file_shard(db_name);
+  return (shard < m_shards.size() && m_shards[shard]->is_writable(db_name));
+}
+
+void
+FedConfiguration::add_include(const std::string& db_name, const std::string& include)
+{
+  m_shards[get_loaded_file_shard(db_name)]->add_include(db_name, include);
+  m_file_shards.clear();
+  m_file_shards_read = false;
+  read_schema();
+}
+
+void
+FedConfiguration::remove_include(const std::string& db_name, const std::string& include)
+{
+  m_shards[get_loaded_file_shard(db_name)]->remove_include(db_name, include);
+  m_file_shards.clear();
+  m_file_shards_read = false;
+}
+
+void
+FedConfiguration::get_includes(const std::string& db_name, std::list<std::string>& includes) const
+{
+  includes.clear();
+
+  if (db_name.empty())
+    {
+      for (const auto& x : m_shards)
+        {
+          std::list<std::string> files;
+          x->get_includes(db_name, files);
+          includes.splice(includes.end(), files);
+        }
+    }
+  else
+    {
+      const unsigned int shard = get_file_shard(db_name);
+
+      if (shard < m_shards.size())
+        m_shards[shard]->get_includes(db_name, includes);
+    }
+}
+
+void
+FedConfiguration::get_updated_dbs(std::list<std::string>& dbs) const
+{
+  dbs.clear();
+
+  for (const auto& x : m_shards)
+    {
+      std::list<std::string> files;
+      x->get_updated_dbs(files);
+      dbs.splice(dbs.end(), files);
+    }
+}
+
+void
+FedConfiguration::set_commit_credentials(const std::string& user, const std::string& password)
+{
+  for (auto& x : m_shards)
+    x->set_commit_credentials(user, password);
+}
+
+void
+FedConfiguration::commit(const std::string& log_message)
+{
+  for (auto& x : m_shards)
+    {
+      std::list<std::string> dbs;
+      x->get_updated_dbs(dbs);
+
+      if (!dbs.empty())
+        x->commit(log_message);
+    }
+}
+
+  // the caller (Configuration::abort) unreads federation objects; unread objects of shards as well
+
+void
+FedConfiguration::abort()
+{
+  for (auto& x : m_shards)
+    {
+      x->abort();
+      x->unread_impl_objects();
+    }
+
+  m_file_shards.clear();
+  m_file_shards_read = false;
+  clear_index();
+}
+
+void
+FedConfiguration::prefetch_all_data()
+{
+  std::vector<unsigned int> shards;
+  for (unsigned int i = 0; i < m_shards.size(); ++i)
+    shards.push_back(i);
+
+  fan_out(shards, [this](unsigned int i) { m_shards[i]->prefetch_all_data(); });
+}
+
+std::vector<daq::config::Version>
+FedConfiguration::get_changes()
+{
+  std::vector<daq::config::Version> result;
+
+  for (auto& x : m_shards)
+    {
+      std::vector<daq::config::Version> versions(x->get_changes());
+      result.insert(result.end(), versions.begin(), versions.end());
+    }
+
+  return result;
+}
+
+std::vector<daq::config::Version>
+FedConfiguration::get_versions(const std::string& since, const std::string& until, daq::config::Version::QueryType type, bool skip_irrelevant)
+{
+  std::vector<daq::config::Version> result;
+
+  for (auto& x : m_shards)
+    {
+      std::vector<daq::config::Version> versions(x->get_versions(since, until, type, skip_irrelevant));
+      result.insert(result.end(), versions.begin(), versions.end());
+    }
+
+  return result;
+}
+
+
+  // the caller (Configuration) locks configuration implementation mutex
+
+void
+FedConfiguration::get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long rlevel, const std::vector<std::string> * rclasses)
+{
+  object = find(class_name, id, rlevel, rclasses);
+
+  if (object.is_null())
+    throw daq::config::NotFound(ERS_HERE, "object", std::string(id + '@' + class_name).c_str());
+
+  wrap(object);
+}
+
+void
+FedConfiguration::get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses)
+{
+  p_number_of_routed_calls++;
+
+  const std::vector<unsigned int>& shards(get_class_shards(class_name));
+
+  objects.clear();
+
+  if (shards.size() == 1)
+    {
+      m_shards[shards.front()]->get(class_name, objects, query, rlevel, rclasses);
+    }
+  else
+    {
+      read_objects(class_name, shards, objects, query, rlevel, rclasses);
+    }
+
+  wrap(objects);
+}
+
+void
+FedConfiguration::get(const ConfigObject& obj_from, const std::string& query, std::vector<ConfigObject>& objects, unsigned long rlevel, const std::vector<std::string> * rclasses)
+{
+  const ConfigObject obj(unwrap(obj_from));
+  m_shards[get_shard(obj.implementation())]->get(obj, query, objects, rlevel, rclasses);
+  wrap(objects);
+}
+
+bool
+FedConfiguration::test_object(const std::string& class_name, const std::string& id, unsigned long rlevel, const std::vector<std::string> * rclasses)
+{
+  return !find(class_name, id, rlevel, rclasses).is_null();
+}
+
+void
+FedConfiguration::create(const std::string& at, const std::string& class_name, const std::string& id, ConfigObject& object)
+{
+  const unsigned int shard = get_loaded_file_shard(at);
+  m_shards[shard]->create(at, class_name, id, object);
+  add_to_index(object, shard);
+  wrap(object);
+}
+
+void
+FedConfiguration::create(const ConfigObject& at, const std::string& class_name, const std::string& id, ConfigObject& object)
+{
+  const ConfigObject obj(unwrap(at));
+  const unsigned int shard = get_shard(obj.implementation());
+  m_shards[shard]->create(obj, class_name, id, object);
+  add_to_index(object, shard);
+  wrap(object);
+}
+
+void
+FedConfiguration::destroy(ConfigObject& object)
+{
+  ConfigObject obj(unwrap(object));
+  m_shards[get_shard(obj.implementation())]->destroy(obj);
+  remove_from_index(object.class_name(), object.UID());
+
+  // the shard may also destroy composite children; federation objects check the state of shard ones on next access
+  unread_impl_objects();
+}
+
+void
+FedConfiguration::rename_inner(ConfigObjectImpl * obj, const std::string& new_id)
+{
+  const unsigned int shard = get_shard(obj);
+  const std::string old_id(obj->UID());
+
+  ProxyConfiguration::rename_inner(obj, new_id);
+
+  remove_from_index(obj->class_name(), old_id);
+  add_to_index(ConfigObject(obj), shard);
+}
+
+daq::config::class_t *
+FedConfiguration::get(const std::string& class_name, bool direct_only)
+{
+  return m_shards[get_class_shards(class_name).front()]->get(class_name, direct_only);
+}
+
+void
+FedConfiguration::get_superclasses(config::fmap<config::fset>& schema)
+{
+  read_schema();
+  schema = m_superclasses;
+}
+
+  // the caller (e.g. the jsonconfig shard reading a relationship) locks configuration implementation mutex
+
+ConfigObjectImpl *
+FedConfiguration::resolve(const std::string& class_name, const std::string& id) noexcept
+{
+  try
+    {
+      ConfigObject obj(find(class_name, id, 0, nullptr));
+
+      if (!obj.is_null())
+        return const_cast<ConfigObjectImpl *>(obj.implementation());
+    }
+  catch (daq::config::Exception& ex)
+    {
+      TLOG_DEBUG(1) << "cannot resolve object " << id << '@' << class_name << ":\n" << ex;
+    }
+
+  return resolve_external(class_name, id);
+}
+
+
+  // any shard notifies the federation, that updates cache of all shards and calls the Configuration
+
+void
+FedConfiguration::subscribe(const std::set<std::string>& class_names, const std::map< std::string, std::set<std::string> >& objs, ConfigurationImpl::notify cb, ConfigurationImpl::pre_notify pre_cb)
+{
+  m_cb = cb;
+
+  for (auto& x : m_shards)
+    x->subscribe(class_names, objs, notify_cb, pre_cb);
+}
+
+void
+FedConfiguration::unsubscribe()
+{
+  for (auto& x : m_shards)
+    x->unsubscribe();
+
+  m_cb = nullptr;
+}
+
+  // the objects might be created, removed or renamed by the shards
+
+void
+FedConfiguration::update_inner_objects(std::vector<ConfigurationChange *>& changes) noexcept
+{
+  for (auto& x : m_shards)
+    update_objects(x.get(), changes);
+
+  clear_index();
+}
+
+
+void
+FedConfiguration::print_profiling_info() noexcept
+{
+  std::cout <<
+    "FedConfiguration profiler report:\n"
+    "  number of shards: " << m_shards.size() << "\n"
+    "  number of routed calls: " << p_number_of_routed_calls << "\n"
+    "  number of index hits: " << p_number_of_index_hits << "\n"
+    "  number of parallel fan-outs: " << p_number_of_fan_outs << "\n"
+    "  number of indexed objects: " << m_index.size() << "\n"
+    "  number of indexed classes: " << m_indexed_classes.size() << std::endl;
+
+  for (unsigned int i = 0; i < m_shards.size(); ++i)
+    {
+      std::cout << "Shard #" << i << " \"" << m_shard_specs[i] << "\":\n";
+      m_shards[i]->print_cache_info();
+      m_shards[i]->print_profiling_info();
+    }
+}
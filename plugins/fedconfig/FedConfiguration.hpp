@@ -0,0 +1,204 @@
+  /**
+   *  \file FedConfiguration.hpp This file contains FedConfiguration class,
+   *  that merges several config implementations into single database.
+   *  \brief federation config plug-in
+   */
+
+#ifndef FEDCONFIG_FEDCONFIGURATION_H_
+#define FEDCONFIG_FEDCONFIGURATION_H_
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "config/map.hpp"
+#include "config/set.hpp"
+#include "config/ProxyConfiguration.hpp"
+
+
+  /**
+   *  \brief Federation of several configuration databases sharing one schema.
+   *
+   *  The plug-in parameter is the list of specifications of federated databases (shards) separated by '|', e.g.
+   *  "fedconfig:oksconfig:daq/segments/detector.data.xml|rdbconfig:infrastructure". The shards are expected to
+   *  use the same schema or to define disjoint sets of classes; the schema of the federation is the union of them.
+   *
+   *  The objects are searched without fan-out to every shard:
+   *  - a class is searched in the shards defining it;
+   *  - the shard of an object is remembered by the class/UID index filled from results of previous calls,
+   *    so get(class, id) is forwarded to a single shard once the object is known;
+   *  - on index miss of a class defined by several shards, all objects of the class are read from these shards
+   *    in parallel once and are added to the index; a missing object of such class is reported without asking the shards.
+   *  If the same object is stored by several shards, the one from the first shard in order of specification is used.
+   *
+   *  The federation resolves objects referenced by a shard and stored by another one, if the shard implementation
+   *  searches references on read (e.g. jsonconfig), so the relationships can be followed across the shards.
+   *
+   *  The files are modified by the shard that has loaded them and the commit is forwarded to the shards having
+   *  updated files; the commit is not atomic across the shards.
+   */
+
+class FedConfiguration : public ProxyConfiguration {
+
+  public:
+
+    FedConfiguration() noexcept;
+
+    virtual ~FedConfiguration();
+
+
+  public:
+
+    virtual void open_db(const std::string& spec);
+    virtual void close_db();
+    virtual bool loaded() const noexcept;
+    virtual void create(const std::string& db_name, const std::list<std::string>& includes);
+    virtual bool is_writable(const std::string& db_name);
+    virtual void add_include(const std::string& db_name, const std::string& include);
+    virtual void remove_include(const std::string& db_name, const std::string& include);
+    virtual void get_includes(const std::string& db_name, std::list<std::string>& includes) const;
+    virtual void get_updated_dbs(std::list<std::string>& dbs) const;
+    virtual void set_commit_credentials(const std::string& user, const std::string& password);
+    virtual void commit(const std::string& log_message);
+    virtual void abort();
+    virtual void prefetch_all_data();
+    virtual std::vector<daq::config::Version> get_changes();
+    virtual std::vector<daq::config::Version> get_versions(const std::string& since, const std::string& until, daq::config::Version::QueryType type, bool skip_irrelevant);
+
+    virtual void get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual void get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual void get(const ConfigObject& obj_from, const std::string& query, std::vector<ConfigObject>& objects, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual bool test_object(const std::string& class_name, const std::string& id, unsigned long rlevel, const std::vector<std::string> * rclasses);
+
+    virtual void create(const std::string& at, const std::string& class_name, const std::string& id, ConfigObject& object);
+    virtual void create(const ConfigObject& at, const std::string& class_name, const std::string& id, ConfigObject& object);
+    virtual void destroy(ConfigObject& object);
+
+    virtual daq::config::class_t * get(const std::string& class_name, bool direct_only);
+    virtual void get_superclasses(config::fmap<config::fset>& schema);
+
+    virtual void subscribe(const std::set<std::string>& class_names, const std::map< std::string, std::set<std::string> >& objs, ConfigurationImpl::notify cb, ConfigurationImpl::pre_notify pre_cb);
+    virtual void unsubscribe();
+
+    virtual void print_profiling_info() noexcept;
+
+    virtual void set(Configuration * db) noexcept;
+    virtual void set_resolver(ConfigurationImpl * impl) noexcept;
+
+    virtual ConfigObjectImpl * resolve(const std::string& class_name, const std::string& id) noexcept;
+
+
+  protected:
+
+    virtual bool is_inner(const ConfigurationImpl * impl) const noexcept;
+    virtual void rename_inner(ConfigObjectImpl * obj, const std::string& new_id);
+    virtual void update_inner_objects(std::vector<ConfigurationChange *>& changes) noexcept;
+
+
+  private:
+
+      /// The shard storing object of class (the class may be a superclass of the object's class)
+
+    struct Location
+    {
+      const std::string * m_class_name;
+      unsigned int m_shard;
+    };
+
+    std::vector<std::string> m_shard_specs;
+    std::vector<std::unique_ptr<ConfigurationImpl>> m_shards;
+
+    config::fmap<config::fset> m_superclasses;                   // merged schema
+    config::fmap<std::vector<unsigned int>> m_class_shards;      // shards defining class
+    config::map<std::vector<Location>> m_index;                  // object ID => locations
+    config::fset m_indexed_classes;                              // classes, which all objects are in the index
+    mutable config::map<unsigned int> m_file_shards;             // file => shard loaded it
+    mutable bool m_file_shards_read;
+
+    unsigned long p_number_of_routed_calls;
+    unsigned long p_number_of_index_hits;
+    unsigned long p_number_of_fan_outs;
+
+
+      /// Read schemas of shards and build class index
+
+    void read_schema();
+
+      /// Return shards defining the class; throw NotFound, if there are no such shards
+
+    const std::vector<unsigned int>& get_class_shards(const std::string& class_name) const;
+
+      /// Return shard of object of the implementation
+
+    unsigned int get_shard(const ConfigObjectImpl * obj) const;
+
+      /// Return shard loaded the file or the number of shards, if the file is not loaded
+
+    unsigned int get_file_shard(const std::string& db_name) const;
+
+      /// Same as above, but throw Generic, if the file is not loaded
+
+    unsigned int get_loaded_file_shard(const std::string& db_name) const;
+
+      /// Search shard object; return null object, if there is no such object
+
+    ConfigObject find(const std::string& class_name, const std::string& id, unsigned long rlevel, const std::vector<std::string> * rclasses);
+
+      /// Read objects of class from given shards in parallel and add them to the index; if the query is empty, mark the class as indexed
+
+    void read_objects(const std::string& class_name, const std::vector<unsigned int>& shards, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses);
+
+      /// Search object in the index; return shard or the number of shards, if the object is not in the index
+
+    unsigned int find_in_index(const std::string * class_name, const std::string& id) const noexcept;
+
+      /// Add shard object to the index
+
+    void add_to_index(const ConfigObject& obj, unsigned int shard);
+
+      /// Remove object from the index
+
+    void remove_from_index(const std::string& class_name, const std::string& id) noexcept;
+
+      /// Clear the index (e.g. when the data of shards are changed)
+
+    void clear_index() noexcept;
+
+
+      /// Call function for every given shard in parallel and rethrow first exception, if any
+
+    template<class F>
+      void
+      fan_out(const std::vector<unsigned int>& shards, F function)
+      {
+        p_number_of_fan_outs++;
+
+        std::vector<std::exception_ptr> errors(shards.size());
+        std::vector<std::thread> threads;
+        threads.reserve(shards.size());
+
+        for (unsigned int i = 0; i < shards.size(); ++i)
+          threads.emplace_back([&, i]() {
+            try
+              {
+                function(shards[i]);
+              }
+            catch (...)
+              {
+                errors[i] = std::current_exception();
+              }
+          });
+
+        for (auto& t : threads)
+          t.join();
+
+        for (const auto& e : errors)
+          if (e)
+            std::rethrow_exception(e);
+      }
+
+};
+
+#endif // FEDCONFIG_FEDCONFIGURATION_H_
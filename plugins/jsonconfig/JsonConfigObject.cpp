@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <sstream>
+#include <type_traits>
+
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+
+#include "JsonConfigObject.hpp"
+#include "JsonConfiguration.hpp"
+
+
+JsonConfigObject::JsonConfigObject(jsonconfig::Object * obj, ConfigurationImpl * impl) noexcept :
+  ConfigObjectImpl(impl, *obj->m_id),
+  m_obj(obj)
+{
+}
+
+JsonConfigObject::~JsonConfigObject() noexcept
+{
+}
+
+const std::string
+JsonConfigObject::contained_in() const
+{
+  return *m_obj->m_file;
+}
+
+const daq::config::attribute_t&
+JsonConfigObject::attribute(const std::string& name, unsigned int& slot) const
+{
+  auto i = m_obj->m_class->m_attribute_index.find(name);
+
+  if (i == m_obj->m_class->m_attribute_index.end())
+    {
+      std::ostringstream text;
+      text << "object " << m_id << '@' << m_obj->m_class->m_name << " has no attribute \"" << name << '\"';
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  slot = i->second;
+  return m_obj->m_class->m_attributes[slot];
+}
+
+const daq::config::relationship_t&
+JsonConfigObject::relationship(const std::string& name, unsigned int& slot) const
+{
+  auto i = m_obj->m_class->m_relationship_index.find(name);
+
+  if (i == m_obj->m_class->m_relationship_index.end())
+    {
+      std::ostringstream text;
+      text << "object " << m_id << '@' << m_obj->m_class->m_name << " has no relationship \"" << name << '\"';
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  slot = i->second;
+  return m_obj->m_class->m_relationships[slot];
+}
+
+namespace
+{
+  template<class T> struct is_vector : std::false_type {};
+  template<class T> struct is_vector<std::vector<T>> : std::true_type {};
+
+    // assign value of the same type or convert between numeric types (like the oksconfig does)
+
+  template<class TO, class FROM>
+  bool
+  assign(TO& to, const FROM& from)
+  {
+    if constexpr (std::is_same<TO, FROM>::value)
+      {
+        to = from;
+        return true;
+      }
+    else if constexpr (std::is_arithmetic<TO>::value && std::is_arithmetic<FROM>::value)
+      {
+        to = static_cast<TO>(from);
+        return true;
+      }
+    else if constexpr (is_vector<TO>::value && is_vector<FROM>::value)
+      {
+        if constexpr (std::is_arithmetic<typename TO::value_type>::value && std::is_arithmetic<typename FROM::value_type>::value)
+          {
+            to.clear();
+            to.reserve(from.size());
+            for (const auto x : from)
+              to.push_back(static_cast<typename TO::value_type>(x));
+            return true;
+          }
+        else
+          return false;
+      }
+    else
+      return false;
+  }
+}
+
+template<class T>
+void
+JsonConfigObject::get_value(const std::string& name, T& value)
+{
+  unsigned int slot;
+  const daq::config::attribute_t& a(attribute(name, slot));
+
+  if (!std::visit([&value](const auto& x) { return assign(value, x); }, m_obj->m_attributes[slot]))
+    {
+      std::ostringstream text;
+      text << "failed to get value of attribute \"" << name << "\" of object " << m_id << '@' << m_obj->m_class->m_name
+           << ": value type does not match attribute type " << daq::config::attribute_t::type(a.p_type) << (a.p_is_multi_value ? " (multi-value)" : "");
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+}
+
+  // the referenced objects are searched and loaded when the relationship is read; the objects stored by another database (e.g. by another shard of federated database) are searched by the resolver
+
+void
+JsonConfigObject::wrap(const std::vector<std::pair<jsonconfig::Class *, std::string>>& refs, std::vector<ConfigObject>& value) const
+{
+  value.clear();
+  value.reserve(refs.size());
+
+  std::lock_guard<std::mutex> scoped_lock(db()->get_conf_impl_mutex());
+
+  for (const auto& x : refs)
+    {
+      if (jsonconfig::Object * obj = db()->find(*x.first, x.second))
+        {
+          value.emplace_back(db()->get_impl(obj));
+        }
+      else if (ConfigObjectImpl * ext = db()->resolve_external(x.first->m_name, x.second))
+        {
+          value.emplace_back(ext);
+        }
+      else
+        {
+          std::ostringstream text;
+          text << "cannot find object " << x.second << '@' << x.first->m_name << " referenced by object " << m_id << '@' << m_obj->m_class->m_name;
+          ers::warning(daq::config::Generic(ERS_HERE, text.str().c_str()));
+        }
+    }
+}
+
+void
+JsonConfigObject::get(const std::string& name, ConfigObject& value)
+{
+  unsigned int slot;
+  const daq::config::relationship_t& r(relationship(name, slot));
+
+  if (r.p_cardinality == daq::config::zero_or_many || r.p_cardinality == daq::config::one_or_many)
+    {
+      std::ostringstream text;
+      text << "failed to get single value of multi-value relationship \"" << name << "\" of object " << m_id << '@' << m_obj->m_class->m_name;
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  std::vector<ConfigObject> values;
+  wrap(m_obj->m_relationships[slot], values);
+
+  if (values.empty())
+    value = ConfigObject();
+  else
+    value = values.front();
+}
+
+void
+JsonConfigObject::get(const std::string& name, std::vector<ConfigObject>& value)
+{
+  unsigned int slot;
+  const daq::config::relationship_t& r(relationship(name, slot));
+
+  if (r.p_cardinality == daq::config::zero_or_one || r.p_cardinality == daq::config::only_one)
+    {
+      std::ostringstream text;
+      text << "failed to get multiple values of single-value relationship \"" << name << "\" of object " << m_id << '@' << m_obj->m_class->m_name;
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  wrap(m_obj->m_relationships[slot], value);
+}
+
+bool
+JsonConfigObject::rel(const std::string& name, std::vector<ConfigObject>& value)
+{
+  auto i = m_obj->m_class->m_relationship_index.find(name);
+
+  if (i == m_obj->m_class->m_relationship_index.end())
+    return false;
+
+  wrap(m_obj->m_relationships[i->second], value);
+
+  return true;
+}
+
+void
+JsonConfigObject::referenced_by(std::vector<ConfigObject>& value, const std::string& association, bool check_composite_only, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/) const
+{
+  std::vector<jsonconfig::Object *> objs;
+
+  std::lock_guard<std::mutex> scoped_lock(db()->get_conf_impl_mutex());
+
+  // there is no reverse index: load and scan relationships of all objects
+
+  for (const auto& c : db()->m_classes)
+    for (unsigned int slot = 0; slot < c.second->m_relationships.size(); ++slot)
+      {
+        const daq::config::relationship_t& r(c.second->m_relationships[slot]);
+
+        if ((association != "*" && association != r.p_name) || (check_composite_only && !r.p_is_aggregation))
+          continue;
+
+        for (auto& o : c.second->m_objects)
+          {
+            db()->load(o.second);
+
+            for (const auto& x : o.second.m_relationships[slot])
+              if (x.second == m_id && m_obj->m_class->is_subclass_of(x.first) && db()->find(*x.first, x.second) == m_obj)
+                {
+                  if (std::find(objs.begin(), objs.end(), &o.second) == objs.end())
+                    objs.push_back(&o.second);
+                  break;
+                }
+          }
+      }
+
+  value.clear();
+  value.reserve(objs.size());
+
+  for (const auto& x : objs)
+    value.emplace_back(db()->get_impl(x));
+}
+
+void
+JsonConfigObject::throw_read_only(const std::string& name) const
+{
+  std::ostringstream text;
+  text << "cannot set \"" << name << "\" of object " << m_id << '@' << m_obj->m_class->m_name << ": jsonconfig database is read-only";
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+void
+JsonConfigObject::set(const std::string& name, const ConfigObject * /*value*/, bool /*skip_non_null_check*/)
+{
+  throw_read_only(name);
+}
+
+void
+JsonConfigObject::set(const std::string& name, const std::vector<const ConfigObject*>& /*value*/, bool /*skip_non_null_check*/)
+{
+  throw_read_only(name);
+}
+
+void
+JsonConfigObject::move(const std::string& /*at*/)
+{
+  std::ostringstream text;
+  text << "cannot move object " << m_id << '@' << m_obj->m_class->m_name << ": jsonconfig database is read-only";
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+void
+JsonConfigObject::rename(const std::string& /*new_id*/)
+{
+  std::ostringstream text;
+  text << "cannot rename object " << m_id << '@' << m_obj->m_class->m_name << ": jsonconfig database is read-only";
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+  // the json data are never changed
+
+void
+JsonConfigObject::reset()
+{
+  m_state = daq::config::Valid;
+}
@@ -0,0 +1,143 @@
+  /**
+   *  \file JsonConfigObject.hpp This file contains JsonConfigObject class,
+   *  that is the json implementation of the config object abstract interface.
+   *  \brief json config object
+   */
+
+#ifndef JSONCONFIG_JSONCONFIGOBJECT_H_
+#define JSONCONFIG_JSONCONFIGOBJECT_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "config/ConfigObjectImpl.hpp"
+#include "config/Schema.hpp"
+
+#include "JsonConfiguration.hpp"
+
+
+  /**
+   *  \brief Implements object of json configuration database.
+   *
+   *  The object refers to the data loaded by the JsonConfiguration.
+   *  The data are loaded before the object is created and never changed, so the values are read without locking.
+   */
+
+class JsonConfigObject : public ConfigObjectImpl {
+
+  friend class JsonConfiguration;
+
+  public:
+
+    JsonConfigObject(jsonconfig::Object * obj, ConfigurationImpl * impl) noexcept;
+
+    virtual ~JsonConfigObject() noexcept;
+
+
+  public:
+
+    virtual const std::string contained_in() const;
+
+    virtual void get(const std::string& attribute, bool&           value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint8_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int8_t&         value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint16_t&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int16_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint32_t&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int32_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint64_t&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int64_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, float&          value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, double&         value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::string&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& association, ConfigObject& value);
+
+    virtual void get(const std::string& attribute, std::vector<bool>&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint8_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int8_t>&      value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint16_t>&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int16_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint32_t>&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int32_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint64_t>&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int64_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<float>&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<double>&      value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<std::string>& value) { get_value(attribute, value); }
+    virtual void get(const std::string& association, std::vector<ConfigObject>& value);
+
+    virtual bool rel(const std::string& name, std::vector<ConfigObject>& value);
+    virtual void referenced_by(std::vector<ConfigObject>& value, const std::string& association, bool check_composite_only, unsigned long rlevel, const std::vector<std::string> * rclasses) const;
+
+    virtual void set(const std::string& attribute, bool               /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, uint8_t            /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, int8_t             /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, uint16_t           /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, int16_t            /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, uint32_t           /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, int32_t            /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, uint64_t           /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, int64_t            /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, float              /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, double             /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::string& /*value*/) { throw_read_only(attribute); }
+
+    virtual void set_enum(const std::string& attribute, const std::string& /*value*/)  { throw_read_only(attribute); }
+    virtual void set_date(const std::string& attribute, const std::string& /*value*/)  { throw_read_only(attribute); }
+    virtual void set_time(const std::string& attribute, const std::string& /*value*/)  { throw_read_only(attribute); }
+    virtual void set_class(const std::string& attribute, const std::string& /*value*/) { throw_read_only(attribute); }
+
+    virtual void set(const std::string& attribute, const std::vector<bool>&        /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<uint8_t>&     /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<int8_t>&      /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<uint16_t>&    /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<int16_t>&     /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<uint32_t>&    /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<int32_t>&     /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<uint64_t>&    /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<int64_t>&     /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<float>&       /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<double>&      /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<std::string>& /*value*/) { throw_read_only(attribute); }
+
+    virtual void set_enum(const std::string& attribute, const std::vector<std::string>& /*value*/)  { throw_read_only(attribute); }
+    virtual void set_date(const std::string& attribute, const std::vector<std::string>& /*value*/)  { throw_read_only(attribute); }
+    virtual void set_time(const std::string& attribute, const std::vector<std::string>& /*value*/)  { throw_read_only(attribute); }
+    virtual void set_class(const std::string& attribute, const std::vector<std::string>& /*value*/) { throw_read_only(attribute); }
+
+    virtual void set(const std::string& association, const ConfigObject * value, bool skip_non_null_check);
+    virtual void set(const std::string& association, const std::vector<const ConfigObject*>& value, bool skip_non_null_check);
+
+    virtual void move(const std::string& at);
+    virtual void rename(const std::string& new_id);
+
+    virtual void reset();
+
+
+  public:
+
+      /// Used by ConfigurationImpl::insert_object() when the implementation object is re-used
+
+    void set(jsonconfig::Object * obj) noexcept { m_obj = obj; }
+
+
+  private:
+
+    jsonconfig::Object * m_obj;
+
+    JsonConfiguration * db() const noexcept { return static_cast<JsonConfiguration *>(m_impl); }
+
+    const daq::config::attribute_t& attribute(const std::string& name, unsigned int& slot) const;
+    const daq::config::relationship_t& relationship(const std::string& name, unsigned int& slot) const;
+
+    template<class T> void get_value(const std::string& name, T& value);
+
+    void wrap(const std::vector<std::pair<jsonconfig::Class *, std::string>>& refs, std::vector<ConfigObject>& value) const;
+
+    [[noreturn]] void throw_read_only(const std::string& name) const;
+
+};
+
+#endif // JSONCONFIG_JSONCONFIGOBJECT_H_
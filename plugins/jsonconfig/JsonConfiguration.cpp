@@ -0,0 +1,1105 @@
+#include <stdlib.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <type_traits>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+#include "config/PluginRegistry.hpp"
+#include "config/DalFactory.hpp"
+
+#include "JsonConfigObject.hpp"
+#include "JsonConfiguration.hpp"
+
+
+  // to be used as plug-in
+
+extern "C" ConfigurationImpl * _jsonconfig_creator_ (const std::string& spec) {
+  try {
+    std::unique_ptr<JsonConfiguration> impl(new JsonConfiguration());
+    if(!spec.empty()) { impl->open_db(spec); }
+    return impl.release();
+  }
+  catch(daq::config::Exception& ex) {
+    throw daq::config::Generic(ERS_HERE, "jsonconfig initialization error", ex);
+  }
+  catch(...) {
+    throw daq::config::Generic(ERS_HERE, "jsonconfig initialization error:\n***** caught unknown exception *****");
+  }
+}
+
+CONFIG_REGISTER_PLUGIN(jsonconfig, _jsonconfig_creator_)
+
+
+namespace jsonconfig
+{
+
+  bool
+  Class::is_subclass_of(const Class * c) const noexcept
+  {
+    return (c == this || std::find(m_superclasses.begin(), m_superclasses.end(), c) != m_superclasses.end());
+  }
+
+
+    /**
+     *  \brief Streaming parser of json text.
+     *
+     *  The parser does not build any tree: the caller walks the text using members() and items() methods
+     *  and reads the values it is interested in; the rest is skipped without allocations.
+     */
+
+  class Parser
+  {
+
+  public:
+
+    Parser(const char * begin, const char * end, const std::string& file) noexcept :
+      m_begin(begin), m_p(begin), m_end(end), m_file(file)
+    {
+    }
+
+    const char *
+    position() const noexcept
+    {
+      return m_p;
+    }
+
+    bool
+    next_is(char c) noexcept
+    {
+      skip_ws();
+      return (m_p < m_end && *m_p == c);
+    }
+
+      // call f(key) for each member of object; f has to read or skip the value
+
+    template<class F>
+    void
+    members(F f)
+    {
+      std::string key;
+
+      expect('{');
+
+      if (next_is('}'))
+        {
+          m_p++;
+          return;
+        }
+
+      do
+        {
+          skip_ws();
+          read_string(key);
+          expect(':');
+          f(key);
+        }
+      while (consume(','));
+
+      expect('}');
+    }
+
+      // read array of scalars or single scalar value as strings; null is read as empty string
+
+    void
+    items(std::vector<std::string>& values)
+    {
+      values.clear();
+
+      if (next_is('['))
+        {
+          m_p++;
+
+          if (next_is(']'))
+            {
+              m_p++;
+              return;
+            }
+
+          do
+            {
+              values.emplace_back();
+              token(values.back());
+            }
+          while (consume(','));
+
+          expect(']');
+        }
+      else
+        {
+          values.emplace_back();
+          token(values.back());
+        }
+    }
+
+    void
+    skip_value()
+    {
+      skip_ws();
+
+      if (m_p >= m_end)
+        error("unexpected end of text");
+
+      if (*m_p == '{' || *m_p == '[')
+        {
+          unsigned int depth = 0;
+
+          for (; m_p < m_end; ++m_p)
+            {
+              if (*m_p == '"')
+                skip_string();
+
+              if (*m_p == '{' || *m_p == '[')
+                depth++;
+              else if ((*m_p == '}' || *m_p == ']') && --depth == 0)
+                {
+                  m_p++;
+                  return;
+                }
+            }
+
+          error("unexpected end of text");
+        }
+      else if (*m_p == '"')
+        {
+          skip_string();
+          m_p++;
+        }
+      else
+        {
+          while (m_p < m_end && !is_delimiter(*m_p))
+            m_p++;
+        }
+    }
+
+      // return true if the first member of first member is not an object, e.g. "abstract": "false" in schema
+
+    bool
+    is_schema()
+    {
+      std::string key;
+
+      expect('{');
+
+      if (next_is('}'))
+        return false;
+
+      read_string(key);
+      expect(':');
+      expect('{');
+
+      if (next_is('}'))
+        return false;
+
+      read_string(key);
+      expect(':');
+
+      return !next_is('{');
+    }
+
+    [[noreturn]] void
+    error(const char * what) const
+    {
+      std::ostringstream text;
+      text << "json parse error in file \"" << m_file << "\" at line " << (std::count(m_begin, m_p, '\n') + 1) << ": " << what;
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+
+  private:
+
+    const char * m_begin;
+    const char * m_p;
+    const char * m_end;
+    const std::string& m_file;
+
+    static bool
+    is_delimiter(char c) noexcept
+    {
+      return (c == ',' || c == '}' || c == ']' || c == ' ' || c == '\t' || c == '\n' || c == '\r');
+    }
+
+    void
+    skip_ws() noexcept
+    {
+      while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\n' || *m_p == '\r'))
+        m_p++;
+    }
+
+    bool
+    consume(char c) noexcept
+    {
+      if (next_is(c))
+        {
+          m_p++;
+          return true;
+        }
+
+      return false;
+    }
+
+    void
+    expect(char c)
+    {
+      if (!consume(c))
+        {
+          std::string text("expected \'");
+          text.push_back(c);
+          text.push_back('\'');
+          error(text.c_str());
+        }
+    }
+
+      // move to closing quote
+
+    void
+    skip_string()
+    {
+      for (m_p++; m_p < m_end && *m_p != '"'; m_p++)
+        if (*m_p == '\\')
+          m_p++;
+
+      if (m_p >= m_end)
+        error("unterminated string");
+    }
+
+    static void
+    append_utf8(std::string& s, unsigned long c)
+    {
+      if (c < 0x80)
+        s.push_back(c);
+      else if (c < 0x800)
+        {
+          s.push_back(0xC0 | (c >> 6));
+          s.push_back(0x80 | (c & 0x3F));
+        }
+      else if (c < 0x10000)
+        {
+          s.push_back(0xE0 | (c >> 12));
+          s.push_back(0x80 | ((c >> 6) & 0x3F));
+          s.push_back(0x80 | (c & 0x3F));
+        }
+      else
+        {
+          s.push_back(0xF0 | (c >> 18));
+          s.push_back(0x80 | ((c >> 12) & 0x3F));
+          s.push_back(0x80 | ((c >> 6) & 0x3F));
+          s.push_back(0x80 | (c & 0x3F));
+        }
+    }
+
+    unsigned long
+    read_hex4()
+    {
+      if (m_end - m_p < 5)
+        error("bad unicode escape");
+
+      char buf[5] = { m_p[1], m_p[2], m_p[3], m_p[4], 0 };
+      char * end;
+      unsigned long c = strtoul(buf, &end, 16);
+
+      if (end != buf + 4)
+        error("bad unicode escape");
+
+      m_p += 4;
+      return c;
+    }
+
+    void
+    read_string(std::string& s)
+    {
+      if (m_p >= m_end || *m_p != '"')
+        error("expected string");
+
+      s.clear();
+
+      for (m_p++; m_p < m_end && *m_p != '"'; m_p++)
+        {
+          const char * start = m_p;
+
+          while (m_p < m_end && *m_p != '"' && *m_p != '\\')
+            m_p++;
+
+          s.append(start, m_p);
+
+          if (m_p >= m_end || *m_p == '"')
+            break;
+
+          if (++m_p >= m_end)
+            break;
+
+          switch (*m_p)
+            {
+              case 'b': s.push_back('\b'); break;
+              case 'f': s.push_back('\f'); break;
+              case 'n': s.push_back('\n'); break;
+              case 'r': s.push_back('\r'); break;
+              case 't': s.push_back('\t'); break;
+              case 'u':
+                {
+                  unsigned long c = read_hex4();
+
+                  if (c >= 0xD800 && c < 0xDC00 && m_end - m_p > 2 && m_p[1] == '\\' && m_p[2] == 'u')
+                    {
+                      m_p += 2;
+                      c = 0x10000 + ((c - 0xD800) << 10) + (read_hex4() - 0xDC00);
+                    }
+
+                  append_utf8(s, c);
+                }
+                break;
+              default:  s.push_back(*m_p);
+            }
+        }
+
+      if (m_p >= m_end)
+        error("unterminated string");
+
+      m_p++;
+    }
+
+    void
+    token(std::string& s)
+    {
+      skip_ws();
+
+      if (m_p < m_end && *m_p == '"')
+        {
+          read_string(s);
+          return;
+        }
+
+      const char * start = m_p;
+
+      while (m_p < m_end && !is_delimiter(*m_p))
+        m_p++;
+
+      if (start == m_p)
+        error("expected value");
+
+      s.assign(start, m_p);
+
+      if (s == "null")
+        s.clear();
+    }
+
+  };
+
+
+  template<class T>
+  static T
+  str2val(const std::string& s)
+  {
+    if constexpr (std::is_same<T, std::string>::value)
+      return s;
+    else if constexpr (std::is_same<T, bool>::value)
+      return (s == "true" || s == "1" || s == "yes");
+    else if constexpr (std::is_floating_point<T>::value)
+      return static_cast<T>(strtod(s.c_str(), nullptr));
+    else if constexpr (std::is_signed<T>::value)
+      return static_cast<T>(strtoll(s.c_str(), nullptr, 0));
+    else
+      return static_cast<T>(strtoull(s.c_str(), nullptr, 0));
+  }
+
+    // the items are either values of json array, or the comma-separated default value of multi-value attribute
+
+  template<class T>
+  static Value
+  make(const daq::config::attribute_t& a, const std::vector<std::string>& items)
+  {
+    if (!a.p_is_multi_value)
+      return Value(std::in_place_type<T>, str2val<T>(items.empty() ? std::string() : items.front()));
+
+    std::vector<T> values;
+    values.reserve(items.size());
+
+    for (const auto& x : items)
+      values.push_back(str2val<T>(x));
+
+    return Value(std::in_place_type<std::vector<T>>, std::move(values));
+  }
+
+  static Value
+  make_value(const daq::config::attribute_t& a, const std::vector<std::string>& items)
+  {
+    switch (a.p_type)
+      {
+        case daq::config::bool_type:   return make<bool>(a, items);
+        case daq::config::s8_type:     return make<int8_t>(a, items);
+        case daq::config::u8_type:     return make<uint8_t>(a, items);
+        case daq::config::s16_type:    return make<int16_t>(a, items);
+        case daq::config::u16_type:    return make<uint16_t>(a, items);
+        case daq::config::s32_type:    return make<int32_t>(a, items);
+        case daq::config::u32_type:    return make<uint32_t>(a, items);
+        case daq::config::s64_type:    return make<int64_t>(a, items);
+        case daq::config::u64_type:    return make<uint64_t>(a, items);
+        case daq::config::float_type:  return make<float>(a, items);
+        case daq::config::double_type: return make<double>(a, items);
+        case daq::config::date_type:
+        case daq::config::time_type:
+        case daq::config::enum_type:
+        case daq::config::class_type:
+        case daq::config::string_type: return make<std::string>(a, items);
+        default: throw daq::config::Generic(ERS_HERE, std::string("invalid type of attribute \'" + a.p_name + '\'').c_str());
+      }
+  }
+
+}
+
+
+JsonConfiguration::JsonConfiguration() noexcept :
+  m_loaded(false),
+  p_number_of_indexed_objects(0),
+  p_number_of_loaded_objects(0)
+{
+}
+
+JsonConfiguration::~JsonConfiguration()
+{
+  close_db();
+}
+
+
+void
+JsonConfiguration::open_db(const std::string& spec)
+{
+  std::vector<std::string> schema_files, data_files;
+
+  std::string::size_type pos = 0, next;
+
+  do
+    {
+      next = spec.find(':', pos);
+      std::string file(spec, pos, next == std::string::npos ? std::string::npos : next - pos);
+
+      if (!file.empty() && m_files.find(file) == m_files.end())
+        {
+          std::ifstream f(file, std::ios::binary);
+          std::ostringstream buf;
+
+          if (!(f && buf << f.rdbuf()))
+            {
+              std::ostringstream text;
+              text << "cannot read json file \"" << file << '\"';
+              throw daq::config::Generic(ERS_HERE, text.str().c_str());
+            }
+
+          const std::string& text = m_files[file] = buf.str();
+
+          // the config_export_schema writes "abstract" property of every class
+
+          bool is_schema = jsonconfig::Parser(text.data(), text.data() + text.size(), file).is_schema();
+
+          TLOG_DEBUG(1) << "read " << (is_schema ? "schema" : "data") << " file \'" << file << '\'';
+
+          (is_schema ? schema_files : data_files).push_back(file);
+        }
+
+      pos = next + 1;
+    }
+  while (next != std::string::npos);
+
+  for (const auto& x : schema_files)
+    {
+      load_schema(x, m_files[x]);
+      m_files.erase(x);
+    }
+
+  link_schema();
+
+  for (const auto& x : data_files)
+    {
+      index_data(x, m_files[x]);
+      m_top_level_files.push_back(x);
+    }
+
+  m_loaded = true;
+}
+
+void
+JsonConfiguration::close_db()
+{
+  clean();
+
+  m_classes.clear();
+  m_files.clear();
+  m_top_level_files.clear();
+
+  m_loaded = false;
+}
+
+void
+JsonConfiguration::load_schema(const std::string& file_name, const std::string& text)
+{
+  boost::property_tree::ptree pt;
+
+  try
+    {
+      std::istringstream s(text);
+      boost::property_tree::read_json(s, pt);
+    }
+  catch (const boost::property_tree::json_parser_error& ex)
+    {
+      std::ostringstream text;
+      text << "cannot read json file \"" << file_name << "\": " << ex.what();
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  for (const auto& x : pt)
+    {
+      std::unique_ptr<jsonconfig::Class>& c = m_classes[x.first];
+
+      if (c)
+        {
+          std::ostringstream text;
+          text << "class \"" << x.first << "\" is already defined";
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      c.reset(new jsonconfig::Class());
+
+      c->m_name = x.first;
+      c->m_description = x.second.get<std::string>("description", "");
+      c->m_abstract = x.second.get<bool>("abstract", false);
+
+      if (auto superclasses = x.second.get_child_optional("superclasses"))
+        for (const auto& s : *superclasses)
+          c->m_direct_superclasses.push_back(s.second.data());
+
+      if (auto attributes = x.second.get_child_optional("attributes"))
+        for (const auto& a : *attributes)
+          c->m_direct_attributes.emplace_back(
+            a.first,
+            daq::config::attribute_t::str2type(a.second.get<std::string>("type")),
+            a.second.get<std::string>("range", ""),
+            daq::config::attribute_t::str2format(a.second.get<std::string>("format", "")),
+            a.second.get<bool>("is-not-null", false),
+            a.second.get<bool>("is-multi-value", false),
+            a.second.get<std::string>("default-value", ""),
+            a.second.get<std::string>("description", "")
+          );
+
+      if (auto relationships = x.second.get_child_optional("relationships"))
+        for (const auto& r : *relationships)
+          {
+            daq::config::relationship_t rel;
+
+            rel.p_name = r.first;
+            rel.p_type = r.second.get<std::string>("type");
+            rel.p_cardinality = daq::config::relationship_t::str2card(r.second.get<std::string>("cardinality"));
+            rel.p_is_aggregation = r.second.get<bool>("is-aggregation", false);
+            rel.p_description = r.second.get<std::string>("description", "");
+
+            c->m_direct_relationships.push_back(rel);
+          }
+    }
+}
+
+void
+JsonConfiguration::link_schema()
+{
+  // resolve superclasses; the schema can be exported with all (not only direct) superclasses
+
+  std::map<jsonconfig::Class *, std::vector<jsonconfig::Class *>> listed;
+
+  for (auto& x : m_classes)
+    for (const auto& s : x.second->m_direct_superclasses)
+      {
+        auto i = m_classes.find(s);
+
+        if (i == m_classes.end())
+          {
+            std::ostringstream text;
+            text << "cannot find superclass \"" << s << "\" of class \"" << x.first << '\"';
+            throw daq::config::Generic(ERS_HERE, text.str().c_str());
+          }
+
+        listed[x.second.get()].push_back(i->second.get());
+      }
+
+  for (auto& x : m_classes)
+    {
+      jsonconfig::Class * c = x.second.get();
+
+      std::vector<jsonconfig::Class *> stack(listed[c].rbegin(), listed[c].rend());
+
+      while (!stack.empty())
+        {
+          jsonconfig::Class * s = stack.back();
+          stack.pop_back();
+
+          if (s == c)
+            {
+              std::ostringstream text;
+              text << "class \"" << c->m_name << "\" is derived from itself";
+              throw daq::config::Generic(ERS_HERE, text.str().c_str());
+            }
+
+          if (std::find(c->m_superclasses.begin(), c->m_superclasses.end(), s) == c->m_superclasses.end())
+            {
+              c->m_superclasses.push_back(s);
+              stack.insert(stack.end(), listed[s].rbegin(), listed[s].rend());
+            }
+        }
+
+      for (auto& s : c->m_superclasses)
+        s->m_subclasses.push_back(c);
+    }
+
+  // leave direct properties only
+
+  for (auto& x : m_classes)
+    {
+      jsonconfig::Class * c = x.second.get();
+
+      std::vector<std::string> superclasses;
+
+      for (const auto& s : listed[c])
+        if (std::none_of(listed[c].begin(), listed[c].end(), [s](const jsonconfig::Class * o) { return o != s && o->is_subclass_of(s); }))
+          superclasses.push_back(s->m_name);
+
+      c->m_direct_superclasses.swap(superclasses);
+    }
+
+  auto inherited = [](const jsonconfig::Class * c, const std::string& name, auto jsonconfig::Class::*list) {
+    for (const auto& s : c->m_superclasses)
+      for (const auto& p : s->*list)
+        if (p.p_name == name)
+          return true;
+    return false;
+  };
+
+  for (auto& x : m_classes)
+    {
+      jsonconfig::Class * c = x.second.get();
+
+      c->m_direct_attributes.erase(std::remove_if(c->m_direct_attributes.begin(), c->m_direct_attributes.end(), [&](const daq::config::attribute_t& a) { return inherited(c, a.p_name, &jsonconfig::Class::m_direct_attributes); }), c->m_direct_attributes.end());
+      c->m_direct_relationships.erase(std::remove_if(c->m_direct_relationships.begin(), c->m_direct_relationships.end(), [&](const daq::config::relationship_t& r) { return inherited(c, r.p_name, &jsonconfig::Class::m_direct_relationships); }), c->m_direct_relationships.end());
+    }
+
+  // calculate slots: inherited properties first, starting from the most generic superclass
+
+  std::vector<std::string> items;
+
+  for (auto& x : m_classes)
+    {
+      jsonconfig::Class * c = x.second.get();
+
+      std::vector<jsonconfig::Class *> hierarchy(c->m_superclasses.rbegin(), c->m_superclasses.rend());
+      hierarchy.push_back(c);
+
+      for (const auto& s : hierarchy)
+        {
+          for (const auto& a : s->m_direct_attributes)
+            if (c->m_attribute_index.emplace(a.p_name, c->m_attributes.size()).second)
+              {
+                c->m_attributes.push_back(a);
+
+                // the default value of multi-value attribute is a comma-separated list
+
+                items.clear();
+
+                if (!a.p_is_multi_value)
+                  items.push_back(a.p_default_value);
+                else if (!a.p_default_value.empty())
+                  for (std::string::size_type pos = 0, next = 0; next != std::string::npos; pos = next + 1)
+                    {
+                      next = a.p_default_value.find(',', pos);
+                      items.push_back(a.p_default_value.substr(pos, next == std::string::npos ? std::string::npos : next - pos));
+                    }
+
+                c->m_default_values.push_back(jsonconfig::make_value(a, items));
+              }
+
+          for (const auto& r : s->m_direct_relationships)
+            if (c->m_relationship_index.emplace(r.p_name, c->m_relationships.size()).second)
+              {
+                if (m_classes.find(r.p_type) == m_classes.end())
+                  {
+                    std::ostringstream text;
+                    text << "cannot find class \"" << r.p_type << "\" of relationship \"" << r.p_name << "\" of class \"" << c->m_name << '\"';
+                    throw daq::config::Generic(ERS_HERE, text.str().c_str());
+                  }
+
+                c->m_relationships.push_back(r);
+              }
+        }
+    }
+}
+
+void
+JsonConfiguration::index_data(const std::string& file_name, const std::string& text)
+{
+  const std::string * file = &m_files.find(file_name)->first;
+
+  jsonconfig::Parser parser(text.data(), text.data() + text.size(), *file);
+
+  parser.members([&](const std::string& class_name) {
+    jsonconfig::Class& c(get_class(class_name));
+
+    parser.members([&](const std::string& id) {
+      auto i = c.m_objects.try_emplace(id);
+
+      if (i.second == false)
+        {
+          std::ostringstream text;
+          text << "object " << id << '@' << c.m_name << " from file \"" << file_name << "\" is already loaded";
+          parser.error(text.str().c_str());
+        }
+
+      jsonconfig::Object& obj(i.first->second);
+
+      obj.m_class = &c;
+      obj.m_id = &i.first->first;
+      obj.m_file = file;
+      obj.m_loaded = false;
+
+      parser.next_is('{');
+      obj.m_begin = parser.position();
+      parser.skip_value();
+      obj.m_end = parser.position();
+
+      p_number_of_indexed_objects++;
+    });
+  });
+}
+
+  // called with locked configuration implementation mutex
+
+void
+JsonConfiguration::load(jsonconfig::Object& obj)
+{
+  if (obj.m_loaded)
+    return;
+
+  const jsonconfig::Class& c(*obj.m_class);
+
+  obj.m_attributes = c.m_default_values;
+  obj.m_relationships.resize(c.m_relationships.size());
+
+  std::vector<std::string> items;
+
+  jsonconfig::Parser parser(obj.m_begin, obj.m_end, *obj.m_file);
+
+  parser.members([&](const std::string& name) {
+    auto a = c.m_attribute_index.find(name);
+
+    if (a != c.m_attribute_index.end())
+      {
+        const daq::config::attribute_t& attribute(c.m_attributes[a->second]);
+
+        parser.items(items);
+
+        // empty array is exported either as [] or as an empty string
+
+        if (attribute.p_is_multi_value && items.size() == 1 && items.front().empty())
+          items.clear();
+
+        obj.m_attributes[a->second] = jsonconfig::make_value(attribute, items);
+        return;
+      }
+
+    auto r = c.m_relationship_index.find(name);
+
+    if (r != c.m_relationship_index.end())
+      {
+        auto& values(obj.m_relationships[r->second]);
+
+        parser.items(items);
+
+        for (const auto& v : items)
+          if (!v.empty())
+            {
+              std::string::size_type idx = v.rfind('@');
+              auto rc = (idx != std::string::npos) ? m_classes.find(v.substr(idx + 1)) : m_classes.end();
+
+              if (rc == m_classes.end())
+                {
+                  std::ostringstream text;
+                  text << "cannot resolve \"" << v << "\" referenced by relationship \"" << name << "\" of object " << *obj.m_id << '@' << c.m_name;
+                  ers::warning(daq::config::Generic(ERS_HERE, text.str().c_str()));
+                }
+              else
+                {
+                  values.emplace_back(rc->second.get(), v.substr(0, idx));
+                }
+            }
+
+        return;
+      }
+
+    parser.skip_value();
+  });
+
+  obj.m_loaded = true;
+  p_number_of_loaded_objects++;
+}
+
+void
+JsonConfiguration::prefetch_all_data()
+{
+  for (auto& c : m_classes)
+    for (auto& o : c.second->m_objects)
+      load(o.second);
+}
+
+
+void
+JsonConfiguration::throw_read_only(const char * what) const
+{
+  std::ostringstream text;
+  text << "cannot " << what << ": jsonconfig database is read-only";
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+void
+JsonConfiguration::create(const std::string& /*db_name*/, const std::list<std::string>& /*includes*/)
+{
+  throw_read_only("create file");
+}
+
+void
+JsonConfiguration::add_include(const std::string& /*db_name*/, const std::string& /*include*/)
+{
+  throw_read_only("add include");
+}
+
+void
+JsonConfiguration::remove_include(const std::string& /*db_name*/, const std::string& /*include*/)
+{
+  throw_read_only("remove include");
+}
+
+void
+JsonConfiguration::get_includes(const std::string& db_name, std::list<std::string>& includes) const
+{
+  if (db_name.empty())
+    includes = m_top_level_files;
+  else
+    includes.clear();
+}
+
+void
+JsonConfiguration::get_updated_dbs(std::list<std::string>& dbs) const
+{
+  dbs.clear();
+}
+
+void
+JsonConfiguration::set_commit_credentials(const std::string& /*user*/, const std::string& /*password*/)
+{
+}
+
+void
+JsonConfiguration::commit(const std::string& /*log_message*/)
+{
+  throw_read_only("commit");
+}
+
+void
+JsonConfiguration::abort()
+{
+}
+
+std::vector<daq::config::Version>
+JsonConfiguration::get_changes()
+{
+  return std::vector<daq::config::Version>();
+}
+
+std::vector<daq::config::Version>
+JsonConfiguration::get_versions(const std::string& /*since*/, const std::string& /*until*/, daq::config::Version::QueryType /*type*/, bool /*skip_irrelevant*/)
+{
+  return std::vector<daq::config::Version>();
+}
+
+
+jsonconfig::Class&
+JsonConfiguration::get_class(const std::string& name) const
+{
+  auto i = m_classes.find(name);
+
+  if (i == m_classes.end())
+    throw daq::config::NotFound(ERS_HERE, "class", name.c_str());
+
+  return *i->second;
+}
+
+jsonconfig::Object *
+JsonConfiguration::find(const jsonconfig::Class& c, const std::string& id) const noexcept
+{
+  auto i = c.m_objects.find(id);
+
+  if (i != c.m_objects.end())
+    return const_cast<jsonconfig::Object *>(&i->second);
+
+  for (const auto& s : c.m_subclasses)
+    {
+      auto j = s->m_objects.find(id);
+
+      if (j != s->m_objects.end())
+        return &j->second;
+    }
+
+  return nullptr;
+}
+
+JsonConfigObject *
+JsonConfiguration::get_impl(jsonconfig::Object * obj)
+{
+  load(*obj);
+  return insert_object<JsonConfigObject>(obj, *obj->m_id, obj->m_class->m_name);
+}
+
+void
+JsonConfiguration::get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/)
+{
+  jsonconfig::Object * obj = find(get_class(class_name), id);
+
+  if (obj == nullptr)
+    throw daq::config::NotFound(ERS_HERE, "object", std::string(id + '@' + class_name).c_str());
+
+  object = get_impl(obj);
+}
+
+void
+JsonConfiguration::get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/)
+{
+  if (!query.empty())
+    {
+      std::ostringstream text;
+      text << "jsonconfig does not support queries (\"" << query << "\")";
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  jsonconfig::Class& c(get_class(class_name));
+
+  objects.clear();
+
+  auto add = [&](jsonconfig::Class& x) {
+    for (auto& o : x.m_objects)
+      objects.emplace_back(get_impl(&o.second));
+  };
+
+  add(c);
+
+  for (const auto& s : c.m_subclasses)
+    add(*s);
+}
+
+void
+JsonConfiguration::get(const ConfigObject& /*obj_from*/, const std::string& query, std::vector<ConfigObject>& /*objects*/, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/)
+{
+  std::ostringstream text;
+  text << "jsonconfig does not support path queries (\"" << query << "\")";
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+bool
+JsonConfiguration::test_object(const std::string& class_name, const std::string& id, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/)
+{
+  return (find(get_class(class_name), id) != nullptr);
+}
+
+void
+JsonConfiguration::create(const std::string& /*at*/, const std::string& /*class_name*/, const std::string& /*id*/, ConfigObject& /*object*/)
+{
+  throw_read_only("create object");
+}
+
+void
+JsonConfiguration::create(const ConfigObject& /*at*/, const std::string& /*class_name*/, const std::string& /*id*/, ConfigObject& /*object*/)
+{
+  throw_read_only("create object");
+}
+
+void
+JsonConfiguration::destroy(ConfigObject& /*object*/)
+{
+  throw_read_only("destroy object");
+}
+
+daq::config::class_t *
+JsonConfiguration::get(const std::string& class_name, bool direct_only)
+{
+  const jsonconfig::Class& c(get_class(class_name));
+
+  daq::config::class_t * d = new daq::config::class_t(c.m_name, c.m_description, c.m_abstract);
+
+  std::vector<std::string>& superclasses(const_cast<std::vector<std::string>&>(d->p_superclasses));
+  std::vector<std::string>& subclasses(const_cast<std::vector<std::string>&>(d->p_subclasses));
+
+  if (direct_only)
+    {
+      superclasses = c.m_direct_superclasses;
+
+      for (const auto& s : c.m_subclasses)
+        if (std::find(s->m_direct_superclasses.begin(), s->m_direct_superclasses.end(), c.m_name) != s->m_direct_superclasses.end())
+          subclasses.push_back(s->m_name);
+
+      const_cast<std::vector<daq::config::attribute_t>&>(d->p_attributes) = c.m_direct_attributes;
+      const_cast<std::vector<daq::config::relationship_t>&>(d->p_relationships) = c.m_direct_relationships;
+    }
+  else
+    {
+      for (const auto& s : c.m_superclasses)
+        superclasses.push_back(s->m_name);
+
+      for (const auto& s : c.m_subclasses)
+        subclasses.push_back(s->m_name);
+
+      const_cast<std::vector<daq::config::attribute_t>&>(d->p_attributes) = c.m_attributes;
+      const_cast<std::vector<daq::config::relationship_t>&>(d->p_relationships) = c.m_relationships;
+    }
+
+  return d;
+}
+
+void
+JsonConfiguration::get_superclasses(config::fmap<config::fset>& schema)
+{
+  schema.clear();
+
+  for (const auto& x : m_classes)
+    {
+      config::fset& superclasses = schema[&DalFactory::instance().get_known_class_name_ref(x.first)];
+
+      for (const auto& s : x.second->m_superclasses)
+        superclasses.insert(&DalFactory::instance().get_known_class_name_ref(s->m_name));
+    }
+}
+
+
+  // the json files are never changed, so there is nothing to notify about
+
+void
+JsonConfiguration::subscribe(const std::set<std::string>& /*class_names*/, const std::map< std::string, std::set<std::string> >& /*objs*/, ConfigurationImpl::notify /*cb*/, ConfigurationImpl::pre_notify /*pre_cb*/)
+{
+}
+
+void
+JsonConfiguration::unsubscribe()
+{
+}
+
+void
+JsonConfiguration::print_profiling_info() noexcept
+{
+  std::cout <<
+    "JsonConfiguration profiler report:\n"
+    "  number of classes: " << m_classes.size() << "\n"
+    "  number of files: " << m_top_level_files.size() << "\n"
+    "  number of indexed objects: " << p_number_of_indexed_objects << "\n"
+    "  number of loaded objects: " << p_number_of_loaded_objects << std::endl;
+
+  print_cache_info();
+}
@@ -0,0 +1,216 @@
+  /**
+   *  \file JsonConfiguration.hpp This file contains JsonConfiguration class,
+   *  that is the read-only implementation of the config abstract interface using json files.
+   *  \brief json config plug-in
+   */
+
+#ifndef JSONCONFIG_JSONCONFIGURATION_H_
+#define JSONCONFIG_JSONCONFIGURATION_H_
+
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "config/ConfigurationImpl.hpp"
+#include "config/Schema.hpp"
+#include "config/map.hpp"
+
+class JsonConfigObject;
+
+namespace jsonconfig
+{
+
+    /// The value of an attribute; the alternative is defined by the attribute type
+
+  typedef std::variant<
+    bool, uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, uint64_t, int64_t, float, double, std::string,
+    std::vector<bool>, std::vector<uint8_t>, std::vector<int8_t>, std::vector<uint16_t>, std::vector<int16_t>,
+    std::vector<uint32_t>, std::vector<int32_t>, std::vector<uint64_t>, std::vector<int64_t>,
+    std::vector<float>, std::vector<double>, std::vector<std::string>
+  > Value;
+
+  struct Class;
+
+
+    /**
+     *  \brief The object data.
+     *
+     *  When data file is loaded, only the position of the object's json text is stored.
+     *  The values are parsed by the JsonConfiguration::load() method, when the object is accessed first time.
+     */
+
+  struct Object
+  {
+    Class * m_class;
+    const std::string * m_id;
+    const std::string * m_file;
+
+    const char * m_begin;                                              // json text of object
+    const char * m_end;
+
+    bool m_loaded;
+    std::vector<Value> m_attributes;
+    std::vector<std::vector<std::pair<Class *, std::string>>> m_relationships;  // class and id of referenced objects
+  };
+
+
+    /// Describes class and stores its objects
+
+  struct Class
+  {
+    std::string m_name;
+    std::string m_description;
+    bool m_abstract;
+
+    std::vector<std::string> m_direct_superclasses;
+    std::vector<daq::config::attribute_t> m_direct_attributes;
+    std::vector<daq::config::relationship_t> m_direct_relationships;
+
+      // calculated when schema is linked
+
+    std::vector<Class *> m_superclasses;                     // all superclasses
+    std::vector<Class *> m_subclasses;                       // all subclasses
+    std::vector<daq::config::attribute_t> m_attributes;      // all attributes including inherited
+    std::vector<daq::config::relationship_t> m_relationships;// all relationships including inherited
+    std::vector<Value> m_default_values;                     // default values of all attributes
+    config::map<unsigned int> m_attribute_index;             // attribute name => slot
+    config::map<unsigned int> m_relationship_index;          // relationship name => slot
+
+    config::map<Object> m_objects;                           // object id => object
+
+    bool
+    is_subclass_of(const Class * c) const noexcept;
+  };
+
+}
+
+
+  /**
+   *  \brief Implements read-only configuration database using json files.
+   *
+   *  The database is read from the json files produced by the config_export_schema
+   *  and config_export_data utilities. The plug-in parameter is a colon-separated list of files;
+   *  the schema files are recognised by their contents and always loaded first.
+   *  Example: "jsonconfig:daq.schema.json:daq.data.json".
+   *
+   *  The data files are read into memory and scanned by a streaming parser, that only indexes
+   *  positions of objects. The values of an object are parsed when it is accessed first time,
+   *  and the relationships are resolved when they are read.
+   *
+   *  The database cannot be modified and there are no notifications.
+   *  The queries and paths are not supported.
+   */
+
+class JsonConfiguration : public ConfigurationImpl {
+
+  friend class JsonConfigObject;
+
+  public:
+
+    JsonConfiguration() noexcept;
+
+    virtual ~JsonConfiguration();
+
+
+  public:
+
+    virtual void open_db(const std::string& db_name);
+    virtual void close_db();
+    virtual bool loaded() const noexcept { return m_loaded; }
+    virtual void create(const std::string& db_name, const std::list<std::string>& includes);
+    virtual bool is_writable(const std::string& /*db_name*/) { return false; }
+    virtual void add_include(const std::string& db_name, const std::string& include);
+    virtual void remove_include(const std::string& db_name, const std::string& include);
+    virtual void get_includes(const std::string& db_name, std::list<std::string>& includes) const;
+    virtual void get_updated_dbs(std::list<std::string>& dbs) const;
+    virtual void set_commit_credentials(const std::string& user, const std::string& password);
+    virtual void commit(const std::string& log_message);
+    virtual void abort();
+    virtual void prefetch_all_data();
+    virtual std::vector<daq::config::Version> get_changes();
+    virtual std::vector<daq::config::Version> get_versions(const std::string& since, const std::string& until, daq::config::Version::QueryType type, bool skip_irrelevant);
+
+
+  public:
+
+    virtual void get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual void get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual void get(const ConfigObject& obj_from, const std::string& query, std::vector<ConfigObject>& objects, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual bool test_object(const std::string& class_name, const std::string& id, unsigned long rlevel, const std::vector<std::string> * rclasses);
+
+
+  public:
+
+    virtual void create(const std::string& at, const std::string& class_name, const std::string& id, ConfigObject& object);
+    virtual void create(const ConfigObject& at, const std::string& class_name, const std::string& id, ConfigObject& object);
+    virtual void destroy(ConfigObject& object);
+
+
+  public:
+
+    virtual daq::config::class_t * get(const std::string& class_name, bool direct_only);
+    virtual void get_superclasses(config::fmap<config::fset>& schema);
+
+
+  public:
+
+    virtual void subscribe(const std::set<std::string>& class_names, const std::map< std::string, std::set<std::string> >& objs, ConfigurationImpl::notify cb, ConfigurationImpl::pre_notify pre_cb);
+    virtual void unsubscribe();
+    virtual void print_profiling_info() noexcept;
+
+
+  protected:
+
+      /// Load schema from json produced by config_export_schema
+
+    void load_schema(const std::string& file_name, const std::string& text);
+
+      /// Calculate inheritance, attribute and relationship slots
+
+    void link_schema();
+
+      /// Index objects of json file produced by config_export_data
+
+    void index_data(const std::string& file_name, const std::string& text);
+
+      /// Parse values of object, if not yet done
+
+    void load(jsonconfig::Object& obj);
+
+      /// Return class by name or throw daq::config::NotFound
+
+    jsonconfig::Class& get_class(const std::string& name) const;
+
+      /// Find object of the class or its subclasses
+
+    jsonconfig::Object * find(const jsonconfig::Class& c, const std::string& id) const noexcept;
+
+      /// Get implementation object for the data object (the object is loaded, if necessary)
+
+    JsonConfigObject * get_impl(jsonconfig::Object * obj);
+
+      /// Raise exception for any modification
+
+    [[noreturn]] void throw_read_only(const char * what) const;
+
+
+  protected:
+
+    bool m_loaded;
+
+    std::map<std::string, std::unique_ptr<jsonconfig::Class>> m_classes;
+    std::map<std::string, std::string> m_files;                 // file name => contents
+    std::list<std::string> m_top_level_files;
+
+    unsigned long p_number_of_indexed_objects;
+    unsigned long p_number_of_loaded_objects;
+
+};
+
+#endif // JSONCONFIG_JSONCONFIGURATION_H_
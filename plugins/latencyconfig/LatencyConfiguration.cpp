@@ -0,0 +1,200 @@
+#include <stdlib.h>
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include "config/Configuration.hpp"
+#include "config/PluginRegistry.hpp"
+
+#include "LatencyConfiguration.hpp"
+
+
+  // to be used as plug-in
+
+extern "C" ConfigurationImpl * _latencyconfig_creator_ (const std::string& spec) {
+  try {
+    std::unique_ptr<LatencyConfiguration> impl(new LatencyConfiguration());
+    if(!spec.empty()) { impl->open_db(spec); }
+    return impl.release();
+  }
+  catch(daq::config::Exception& ex) {
+    throw daq::config::Generic(ERS_HERE, "latencyconfig initialization error", ex);
+  }
+  catch(...) {
+    throw daq::config::Generic(ERS_HERE, "latencyconfig initialization error:\n***** caught unknown exception *****");
+  }
+}
+
+CONFIG_REGISTER_PLUGIN(latencyconfig, _latencyconfig_creator_)
+
+
+LatencyConfiguration::LatencyConfiguration() noexcept :
+  m_rtt(0),
+  m_jitter(0),
+  m_bandwidth(0),
+  p_number_of_delayed_calls(0),
+  p_delay(0)
+{
+}
+
+LatencyConfiguration::~LatencyConfiguration()
+{
+  close_db();
+}
+
+
+static void
+throw_bad_parameter(const std::string& parameter, const char * reason)
+{
+  std::ostringstream text;
+  text << "bad parameter \"" << parameter << "\": " << reason;
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+static double
+str2number(const std::string& parameter, const std::string& value, std::string& suffix)
+{
+  const char * s = value.c_str();
+  char * end;
+
+  double number = strtod(s, &end);
+
+  if (end == s || number < 0)
+    throw_bad_parameter(parameter, "expect non-negative number");
+
+  suffix = end;
+
+  return number;
+}
+
+static std::chrono::nanoseconds
+str2duration(const std::string& parameter, const std::string& value)
+{
+  std::string unit;
+  double number = str2number(parameter, value, unit);
+
+  if (unit == "ns")
+    ;
+  else if (unit == "us")
+    number *= 1e3;
+  else if (unit == "ms" || unit.empty())
+    number *= 1e6;
+  else if (unit == "s")
+    number *= 1e9;
+  else
+    throw_bad_parameter(parameter, "expect ns, us, ms or s units");
+
+  return std::chrono::nanoseconds(static_cast<int64_t>(number));
+}
+
+static double
+str2bandwidth(const std::string& parameter, const std::string& value)
+{
+  std::string suffix;
+  double number = str2number(parameter, value, suffix);
+
+  if (suffix.empty())
+    ;
+  else if (suffix == "k")
+    number *= 1e3;
+  else if (suffix == "M")
+    number *= 1e6;
+  else if (suffix == "G")
+    number *= 1e9;
+  else
+    throw_bad_parameter(parameter, "expect k, M or G suffix");
+
+  return number;
+}
+
+void
+LatencyConfiguration::open_db(const std::string& spec_and_params)
+{
+  std::string::size_type idx = spec_and_params.find_last_of('?');
+
+  m_rtt = m_jitter = std::chrono::nanoseconds::zero();
+  m_bandwidth = 0;
+  m_random.seed(std::mt19937_64::default_seed);
+
+  if (idx != std::string::npos)
+    {
+      std::istringstream params(spec_and_params.substr(idx + 1));
+      std::string param;
+
+      while (std::getline(params, param, '&'))
+        {
+          if (param.empty())
+            continue;
+
+          std::string::size_type eq = param.find('=');
+
+          if (eq == std::string::npos)
+            throw_bad_parameter(param, "expect name=value");
+
+          const std::string name(param.substr(0, eq)), value(param.substr(eq + 1));
+
+          if (name == "rtt")
+            m_rtt = str2duration(param, value);
+          else if (name == "jitter")
+            m_jitter = str2duration(param, value);
+          else if (name == "bw")
+            m_bandwidth = str2bandwidth(param, value);
+          else if (name == "seed")
+            m_random.seed(strtoull(value.c_str(), nullptr, 0));
+          else
+            throw_bad_parameter(param, "expect rtt, jitter, bw or seed");
+        }
+    }
+
+  ProxyConfiguration::open_db(spec_and_params.substr(0, idx));
+
+  TLOG_DEBUG(1) << "emulate latency of database \"" << m_spec << "\": rtt = " << m_rtt.count() << " ns, jitter = " << m_jitter.count() << " ns, bandwidth = " << m_bandwidth << " B/s";
+}
+
+void
+LatencyConfiguration::called(config::proxy::CallType, const std::string&, const std::string&, const std::string&,
+                             uint64_t result_size, std::chrono::steady_clock::time_point, std::chrono::nanoseconds, bool) noexcept
+{
+  std::chrono::nanoseconds delay(m_rtt);
+
+  if (m_jitter.count() > 0)
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_random_mutex);
+      delay += std::chrono::nanoseconds(m_random() % (m_jitter.count() + 1));
+    }
+
+  if (m_bandwidth > 0)
+    delay += std::chrono::nanoseconds(static_cast<int64_t>(result_size * 1e9 / m_bandwidth));
+
+  if (delay.count() > 0)
+    {
+      std::this_thread::sleep_for(delay);
+      p_number_of_delayed_calls++;
+      p_delay += delay.count();
+    }
+}
+
+void
+LatencyConfiguration::print_profiling_info() noexcept
+{
+  std::cout <<
+    "LatencyConfiguration profiler report:\n"
+    "  round-trip time: " << m_rtt.count() / 1e6 << " ms\n"
+    "  jitter: " << m_jitter.count() / 1e6 << " ms\n"
+    "  bandwidth: ";
+
+  if (m_bandwidth > 0)
+    std::cout << m_bandwidth << " B/s\n";
+  else
+    std::cout << "unlimited\n";
+
+  std::cout <<
+    "  number of delayed calls: " << p_number_of_delayed_calls << "\n"
+    "  total injected delay: " << p_delay / 1e9 << " s" << std::endl;
+
+  ProxyConfiguration::print_profiling_info();
+}
@@ -0,0 +1,69 @@
+  /**
+   *  \file LatencyConfiguration.hpp This file contains LatencyConfiguration class,
+   *  that adds latency to calls of another config implementation.
+   *  \brief latency injecting config plug-in
+   */
+
+#ifndef LATENCYCONFIG_LATENCYCONFIGURATION_H_
+#define LATENCYCONFIG_LATENCYCONFIGURATION_H_
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <string>
+
+#include "config/ProxyConfiguration.hpp"
+
+
+  /**
+   *  \brief Emulates remote configuration database on top of any other implementation.
+   *
+   *  The plug-in parameter is the specification of the proxied database followed by optional parameters after '?' separated by '&', e.g.
+   *  "latencyconfig:jsonconfig:/tmp/setup.schema.json:/tmp/setup.data.json?rtt=2ms&jitter=500us&bw=10M".
+   *  The parameters are:
+   *  - rtt: round-trip time added to every call (the units are ns, us, ms or s; default is ms);
+   *  - jitter: maximum random delay uniformly distributed and added to the round-trip time;
+   *  - bw: bandwidth in bytes per second used to add transfer time of returned data (the k, M and G suffixes multiply by 10^3, 10^6 and 10^9);
+   *  - seed: seed of the jitter random generator (to reproduce sequence of delays).
+   *
+   *  The delay is added after the call of proxied implementation returns; the calls are not pipelined,
+   *  like synchronous calls of a remote server. It is the local stand-in to evaluate optimisations of round-trips.
+   */
+
+class LatencyConfiguration : public ProxyConfiguration {
+
+  public:
+
+    LatencyConfiguration() noexcept;
+
+    virtual ~LatencyConfiguration();
+
+
+  public:
+
+    virtual void open_db(const std::string& spec);
+    virtual void print_profiling_info() noexcept;
+
+
+  protected:
+
+    virtual void called(config::proxy::CallType type, const std::string& class_name, const std::string& id, const std::string& name,
+                        uint64_t result_size, std::chrono::steady_clock::time_point start, std::chrono::nanoseconds duration, bool failed) noexcept;
+
+
+  private:
+
+    std::chrono::nanoseconds m_rtt;
+    std::chrono::nanoseconds m_jitter;
+    double m_bandwidth;                   // bytes per second, 0 means unlimited
+
+    std::mutex m_random_mutex;
+    std::mt19937_64 m_random;
+
+    std::atomic<uint64_t> p_number_of_delayed_calls;
+    std::atomic<uint64_t> p_delay;        // total injected delay in nanoseconds
+
+};
+
+#endif // LATENCYCONFIG_LATENCYCONFIGURATION_H_
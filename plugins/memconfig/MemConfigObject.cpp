@@ -0,0 +1,418 @@
+#include <algorithm>
+#include <sstream>
+#include <type_traits>
+
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+
+#include "MemConfigObject.hpp"
+#include "MemConfiguration.hpp"
+
+
+MemConfigObject::MemConfigObject(memconfig::Object * obj, ConfigurationImpl * impl) noexcept :
+  ConfigObjectImpl(impl, obj->m_id),
+  m_obj(obj)
+{
+}
+
+MemConfigObject::~MemConfigObject() noexcept
+{
+}
+
+const std::string
+MemConfigObject::contained_in() const
+{
+  std::lock_guard<std::mutex> scoped_lock(m_mutex);
+  throw_if_deleted();
+  return *m_obj->m_file;
+}
+
+const daq::config::attribute_t&
+MemConfigObject::attribute(const std::string& name, unsigned int& slot) const
+{
+  auto i = m_obj->m_class->m_attribute_index.find(name);
+
+  if (i == m_obj->m_class->m_attribute_index.end())
+    {
+      std::ostringstream text;
+      text << "object " << m_obj->m_id << '@' << m_obj->m_class->m_name << " has no attribute \"" << name << '\"';
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  slot = i->second;
+  return m_obj->m_class->m_attributes[slot];
+}
+
+const daq::config::relationship_t&
+MemConfigObject::relationship(const std::string& name, unsigned int& slot) const
+{
+  auto i = m_obj->m_class->m_relationship_index.find(name);
+
+  if (i == m_obj->m_class->m_relationship_index.end())
+    {
+      std::ostringstream text;
+      text << "object " << m_obj->m_id << '@' << m_obj->m_class->m_name << " has no relationship \"" << name << '\"';
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  slot = i->second;
+  return m_obj->m_class->m_relationships[slot];
+}
+
+namespace
+{
+  template<class T> struct is_vector : std::false_type {};
+  template<class T> struct is_vector<std::vector<T>> : std::true_type {};
+
+    // assign value of the same type or convert between numeric types (like the oksconfig does)
+
+  template<class TO, class FROM>
+  bool
+  assign(TO& to, const FROM& from)
+  {
+    if constexpr (std::is_same<TO, FROM>::value)
+      {
+        to = from;
+        return true;
+      }
+    else if constexpr (std::is_arithmetic<TO>::value && std::is_arithmetic<FROM>::value)
+      {
+        to = static_cast<TO>(from);
+        return true;
+      }
+    else if constexpr (is_vector<TO>::value && is_vector<FROM>::value)
+      {
+        if constexpr (std::is_arithmetic<typename TO::value_type>::value && std::is_arithmetic<typename FROM::value_type>::value)
+          {
+            to.clear();
+            to.reserve(from.size());
+            for (const auto x : from)
+              to.push_back(static_cast<typename TO::value_type>(x));
+            return true;
+          }
+        else
+          return false;
+      }
+    else
+      return false;
+  }
+}
+
+template<class T>
+void
+MemConfigObject::get_value(const std::string& name, T& value)
+{
+  std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+  throw_if_deleted();
+
+  unsigned int slot;
+  const daq::config::attribute_t& a(attribute(name, slot));
+
+  if (!std::visit([&value](const auto& x) { return assign(value, x); }, m_obj->m_attributes[slot]))
+    {
+      std::ostringstream text;
+      text << "failed to get value of attribute \"" << name << "\" of object " << m_obj->m_id << '@' << m_obj->m_class->m_name
+           << ": value type does not match attribute type " << daq::config::attribute_t::type(a.p_type) << (a.p_is_multi_value ? " (multi-value)" : "");
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+}
+
+template<class T>
+void
+MemConfigObject::set_value(const std::string& name, const T& value, daq::config::type_t type)
+{
+  std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+  throw_if_deleted();
+
+  unsigned int slot;
+  const daq::config::attribute_t& a(attribute(name, slot));
+
+  memconfig::Value new_value(m_obj->m_attributes[slot]);
+
+  bool type_mismatch = !std::visit([&value](auto& x) { return assign(x, value); }, new_value);
+
+  // strings are also used to store values of enum, date, time and class attributes
+  if constexpr (std::is_same<T, std::string>::value || std::is_same<T, std::vector<std::string>>::value)
+    if (a.p_type != type)
+      type_mismatch = true;
+
+  if (type_mismatch)
+    {
+      std::ostringstream text;
+      text << "failed to set value of attribute \"" << name << "\" of object " << m_obj->m_id << '@' << m_obj->m_class->m_name
+           << ": value type does not match attribute type " << daq::config::attribute_t::type(a.p_type) << (a.p_is_multi_value ? " (multi-value)" : "");
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  db()->modify(m_obj);
+  m_obj->m_attributes[slot].swap(new_value);
+}
+
+void
+MemConfigObject::wrap(const std::vector<memconfig::Object *>& objs, std::vector<ConfigObject>& value) const
+{
+  value.clear();
+  value.reserve(objs.size());
+
+  std::lock_guard<std::mutex> scoped_lock(db()->get_conf_impl_mutex());
+
+  for (const auto& x : objs)
+    value.emplace_back(db()->get_impl(x));
+}
+
+void
+MemConfigObject::get(const std::string& name, ConfigObject& value)
+{
+  std::vector<memconfig::Object *> objs;
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+      throw_if_deleted();
+
+      unsigned int slot;
+      const daq::config::relationship_t& r(relationship(name, slot));
+
+      if (r.p_cardinality == daq::config::zero_or_many || r.p_cardinality == daq::config::one_or_many)
+        {
+          std::ostringstream text;
+          text << "failed to get single value of multi-value relationship \"" << name << "\" of object " << m_obj->m_id << '@' << m_obj->m_class->m_name;
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      for (const auto& x : m_obj->m_relationships[slot])
+        if (!x->m_deleted)
+          objs.push_back(x);
+    }
+
+  if (objs.empty())
+    {
+      value = ConfigObject();
+    }
+  else
+    {
+      std::lock_guard<std::mutex> scoped_lock(db()->get_conf_impl_mutex());
+      value = db()->get_impl(objs.front());
+    }
+}
+
+void
+MemConfigObject::get(const std::string& name, std::vector<ConfigObject>& value)
+{
+  std::vector<memconfig::Object *> objs;
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+      throw_if_deleted();
+
+      unsigned int slot;
+      const daq::config::relationship_t& r(relationship(name, slot));
+
+      if (r.p_cardinality == daq::config::zero_or_one || r.p_cardinality == daq::config::only_one)
+        {
+          std::ostringstream text;
+          text << "failed to get multiple values of single-value relationship \"" << name << "\" of object " << m_obj->m_id << '@' << m_obj->m_class->m_name;
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      for (const auto& x : m_obj->m_relationships[slot])
+        if (!x->m_deleted)
+          objs.push_back(x);
+    }
+
+  wrap(objs, value);
+}
+
+bool
+MemConfigObject::rel(const std::string& name, std::vector<ConfigObject>& value)
+{
+  std::vector<memconfig::Object *> objs;
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+      throw_if_deleted();
+
+      auto i = m_obj->m_class->m_relationship_index.find(name);
+
+      if (i == m_obj->m_class->m_relationship_index.end())
+        return false;
+
+      for (const auto& x : m_obj->m_relationships[i->second])
+        if (!x->m_deleted)
+          objs.push_back(x);
+    }
+
+  wrap(objs, value);
+
+  return true;
+}
+
+void
+MemConfigObject::referenced_by(std::vector<ConfigObject>& value, const std::string& association, bool check_composite_only, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/) const
+{
+  std::vector<memconfig::Object *> objs;
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+      throw_if_deleted();
+
+      // there is no reverse index: scan relationships of all objects
+
+      for (const auto& c : db()->m_classes)
+        for (unsigned int slot = 0; slot < c.second->m_relationships.size(); ++slot)
+          {
+            const daq::config::relationship_t& r(c.second->m_relationships[slot]);
+
+            if ((association != "*" && association != r.p_name) || (check_composite_only && !r.p_is_aggregation))
+              continue;
+
+            if (!m_obj->m_class->is_subclass_of(c.second->m_relationship_types[slot]))
+              continue;
+
+            for (auto& o : c.second->m_objects)
+              if (!o.m_deleted && std::find(o.m_relationships[slot].begin(), o.m_relationships[slot].end(), m_obj) != o.m_relationships[slot].end())
+                if (std::find(objs.begin(), objs.end(), &o) == objs.end())
+                  objs.push_back(&o);
+          }
+    }
+
+  wrap(objs, value);
+}
+
+memconfig::Object *
+MemConfigObject::get_object(const ConfigObject * value) const
+{
+  if (value == nullptr || value->is_null())
+    return nullptr;
+
+  const MemConfigObject * impl = dynamic_cast<const MemConfigObject *>(value->implementation());
+
+  if (impl == nullptr || impl->m_impl != m_impl)
+    {
+      std::ostringstream text;
+      text << "object " << value->full_name() << " does not belong to the same memconfig database";
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  impl->throw_if_deleted();
+
+  return impl->m_obj;
+}
+
+void
+MemConfigObject::set_relationship(const std::string& name, std::vector<memconfig::Object *>& value, bool skip_non_null_check)
+{
+  std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+  throw_if_deleted();
+
+  unsigned int slot;
+  const daq::config::relationship_t& r(relationship(name, slot));
+  const memconfig::Class * type = m_obj->m_class->m_relationship_types[slot];
+
+  if (value.empty() && !skip_non_null_check && (r.p_cardinality == daq::config::only_one || r.p_cardinality == daq::config::one_or_many))
+    {
+      std::ostringstream text;
+      text << "failed to set relationship \"" << name << "\" of object " << m_obj->m_id << '@' << m_obj->m_class->m_name << ": value cannot be null";
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  for (const auto& x : value)
+    if (!x->m_class->is_subclass_of(type))
+      {
+        std::ostringstream text;
+        text << "failed to set relationship \"" << name << "\" of object " << m_obj->m_id << '@' << m_obj->m_class->m_name << ": object "
+             << x->m_id << '@' << x->m_class->m_name << " is not of class " << type->m_name;
+        throw daq::config::Generic(ERS_HERE, text.str().c_str());
+      }
+
+  db()->modify(m_obj);
+  m_obj->m_relationships[slot].swap(value);
+}
+
+void
+MemConfigObject::set(const std::string& name, const ConfigObject * value, bool skip_non_null_check)
+{
+  std::vector<memconfig::Object *> objs;
+
+  if (memconfig::Object * obj = get_object(value))
+    objs.push_back(obj);
+
+  set_relationship(name, objs, skip_non_null_check);
+}
+
+void
+MemConfigObject::set(const std::string& name, const std::vector<const ConfigObject*>& value, bool skip_non_null_check)
+{
+  std::vector<memconfig::Object *> objs;
+  objs.reserve(value.size());
+
+  for (const auto& x : value)
+    if (memconfig::Object * obj = get_object(x))
+      objs.push_back(obj);
+
+  set_relationship(name, objs, skip_non_null_check);
+}
+
+void
+MemConfigObject::move(const std::string& at)
+{
+  std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+  throw_if_deleted();
+
+  auto file = db()->m_files.find(at);
+
+  if (file == db()->m_files.end())
+    {
+      std::ostringstream text;
+      text << "cannot move object " << m_obj->m_id << '@' << m_obj->m_class->m_name << " to file \"" << at << "\", that is not loaded";
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  db()->modify(m_obj);
+  m_obj->m_file = &*file;
+  db()->modify(m_obj);
+}
+
+// called by Configuration::rename_object() with locked object mutex
+
+void
+MemConfigObject::rename(const std::string& new_id)
+{
+  memconfig::Class& c(*m_obj->m_class);
+
+  if (db()->find(c, new_id) != nullptr || std::any_of(c.m_superclasses.begin(), c.m_superclasses.end(), [&](const memconfig::Class * x) { return db()->find(*x, new_id) != nullptr; }))
+    {
+      std::ostringstream text;
+      text << "cannot rename object " << m_obj->m_id << '@' << c.m_name << ": object with id \"" << new_id << "\" already exists";
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  db()->modify(m_obj);
+
+  c.m_index.erase(m_obj->m_id);
+  m_obj->m_id = new_id;
+  c.m_index[new_id] = m_obj;
+}
+
+void
+MemConfigObject::reset()
+{
+  memconfig::Object * obj = db()->find(db()->get_class(*m_class_name), m_id);
+
+  if (obj != nullptr)
+    {
+      m_obj = obj;
+      m_state = daq::config::Valid;
+    }
+  else
+    {
+      m_state = daq::config::Deleted;
+    }
+}
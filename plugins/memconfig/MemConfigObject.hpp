@@ -0,0 +1,142 @@
+  /**
+   *  \file MemConfigObject.hpp This file contains MemConfigObject class,
+   *  that is the in-memory implementation of the config object abstract interface.
+   *  \brief in-memory config object
+   */
+
+#ifndef MEMCONFIG_MEMCONFIGOBJECT_H_
+#define MEMCONFIG_MEMCONFIGOBJECT_H_
+
+#include <string>
+#include <vector>
+
+#include "config/ConfigObjectImpl.hpp"
+#include "config/Schema.hpp"
+
+#include "MemConfiguration.hpp"
+
+
+  /**
+   *  \brief Implements object of in-memory configuration database.
+   *
+   *  The object refers to the data stored by the MemConfiguration.
+   */
+
+class MemConfigObject : public ConfigObjectImpl {
+
+  friend class MemConfiguration;
+
+  public:
+
+    MemConfigObject(memconfig::Object * obj, ConfigurationImpl * impl) noexcept;
+
+    virtual ~MemConfigObject() noexcept;
+
+
+  public:
+
+    virtual const std::string contained_in() const;
+
+    virtual void get(const std::string& attribute, bool&           value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint8_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int8_t&         value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint16_t&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int16_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint32_t&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int32_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint64_t&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int64_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, float&          value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, double&         value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::string&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& association, ConfigObject& value);
+
+    virtual void get(const std::string& attribute, std::vector<bool>&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint8_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int8_t>&      value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint16_t>&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int16_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint32_t>&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int32_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint64_t>&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int64_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<float>&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<double>&      value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<std::string>& value) { get_value(attribute, value); }
+    virtual void get(const std::string& association, std::vector<ConfigObject>& value);
+
+    virtual bool rel(const std::string& name, std::vector<ConfigObject>& value);
+    virtual void referenced_by(std::vector<ConfigObject>& value, const std::string& association, bool check_composite_only, unsigned long rlevel, const std::vector<std::string> * rclasses) const;
+
+    virtual void set(const std::string& attribute, bool               value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, uint8_t            value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, int8_t             value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, uint16_t           value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, int16_t            value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, uint32_t           value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, int32_t            value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, uint64_t           value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, int64_t            value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, float              value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, double             value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::string& value) { set_value(attribute, value, daq::config::string_type); }
+
+    virtual void set_enum(const std::string& attribute, const std::string& value)  { set_value(attribute, value, daq::config::enum_type); }
+    virtual void set_date(const std::string& attribute, const std::string& value)  { set_value(attribute, value, daq::config::date_type); }
+    virtual void set_time(const std::string& attribute, const std::string& value)  { set_value(attribute, value, daq::config::time_type); }
+    virtual void set_class(const std::string& attribute, const std::string& value) { set_value(attribute, value, daq::config::class_type); }
+
+    virtual void set(const std::string& attribute, const std::vector<bool>&        value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<uint8_t>&     value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<int8_t>&      value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<uint16_t>&    value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<int16_t>&     value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<uint32_t>&    value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<int32_t>&     value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<uint64_t>&    value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<int64_t>&     value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<float>&       value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<double>&      value) { set_value(attribute, value); }
+    virtual void set(const std::string& attribute, const std::vector<std::string>& value) { set_value(attribute, value, daq::config::string_type); }
+
+    virtual void set_enum(const std::string& attribute, const std::vector<std::string>& value)  { set_value(attribute, value, daq::config::enum_type); }
+    virtual void set_date(const std::string& attribute, const std::vector<std::string>& value)  { set_value(attribute, value, daq::config::date_type); }
+    virtual void set_time(const std::string& attribute, const std::vector<std::string>& value)  { set_value(attribute, value, daq::config::time_type); }
+    virtual void set_class(const std::string& attribute, const std::vector<std::string>& value) { set_value(attribute, value, daq::config::class_type); }
+
+    virtual void set(const std::string& association, const ConfigObject * value, bool skip_non_null_check);
+    virtual void set(const std::string& association, const std::vector<const ConfigObject*>& value, bool skip_non_null_check);
+
+    virtual void move(const std::string& at);
+    virtual void rename(const std::string& new_id);
+
+    virtual void reset();
+
+
+  public:
+
+      /// Used by ConfigurationImpl::insert_object() when the implementation object is re-used
+
+    void set(memconfig::Object * obj) noexcept { m_obj = obj; }
+
+
+  private:
+
+    memconfig::Object * m_obj;
+
+    MemConfiguration * db() const noexcept { return static_cast<MemConfiguration *>(m_impl); }
+
+    const daq::config::attribute_t& attribute(const std::string& name, unsigned int& slot) const;
+    const daq::config::relationship_t& relationship(const std::string& name, unsigned int& slot) const;
+
+    template<class T> void get_value(const std::string& name, T& value);
+    template<class T> void set_value(const std::string& name, const T& value, daq::config::type_t type = daq::config::string_type);
+
+    void set_relationship(const std::string& name, std::vector<memconfig::Object *>& value, bool skip_non_null_check);
+    memconfig::Object * get_object(const ConfigObject * value) const;
+
+    void wrap(const std::vector<memconfig::Object *>& objs, std::vector<ConfigObject>& value) const;
+
+};
+
+#endif // MEMCONFIG_MEMCONFIGOBJECT_H_
@@ -0,0 +1,1255 @@
+#include <stdlib.h>
+
+#include <algorithm>
+#include <sstream>
+#include <type_traits>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include "config/Change.hpp"
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+#include "config/PluginRegistry.hpp"
+#include "config/DalFactory.hpp"
+
+#include "MemConfigObject.hpp"
+#include "MemConfiguration.hpp"
+
+
+  // to be used as plug-in
+
+extern "C" ConfigurationImpl * _memconfig_creator_ (const std::string& spec) {
+  try {
+    std::unique_ptr<MemConfiguration> impl(new MemConfiguration());
+    if(!spec.empty()) { impl->open_db(spec); }
+    return impl.release();
+  }
+  catch(daq::config::Exception& ex) {
+    throw daq::config::Generic(ERS_HERE, "memconfig initialization error", ex);
+  }
+  catch(...) {
+    throw daq::config::Generic(ERS_HERE, "memconfig initialization error:\n***** caught unknown exception *****");
+  }
+}
+
+CONFIG_REGISTER_PLUGIN(memconfig, _memconfig_creator_)
+
+
+namespace memconfig
+{
+
+  bool
+  Class::is_subclass_of(const Class * c) const noexcept
+  {
+    return (c == this || std::find(m_superclasses.begin(), m_superclasses.end(), c) != m_superclasses.end());
+  }
+
+
+  template<class T>
+  static T
+  str2val(const std::string& s)
+  {
+    if constexpr (std::is_same<T, std::string>::value)
+      return s;
+    else if constexpr (std::is_same<T, bool>::value)
+      return (s == "true" || s == "1" || s == "yes");
+    else if constexpr (std::is_floating_point<T>::value)
+      return static_cast<T>(strtod(s.c_str(), nullptr));
+    else if constexpr (std::is_signed<T>::value)
+      return static_cast<T>(strtoll(s.c_str(), nullptr, 0));
+    else
+      return static_cast<T>(strtoull(s.c_str(), nullptr, 0));
+  }
+
+  template<class T>
+  static Value
+  make(const daq::config::attribute_t& a, const std::string& value)
+  {
+    if (!a.p_is_multi_value)
+      return Value(std::in_place_type<T>, str2val<T>(value));
+
+    // the default value of multi-value attribute is a comma-separated list
+
+    std::vector<T> values;
+
+    if (!value.empty())
+      {
+        std::string::size_type pos = 0, next;
+
+        do
+          {
+            next = value.find(',', pos);
+            values.push_back(str2val<T>(value.substr(pos, next == std::string::npos ? std::string::npos : next - pos)));
+            pos = next + 1;
+          }
+        while (next != std::string::npos);
+      }
+
+    return Value(std::in_place_type<std::vector<T>>, std::move(values));
+  }
+
+  template<class T>
+  static Value
+  make(const daq::config::attribute_t& a, const boost::property_tree::ptree& node)
+  {
+    if (!a.p_is_multi_value)
+      return Value(std::in_place_type<T>, str2val<T>(node.data()));
+
+    // empty array is exported either as [] or as an empty string
+
+    std::vector<T> values;
+    values.reserve(node.size());
+
+    for (const auto& x : node)
+      values.push_back(str2val<T>(x.second.data()));
+
+    return Value(std::in_place_type<std::vector<T>>, std::move(values));
+  }
+
+  template<class S>
+  static Value
+  dispatch(const daq::config::attribute_t& a, const S& value)
+  {
+    switch (a.p_type)
+      {
+        case daq::config::bool_type:   return make<bool>(a, value);
+        case daq::config::s8_type:     return make<int8_t>(a, value);
+        case daq::config::u8_type:     return make<uint8_t>(a, value);
+        case daq::config::s16_type:    return make<int16_t>(a, value);
+        case daq::config::u16_type:    return make<uint16_t>(a, value);
+        case daq::config::s32_type:    return make<int32_t>(a, value);
+        case daq::config::u32_type:    return make<uint32_t>(a, value);
+        case daq::config::s64_type:    return make<int64_t>(a, value);
+        case daq::config::u64_type:    return make<uint64_t>(a, value);
+        case daq::config::float_type:  return make<float>(a, value);
+        case daq::config::double_type: return make<double>(a, value);
+        case daq::config::date_type:
+        case daq::config::time_type:
+        case daq::config::enum_type:
+        case daq::config::class_type:
+        case daq::config::string_type: return make<std::string>(a, value);
+        default: throw daq::config::Generic(ERS_HERE, std::string("invalid type of attribute \'" + a.p_name + '\'').c_str());
+      }
+  }
+
+  Value
+  make_value(const daq::config::attribute_t& a, const std::string& value)
+  {
+    return dispatch(a, value);
+  }
+
+  Value
+  make_value(const daq::config::attribute_t& a, const boost::property_tree::ptree& node)
+  {
+    return dispatch(a, node);
+  }
+
+}
+
+
+MemConfiguration::MemConfiguration() noexcept :
+  m_loaded(false),
+  m_cb(nullptr),
+  m_pre_cb(nullptr),
+  m_notify_stop(false)
+{
+}
+
+MemConfiguration::~MemConfiguration()
+{
+  stop_notify_thread();
+  close_db();
+}
+
+
+void
+MemConfiguration::open_db(const std::string& spec)
+{
+  std::vector<std::string> files;
+
+  std::string::size_type pos = 0, next;
+
+  do
+    {
+      next = spec.find(':', pos);
+      std::string file(spec, pos, next == std::string::npos ? std::string::npos : next - pos);
+      if (!file.empty())
+        files.push_back(file);
+      pos = next + 1;
+    }
+  while (next != std::string::npos);
+
+  load_files(files);
+
+  m_top_level_files.assign(files.begin(), files.end());
+
+  m_loaded = true;
+}
+
+void
+MemConfiguration::close_db()
+{
+  clean();
+
+  m_classes.clear();
+  m_files.clear();
+  m_includes.clear();
+  m_top_level_files.clear();
+  m_loaded_files.clear();
+  m_references.clear();
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_tx_mutex);
+      m_saved.clear();
+      m_created.clear();
+      m_updated_files.clear();
+      m_saved_includes.reset();
+      m_saved_top_level_files.reset();
+    }
+
+  m_loaded = false;
+}
+
+void
+MemConfiguration::load_files(const std::vector<std::string>& files)
+{
+  std::vector<std::pair<std::string, boost::property_tree::ptree>> data;
+
+  bool new_schema = false;
+
+  for (const auto& file : files)
+    {
+      if (m_loaded_files.find(file) != m_loaded_files.end())
+        continue;
+
+      boost::property_tree::ptree pt;
+
+      try
+        {
+          boost::property_tree::read_json(file, pt);
+        }
+      catch (const boost::property_tree::json_parser_error& ex)
+        {
+          std::ostringstream text;
+          text << "cannot read json file \"" << file << "\": " << ex.what();
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      m_loaded_files.insert(file);
+
+      // the config_export_schema writes "abstract" property of every class
+
+      bool is_schema = false;
+
+      if (!pt.empty())
+        if (auto abstract = pt.begin()->second.get_child_optional("abstract"))
+          is_schema = abstract->empty();
+
+      TLOG_DEBUG(1) << "load " << (is_schema ? "schema" : "data") << " file \'" << file << '\'';
+
+      if (is_schema)
+        {
+          load_schema(pt);
+          new_schema = true;
+        }
+      else
+        {
+          data.emplace_back(file, std::move(pt));
+        }
+    }
+
+  if (new_schema)
+    link_schema();
+
+  for (const auto& x : data)
+    load_data(x.first, x.second);
+
+  resolve_references();
+}
+
+void
+MemConfiguration::load_schema(const boost::property_tree::ptree& pt)
+{
+  for (const auto& x : pt)
+    {
+      std::unique_ptr<memconfig::Class>& c = m_classes[x.first];
+
+      if (c)
+        {
+          std::ostringstream text;
+          text << "class \"" << x.first << "\" is already defined";
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      c.reset(new memconfig::Class());
+
+      c->m_name = x.first;
+      c->m_description = x.second.get<std::string>("description", "");
+      c->m_abstract = x.second.get<bool>("abstract", false);
+
+      if (auto superclasses = x.second.get_child_optional("superclasses"))
+        for (const auto& s : *superclasses)
+          c->m_direct_superclasses.push_back(s.second.data());
+
+      if (auto attributes = x.second.get_child_optional("attributes"))
+        for (const auto& a : *attributes)
+          {
+            const std::string type(a.second.get<std::string>("type"));
+            const std::string format(a.second.get<std::string>("format", ""));
+
+            c->m_direct_attributes.emplace_back(
+              a.first,
+              daq::config::attribute_t::str2type(type),
+              a.second.get<std::string>("range", ""),
+              daq::config::attribute_t::str2format(format),
+              a.second.get<bool>("is-not-null", false),
+              a.second.get<bool>("is-multi-value", false),
+              a.second.get<std::string>("default-value", ""),
+              a.second.get<std::string>("description", "")
+            );
+          }
+
+      if (auto relationships = x.second.get_child_optional("relationships"))
+        for (const auto& r : *relationships)
+          {
+            daq::config::relationship_t rel;
+
+            rel.p_name = r.first;
+            rel.p_type = r.second.get<std::string>("type");
+            rel.p_cardinality = daq::config::relationship_t::str2card(r.second.get<std::string>("cardinality"));
+            rel.p_is_aggregation = r.second.get<bool>("is-aggregation", false);
+            rel.p_description = r.second.get<std::string>("description", "");
+
+            c->m_direct_relationships.push_back(rel);
+          }
+    }
+}
+
+memconfig::Class&
+MemConfiguration::get_class(const std::string& name) const
+{
+  auto i = m_classes.find(name);
+
+  if (i == m_classes.end())
+    throw daq::config::NotFound(ERS_HERE, "class", name.c_str());
+
+  return *i->second;
+}
+
+void
+MemConfiguration::link_schema()
+{
+  // resolve superclasses; the schema can be exported with all (not only direct) superclasses
+
+  std::map<memconfig::Class *, std::vector<memconfig::Class *>> listed;
+
+  for (auto& x : m_classes)
+    {
+      memconfig::Class * c = x.second.get();
+
+      c->m_superclasses.clear();
+      c->m_subclasses.clear();
+
+      for (const auto& s : c->m_direct_superclasses)
+        {
+          auto i = m_classes.find(s);
+
+          if (i == m_classes.end())
+            {
+              std::ostringstream text;
+              text << "cannot find superclass \"" << s << "\" of class \"" << c->m_name << '\"';
+              throw daq::config::Generic(ERS_HERE, text.str().c_str());
+            }
+
+          listed[c].push_back(i->second.get());
+        }
+    }
+
+  for (auto& x : m_classes)
+    {
+      memconfig::Class * c = x.second.get();
+
+      std::vector<memconfig::Class *> stack(listed[c].rbegin(), listed[c].rend());
+
+      while (!stack.empty())
+        {
+          memconfig::Class * s = stack.back();
+          stack.pop_back();
+
+          if (s == c)
+            {
+              std::ostringstream text;
+              text << "class \"" << c->m_name << "\" is derived from itself";
+              throw daq::config::Generic(ERS_HERE, text.str().c_str());
+            }
+
+          if (std::find(c->m_superclasses.begin(), c->m_superclasses.end(), s) == c->m_superclasses.end())
+            {
+              c->m_superclasses.push_back(s);
+              stack.insert(stack.end(), listed[s].rbegin(), listed[s].rend());
+            }
+        }
+
+      for (auto& s : c->m_superclasses)
+        s->m_subclasses.push_back(c);
+    }
+
+  // leave direct properties only
+
+  for (auto& x : m_classes)
+    {
+      memconfig::Class * c = x.second.get();
+
+      std::vector<std::string> superclasses;
+
+      for (const auto& s : listed[c])
+        if (std::none_of(listed[c].begin(), listed[c].end(), [s](const memconfig::Class * o) { return o != s && o->is_subclass_of(s); }))
+          superclasses.push_back(s->m_name);
+
+      c->m_direct_superclasses.swap(superclasses);
+    }
+
+  auto inherited = [](const memconfig::Class * c, const std::string& name, auto memconfig::Class::*list) {
+    for (const auto& s : c->m_superclasses)
+      for (const auto& p : s->*list)
+        if (p.p_name == name)
+          return true;
+    return false;
+  };
+
+  for (auto& x : m_classes)
+    {
+      memconfig::Class * c = x.second.get();
+
+      c->m_direct_attributes.erase(std::remove_if(c->m_direct_attributes.begin(), c->m_direct_attributes.end(), [&](const daq::config::attribute_t& a) { return inherited(c, a.p_name, &memconfig::Class::m_direct_attributes); }), c->m_direct_attributes.end());
+      c->m_direct_relationships.erase(std::remove_if(c->m_direct_relationships.begin(), c->m_direct_relationships.end(), [&](const daq::config::relationship_t& r) { return inherited(c, r.p_name, &memconfig::Class::m_direct_relationships); }), c->m_direct_relationships.end());
+    }
+
+  // calculate slots: inherited properties first, starting from the most generic superclass
+
+  for (auto& x : m_classes)
+    {
+      memconfig::Class * c = x.second.get();
+
+      c->m_attributes.clear();
+      c->m_relationships.clear();
+      c->m_relationship_types.clear();
+      c->m_attribute_index.clear();
+      c->m_relationship_index.clear();
+
+      std::vector<memconfig::Class *> hierarchy(c->m_superclasses.rbegin(), c->m_superclasses.rend());
+      hierarchy.push_back(c);
+
+      for (const auto& s : hierarchy)
+        {
+          for (const auto& a : s->m_direct_attributes)
+            if (c->m_attribute_index.emplace(a.p_name, c->m_attributes.size()).second)
+              c->m_attributes.push_back(a);
+
+          for (const auto& r : s->m_direct_relationships)
+            if (c->m_relationship_index.emplace(r.p_name, c->m_relationships.size()).second)
+              {
+                auto t = m_classes.find(r.p_type);
+
+                if (t == m_classes.end())
+                  {
+                    std::ostringstream text;
+                    text << "cannot find class \"" << r.p_type << "\" of relationship \"" << r.p_name << "\" of class \"" << c->m_name << '\"';
+                    throw daq::config::Generic(ERS_HERE, text.str().c_str());
+                  }
+
+                c->m_relationships.push_back(r);
+                c->m_relationship_types.push_back(t->second.get());
+              }
+        }
+
+      if (!c->m_objects.empty() && (c->m_objects.front().m_attributes.size() != c->m_attributes.size() || c->m_objects.front().m_relationships.size() != c->m_relationships.size()))
+        {
+          std::ostringstream text;
+          text << "schema of class \"" << c->m_name << "\" with objects cannot be changed";
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+    }
+}
+
+const std::string *
+MemConfiguration::add_file(const std::string& name)
+{
+  const std::string * file = &*m_files.insert(name).first;
+  m_includes[name];
+  return file;
+}
+
+memconfig::Object *
+MemConfiguration::find(const memconfig::Class& c, const std::string& id) const noexcept
+{
+  auto i = c.m_index.find(id);
+
+  if (i != c.m_index.end())
+    return i->second;
+
+  for (const auto& s : c.m_subclasses)
+    {
+      auto j = s->m_index.find(id);
+
+      if (j != s->m_index.end())
+        return j->second;
+    }
+
+  return nullptr;
+}
+
+memconfig::Object *
+MemConfiguration::add_object(memconfig::Class& c, const std::string& id, const std::string * file)
+{
+  memconfig::Object * obj = &c.m_objects.emplace_back();
+
+  obj->m_class = &c;
+  obj->m_id = id;
+  obj->m_file = file;
+  obj->m_deleted = false;
+
+  obj->m_attributes.reserve(c.m_attributes.size());
+
+  for (const auto& a : c.m_attributes)
+    obj->m_attributes.push_back(memconfig::make_value(a, a.p_default_value));
+
+  obj->m_relationships.resize(c.m_relationships.size());
+
+  c.m_index[id] = obj;
+
+  return obj;
+}
+
+void
+MemConfiguration::load_data(const std::string& file_name, const boost::property_tree::ptree& pt)
+{
+  const std::string * file = add_file(file_name);
+
+  for (const auto& x : pt)
+    {
+      memconfig::Class& c(get_class(x.first));
+
+      for (const auto& o : x.second)
+        {
+          if (find(c, o.first) != nullptr)
+            {
+              std::ostringstream text;
+              text << "object " << o.first << '@' << c.m_name << " from file \"" << file_name << "\" is already loaded";
+              throw daq::config::Generic(ERS_HERE, text.str().c_str());
+            }
+
+          memconfig::Object * obj = add_object(c, o.first, file);
+
+          for (unsigned int slot = 0; slot < c.m_attributes.size(); ++slot)
+            if (auto value = o.second.get_child_optional(boost::property_tree::ptree::path_type(c.m_attributes[slot].p_name, '\0')))
+              obj->m_attributes[slot] = memconfig::make_value(c.m_attributes[slot], *value);
+
+          for (unsigned int slot = 0; slot < c.m_relationships.size(); ++slot)
+            if (auto value = o.second.get_child_optional(boost::property_tree::ptree::path_type(c.m_relationships[slot].p_name, '\0')))
+              {
+                Reference ref { obj, slot, { } };
+
+                if (value->empty())
+                  {
+                    if (!value->data().empty())
+                      ref.m_values.push_back(value->data());
+                  }
+                else
+                  {
+                    for (const auto& v : *value)
+                      if (!v.second.data().empty())
+                        ref.m_values.push_back(v.second.data());
+                  }
+
+                if (!ref.m_values.empty())
+                  m_references.push_back(std::move(ref));
+              }
+        }
+    }
+}
+
+void
+MemConfiguration::resolve_references()
+{
+  for (auto& ref : m_references)
+    {
+      std::vector<memconfig::Object *>& values(ref.m_obj->m_relationships[ref.m_slot]);
+
+      for (const auto& v : ref.m_values)
+        {
+          std::string::size_type idx = v.rfind('@');
+
+          auto c = (idx != std::string::npos) ? m_classes.find(v.substr(idx + 1)) : m_classes.end();
+          memconfig::Object * obj = (c != m_classes.end()) ? find(*c->second, v.substr(0, idx)) : nullptr;
+
+          if (obj == nullptr)
+            {
+              std::ostringstream text;
+              text << "cannot resolve \"" << v << "\" referenced by relationship \"" << ref.m_obj->m_class->m_relationships[ref.m_slot].p_name
+                   << "\" of object " << ref.m_obj->m_id << '@' << ref.m_obj->m_class->m_name;
+              ers::warning(daq::config::Generic(ERS_HERE, text.str().c_str()));
+            }
+          else
+            {
+              values.push_back(obj);
+            }
+        }
+    }
+
+  m_references.clear();
+}
+
+void
+MemConfiguration::create(const std::string& db_name, const std::list<std::string>& includes)
+{
+  if (m_files.find(db_name) != m_files.end())
+    {
+      std::ostringstream text;
+      text << "file \"" << db_name << "\" already exists";
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  modify_includes();
+
+  add_file(db_name);
+  m_loaded_files.insert(db_name);
+  m_top_level_files.push_back(db_name);
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_tx_mutex);
+      m_updated_files.insert(db_name);
+    }
+
+  for (const auto& x : includes)
+    add_include(db_name, x);
+
+  m_loaded = true;
+}
+
+bool
+MemConfiguration::is_writable(const std::string& db_name)
+{
+  return (m_files.find(db_name) != m_files.end());
+}
+
+void
+MemConfiguration::add_include(const std::string& db_name, const std::string& include)
+{
+  auto i = m_includes.find(db_name);
+
+  if (i == m_includes.end())
+    {
+      std::ostringstream text;
+      text << "file \"" << db_name << "\" is not loaded";
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  load_files({ include });
+
+  if (std::find(i->second.begin(), i->second.end(), include) == i->second.end())
+    {
+      modify_includes();
+
+      i->second.push_back(include);
+      m_top_level_files.remove(include);
+
+      std::lock_guard<std::mutex> scoped_lock(m_tx_mutex);
+      m_updated_files.insert(db_name);
+    }
+}
+
+void
+MemConfiguration::remove_include(const std::string& db_name, const std::string& include)
+{
+  auto i = m_includes.find(db_name);
+
+  if (i != m_includes.end())
+    {
+      auto j = std::find(i->second.begin(), i->second.end(), include);
+
+      if (j != i->second.end())
+        {
+          modify_includes();
+
+          i->second.erase(j);
+
+            {
+              std::lock_guard<std::mutex> scoped_lock(m_tx_mutex);
+              m_updated_files.insert(db_name);
+            }
+
+          remove_unreachable_objects();
+        }
+    }
+}
+
+void
+MemConfiguration::get_includes(const std::string& db_name, std::list<std::string>& includes) const
+{
+  if (db_name.empty())
+    {
+      includes = m_top_level_files;
+      return;
+    }
+
+  auto i = m_includes.find(db_name);
+
+  if (i != m_includes.end())
+    includes = i->second;
+  else
+    includes.clear();
+}
+
+void
+MemConfiguration::get_updated_dbs(std::list<std::string>& dbs) const
+{
+  std::lock_guard<std::mutex> scoped_lock(m_tx_mutex);
+  dbs.assign(m_updated_files.begin(), m_updated_files.end());
+}
+
+void
+MemConfiguration::set_commit_credentials(const std::string& /*user*/, const std::string& /*password*/)
+{
+}
+
+void
+MemConfiguration::modify(memconfig::Object * obj)
+{
+  std::lock_guard<std::mutex> scoped_lock(m_tx_mutex);
+
+  if (m_created.find(obj) == m_created.end())
+    {
+      std::unique_ptr<memconfig::Object>& saved = m_saved[obj];
+
+      if (!saved)
+        saved.reset(new memconfig::Object(*obj));
+    }
+
+  m_updated_files.insert(*obj->m_file);
+}
+
+void
+MemConfiguration::modify_includes()
+{
+  std::lock_guard<std::mutex> scoped_lock(m_tx_mutex);
+
+  if (!m_saved_includes)
+    {
+      m_saved_includes.reset(new std::map<std::string, std::list<std::string>>(m_includes));
+      m_saved_top_level_files.reset(new std::list<std::string>(m_top_level_files));
+    }
+}
+
+void
+MemConfiguration::remove_object(memconfig::Object * obj, bool composite_children)
+{
+  modify(obj);
+
+  obj->m_class->m_index.erase(obj->m_id);
+  obj->m_deleted = true;
+
+  if (ConfigObjectImpl * impl = get_impl_object(obj->m_class->m_name, obj->m_id))
+    {
+      MemConfigObject * p = static_cast<MemConfigObject *>(impl);
+      std::lock_guard<std::mutex> scoped_lock(p->m_mutex);
+      p->m_state = daq::config::Deleted;
+    }
+
+  if (!composite_children)
+    return;
+
+  auto has_composite_parent = [this](const memconfig::Object * child) {
+    for (const auto& c : m_classes)
+      for (unsigned int slot = 0; slot < c.second->m_relationships.size(); ++slot)
+        if (c.second->m_relationships[slot].p_is_aggregation && child->m_class->is_subclass_of(c.second->m_relationship_types[slot]))
+          for (const auto& x : c.second->m_index)
+            if (std::find(x.second->m_relationships[slot].begin(), x.second->m_relationships[slot].end(), child) != x.second->m_relationships[slot].end())
+              return true;
+    return false;
+  };
+
+  for (unsigned int slot = 0; slot < obj->m_class->m_relationships.size(); ++slot)
+    if (obj->m_class->m_relationships[slot].p_is_aggregation)
+      for (const auto& x : obj->m_relationships[slot])
+        if (!x->m_deleted && !has_composite_parent(x))
+          remove_object(x, true);
+}
+
+void
+MemConfiguration::remove_unreachable_objects()
+{
+  std::set<std::string> reachable;
+  std::vector<const std::string *> stack;
+
+  for (const auto& x : m_top_level_files)
+    stack.push_back(&x);
+
+  while (!stack.empty())
+    {
+      const std::string * file = stack.back();
+      stack.pop_back();
+
+      if (reachable.insert(*file).second)
+        {
+          auto i = m_includes.find(*file);
+          if (i != m_includes.end())
+            for (const auto& x : i->second)
+              stack.push_back(&x);
+        }
+    }
+
+  std::vector<memconfig::Object *> objs;
+
+  for (const auto& c : m_classes)
+    for (const auto& x : c.second->m_index)
+      if (reachable.find(*x.second->m_file) == reachable.end())
+        objs.push_back(x.second);
+
+  TLOG_DEBUG(2) << "remove " << objs.size() << " objects from files which are not included";
+
+  for (const auto& x : objs)
+    remove_object(x, false);
+}
+
+std::vector<std::string>
+MemConfiguration::get_modified_attributes(const memconfig::Object& before, const memconfig::Object& after)
+{
+  std::vector<std::string> names;
+
+  for (unsigned int slot = 0; slot < after.m_attributes.size(); ++slot)
+    if (after.m_attributes[slot] != before.m_attributes[slot])
+      names.push_back(after.m_class->m_attributes[slot].p_name);
+
+  for (unsigned int slot = 0; slot < after.m_relationships.size(); ++slot)
+    if (after.m_relationships[slot] != before.m_relationships[slot])
+      names.push_back(after.m_class->m_relationships[slot].p_name);
+
+  return names;
+}
+
+void
+MemConfiguration::commit(const std::string& /*log_message*/)
+{
+  std::vector<ConfigurationChange *> changes;
+
+    {
+      ConfigurationChangeBuilder builder;
+
+      std::lock_guard<std::mutex> scoped_lock1(m_tx_mutex);
+      std::lock_guard<std::mutex> scoped_lock2(m_notify_mutex);
+
+      for (const auto& x : m_created)
+        if (!x->m_deleted && is_subscribed(*x))
+          builder.add(x->m_class->m_name, x->m_id, '+');
+
+      for (const auto& x : m_saved)
+        {
+          const memconfig::Object& before(*x.second);
+          const memconfig::Object& after(*x.first);
+
+          if (after.m_deleted)
+            {
+              if (is_subscribed(before))
+                builder.add(before.m_class->m_name, before.m_id, '-');
+            }
+          else if (after.m_id != before.m_id)
+            {
+              if (is_subscribed(before))
+                builder.add(before.m_class->m_name, before.m_id, '-');
+
+              if (is_subscribed(after))
+                builder.add(after.m_class->m_name, after.m_id, '+');
+            }
+          else if (is_subscribed(after))
+            {
+              builder.add(after.m_class->m_name, after.m_id, get_modified_attributes(before, after));
+            }
+        }
+
+      builder.build(changes);
+
+      m_saved.clear();
+      m_created.clear();
+      m_updated_files.clear();
+      m_saved_includes.reset();
+      m_saved_top_level_files.reset();
+    }
+
+  if (!changes.empty())
+    notify_changes(changes);
+}
+
+void
+MemConfiguration::abort()
+{
+  std::lock_guard<std::mutex> scoped_lock(m_tx_mutex);
+
+  for (const auto& x : m_created)
+    {
+      auto i = x->m_class->m_index.find(x->m_id);
+
+      if (i != x->m_class->m_index.end() && i->second == x)
+        x->m_class->m_index.erase(i);
+
+      x->m_deleted = true;
+    }
+
+  for (auto& x : m_saved)
+    {
+      memconfig::Object& obj(*x.first);
+
+      auto i = obj.m_class->m_index.find(obj.m_id);
+
+      if (i != obj.m_class->m_index.end() && i->second == &obj)
+        obj.m_class->m_index.erase(i);
+
+      obj = *x.second;
+
+      if (!obj.m_deleted)
+        obj.m_class->m_index[obj.m_id] = &obj;
+    }
+
+  if (m_saved_includes)
+    {
+      m_includes.swap(*m_saved_includes);
+      m_top_level_files.swap(*m_saved_top_level_files);
+      m_saved_includes.reset();
+      m_saved_top_level_files.reset();
+    }
+
+  m_saved.clear();
+  m_created.clear();
+  m_updated_files.clear();
+}
+
+std::vector<daq::config::Version>
+MemConfiguration::get_changes()
+{
+  return std::vector<daq::config::Version>();
+}
+
+std::vector<daq::config::Version>
+MemConfiguration::get_versions(const std::string& /*since*/, const std::string& /*until*/, daq::config::Version::QueryType /*type*/, bool /*skip_irrelevant*/)
+{
+  return std::vector<daq::config::Version>();
+}
+
+MemConfigObject *
+MemConfiguration::get_impl(memconfig::Object * obj)
+{
+  return insert_object<MemConfigObject>(obj, obj->m_id, obj->m_class->m_name);
+}
+
+void
+MemConfiguration::get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/)
+{
+  memconfig::Object * obj = find(get_class(class_name), id);
+
+  if (obj == nullptr)
+    throw daq::config::NotFound(ERS_HERE, "object", std::string(id + '@' + class_name).c_str());
+
+  object = get_impl(obj);
+}
+
+void
+MemConfiguration::get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/)
+{
+  if (!query.empty())
+    {
+      std::ostringstream text;
+      text << "memconfig does not support queries (\"" << query << "\")";
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  memconfig::Class& c(get_class(class_name));
+
+  objects.clear();
+
+  auto add = [&](const memconfig::Class& x) {
+    for (const auto& o : x.m_index)
+      objects.emplace_back(get_impl(o.second));
+  };
+
+  add(c);
+
+  for (const auto& s : c.m_subclasses)
+    add(*s);
+}
+
+void
+MemConfiguration::get(const ConfigObject& /*obj_from*/, const std::string& query, std::vector<ConfigObject>& /*objects*/, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/)
+{
+  std::ostringstream text;
+  text << "memconfig does not support path queries (\"" << query << "\")";
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+bool
+MemConfiguration::test_object(const std::string& class_name, const std::string& id, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/)
+{
+  return (find(get_class(class_name), id) != nullptr);
+}
+
+void
+MemConfiguration::create(const std::string& at, const std::string& class_name, const std::string& id, ConfigObject& object)
+{
+  auto file = m_files.find(at);
+
+  if (file == m_files.end())
+    {
+      std::ostringstream text;
+      text << "file \"" << at << "\" is not loaded";
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  memconfig::Class& c(get_class(class_name));
+
+  if (c.m_abstract)
+    {
+      std::ostringstream text;
+      text << "cannot create object of abstract class \"" << class_name << '\"';
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  if (find(c, id) != nullptr || std::any_of(c.m_superclasses.begin(), c.m_superclasses.end(), [&](const memconfig::Class * x) { return find(*x, id) != nullptr; }))
+    {
+      std::ostringstream text;
+      text << "object " << id << '@' << class_name << " already exists";
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  memconfig::Object * obj = add_object(c, id, &*file);
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_tx_mutex);
+      m_created.insert(obj);
+      m_updated_files.insert(at);
+    }
+
+  object = get_impl(obj);
+}
+
+void
+MemConfiguration::create(const ConfigObject& at, const std::string& class_name, const std::string& id, ConfigObject& object)
+{
+  create(at.contained_in(), class_name, id, object);
+}
+
+void
+MemConfiguration::destroy(ConfigObject& object)
+{
+  const MemConfigObject * impl = dynamic_cast<const MemConfigObject *>(object.implementation());
+
+  if (impl == nullptr || impl->m_impl != this)
+    throw daq::config::Generic(ERS_HERE, "object does not belong to the memconfig database");
+
+  impl->throw_if_deleted();
+
+  remove_object(impl->m_obj, true);
+}
+
+daq::config::class_t *
+MemConfiguration::get(const std::string& class_name, bool direct_only)
+{
+  const memconfig::Class& c(get_class(class_name));
+
+  daq::config::class_t * d = new daq::config::class_t(c.m_name, c.m_description, c.m_abstract);
+
+  std::vector<std::string>& superclasses(const_cast<std::vector<std::string>&>(d->p_superclasses));
+  std::vector<std::string>& subclasses(const_cast<std::vector<std::string>&>(d->p_subclasses));
+
+  if (direct_only)
+    {
+      superclasses = c.m_direct_superclasses;
+
+      for (const auto& s : c.m_subclasses)
+        if (std::find(s->m_direct_superclasses.begin(), s->m_direct_superclasses.end(), c.m_name) != s->m_direct_superclasses.end())
+          subclasses.push_back(s->m_name);
+
+      const_cast<std::vector<daq::config::attribute_t>&>(d->p_attributes) = c.m_direct_attributes;
+      const_cast<std::vector<daq::config::relationship_t>&>(d->p_relationships) = c.m_direct_relationships;
+    }
+  else
+    {
+      for (const auto& s : c.m_superclasses)
+        superclasses.push_back(s->m_name);
+
+      for (const auto& s : c.m_subclasses)
+        subclasses.push_back(s->m_name);
+
+      const_cast<std::vector<daq::config::attribute_t>&>(d->p_attributes) = c.m_attributes;
+      const_cast<std::vector<daq::config::relationship_t>&>(d->p_relationships) = c.m_relationships;
+    }
+
+  return d;
+}
+
+void
+MemConfiguration::get_superclasses(config::fmap<config::fset>& schema)
+{
+  schema.clear();
+
+  for (const auto& x : m_classes)
+    {
+      config::fset& superclasses = schema[&DalFactory::instance().get_known_class_name_ref(x.first)];
+
+      for (const auto& s : x.second->m_superclasses)
+        superclasses.insert(&DalFactory::instance().get_known_class_name_ref(s->m_name));
+    }
+}
+
+
+bool
+MemConfiguration::is_subscribed(const memconfig::Object& obj) const noexcept
+{
+  if (m_cb == nullptr)
+    return false;
+
+  if (m_subscribed_classes.empty() && m_subscribed_objects.empty())
+    return true;
+
+  auto test = [&](const memconfig::Class * c) {
+    if (m_subscribed_classes.find(c->m_name) != m_subscribed_classes.end())
+      return true;
+
+    auto i = m_subscribed_objects.find(c->m_name);
+    return (i != m_subscribed_objects.end() && i->second.find(obj.m_id) != i->second.end());
+  };
+
+  return (test(obj.m_class) || std::any_of(obj.m_class->m_superclasses.begin(), obj.m_class->m_superclasses.end(), test));
+}
+
+void
+MemConfiguration::subscribe(const std::set<std::string>& class_names, const std::map< std::string, std::set<std::string> >& objs, ConfigurationImpl::notify cb, ConfigurationImpl::pre_notify pre_cb)
+{
+  std::lock_guard<std::mutex> scoped_lock(m_notify_mutex);
+
+  m_subscribed_classes = class_names;
+  m_subscribed_objects = objs;
+  m_cb = cb;
+  m_pre_cb = pre_cb;
+
+  if (!m_notify_thread.joinable())
+    {
+      m_notify_stop = false;
+      m_notify_thread = std::thread(&MemConfiguration::notify_thread, this);
+    }
+}
+
+  // the notification thread is not joined here: it may wait for a lock held by the caller
+
+void
+MemConfiguration::unsubscribe()
+{
+  std::lock_guard<std::mutex> scoped_lock(m_notify_mutex);
+
+  m_subscribed_classes.clear();
+  m_subscribed_objects.clear();
+  m_cb = nullptr;
+  m_pre_cb = nullptr;
+
+  for (auto& x : m_notify_queue)
+    ConfigurationChange::clear(x);
+
+  m_notify_queue.clear();
+}
+
+void
+MemConfiguration::notify_changes(std::vector<ConfigurationChange *>& changes)
+{
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_notify_mutex);
+      m_notify_queue.emplace_back();
+      m_notify_queue.back().swap(changes);
+    }
+
+  m_notify_cond.notify_one();
+}
+
+void
+MemConfiguration::notify_thread()
+{
+  std::unique_lock<std::mutex> lock(m_notify_mutex);
+
+  while (true)
+    {
+      m_notify_cond.wait(lock, [this] { return m_notify_stop || !m_notify_queue.empty(); });
+
+      if (m_notify_stop)
+        break;
+
+      std::vector<ConfigurationChange *> changes;
+      changes.swap(m_notify_queue.front());
+      m_notify_queue.pop_front();
+
+      ConfigurationImpl::notify cb = m_cb;
+      ConfigurationImpl::pre_notify pre_cb = m_pre_cb;
+
+      lock.unlock();
+
+      try
+        {
+          if (pre_cb)
+            (*pre_cb)(m_conf);
+
+          if (cb)
+            (*cb)(changes, m_conf);
+        }
+      catch (const ers::Issue& ex)
+        {
+          ers::error(daq::config::Generic(ERS_HERE, "notification callback failed", ex));
+        }
+      catch (const std::exception& ex)
+        {
+          ers::error(daq::config::Generic(ERS_HERE, "notification callback failed", ex));
+        }
+
+      ConfigurationChange::clear(changes);
+
+      lock.lock();
+    }
+}
+
+void
+MemConfiguration::stop_notify_thread()
+{
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_notify_mutex);
+      m_notify_stop = true;
+
+      for (auto& x : m_notify_queue)
+        ConfigurationChange::clear(x);
+
+      m_notify_queue.clear();
+    }
+
+  m_notify_cond.notify_one();
+
+  if (m_notify_thread.joinable())
+    m_notify_thread.join();
+}
+
+void
+MemConfiguration::print_profiling_info() noexcept
+{
+  std::cout << "MemConfiguration profiler report:\n";
+
+  unsigned long num_of_classes(0), num_of_objects(0);
+
+  for (const auto& x : m_classes)
+    {
+      num_of_classes++;
+      num_of_objects += x.second->m_index.size();
+    }
+
+  std::cout <<
+    "  number of classes: " << num_of_classes << "\n"
+    "  number of objects: " << num_of_objects << "\n"
+    "  number of files: " << m_files.size() << std::endl;
+
+  print_cache_info();
+}
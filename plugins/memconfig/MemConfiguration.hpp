@@ -0,0 +1,308 @@
+  /**
+   *  \file MemConfiguration.hpp This file contains MemConfiguration class,
+   *  that is the in-memory implementation of the config abstract interface.
+   *  \brief in-memory config plug-in
+   */
+
+#ifndef MEMCONFIG_MEMCONFIGURATION_H_
+#define MEMCONFIG_MEMCONFIGURATION_H_
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include "config/ConfigurationImpl.hpp"
+#include "config/Schema.hpp"
+#include "config/map.hpp"
+
+class MemConfigObject;
+
+namespace memconfig
+{
+
+    /// The value of an attribute; the alternative is defined by the attribute type
+
+  typedef std::variant<
+    bool, uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, uint64_t, int64_t, float, double, std::string,
+    std::vector<bool>, std::vector<uint8_t>, std::vector<int8_t>, std::vector<uint16_t>, std::vector<int16_t>,
+    std::vector<uint32_t>, std::vector<int32_t>, std::vector<uint64_t>, std::vector<int64_t>,
+    std::vector<float>, std::vector<double>, std::vector<std::string>
+  > Value;
+
+  struct Object;
+
+
+    /**
+     *  \brief Describes class and stores its objects.
+     *
+     *  The objects are stored in a deque, so pointers to them remain valid for the life of the database;
+     *  removed objects are marked as deleted and are only dropped from the hash index.
+     *  The attributes and relationships of objects are stored in slots, which
+     *  positions are defined by the attribute and relationship indices of the class.
+     */
+
+  struct Class
+  {
+    std::string m_name;
+    std::string m_description;
+    bool m_abstract;
+
+    std::vector<std::string> m_direct_superclasses;
+    std::vector<daq::config::attribute_t> m_direct_attributes;
+    std::vector<daq::config::relationship_t> m_direct_relationships;
+
+      // calculated when schema is linked
+
+    std::vector<Class *> m_superclasses;                     // all superclasses
+    std::vector<Class *> m_subclasses;                       // all subclasses
+    std::vector<daq::config::attribute_t> m_attributes;      // all attributes including inherited
+    std::vector<daq::config::relationship_t> m_relationships;// all relationships including inherited
+    std::vector<Class *> m_relationship_types;               // class of each relationship
+    config::map<unsigned int> m_attribute_index;             // attribute name => slot
+    config::map<unsigned int> m_relationship_index;          // relationship name => slot
+
+      // data
+
+    std::deque<Object> m_objects;
+    config::map<Object *> m_index;                           // object id => object
+
+    bool
+    is_subclass_of(const Class * c) const noexcept;
+  };
+
+
+    /// The object data
+
+  struct Object
+  {
+    Class * m_class;
+    std::string m_id;
+    const std::string * m_file;
+    std::vector<Value> m_attributes;
+    std::vector<std::vector<Object *>> m_relationships;
+    bool m_deleted;
+  };
+
+
+    /// Convert string to attribute value of given type (used to parse json data and default values)
+
+  Value
+  make_value(const daq::config::attribute_t& a, const std::string& value);
+
+    /// Convert json node to attribute value of given type
+
+  Value
+  make_value(const daq::config::attribute_t& a, const boost::property_tree::ptree& node);
+
+}
+
+
+  /**
+   *  \brief Implements in-memory configuration database.
+   *
+   *  The database is initialised from the json files produced by the config_export_schema
+   *  and config_export_data utilities. The plug-in parameter is a colon-separated list of files;
+   *  the schema files are recognised by their contents and always loaded first.
+   *  Example: "memconfig:daq.schema.json:daq.data.json".
+   *  The files can be included by the files created in memory; the objects of a file,
+   *  which is not included any more, are removed.
+   *
+   *  The objects can be created, modified and destroyed. The changes are kept in memory:
+   *  the commit() notifies subscribers (reporting the names of modified attributes and relationships)
+   *  and the abort() restores the last committed state.
+   *  The notification is delivered asynchronously by a dedicated thread.
+   *
+   *  The queries and paths are not supported.
+   */
+
+class MemConfiguration : public ConfigurationImpl {
+
+  friend class MemConfigObject;
+
+  public:
+
+    MemConfiguration() noexcept;
+
+    virtual ~MemConfiguration();
+
+
+  public:
+
+    virtual void open_db(const std::string& db_name);
+    virtual void close_db();
+    virtual bool loaded() const noexcept { return m_loaded; }
+    virtual void create(const std::string& db_name, const std::list<std::string>& includes);
+    virtual bool is_writable(const std::string& db_name);
+    virtual void add_include(const std::string& db_name, const std::string& include);
+    virtual void remove_include(const std::string& db_name, const std::string& include);
+    virtual void get_includes(const std::string& db_name, std::list<std::string>& includes) const;
+    virtual void get_updated_dbs(std::list<std::string>& dbs) const;
+    virtual void set_commit_credentials(const std::string& user, const std::string& password);
+    virtual void commit(const std::string& log_message);
+    virtual void abort();
+    virtual void prefetch_all_data() { ; }
+    virtual std::vector<daq::config::Version> get_changes();
+    virtual std::vector<daq::config::Version> get_versions(const std::string& since, const std::string& until, daq::config::Version::QueryType type, bool skip_irrelevant);
+
+
+  public:
+
+    virtual void get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual void get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual void get(const ConfigObject& obj_from, const std::string& query, std::vector<ConfigObject>& objects, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual bool test_object(const std::string& class_name, const std::string& id, unsigned long rlevel, const std::vector<std::string> * rclasses);
+
+
+  public:
+
+    virtual void create(const std::string& at, const std::string& class_name, const std::string& id, ConfigObject& object);
+    virtual void create(const ConfigObject& at, const std::string& class_name, const std::string& id, ConfigObject& object);
+    virtual void destroy(ConfigObject& object);
+
+
+  public:
+
+    virtual daq::config::class_t * get(const std::string& class_name, bool direct_only);
+    virtual void get_superclasses(config::fmap<config::fset>& schema);
+
+
+  public:
+
+    virtual void subscribe(const std::set<std::string>& class_names, const std::map< std::string, std::set<std::string> >& objs, ConfigurationImpl::notify cb, ConfigurationImpl::pre_notify pre_cb);
+    virtual void unsubscribe();
+    virtual void print_profiling_info() noexcept;
+
+
+  protected:
+
+      /// Load schema from json produced by config_export_schema (classes are linked by the link_schema())
+
+    void load_schema(const boost::property_tree::ptree& pt);
+
+      /// Load objects from json produced by config_export_data (relationships are resolved by the resolve_references())
+
+    void load_data(const std::string& file_name, const boost::property_tree::ptree& pt);
+
+      /// Calculate inheritance, attribute and relationship slots
+
+    void link_schema();
+
+      /// Set values of relationships read by the load_data()
+
+    void resolve_references();
+
+      /// Load json files (the schema files first)
+
+    void load_files(const std::vector<std::string>& files);
+
+      /// Return class by name or throw daq::config::NotFound
+
+    memconfig::Class& get_class(const std::string& name) const;
+
+      /// Find object of the class or its subclasses
+
+    memconfig::Object * find(const memconfig::Class& c, const std::string& id) const noexcept;
+
+      /// Add new object with default values of attributes
+
+    memconfig::Object * add_object(memconfig::Class& c, const std::string& id, const std::string * file);
+
+      /// Register file and return pointer to stored name
+
+    const std::string * add_file(const std::string& name);
+
+      /// Get implementation object for the data object
+
+    MemConfigObject * get_impl(memconfig::Object * obj);
+
+      /// Save committed state of object before modification
+
+    void modify(memconfig::Object * obj);
+
+      /// Save committed state of includes before modification
+
+    void modify_includes();
+
+      /// Destroy object and, if requested, its composite children, which have no other composite parents
+
+    void remove_object(memconfig::Object * obj, bool composite_children);
+
+      /// Destroy objects from files, which are not included any more
+
+    void remove_unreachable_objects();
+
+      /// Return names of attributes and relationships having different values in saved and modified object
+
+    static std::vector<std::string> get_modified_attributes(const memconfig::Object& before, const memconfig::Object& after);
+
+      /// Return true if object is of class or it's subclass
+
+    static bool test_class(const memconfig::Object * obj, const std::string& class_name) noexcept;
+
+
+  protected:
+
+    bool m_loaded;
+
+    std::map<std::string, std::unique_ptr<memconfig::Class>> m_classes;
+    std::set<std::string> m_files;
+    std::map<std::string, std::list<std::string>> m_includes;
+    std::list<std::string> m_top_level_files;
+    std::set<std::string> m_loaded_files;
+
+      // relationship values read from json data: object, slot, list of "id@class" references
+
+    struct Reference {
+      memconfig::Object * m_obj;
+      unsigned int m_slot;
+      std::vector<std::string> m_values;
+    };
+
+    std::vector<Reference> m_references;
+
+
+      // uncommitted changes
+
+    mutable std::mutex m_tx_mutex;
+    std::map<memconfig::Object *, std::unique_ptr<memconfig::Object>> m_saved;
+    std::set<memconfig::Object *> m_created;
+    std::set<std::string> m_updated_files;
+    std::unique_ptr<std::map<std::string, std::list<std::string>>> m_saved_includes;
+    std::unique_ptr<std::list<std::string>> m_saved_top_level_files;
+
+
+      // notification
+
+  private:
+
+    std::set<std::string> m_subscribed_classes;
+    std::map< std::string, std::set<std::string> > m_subscribed_objects;
+    ConfigurationImpl::notify m_cb;
+    ConfigurationImpl::pre_notify m_pre_cb;
+
+    std::mutex m_notify_mutex;
+    std::condition_variable m_notify_cond;
+    std::deque<std::vector<ConfigurationChange *>> m_notify_queue;
+    std::thread m_notify_thread;
+    bool m_notify_stop;
+
+    bool is_subscribed(const memconfig::Object& obj) const noexcept;
+    void notify_changes(std::vector<ConfigurationChange *>& changes);
+    void notify_thread();
+    void stop_notify_thread();
+
+};
+
+#endif // MEMCONFIG_MEMCONFIGURATION_H_
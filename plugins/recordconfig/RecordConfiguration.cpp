@@ -0,0 +1,87 @@
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <iostream>
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include "config/Configuration.hpp"
+#include "config/PluginRegistry.hpp"
+
+#include "RecordConfiguration.hpp"
+
+
+  // to be used as plug-in
+
+extern "C" ConfigurationImpl * _recordconfig_creator_ (const std::string& spec) {
+  try {
+    std::unique_ptr<RecordConfiguration> impl(new RecordConfiguration());
+    if(!spec.empty()) { impl->open_db(spec); }
+    return impl.release();
+  }
+  catch(daq::config::Exception& ex) {
+    throw daq::config::Generic(ERS_HERE, "recordconfig initialization error", ex);
+  }
+  catch(...) {
+    throw daq::config::Generic(ERS_HERE, "recordconfig initialization error:\n***** caught unknown exception *****");
+  }
+}
+
+CONFIG_REGISTER_PLUGIN(recordconfig, _recordconfig_creator_)
+
+
+RecordConfiguration::~RecordConfiguration()
+{
+  close_db();
+}
+
+void
+RecordConfiguration::open_db(const std::string& spec)
+{
+  close_db();
+
+  ProxyConfiguration::open_db(spec);
+
+  std::string file_name;
+
+  if (const char * s = getenv("TDAQ_DB_TRACE_FILE"))
+    file_name = s;
+  else
+    file_name = "config-" + std::to_string(getpid()) + ".trace";
+
+  m_writer.reset(new config::trace::Writer(file_name, spec));
+
+  TLOG_DEBUG(1) << "record calls of database \"" << spec << "\" to trace file \"" << file_name << '\"';
+}
+
+void
+RecordConfiguration::close_db()
+{
+  m_writer.reset();
+  ProxyConfiguration::close_db();
+}
+
+void
+RecordConfiguration::called(config::proxy::CallType type, const std::string& class_name, const std::string& id, const std::string& name,
+                            uint64_t result_size, std::chrono::steady_clock::time_point start, std::chrono::nanoseconds duration, bool failed) noexcept
+{
+  if (m_writer)
+    m_writer->add(type, class_name, id, name, result_size, start, duration, failed);
+}
+
+void
+RecordConfiguration::print_profiling_info() noexcept
+{
+  std::cout << "RecordConfiguration profiler report:\n";
+
+  if (m_writer)
+    {
+      m_writer->flush();
+      std::cout <<
+        "  trace file: \"" << m_writer->get_file_name() << "\"\n"
+        "  number of recorded calls: " << m_writer->get_number_of_calls() << std::endl;
+    }
+
+  ProxyConfiguration::print_profiling_info();
+}
@@ -0,0 +1,53 @@
+  /**
+   *  \file RecordConfiguration.hpp This file contains RecordConfiguration class,
+   *  that records calls of another config implementation.
+   *  \brief recording config plug-in
+   */
+
+#ifndef RECORDCONFIG_RECORDCONFIGURATION_H_
+#define RECORDCONFIG_RECORDCONFIGURATION_H_
+
+#include <memory>
+#include <string>
+
+#include "config/ProxyConfiguration.hpp"
+#include "config/Trace.hpp"
+
+
+  /**
+   *  \brief Records calls of proxied configuration database into binary trace.
+   *
+   *  The plug-in parameter is the specification of the proxied database, e.g. "recordconfig:oksconfig:daq/partitions/test.data.xml".
+   *  Every call of the database and of its objects is recorded with arguments, size of returned data and latency
+   *  (see config::trace for format description). The trace can be replayed against another database by the config_replay utility.
+   *
+   *  The trace file is defined by the TDAQ_DB_TRACE_FILE environment variable (by default config-<pid>.trace in current directory).
+   */
+
+class RecordConfiguration : public ProxyConfiguration {
+
+  public:
+
+    virtual ~RecordConfiguration();
+
+
+  public:
+
+    virtual void open_db(const std::string& spec);
+    virtual void close_db();
+    virtual void print_profiling_info() noexcept;
+
+
+  protected:
+
+    virtual void called(config::proxy::CallType type, const std::string& class_name, const std::string& id, const std::string& name,
+                        uint64_t result_size, std::chrono::steady_clock::time_point start, std::chrono::nanoseconds duration, bool failed) noexcept;
+
+
+  private:
+
+    std::unique_ptr<config::trace::Writer> m_writer;
+
+};
+
+#endif // RECORDCONFIG_RECORDCONFIGURATION_H_
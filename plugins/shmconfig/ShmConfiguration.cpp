@@ -0,0 +1,106 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include "ers/ers.hpp"
+
+#include "config/Configuration.hpp"
+#include "config/PluginRegistry.hpp"
+
+#include "ShmConfiguration.hpp"
+
+
+  // to be used as plug-in
+
+extern "C" ConfigurationImpl * _shmconfig_creator_ (const std::string& spec) {
+  try {
+    std::unique_ptr<ShmConfiguration> impl(new ShmConfiguration());
+    if(!spec.empty()) { impl->open_db(spec); }
+    return impl.release();
+  }
+  catch(daq::config::Exception& ex) {
+    throw daq::config::Generic(ERS_HERE, "shmconfig initialization error", ex);
+  }
+  catch(...) {
+    throw daq::config::Generic(ERS_HERE, "shmconfig initialization error:\n***** caught unknown exception *****");
+  }
+}
+
+CONFIG_REGISTER_PLUGIN(shmconfig, _shmconfig_creator_)
+
+
+  // return true, if the magic of snapshot is written; the publish() writes it after all other data
+
+static bool
+is_published(int fd)
+{
+  struct stat st;
+
+  if (fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < sizeof(config::snapshot::Header))
+    return false;
+
+  void * data = mmap(nullptr, sizeof(config::snapshot::Header), PROT_READ, MAP_SHARED, fd, 0);
+
+  if (data == MAP_FAILED)
+    return false;
+
+  const char zero[sizeof(config::snapshot::Header::m_magic)] = {};
+  const bool published(memcmp(static_cast<const config::snapshot::Header *>(data)->m_magic, zero, sizeof(zero)) != 0);
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  munmap(data, sizeof(config::snapshot::Header));
+
+  return published;
+}
+
+void
+ShmConfiguration::open_db(const std::string& shm_name)
+{
+  close_db();
+
+  // The publish() replaces the segment in steps: the old segment is removed, the new one is created, resized and filled.
+  // Retry, while the segment is missing or is not completely written; on timeout the errors are reported as usual.
+
+  const std::chrono::milliseconds retry_interval(1);
+  const std::chrono::milliseconds missing_timeout(10);     // the old segment is removed just before new one is created
+  const std::chrono::milliseconds publish_timeout(10000);  // the big snapshot is copied for a while
+
+  const auto start = std::chrono::steady_clock::now();
+
+  while (true)
+    {
+      int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+
+      const auto elapsed = std::chrono::steady_clock::now() - start;
+
+      if (fd < 0)
+        {
+          if (errno == ENOENT && elapsed < missing_timeout)
+            {
+              std::this_thread::sleep_for(retry_interval);
+              continue;
+            }
+
+          std::ostringstream text;
+          text << "cannot open shared memory segment \"" << shm_name << "\": " << strerror(errno);
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      if (elapsed >= publish_timeout || is_published(fd))
+        {
+          map(fd, shm_name);
+          return;
+        }
+
+      ::close(fd);
+      std::this_thread::sleep_for(retry_interval);
+    }
+}
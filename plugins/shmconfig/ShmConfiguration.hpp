@@ -0,0 +1,34 @@
+  /**
+   *  \file ShmConfiguration.hpp This file contains ShmConfiguration class,
+   *  that is the read-only implementation of the config abstract interface using shared memory.
+   *  \brief shared memory config plug-in
+   */
+
+#ifndef SHMCONFIG_SHMCONFIGURATION_H_
+#define SHMCONFIG_SHMCONFIGURATION_H_
+
+#include <string>
+
+#include "SnapConfiguration.hpp"
+
+
+  /**
+   *  \brief Implements read-only configuration database using snapshot published in POSIX shared memory.
+   *
+   *  The plug-in parameter is the name of shared memory segment, e.g. "shmconfig:/daq-config".
+   *  The segment is published by the config::snapshot::Writer::publish() method (see config_snapshot utility).
+   *  The snapshot uses offsets only, so all processes of the node attach the same physical memory read-only
+   *  at any address and read the objects without parsing. Publishing of new segment does not affect
+   *  the processes, which already attached previous one. The process opening the segment while it is
+   *  being replaced waits until the new segment is published.
+   */
+
+class ShmConfiguration : public SnapConfiguration {
+
+  public:
+
+    virtual void open_db(const std::string& shm_name);
+
+};
+
+#endif // SHMCONFIG_SHMCONFIGURATION_H_
@@ -0,0 +1,402 @@
+#include <algorithm>
+#include <sstream>
+#include <type_traits>
+
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+
+#include "SnapConfigObject.hpp"
+#include "SnapConfiguration.hpp"
+
+
+SnapConfigObject::SnapConfigObject(uint64_t ref, ConfigurationImpl * impl) noexcept :
+  ConfigObjectImpl(impl, static_cast<SnapConfiguration *>(impl)->str(static_cast<SnapConfiguration *>(impl)->get_object_rec(ref).m_id)),
+  m_ref(ref)
+{
+}
+
+SnapConfigObject::~SnapConfigObject() noexcept
+{
+}
+
+const std::string
+SnapConfigObject::contained_in() const
+{
+  return db()->str(db()->at<uint32_t>(db()->m_header->m_files)[db()->get_object_rec(m_ref).m_file]);
+}
+
+const config::snapshot::Attribute&
+SnapConfigObject::attribute(const std::string& name, unsigned int& idx) const
+{
+  const SnapConfiguration::ClassInfo& c(db()->m_classes[class_idx()]);
+
+  auto i = c.m_attribute_index.find(name);
+
+  if (i == c.m_attribute_index.end())
+    {
+      std::ostringstream text;
+      text << "object " << m_id << '@' << c.m_name << " has no attribute \"" << name << '\"';
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  idx = i->second;
+  return db()->at<config::snapshot::Attribute>(c.m_class->m_attributes)[idx];
+}
+
+const config::snapshot::Relationship&
+SnapConfigObject::relationship(const std::string& name, unsigned int& idx) const
+{
+  const SnapConfiguration::ClassInfo& c(db()->m_classes[class_idx()]);
+
+  auto i = c.m_relationship_index.find(name);
+
+  if (i == c.m_relationship_index.end())
+    {
+      std::ostringstream text;
+      text << "object " << m_id << '@' << c.m_name << " has no relationship \"" << name << '\"';
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  idx = i->second;
+  return db()->at<config::snapshot::Relationship>(c.m_class->m_relationships)[idx - c.m_class->m_attributes_count];
+}
+
+namespace
+{
+  template<class T> struct is_vector : std::false_type {};
+  template<class T> struct is_vector<std::vector<T>> : std::true_type {};
+
+    // assign value of the same type or convert between numeric types (like the oksconfig does)
+
+  template<class TO, class FROM>
+  bool
+  assign(TO& to, FROM& from)
+  {
+    if constexpr (std::is_same<TO, FROM>::value)
+      {
+        to = std::move(from);
+        return true;
+      }
+    else if constexpr (std::is_arithmetic<TO>::value && std::is_arithmetic<FROM>::value)
+      {
+        to = static_cast<TO>(from);
+        return true;
+      }
+    else if constexpr (is_vector<TO>::value && is_vector<FROM>::value)
+      {
+        if constexpr (std::is_arithmetic<typename TO::value_type>::value && std::is_arithmetic<typename FROM::value_type>::value)
+          {
+            to.clear();
+            to.reserve(from.size());
+            for (const auto x : from)
+              to.push_back(static_cast<typename TO::value_type>(x));
+            return true;
+          }
+        else
+          return false;
+      }
+    else
+      return false;
+  }
+
+    // size of value in the snapshot: bool is stored as uint8_t and strings as uint32_t string reference
+
+  template<class S>
+  constexpr size_t
+  stored_size()
+  {
+    if constexpr (std::is_same<S, bool>::value)
+      return sizeof(uint8_t);
+    else if constexpr (std::is_same<S, std::string>::value)
+      return sizeof(uint32_t);
+    else
+      return sizeof(S);
+  }
+}
+
+  // read value of type S stored in the slot and assign it to the value of type T
+
+template<class S, class T>
+bool
+SnapConfigObject::read(unsigned int idx, bool multi_value, T& value) const
+{
+  auto load = [this](const char * p) -> S {
+    if constexpr (std::is_same<S, bool>::value)
+      {
+        return (*reinterpret_cast<const uint8_t *>(p) != 0);
+      }
+    else if constexpr (std::is_same<S, std::string>::value)
+      {
+        uint32_t ref;
+        memcpy(&ref, p, sizeof(ref));
+        return db()->str(ref);
+      }
+    else
+      {
+        S v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+      }
+  };
+
+  if (!multi_value)
+    {
+      S v(load(db()->get_slot(m_ref, idx)));
+      return assign(value, v);
+    }
+  else
+    {
+      uint64_t count;
+      const char * p = db()->get_array(m_ref, idx, count);
+
+      if constexpr (std::is_same<T, std::vector<S>>::value)
+        {
+          value.clear();
+          value.reserve(count);
+
+          for (uint64_t i = 0; i < count; ++i)
+            value.push_back(load(p + i * stored_size<S>()));
+
+          return true;
+        }
+      else if constexpr (is_vector<T>::value)
+        {
+          std::vector<S> v;
+          v.reserve(count);
+
+          for (uint64_t i = 0; i < count; ++i)
+            v.push_back(load(p + i * stored_size<S>()));
+
+          return assign(value, v);
+        }
+      else
+        {
+          return false;
+        }
+    }
+}
+
+template<class T>
+void
+SnapConfigObject::get_value(const std::string& name, T& value)
+{
+  unsigned int idx;
+  const config::snapshot::Attribute& a(attribute(name, idx));
+
+  const bool multi_value = (a.m_flags & config::snapshot::Attribute::multi_value_flag);
+  bool result;
+
+  switch (a.m_type)
+    {
+      case daq::config::bool_type:   result = read<bool>(idx, multi_value, value);     break;
+      case daq::config::s8_type:     result = read<int8_t>(idx, multi_value, value);   break;
+      case daq::config::u8_type:     result = read<uint8_t>(idx, multi_value, value);  break;
+      case daq::config::s16_type:    result = read<int16_t>(idx, multi_value, value);  break;
+      case daq::config::u16_type:    result = read<uint16_t>(idx, multi_value, value); break;
+      case daq::config::s32_type:    result = read<int32_t>(idx, multi_value, value);  break;
+      case daq::config::u32_type:    result = read<uint32_t>(idx, multi_value, value); break;
+      case daq::config::s64_type:    result = read<int64_t>(idx, multi_value, value);  break;
+      case daq::config::u64_type:    result = read<uint64_t>(idx, multi_value, value); break;
+      case daq::config::float_type:  result = read<float>(idx, multi_value, value);    break;
+      case daq::config::double_type: result = read<double>(idx, multi_value, value);   break;
+      default:                       result = read<std::string>(idx, multi_value, value);
+    }
+
+  if (!result)
+    {
+      std::ostringstream text;
+      text << "failed to get value of attribute \"" << name << "\" of object " << m_id << '@' << *m_class_name
+           << ": value type does not match attribute type " << daq::config::attribute_t::type(static_cast<daq::config::type_t>(a.m_type)) << (multi_value ? " (multi-value)" : "");
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+}
+
+void
+SnapConfigObject::get_refs(unsigned int idx, std::vector<uint64_t>& refs) const
+{
+  uint64_t count;
+  const char * p = db()->get_array(m_ref, idx, count);
+
+  refs.resize(count);
+
+  if (count)
+    memcpy(refs.data(), p, sizeof(uint64_t) * count);
+}
+
+void
+SnapConfigObject::wrap(const std::vector<uint64_t>& refs, std::vector<ConfigObject>& value) const
+{
+  value.clear();
+  value.reserve(refs.size());
+
+  std::lock_guard<std::mutex> scoped_lock(db()->get_conf_impl_mutex());
+
+  for (const auto& x : refs)
+    value.emplace_back(db()->get_impl(x));
+}
+
+void
+SnapConfigObject::get(const std::string& name, ConfigObject& value)
+{
+  unsigned int idx;
+  const config::snapshot::Relationship& r(relationship(name, idx));
+
+  if (r.m_cardinality == daq::config::zero_or_many || r.m_cardinality == daq::config::one_or_many)
+    {
+      std::ostringstream text;
+      text << "failed to get single value of multi-value relationship \"" << name << "\" of object " << m_id << '@' << *m_class_name;
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  uint64_t count;
+  const char * p = db()->get_array(m_ref, idx, count);
+
+  if (count == 0)
+    {
+      value = ConfigObject();
+    }
+  else
+    {
+      uint64_t ref;
+      memcpy(&ref, p, sizeof(ref));
+
+      std::lock_guard<std::mutex> scoped_lock(db()->get_conf_impl_mutex());
+      value = db()->get_impl(ref);
+    }
+}
+
+void
+SnapConfigObject::get(const std::string& name, std::vector<ConfigObject>& value)
+{
+  unsigned int idx;
+  const config::snapshot::Relationship& r(relationship(name, idx));
+
+  if (r.m_cardinality == daq::config::zero_or_one || r.m_cardinality == daq::config::only_one)
+    {
+      std::ostringstream text;
+      text << "failed to get multiple values of single-value relationship \"" << name << "\" of object " << m_id << '@' << *m_class_name;
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  std::vector<uint64_t> refs;
+  get_refs(idx, refs);
+  wrap(refs, value);
+}
+
+bool
+SnapConfigObject::rel(const std::string& name, std::vector<ConfigObject>& value)
+{
+  const SnapConfiguration::ClassInfo& c(db()->m_classes[class_idx()]);
+
+  auto i = c.m_relationship_index.find(name);
+
+  if (i == c.m_relationship_index.end())
+    return false;
+
+  std::vector<uint64_t> refs;
+  get_refs(i->second, refs);
+  wrap(refs, value);
+
+  return true;
+}
+
+void
+SnapConfigObject::referenced_by(std::vector<ConfigObject>& value, const std::string& association, bool check_composite_only, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/) const
+{
+  const config::snapshot::Class& this_class(db()->get_class_rec(class_idx()));
+  const uint32_t * superclasses = db()->at<uint32_t>(this_class.m_superclasses);
+
+  auto is_subclass_of = [&](uint32_t c) {
+    return (c == class_idx() || std::any_of(superclasses, superclasses + this_class.m_superclasses_count, [c](uint32_t x) { return (x & ~config::snapshot::direct_class_bit) == c; }));
+  };
+
+  std::vector<uint64_t> refs;
+
+  // there is no reverse index: scan relationships of all objects
+
+  for (uint32_t c = 0; c < db()->m_classes.size(); ++c)
+    {
+      const config::snapshot::Class& rec(db()->get_class_rec(c));
+      const config::snapshot::Relationship * relationships = db()->at<config::snapshot::Relationship>(rec.m_relationships);
+
+      for (uint32_t j = 0; j < rec.m_relationships_count; ++j)
+        {
+          const config::snapshot::Relationship& r(relationships[j]);
+
+          if (check_composite_only && !(r.m_flags & config::snapshot::Relationship::aggregation_flag))
+            continue;
+
+          if (association != "*")
+            {
+              uint32_t len;
+              const char * s = db()->str(r.m_name, len);
+              if (association.size() != len || association.compare(0, len, s, len) != 0)
+                continue;
+            }
+
+          if (!is_subclass_of(r.m_type))
+            continue;
+
+          for (uint32_t o = 0; o < rec.m_objects_count; ++o)
+            {
+              const uint64_t ref = config::snapshot::make_ref(c, o);
+              uint64_t count;
+              const char * p = db()->get_array(ref, rec.m_attributes_count + j, count);
+
+              for (uint64_t k = 0; k < count; ++k)
+                if (!memcmp(p + k * sizeof(uint64_t), &m_ref, sizeof(uint64_t)))
+                  {
+                    if (std::find(refs.begin(), refs.end(), ref) == refs.end())
+                      refs.push_back(ref);
+                    break;
+                  }
+            }
+        }
+    }
+
+  wrap(refs, value);
+}
+
+void
+SnapConfigObject::throw_read_only(const std::string& name) const
+{
+  std::ostringstream text;
+  text << "cannot set \"" << name << "\" of object " << m_id << '@' << *m_class_name << ": snapshot database is read-only";
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+void
+SnapConfigObject::set(const std::string& name, const ConfigObject * /*value*/, bool /*skip_non_null_check*/)
+{
+  throw_read_only(name);
+}
+
+void
+SnapConfigObject::set(const std::string& name, const std::vector<const ConfigObject*>& /*value*/, bool /*skip_non_null_check*/)
+{
+  throw_read_only(name);
+}
+
+void
+SnapConfigObject::move(const std::string& /*at*/)
+{
+  std::ostringstream text;
+  text << "cannot move object " << m_id << '@' << *m_class_name << ": snapshot database is read-only";
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+void
+SnapConfigObject::rename(const std::string& /*new_id*/)
+{
+  std::ostringstream text;
+  text << "cannot rename object " << m_id << '@' << *m_class_name << ": snapshot database is read-only";
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+  // the snapshot data are never changed
+
+void
+SnapConfigObject::reset()
+{
+  m_state = daq::config::Valid;
+}
@@ -0,0 +1,147 @@
+  /**
+   *  \file SnapConfigObject.hpp This file contains SnapConfigObject class,
+   *  that is the snapshot implementation of the config object abstract interface.
+   *  \brief snapshot config object
+   */
+
+#ifndef SNAPCONFIG_SNAPCONFIGOBJECT_H_
+#define SNAPCONFIG_SNAPCONFIGOBJECT_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "config/ConfigObjectImpl.hpp"
+#include "config/Schema.hpp"
+
+#include "SnapConfiguration.hpp"
+
+
+  /**
+   *  \brief Implements object of snapshot configuration database.
+   *
+   *  The object refers to the data of the file mapped by the SnapConfiguration.
+   *  The data are never changed, so the values are read without locking.
+   */
+
+class SnapConfigObject : public ConfigObjectImpl {
+
+  friend class SnapConfiguration;
+
+  public:
+
+    SnapConfigObject(uint64_t ref, ConfigurationImpl * impl) noexcept;
+
+    virtual ~SnapConfigObject() noexcept;
+
+
+  public:
+
+    virtual const std::string contained_in() const;
+
+    virtual void get(const std::string& attribute, bool&           value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint8_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int8_t&         value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint16_t&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int16_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint32_t&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int32_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, uint64_t&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, int64_t&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, float&          value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, double&         value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::string&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& association, ConfigObject& value);
+
+    virtual void get(const std::string& attribute, std::vector<bool>&        value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint8_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int8_t>&      value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint16_t>&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int16_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint32_t>&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int32_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<uint64_t>&    value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<int64_t>&     value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<float>&       value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<double>&      value) { get_value(attribute, value); }
+    virtual void get(const std::string& attribute, std::vector<std::string>& value) { get_value(attribute, value); }
+    virtual void get(const std::string& association, std::vector<ConfigObject>& value);
+
+    virtual bool rel(const std::string& name, std::vector<ConfigObject>& value);
+    virtual void referenced_by(std::vector<ConfigObject>& value, const std::string& association, bool check_composite_only, unsigned long rlevel, const std::vector<std::string> * rclasses) const;
+
+    virtual void set(const std::string& attribute, bool               /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, uint8_t            /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, int8_t             /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, uint16_t           /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, int16_t            /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, uint32_t           /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, int32_t            /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, uint64_t           /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, int64_t            /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, float              /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, double             /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::string& /*value*/) { throw_read_only(attribute); }
+
+    virtual void set_enum(const std::string& attribute, const std::string& /*value*/)  { throw_read_only(attribute); }
+    virtual void set_date(const std::string& attribute, const std::string& /*value*/)  { throw_read_only(attribute); }
+    virtual void set_time(const std::string& attribute, const std::string& /*value*/)  { throw_read_only(attribute); }
+    virtual void set_class(const std::string& attribute, const std::string& /*value*/) { throw_read_only(attribute); }
+
+    virtual void set(const std::string& attribute, const std::vector<bool>&        /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<uint8_t>&     /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<int8_t>&      /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<uint16_t>&    /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<int16_t>&     /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<uint32_t>&    /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<int32_t>&     /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<uint64_t>&    /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<int64_t>&     /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<float>&       /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<double>&      /*value*/) { throw_read_only(attribute); }
+    virtual void set(const std::string& attribute, const std::vector<std::string>& /*value*/) { throw_read_only(attribute); }
+
+    virtual void set_enum(const std::string& attribute, const std::vector<std::string>& /*value*/)  { throw_read_only(attribute); }
+    virtual void set_date(const std::string& attribute, const std::vector<std::string>& /*value*/)  { throw_read_only(attribute); }
+    virtual void set_time(const std::string& attribute, const std::vector<std::string>& /*value*/)  { throw_read_only(attribute); }
+    virtual void set_class(const std::string& attribute, const std::vector<std::string>& /*value*/) { throw_read_only(attribute); }
+
+    virtual void set(const std::string& association, const ConfigObject * value, bool skip_non_null_check);
+    virtual void set(const std::string& association, const std::vector<const ConfigObject*>& value, bool skip_non_null_check);
+
+    virtual void move(const std::string& at);
+    virtual void rename(const std::string& new_id);
+
+    virtual void reset();
+
+
+  public:
+
+      /// Used by ConfigurationImpl::insert_object() when the implementation object is re-used
+
+    void set(uint64_t ref) noexcept { m_ref = ref; }
+
+
+  private:
+
+    uint64_t m_ref;   // the class index and the object index
+
+    SnapConfiguration * db() const noexcept { return static_cast<SnapConfiguration *>(m_impl); }
+
+    uint32_t class_idx() const noexcept { return (m_ref >> 32); }
+
+    const config::snapshot::Attribute& attribute(const std::string& name, unsigned int& idx) const;
+    const config::snapshot::Relationship& relationship(const std::string& name, unsigned int& idx) const;
+
+    template<class T> void get_value(const std::string& name, T& value);
+    template<class S, class T> bool read(unsigned int idx, bool multi_value, T& value) const;
+
+    void get_refs(unsigned int idx, std::vector<uint64_t>& refs) const;
+    void wrap(const std::vector<uint64_t>& refs, std::vector<ConfigObject>& value) const;
+
+    [[noreturn]] void throw_read_only(const std::string& name) const;
+
+};
+
+#endif // SNAPCONFIG_SNAPCONFIGOBJECT_H_
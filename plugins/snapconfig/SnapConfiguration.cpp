@@ -0,0 +1,521 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+#include "config/PluginRegistry.hpp"
+#include "config/DalFactory.hpp"
+
+#include "SnapConfigObject.hpp"
+#include "SnapConfiguration.hpp"
+
+
+  // to be used as plug-in
+
+extern "C" ConfigurationImpl * _snapconfig_creator_ (const std::string& spec) {
+  try {
+    std::unique_ptr<SnapConfiguration> impl(new SnapConfiguration());
+    if(!spec.empty()) { impl->open_db(spec); }
+    return impl.release();
+  }
+  catch(daq::config::Exception& ex) {
+    throw daq::config::Generic(ERS_HERE, "snapconfig initialization error", ex);
+  }
+  catch(...) {
+    throw daq::config::Generic(ERS_HERE, "snapconfig initialization error:\n***** caught unknown exception *****");
+  }
+}
+
+CONFIG_REGISTER_PLUGIN(snapconfig, _snapconfig_creator_)
+
+
+SnapConfiguration::SnapConfiguration() noexcept :
+  m_data(nullptr),
+  m_size(0),
+  m_header(nullptr)
+{
+}
+
+SnapConfiguration::~SnapConfiguration()
+{
+  close_db();
+}
+
+
+void
+SnapConfiguration::open_db(const std::string& file_name)
+{
+  close_db();
+
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+
+  if (fd < 0)
+    {
+      std::ostringstream text;
+      text << "cannot open snapshot file \"" << file_name << "\": " << strerror(errno);
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  map(fd, file_name);
+}
+
+void
+SnapConfiguration::map(int fd, const std::string& file_name)
+{
+  struct stat st;
+
+  if (fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < sizeof(config::snapshot::Header))
+    {
+      ::close(fd);
+      std::ostringstream text;
+      text << "snapshot file \"" << file_name << "\" is too short";
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  void * data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+  ::close(fd);
+
+  if (data == MAP_FAILED)
+    {
+      std::ostringstream text;
+      text << "cannot map snapshot file \"" << file_name << "\": " << strerror(errno);
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  m_file_name = file_name;
+  m_data = static_cast<const char *>(data);
+  m_size = st.st_size;
+  m_header = at<config::snapshot::Header>(0);
+
+  try
+    {
+      validate();
+
+      m_classes.resize(m_header->m_classes_count);
+
+      for (uint32_t idx = 0; idx < m_header->m_classes_count; ++idx)
+        {
+          ClassInfo& info(m_classes[idx]);
+
+          info.m_class = &get_class_rec(idx);
+          info.m_name = str(info.m_class->m_name);
+
+          const config::snapshot::Attribute * attributes = at<config::snapshot::Attribute>(info.m_class->m_attributes);
+          for (uint32_t i = 0; i < info.m_class->m_attributes_count; ++i)
+            info.m_attribute_index.emplace(str(attributes[i].m_name), i);
+
+          const config::snapshot::Relationship * relationships = at<config::snapshot::Relationship>(info.m_class->m_relationships);
+          for (uint32_t i = 0; i < info.m_class->m_relationships_count; ++i)
+            info.m_relationship_index.emplace(str(relationships[i].m_name), info.m_class->m_attributes_count + i);
+
+          m_class_index.emplace(info.m_name, idx);
+        }
+    }
+  catch (...)
+    {
+      close_db();
+      throw;
+    }
+
+  TLOG_DEBUG(2) << "mapped snapshot file \"" << file_name << "\" (" << m_size << " bytes, " << m_header->m_classes_count << " classes, " << m_header->m_objects_count << " objects)";
+}
+
+void
+SnapConfiguration::validate() const
+{
+  auto error = [this](const char * what) {
+    std::ostringstream text;
+    text << "bad snapshot file \"" << m_file_name << "\": " << what;
+    throw daq::config::Generic(ERS_HERE, text.str().c_str());
+  };
+
+  if (memcmp(m_header->m_magic, config::snapshot::magic, sizeof(config::snapshot::magic)))
+    error("unknown file format");
+
+  if (m_header->m_byte_order != config::snapshot::byte_order_mark)
+    error("byte order mismatch");
+
+  if (m_header->m_version != config::snapshot::format_version)
+    {
+      std::ostringstream text;
+      text << "version " << m_header->m_version << " is not supported (expected " << config::snapshot::format_version << ')';
+      error(text.str().c_str());
+    }
+
+  if (m_header->m_size != m_size)
+    error("file size does not match size stored in header");
+
+  auto in_file = [this](uint64_t offset, uint64_t count, uint64_t size) {
+    return (offset <= m_size && count <= (m_size - offset) / size);
+  };
+
+  if (!in_file(m_header->m_strings, m_header->m_strings_size, 1) || !in_file(m_header->m_files, m_header->m_files_count, sizeof(uint32_t)) || !in_file(m_header->m_classes, m_header->m_classes_count, sizeof(config::snapshot::Class)))
+    error("section is out of file");
+
+  for (uint32_t idx = 0; idx < m_header->m_classes_count; ++idx)
+    {
+      const config::snapshot::Class& c(get_class_rec(idx));
+
+      if (
+        !in_file(c.m_superclasses, c.m_superclasses_count, sizeof(uint32_t)) ||
+        !in_file(c.m_subclasses, c.m_subclasses_count, sizeof(uint32_t)) ||
+        !in_file(c.m_attributes, c.m_attributes_count, sizeof(config::snapshot::Attribute)) ||
+        !in_file(c.m_relationships, c.m_relationships_count, sizeof(config::snapshot::Relationship)) ||
+        !in_file(c.m_objects, c.m_objects_count, sizeof(config::snapshot::Object))
+      )
+        error("class record is out of file");
+    }
+
+  if (getenv("TDAQ_DB_SNAPSHOT_VERIFY"))
+    if (config::snapshot::checksum(m_data + sizeof(config::snapshot::Header), m_size - sizeof(config::snapshot::Header)) != m_header->m_checksum)
+      error("checksum mismatch");
+}
+
+void
+SnapConfiguration::close_db()
+{
+  clean();
+
+  m_classes.clear();
+  m_class_index.clear();
+
+  if (m_data)
+    {
+      munmap(const_cast<char *>(m_data), m_size);
+      m_data = nullptr;
+      m_size = 0;
+      m_header = nullptr;
+    }
+}
+
+
+void
+SnapConfiguration::throw_read_only(const char * what) const
+{
+  std::ostringstream text;
+  text << "cannot " << what << ": snapshot \"" << m_file_name << "\" is read-only";
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+void
+SnapConfiguration::create(const std::string& /*db_name*/, const std::list<std::string>& /*includes*/)
+{
+  throw_read_only("create file");
+}
+
+void
+SnapConfiguration::add_include(const std::string& /*db_name*/, const std::string& /*include*/)
+{
+  throw_read_only("add include");
+}
+
+void
+SnapConfiguration::remove_include(const std::string& /*db_name*/, const std::string& /*include*/)
+{
+  throw_read_only("remove include");
+}
+
+  // the snapshot does not store includes: all files of the snapshot are returned as top-level ones
+
+void
+SnapConfiguration::get_includes(const std::string& db_name, std::list<std::string>& includes) const
+{
+  includes.clear();
+
+  if (db_name.empty() && m_data)
+    {
+      const uint32_t * files = at<uint32_t>(m_header->m_files);
+
+      for (uint32_t i = 0; i < m_header->m_files_count; ++i)
+        includes.push_back(str(files[i]));
+    }
+}
+
+void
+SnapConfiguration::get_updated_dbs(std::list<std::string>& dbs) const
+{
+  dbs.clear();
+}
+
+void
+SnapConfiguration::set_commit_credentials(const std::string& /*user*/, const std::string& /*password*/)
+{
+}
+
+void
+SnapConfiguration::commit(const std::string& /*log_message*/)
+{
+  throw_read_only("commit");
+}
+
+void
+SnapConfiguration::abort()
+{
+}
+
+std::vector<daq::config::Version>
+SnapConfiguration::get_changes()
+{
+  return std::vector<daq::config::Version>();
+}
+
+std::vector<daq::config::Version>
+SnapConfiguration::get_versions(const std::string& /*since*/, const std::string& /*until*/, daq::config::Version::QueryType /*type*/, bool /*skip_irrelevant*/)
+{
+  return std::vector<daq::config::Version>();
+}
+
+
+uint32_t
+SnapConfiguration::get_class(const std::string& name) const
+{
+  auto i = m_class_index.find(name);
+
+  if (i == m_class_index.end())
+    throw daq::config::NotFound(ERS_HERE, "class", name.c_str());
+
+  return i->second;
+}
+
+bool
+SnapConfiguration::find(uint32_t class_idx, const std::string& id, uint64_t& ref) const noexcept
+{
+  const config::snapshot::Class& c(get_class_rec(class_idx));
+  const config::snapshot::Object * objects = at<config::snapshot::Object>(c.m_objects);
+
+  // compare ids as memcmp() does, that is the order used by writer
+
+  auto compare = [this, &id](const config::snapshot::Object& o) {
+    uint32_t len;
+    const char * s = str(o.m_id, len);
+    int r = memcmp(s, id.data(), std::min<size_t>(len, id.size()));
+    return (r != 0 ? r : (len < id.size() ? -1 : (len > id.size() ? 1 : 0)));
+  };
+
+  uint32_t lo = 0, hi = c.m_objects_count;
+
+  while (lo < hi)
+    {
+      uint32_t mid = lo + (hi - lo) / 2;
+      int r = compare(objects[mid]);
+
+      if (r == 0)
+        {
+          ref = config::snapshot::make_ref(class_idx, mid);
+          return true;
+        }
+      else if (r < 0)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+  return false;
+}
+
+bool
+SnapConfiguration::find_all(uint32_t class_idx, const std::string& id, uint64_t& ref) const noexcept
+{
+  if (find(class_idx, id, ref))
+    return true;
+
+  const config::snapshot::Class& c(get_class_rec(class_idx));
+  const uint32_t * subclasses = at<uint32_t>(c.m_subclasses);
+
+  for (uint32_t i = 0; i < c.m_subclasses_count; ++i)
+    if (find(subclasses[i] & ~config::snapshot::direct_class_bit, id, ref))
+      return true;
+
+  return false;
+}
+
+SnapConfigObject *
+SnapConfiguration::get_impl(uint64_t ref)
+{
+  return insert_object<SnapConfigObject>(ref, str(get_object_rec(ref).m_id), m_classes[ref >> 32].m_name);
+}
+
+void
+SnapConfiguration::get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/)
+{
+  uint64_t ref;
+
+  if (!find_all(get_class(class_name), id, ref))
+    throw daq::config::NotFound(ERS_HERE, "object", std::string(id + '@' + class_name).c_str());
+
+  object = get_impl(ref);
+}
+
+void
+SnapConfiguration::get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/)
+{
+  if (!query.empty())
+    {
+      std::ostringstream text;
+      text << "snapconfig does not support queries (\"" << query << "\")";
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  const uint32_t class_idx = get_class(class_name);
+  const config::snapshot::Class& c(get_class_rec(class_idx));
+  const uint32_t * subclasses = at<uint32_t>(c.m_subclasses);
+
+  objects.clear();
+
+  auto add = [&](uint32_t idx) {
+    for (uint32_t i = 0; i < get_class_rec(idx).m_objects_count; ++i)
+      objects.emplace_back(get_impl(config::snapshot::make_ref(idx, i)));
+  };
+
+  add(class_idx);
+
+  for (uint32_t i = 0; i < c.m_subclasses_count; ++i)
+    add(subclasses[i] & ~config::snapshot::direct_class_bit);
+}
+
+void
+SnapConfiguration::get(const ConfigObject& /*obj_from*/, const std::string& query, std::vector<ConfigObject>& /*objects*/, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/)
+{
+  std::ostringstream text;
+  text << "snapconfig does not support path queries (\"" << query << "\")";
+  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+}
+
+bool
+SnapConfiguration::test_object(const std::string& class_name, const std::string& id, unsigned long /*rlevel*/, const std::vector<std::string> * /*rclasses*/)
+{
+  uint64_t ref;
+  return find_all(get_class(class_name), id, ref);
+}
+
+void
+SnapConfiguration::create(const std::string& /*at*/, const std::string& /*class_name*/, const std::string& /*id*/, ConfigObject& /*object*/)
+{
+  throw_read_only("create object");
+}
+
+void
+SnapConfiguration::create(const ConfigObject& /*at*/, const std::string& /*class_name*/, const std::string& /*id*/, ConfigObject& /*object*/)
+{
+  throw_read_only("create object");
+}
+
+void
+SnapConfiguration::destroy(ConfigObject& /*object*/)
+{
+  throw_read_only("destroy object");
+}
+
+daq::config::class_t *
+SnapConfiguration::get(const std::string& class_name, bool direct_only)
+{
+  const config::snapshot::Class& c(get_class_rec(get_class(class_name)));
+
+  daq::config::class_t * d = new daq::config::class_t(class_name, str(c.m_description), (c.m_flags & config::snapshot::Class::abstract_flag));
+
+  auto add_classes = [&](uint64_t offset, uint32_t count, const std::vector<std::string>& names) {
+    std::vector<std::string>& v(const_cast<std::vector<std::string>&>(names));
+    const uint32_t * classes = at<uint32_t>(offset);
+
+    for (uint32_t i = 0; i < count; ++i)
+      if (!direct_only || (classes[i] & config::snapshot::direct_class_bit))
+        v.push_back(m_classes[classes[i] & ~config::snapshot::direct_class_bit].m_name);
+  };
+
+  add_classes(c.m_superclasses, c.m_superclasses_count, d->p_superclasses);
+  add_classes(c.m_subclasses, c.m_subclasses_count, d->p_subclasses);
+
+  std::vector<daq::config::attribute_t>& attributes(const_cast<std::vector<daq::config::attribute_t>&>(d->p_attributes));
+  const config::snapshot::Attribute * a = at<config::snapshot::Attribute>(c.m_attributes);
+
+  for (uint32_t i = 0; i < c.m_attributes_count; ++i)
+    if (!direct_only || (a[i].m_flags & config::snapshot::Attribute::direct_flag))
+      attributes.emplace_back(
+        str(a[i].m_name),
+        static_cast<daq::config::type_t>(a[i].m_type),
+        str(a[i].m_range),
+        static_cast<daq::config::int_format_t>(a[i].m_int_format),
+        (a[i].m_flags & config::snapshot::Attribute::not_null_flag),
+        (a[i].m_flags & config::snapshot::Attribute::multi_value_flag),
+        str(a[i].m_default_value),
+        str(a[i].m_description)
+      );
+
+  std::vector<daq::config::relationship_t>& relationships(const_cast<std::vector<daq::config::relationship_t>&>(d->p_relationships));
+  const config::snapshot::Relationship * r = at<config::snapshot::Relationship>(c.m_relationships);
+
+  for (uint32_t i = 0; i < c.m_relationships_count; ++i)
+    if (!direct_only || (r[i].m_flags & config::snapshot::Relationship::direct_flag))
+      {
+        const daq::config::cardinality_t cardinality = static_cast<daq::config::cardinality_t>(r[i].m_cardinality);
+
+        relationships.emplace_back(
+          str(r[i].m_name),
+          m_classes[r[i].m_type].m_name,
+          (cardinality == daq::config::zero_or_one || cardinality == daq::config::zero_or_many),
+          (cardinality == daq::config::zero_or_many || cardinality == daq::config::one_or_many),
+          (r[i].m_flags & config::snapshot::Relationship::aggregation_flag),
+          str(r[i].m_description)
+        );
+      }
+
+  return d;
+}
+
+void
+SnapConfiguration::get_superclasses(config::fmap<config::fset>& schema)
+{
+  schema.clear();
+
+  for (const auto& x : m_classes)
+    {
+      config::fset& superclasses = schema[&DalFactory::instance().get_known_class_name_ref(x.m_name)];
+
+      const uint32_t * classes = at<uint32_t>(x.m_class->m_superclasses);
+
+      for (uint32_t i = 0; i < x.m_class->m_superclasses_count; ++i)
+        superclasses.insert(&DalFactory::instance().get_known_class_name_ref(m_classes[classes[i] & ~config::snapshot::direct_class_bit].m_name));
+    }
+}
+
+
+  // the snapshot is never changed, so there is nothing to notify about
+
+void
+SnapConfiguration::subscribe(const std::set<std::string>& /*class_names*/, const std::map< std::string, std::set<std::string> >& /*objs*/, ConfigurationImpl::notify /*cb*/, ConfigurationImpl::pre_notify /*pre_cb*/)
+{
+}
+
+void
+SnapConfiguration::unsubscribe()
+{
+}
+
+void
+SnapConfiguration::print_profiling_info() noexcept
+{
+  std::cout << "SnapConfiguration profiler report:\n";
+
+  if (m_data)
+    std::cout <<
+      "  snapshot file: \"" << m_file_name << "\"\n"
+      "  size of file: " << m_size << " bytes\n"
+      "  number of classes: " << m_header->m_classes_count << "\n"
+      "  number of objects: " << m_header->m_objects_count << "\n"
+      "  number of files: " << m_header->m_files_count << std::endl;
+
+  print_cache_info();
+}
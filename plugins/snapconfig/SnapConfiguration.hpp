@@ -0,0 +1,218 @@
+  /**
+   *  \file SnapConfiguration.hpp This file contains SnapConfiguration class,
+   *  that is the read-only implementation of the config abstract interface using binary snapshot file.
+   *  \brief snapshot config plug-in
+   */
+
+#ifndef SNAPCONFIG_SNAPCONFIGURATION_H_
+#define SNAPCONFIG_SNAPCONFIGURATION_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "config/ConfigurationImpl.hpp"
+#include "config/Schema.hpp"
+#include "config/Snapshot.hpp"
+#include "config/map.hpp"
+
+class SnapConfigObject;
+
+
+  /**
+   *  \brief Implements read-only configuration database using memory-mapped snapshot file.
+   *
+   *  The snapshot file is produced by the config::snapshot::Writer (see config_snapshot utility).
+   *  The plug-in parameter is the name of snapshot file, e.g. "snapconfig:daq.snapshot".
+   *  The file is mapped into memory; the objects and their values are read directly from the mapped data.
+   *  Only the class and attribute names indices are built when the file is opened.
+   *  The checksum of the file is verified, if the TDAQ_DB_SNAPSHOT_VERIFY environment variable is defined.
+   *
+   *  The database cannot be modified and there are no notifications.
+   *  The queries and paths are not supported.
+   */
+
+class SnapConfiguration : public ConfigurationImpl {
+
+  friend class SnapConfigObject;
+
+  public:
+
+    SnapConfiguration() noexcept;
+
+    virtual ~SnapConfiguration();
+
+
+  public:
+
+    virtual void open_db(const std::string& db_name);
+    virtual void close_db();
+    virtual bool loaded() const noexcept { return (m_data != nullptr); }
+    virtual void create(const std::string& db_name, const std::list<std::string>& includes);
+    virtual bool is_writable(const std::string& /*db_name*/) { return false; }
+    virtual void add_include(const std::string& db_name, const std::string& include);
+    virtual void remove_include(const std::string& db_name, const std::string& include);
+    virtual void get_includes(const std::string& db_name, std::list<std::string>& includes) const;
+    virtual void get_updated_dbs(std::list<std::string>& dbs) const;
+    virtual void set_commit_credentials(const std::string& user, const std::string& password);
+    virtual void commit(const std::string& log_message);
+    virtual void abort();
+    virtual void prefetch_all_data() { ; }
+    virtual std::vector<daq::config::Version> get_changes();
+    virtual std::vector<daq::config::Version> get_versions(const std::string& since, const std::string& until, daq::config::Version::QueryType type, bool skip_irrelevant);
+
+
+  public:
+
+    virtual void get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual void get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual void get(const ConfigObject& obj_from, const std::string& query, std::vector<ConfigObject>& objects, unsigned long rlevel, const std::vector<std::string> * rclasses);
+    virtual bool test_object(const std::string& class_name, const std::string& id, unsigned long rlevel, const std::vector<std::string> * rclasses);
+
+
+  public:
+
+    virtual void create(const std::string& at, const std::string& class_name, const std::string& id, ConfigObject& object);
+    virtual void create(const ConfigObject& at, const std::string& class_name, const std::string& id, ConfigObject& object);
+    virtual void destroy(ConfigObject& object);
+
+
+  public:
+
+    virtual daq::config::class_t * get(const std::string& class_name, bool direct_only);
+    virtual void get_superclasses(config::fmap<config::fset>& schema);
+
+
+  public:
+
+    virtual void subscribe(const std::set<std::string>& class_names, const std::map< std::string, std::set<std::string> >& objs, ConfigurationImpl::notify cb, ConfigurationImpl::pre_notify pre_cb);
+    virtual void unsubscribe();
+    virtual void print_profiling_info() noexcept;
+
+
+  protected:
+
+      /// Return record at given offset of mapped file
+
+    template<class T>
+    const T *
+    at(uint64_t offset) const noexcept
+    {
+      return reinterpret_cast<const T *>(m_data + offset);
+    }
+
+      /// Return string by reference
+
+    const char *
+    str(uint32_t ref, uint32_t& len) const noexcept
+    {
+      const char * p = m_data + m_header->m_strings + ref;
+      memcpy(&len, p, sizeof(uint32_t));
+      return p + sizeof(uint32_t);
+    }
+
+    std::string
+    str(uint32_t ref) const
+    {
+      uint32_t len;
+      const char * p = str(ref, len);
+      return std::string(p, len);
+    }
+
+      /// Return class record by index
+
+    const config::snapshot::Class&
+    get_class_rec(uint32_t idx) const noexcept
+    {
+      return at<config::snapshot::Class>(m_header->m_classes)[idx];
+    }
+
+      /// Return object record by object reference
+
+    const config::snapshot::Object&
+    get_object_rec(uint64_t ref) const noexcept
+    {
+      return at<config::snapshot::Object>(get_class_rec(ref >> 32).m_objects)[static_cast<uint32_t>(ref)];
+    }
+
+      /// Return pointer to 8-bytes slot of the object data
+
+    const char *
+    get_slot(uint64_t ref, unsigned int idx) const noexcept
+    {
+      return m_data + get_object_rec(ref).m_data + sizeof(uint64_t) * idx;
+    }
+
+      /// Return pointer to array stored in the slot of the object data and the number of items
+
+    const char *
+    get_array(uint64_t ref, unsigned int idx, uint64_t& count) const noexcept
+    {
+      uint64_t offset;
+      memcpy(&offset, get_slot(ref, idx), sizeof(offset));
+
+      if (offset == 0)
+        {
+          count = 0;
+          return nullptr;
+        }
+
+      memcpy(&count, m_data + offset, sizeof(count));
+      return m_data + offset + sizeof(count);
+    }
+
+      /// Return class index by name or throw daq::config::NotFound
+
+    uint32_t get_class(const std::string& name) const;
+
+      /// Binary search of object with given id in the class (without subclasses)
+
+    bool find(uint32_t class_idx, const std::string& id, uint64_t& ref) const noexcept;
+
+      /// Find object in the class and its subclasses
+
+    bool find_all(uint32_t class_idx, const std::string& id, uint64_t& ref) const noexcept;
+
+      /// Get implementation object by object reference
+
+    SnapConfigObject * get_impl(uint64_t ref);
+
+      /// Raise exception for any modification
+
+    [[noreturn]] void throw_read_only(const char * what) const;
+
+      /// Map snapshot from file descriptor (the descriptor is closed) and build indices
+
+    void map(int fd, const std::string& file_name);
+
+      /// Check that all records are inside mapped file
+
+    void validate() const;
+
+
+  protected:
+
+    struct ClassInfo
+    {
+      const config::snapshot::Class * m_class;
+      std::string m_name;
+      config::map<unsigned int> m_attribute_index;      // attribute name => slot
+      config::map<unsigned int> m_relationship_index;   // relationship name => slot
+    };
+
+    std::string m_file_name;
+    const char * m_data;
+    uint64_t m_size;
+    const config::snapshot::Header * m_header;
+
+    std::vector<ClassInfo> m_classes;
+    config::map<uint32_t> m_class_index;
+
+};
+
+#endif // SNAPCONFIG_SNAPCONFIGURATION_H_
@@ -0,0 +1,453 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <type_traits>
+
+#include "ers/ers.hpp"
+
+#include "config/Columns.hpp"
+#include "config/ConfigObject.hpp"
+#include "config/Errors.hpp"
+
+
+namespace config
+{
+  namespace columns
+  {
+
+    namespace
+    {
+
+        // 8-bytes aligned output buffer; the records are addressed by offsets since the buffer may grow
+
+      class Buffer
+      {
+
+      public:
+
+        uint64_t
+        allocate(uint64_t size)
+        {
+          uint64_t offset = (m_data.size() + 7) & ~static_cast<uint64_t>(7);
+          m_data.resize(offset + size, 0);
+          return offset;
+        }
+
+        uint64_t
+        add(const void * data, uint64_t size)
+        {
+          uint64_t offset = allocate(size);
+
+          if (size)
+            memcpy(m_data.data() + offset, data, size);
+
+          return offset;
+        }
+
+        uint64_t
+        add(const std::string& name)
+        {
+          return add(name.c_str(), name.size() + 1);
+        }
+
+        template<class T>
+        void
+        put(uint64_t offset, const T& value) noexcept
+        {
+          memcpy(m_data.data() + offset, &value, sizeof(T));
+        }
+
+        std::vector<char> m_data;
+
+      };
+
+
+        // values of a column collected for all rows
+
+      struct ColumnData
+      {
+        ColumnData(const std::string& name, daq::config::type_t type, bool multi_value) :
+          m_name(name), m_type(type), m_multi_value(multi_value)
+        {
+          if (m_multi_value)
+            m_rows.push_back(0);
+
+          if (is_string())
+            append<uint64_t>(0);
+        }
+
+        bool
+        is_string() const
+        {
+          return (m_type >= daq::config::date_type);
+        }
+
+        template<class T>
+        void
+        add(const T& value)
+        {
+          if constexpr (std::is_same<T, std::string>::value)
+            {
+              m_chars.append(value);
+              append<uint64_t>(m_chars.size());
+            }
+          else if constexpr (std::is_same<T, bool>::value)
+            append<uint8_t>(value);
+          else
+            append<T>(value);
+
+          m_count++;
+        }
+
+        void
+        end_row()
+        {
+          if (m_multi_value)
+            m_rows.push_back(m_count);
+        }
+
+        template<class T>
+        void
+        append(T value)
+        {
+          const char * p = reinterpret_cast<const char *>(&value);
+          m_values.insert(m_values.end(), p, p + sizeof(T));
+        }
+
+        std::string m_name;
+        daq::config::type_t m_type;
+        bool m_multi_value;
+        uint64_t m_count = 0;
+        std::vector<uint64_t> m_rows;
+        std::vector<char> m_values;
+        std::string m_chars;
+      };
+
+
+      struct TableData
+      {
+        std::string m_name;
+        uint64_t m_rows;
+        std::vector<ColumnData> m_columns;
+      };
+
+
+        // read values of attribute of all objects
+
+      template<class T>
+      void
+      read_attribute(ColumnData& column, const std::vector<ConfigObject>& objects)
+      {
+        for (const auto& x : objects)
+          {
+            auto &o = const_cast<ConfigObject&>(x);
+
+            if (!column.m_multi_value)
+              {
+                T value;
+                o.get(column.m_name, value);
+                column.add(value);
+              }
+            else
+              {
+                std::vector<T> values;
+                o.get(column.m_name, values);
+
+                for (const auto& v : values)
+                  column.add<T>(v);
+
+                column.end_row();
+              }
+          }
+      }
+
+    }
+
+
+    void
+    write(const daq::config::class_t& info, const std::vector<ConfigObject>& objects, const std::string& file_name)
+    {
+      std::vector<TableData> tables;
+
+      tables.push_back(TableData{info.p_name, objects.size(), {}});
+
+        {
+          std::vector<ColumnData>& columns(tables.back().m_columns);
+
+          columns.emplace_back("#id", daq::config::string_type, false);
+          columns.emplace_back("#file", daq::config::string_type, false);
+
+          for (const auto& x : objects)
+            {
+              columns[0].add(x.UID());
+              columns[1].add(x.contained_in());
+            }
+
+          for (const auto& a : info.p_attributes)
+            {
+              columns.emplace_back(a.p_name, a.p_type, a.p_is_multi_value);
+              ColumnData& column(columns.back());
+
+              switch (a.p_type)
+                {
+                  case daq::config::bool_type:   read_attribute<bool>(column, objects); break;
+                  case daq::config::s8_type:     read_attribute<int8_t>(column, objects); break;
+                  case daq::config::u8_type:     read_attribute<uint8_t>(column, objects); break;
+                  case daq::config::s16_type:    read_attribute<int16_t>(column, objects); break;
+                  case daq::config::u16_type:    read_attribute<uint16_t>(column, objects); break;
+                  case daq::config::s32_type:    read_attribute<int32_t>(column, objects); break;
+                  case daq::config::u32_type:    read_attribute<uint32_t>(column, objects); break;
+                  case daq::config::s64_type:    read_attribute<int64_t>(column, objects); break;
+                  case daq::config::u64_type:    read_attribute<uint64_t>(column, objects); break;
+                  case daq::config::float_type:  read_attribute<float>(column, objects); break;
+                  case daq::config::double_type: read_attribute<double>(column, objects); break;
+                  default:                       read_attribute<std::string>(column, objects); break;
+                }
+            }
+        }
+
+      for (const auto& r : info.p_relationships)
+        {
+          tables.push_back(TableData{info.p_name + '.' + r.p_name, 0, {}});
+
+          TableData& table(tables.back());
+
+          table.m_columns.emplace_back("source", daq::config::string_type, false);
+          table.m_columns.emplace_back("target", daq::config::string_type, false);
+          table.m_columns.emplace_back("target_class", daq::config::string_type, false);
+
+          auto add_row = [&table](const ConfigObject& source, const ConfigObject& target) {
+            table.m_columns[0].add(source.UID());
+            table.m_columns[1].add(target.UID());
+            table.m_columns[2].add(target.class_name());
+            table.m_rows++;
+          };
+
+          for (const auto& x : objects)
+            {
+              auto &o = const_cast<ConfigObject&>(x);
+
+              if (r.p_cardinality == daq::config::zero_or_many || r.p_cardinality == daq::config::one_or_many)
+                {
+                  std::vector<ConfigObject> values;
+                  o.get(r.p_name, values);
+
+                  for (const auto& v : values)
+                    add_row(x, v);
+                }
+              else
+                {
+                  ConfigObject value;
+                  o.get(r.p_name, value);
+
+                  if (!value.is_null())
+                    add_row(x, value);
+                }
+            }
+        }
+
+      // serialize tables; the collected data are released when copied
+
+      Buffer buf;
+
+      buf.allocate(sizeof(Header));
+
+      const uint64_t tables_offset = buf.allocate(sizeof(Table) * tables.size());
+
+      for (uint32_t i = 0; i < tables.size(); ++i)
+        {
+          TableData& t(tables[i]);
+
+          Table rec;
+          memset(&rec, 0, sizeof(rec));
+
+          rec.m_name = buf.add(t.m_name);
+          rec.m_rows = t.m_rows;
+          rec.m_columns_count = t.m_columns.size();
+          rec.m_columns = buf.allocate(sizeof(Column) * t.m_columns.size());
+
+          for (uint32_t j = 0; j < t.m_columns.size(); ++j)
+            {
+              ColumnData& c(t.m_columns[j]);
+
+              Column col;
+              memset(&col, 0, sizeof(col));
+
+              col.m_name = buf.add(c.m_name);
+              col.m_type = c.m_type;
+              col.m_flags = (c.m_multi_value ? Column::multi_value_flag : 0);
+              col.m_count = c.m_count;
+
+              if (c.m_multi_value)
+                col.m_rows = buf.add(c.m_rows.data(), c.m_rows.size() * sizeof(uint64_t));
+
+              col.m_values = buf.add(c.m_values.data(), c.m_values.size());
+
+              if (c.is_string())
+                {
+                  col.m_chars = buf.add(c.m_chars.data(), c.m_chars.size());
+                  col.m_chars_size = c.m_chars.size();
+                }
+
+              buf.put(rec.m_columns + j * sizeof(Column), col);
+
+              std::vector<uint64_t>().swap(c.m_rows);
+              std::vector<char>().swap(c.m_values);
+              std::string().swap(c.m_chars);
+            }
+
+          buf.put(tables_offset + i * sizeof(Table), rec);
+        }
+
+      Header header;
+      memset(&header, 0, sizeof(header));
+
+      memcpy(header.m_magic, magic, sizeof(magic));
+      header.m_version = format_version;
+      header.m_byte_order = byte_order_mark;
+      header.m_size = buf.m_data.size();
+      header.m_tables_count = tables.size();
+      header.m_tables = tables_offset;
+
+      buf.put(0, header);
+
+      // write to temporary file and rename, so readers never see incomplete file
+
+      const std::string tmp_name(file_name + ".tmp." + std::to_string(getpid()));
+
+      std::ofstream f(tmp_name, std::ios::binary | std::ios::trunc);
+
+      if (f)
+        f.write(buf.m_data.data(), buf.m_data.size());
+
+      f.close();
+
+      if (!f || rename(tmp_name.c_str(), file_name.c_str()) != 0)
+        {
+          unlink(tmp_name.c_str());
+          std::ostringstream text;
+          text << "cannot write columnar file \"" << file_name << '\"';
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+    }
+
+
+    Reader::Reader(const std::string& file_name)
+    {
+      auto error = [&file_name](const char * problem) {
+        std::ostringstream text;
+        text << "cannot read columnar file \"" << file_name << "\": " << problem;
+        return daq::config::Generic(ERS_HERE, text.str().c_str());
+      };
+
+      std::ifstream f(file_name, std::ios::binary);
+
+      if (!f)
+        throw error("cannot open file");
+
+      m_data.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+
+      if (f.bad())
+        throw error("read failed");
+
+      if (!check(0, sizeof(Header)) || memcmp(header().m_magic, magic, sizeof(magic)))
+        throw error("bad signature");
+
+      if (header().m_byte_order != byte_order_mark)
+        throw error("byte order mismatch");
+
+      if (header().m_version != format_version)
+        throw error("unsupported format version");
+
+      if (header().m_size != m_data.size() || !check(header().m_tables, header().m_tables_count * sizeof(Table)))
+        throw error("file is truncated or corrupted");
+
+      for (uint32_t i = 0; i < get_tables_count(); ++i)
+        {
+          const Table& t(get_table(i));
+
+          if (!check_name(t.m_name) || t.m_rows > m_data.size() || !check(t.m_columns, t.m_columns_count * sizeof(Column)))
+            throw error("bad table");
+
+          for (uint32_t j = 0; j < t.m_columns_count; ++j)
+            {
+              const Column& c(at<Column>(t.m_columns)[j]);
+
+              if (!check_name(c.m_name) || c.m_type > daq::config::class_type || c.m_count > m_data.size())
+                throw error("bad column");
+
+              if (c.m_flags & Column::multi_value_flag)
+                {
+                  if (!check(c.m_rows, (t.m_rows + 1) * sizeof(uint64_t)) || get_rows(c)[t.m_rows] != c.m_count)
+                    throw error("bad rows of multi-value column");
+
+                  for (uint64_t k = 0; k < t.m_rows; ++k)
+                    if (get_rows(c)[k] > get_rows(c)[k + 1])
+                      throw error("bad rows of multi-value column");
+                }
+              else if (c.m_count != t.m_rows)
+                {
+                  throw error("number of values of column differs from number of rows");
+                }
+
+              if (c.m_type >= daq::config::date_type)
+                {
+                  if (!check(c.m_values, (c.m_count + 1) * sizeof(uint64_t)) || !check(c.m_chars, c.m_chars_size))
+                    throw error("bad strings of column");
+
+                  const uint64_t * offsets = get_values<uint64_t>(c);
+
+                  if (offsets[0] != 0 || offsets[c.m_count] != c.m_chars_size)
+                    throw error("bad strings of column");
+
+                  for (uint64_t k = 0; k < c.m_count; ++k)
+                    if (offsets[k] > offsets[k + 1])
+                      throw error("bad strings of column");
+                }
+              else
+                {
+                  static const uint64_t sizes[] = { 1, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8 };
+
+                  if (!check(c.m_values, c.m_count * sizes[c.m_type]))
+                    throw error("bad values of column");
+                }
+            }
+        }
+    }
+
+    bool
+    Reader::check_name(uint64_t offset) const noexcept
+    {
+      return (offset < m_data.size() && memchr(m_data.data() + offset, 0, m_data.size() - offset) != nullptr);
+    }
+
+    const Table *
+    Reader::find_table(const std::string& name) const noexcept
+    {
+      for (uint32_t i = 0; i < get_tables_count(); ++i)
+        if (name == get_name(get_table(i).m_name))
+          return &get_table(i);
+
+      return nullptr;
+    }
+
+    const Column *
+    Reader::find_column(const Table& table, const std::string& name) const noexcept
+    {
+      for (uint32_t i = 0; i < table.m_columns_count; ++i)
+        {
+          const Column& c(at<Column>(table.m_columns)[i]);
+
+          if (name == get_name(c.m_name))
+            return &c;
+        }
+
+      return nullptr;
+    }
+
+  }
+}
@@ -12,34 +12,37 @@ ConfigObject::ConfigObject() noexcept :
 {
 }
 
+  // the implementation object used by a config object is pinned, i.e. it cannot be evicted from bounded cache
+
 ConfigObject::ConfigObject(const ConfigObject& other) noexcept :
   m_impl(other.m_impl)
 {
+  if(m_impl) m_impl->pin();
 }
 
 ConfigObject::ConfigObject(ConfigObjectImpl *impl) noexcept :
   m_impl(impl)
 {
+  if(m_impl) m_impl->pin();
 }
 
 ConfigObject::~ConfigObject() noexcept
 {
+  if(m_impl) m_impl->unpin();
 }
 
 ConfigObject&
 ConfigObject::operator=(const ConfigObject& other) noexcept
 {
-  if(this != &other) {
-    m_impl = other.m_impl;
-  }
-
-  return *this;
+  return (*this = other.m_impl);
 }
 
 ConfigObject&
 ConfigObject::operator=(ConfigObjectImpl *impl) noexcept
 {
   if(m_impl != impl) {
+    if(impl) impl->pin();
+    if(m_impl) m_impl->unpin();
     m_impl = impl;
   }
 
@@ -90,6 +93,7 @@ ConfigObject::rename(const std::string& new_id)
 void
 ConfigObject::action_on_object_update(Configuration * db, const std::string& name)
 {
+  m_impl->m_generation++;
   db->action_on_update(*this, name);
 }
 
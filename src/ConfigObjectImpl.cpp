@@ -98,7 +98,7 @@ class ConfigObjectDefault : public ConfigObjectImpl {
 
 };
 
-ConfigObjectImpl::ConfigObjectImpl(ConfigurationImpl * impl, const std::string& id, daq::config::ObjectState state) noexcept : m_impl (impl), m_state(state), m_id(id), m_class_name(nullptr)
+ConfigObjectImpl::ConfigObjectImpl(ConfigurationImpl * impl, const std::string& id, daq::config::ObjectState state) noexcept : m_impl (impl), m_state(state), m_id(id), m_class_name(nullptr), m_generation(0), m_referenced(true), m_pins(0)
 {
 }
 
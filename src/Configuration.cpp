@@ -1,21 +1,31 @@
 #include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <regex>
+#include <set>
 #include <sstream>
-
-#include <dlfcn.h>
+#include <thread>
 
 #include "ers/ers.hpp"
 #include "ers/internal/SingletonCreator.hpp"
 
 #include "config/Change.hpp"
+#include "config/Columns.hpp"
+#include "config/DataWriter.hpp"
+#include "config/Filter.hpp"
 #include "config/DalObject.hpp"
 #include "config/DalObjectPrint.hpp"
 #include "config/DalFactory.hpp"
 #include "config/ConfigObject.hpp"
+#include "config/NotificationDispatcher.hpp"
 #include "config/ConfigAction.hpp"
 #include "config/Configuration.hpp"
 #include "config/ConfigurationImpl.hpp"
+#include "config/PluginRegistry.hpp"
 #include "config/Schema.hpp"
 
 namespace daq {
@@ -72,6 +82,8 @@ Configuration::remove_action(ConfigAction * ac)
 void
 Configuration::action_on_update(const ConfigObject& obj, const std::string& name)
 {
+  p_generation++;
+
   std::lock_guard<std::mutex> scoped_lock(m_actn_mutex);
   for (auto &i : m_actions)
     i->update(obj, name);
@@ -85,11 +97,25 @@ check_prefetch_needs()
   return (getenv("TDAQ_DB_PREFETCH_ALL_DATA") != nullptr);
 }
 
+static unsigned long
+get_cache_limit()
+{
+  const char * s = getenv("TDAQ_DB_CACHE_LIMIT");
+  return (s && *s) ? strtoul(s, nullptr, 0) : 0;
+}
+
+static unsigned int
+get_notification_threads()
+{
+  const char * s = getenv("TDAQ_DB_NOTIFICATION_THREADS");
+  return (s && *s) ? strtoul(s, nullptr, 0) : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 
 Configuration::Configuration(const std::string& spec) :
-    p_number_of_cache_hits(0), p_number_of_template_object_created(0), p_number_of_template_object_read(0), m_impl(nullptr), m_shlib_h(nullptr)
+    p_number_of_cache_hits(0), p_number_of_template_object_created(0), p_number_of_template_object_read(0), p_generation(0), m_impl(nullptr), m_async_threads(0), m_async_queue_limit(1024)
 {
   std::string s;
 
@@ -118,36 +144,9 @@ Configuration::Configuration(const std::string& spec) :
       m_impl_param = m_impl_spec.substr(idx + 1);
     }
 
-  std::string plugin_name = std::string("lib") + m_impl_name + ".so";
-  std::string impl_creator = std::string("_") + m_impl_name + "_creator_";
-
-  // load plug-in
-
-  m_shlib_h = dlopen(plugin_name.c_str(), RTLD_LAZY | RTLD_GLOBAL);
-
-  if (!m_shlib_h)
-    {
-      std::ostringstream text;
-      text << "failed to load implementation plug-in \'" << plugin_name << "\': \"" << dlerror() << '\"';
-      throw(daq::config::Generic( ERS_HERE, text.str().c_str() ) );
-    }
-
-  // search in plug-in implementation creator function
-
-  ConfigurationImpl *
-  (*f)(const std::string& spec);
+  // get creator of registered or dynamically loaded plug-in
 
-  f = (ConfigurationImpl*
-  (*)(const std::string&))dlsym(m_shlib_h, impl_creator.c_str());
-
-  char * error = 0;
-
-  if ((error = dlerror()) != 0)
-    {
-      std::ostringstream text;
-      text << "failed to find implementation creator function \'" << impl_creator << "\' in plug-in \'" << plugin_name << "\': \"" << error << '\"';
-      throw(daq::config::Generic( ERS_HERE, text.str().c_str() ) );
-    }
+  PluginRegistry::creator_fn f = PluginRegistry::instance().get(m_impl_name);
 
 
     // create implementation
@@ -159,11 +158,15 @@ Configuration::Configuration(const std::string& spec) :
       m_impl->get_superclasses(p_superclasses);
       set_subclasses();
       m_impl->set(this);
+      m_impl->set_cache_limit(get_cache_limit());
     }
 
   if (check_prefetch_needs())
     m_impl->prefetch_all_data();
 
+  if (unsigned int num_of_threads = get_notification_threads())
+    set_async_notification(num_of_threads);
+
   TLOG_DEBUG(2) << "\n*** DUMP CONFIGURATION ***\n" << *this;
 }
 
@@ -178,6 +181,49 @@ Configuration::print_profiling_info() noexcept
       "  number of read template objects: " << p_number_of_template_object_read << "\n"
       "  number of cache hits: " << p_number_of_cache_hits << std::endl;
 
+  std::shared_ptr<config::NotificationDispatcher> dispatcher;
+
+    {
+      std::lock_guard<std::mutex> scoped_lock2(m_else_mutex);
+      dispatcher = m_dispatcher;
+    }
+
+  config::NotificationLatency latency;
+  get_notification_latency(latency);
+
+  if (latency.m_total.m_count || latency.m_pre_notify.m_count)
+    {
+      std::cout << "  notification latency:\n    pre-notify callbacks: ";
+      latency.m_pre_notify.print(std::cout);
+      std::cout << "\n    config actions: ";
+      latency.m_actions.print(std::cout);
+      std::cout << "\n    cache update: ";
+      latency.m_cache_update.print(std::cout);
+      std::cout << "\n    user callbacks: ";
+      latency.m_callbacks.print(std::cout);
+      std::cout << "\n    total: ";
+      latency.m_total.print(std::cout);
+      std::cout << std::endl;
+
+        {
+          std::lock_guard<std::mutex> scoped_lock2(m_else_mutex);
+
+          for (const auto& cb : m_callbacks)
+            if (cb->m_latency.m_count)
+              {
+                std::cout << "    synchronous callback " << (void *)cb << ": ";
+                cb->m_latency.print(std::cout);
+                std::cout << std::endl;
+              }
+        }
+    }
+
+  if (dispatcher)
+    {
+      std::cout << "  asynchronous notification:\n";
+      dispatcher->print(std::cout);
+    }
+
   const char * s = ::getenv("TDAQ_DUMP_CONFIG_PROFILER_INFO");
   if (s && !strcmp(s, "DEBUG"))
     {
@@ -208,14 +254,12 @@ Configuration::~Configuration() noexcept
     {
       unload();
 
-      if (m_shlib_h)
+      if (m_impl)
         {
           std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
 
           delete m_impl;
           m_impl = 0;
-          //dlclose(m_shlib_h);
-          m_shlib_h = 0;
         }
     }
   catch (daq::config::Generic& ex)
@@ -237,6 +281,7 @@ Configuration::_get(const std::string& class_name, const std::string& name, Conf
   try
     {
       m_impl->get(class_name, name, object, rlevel, rclasses);
+      m_impl->shrink_cache();
     }
   catch (daq::config::Generic& ex)
     {
@@ -253,6 +298,7 @@ Configuration::get(const std::string& class_name, std::vector<ConfigObject>& obj
     {
       std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
       m_impl->get(class_name, objects, query, rlevel, rclasses);
+      m_impl->shrink_cache();
     }
   catch (daq::config::Generic& ex)
     {
@@ -273,6 +319,7 @@ Configuration::get(const ConfigObject& obj_from, const std::string& query, std::
     {
       std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
       m_impl->get(obj_from, query, objects, rlevel, rclasses);
+      m_impl->shrink_cache();
     }
   catch (daq::config::Generic& ex)
     {
@@ -337,6 +384,7 @@ Configuration::load(const std::string& db_name)
       m_impl->get_superclasses(p_superclasses);
       set_subclasses();
       m_impl->set(this);
+      p_generation++;
 
       if(check_prefetch_needs())
         {
@@ -357,6 +405,28 @@ Configuration::unload()
   if (m_impl == nullptr)
     throw daq::config::Generic( ERS_HERE, "nothing to unload" );
 
+  // stop asynchronous notification before locking objects mutexes, since callbacks in progress may access objects
+    {
+      std::shared_ptr<config::NotificationDispatcher> dispatcher;
+      std::vector<uint64_t> queues;
+
+        {
+          std::lock_guard<std::mutex> scoped_lock(m_else_mutex);
+
+          dispatcher = m_dispatcher;
+
+          for (auto& cb : m_callbacks)
+            if (cb->m_queue)
+              {
+                queues.push_back(cb->m_queue);
+                cb->m_queue = 0;
+              }
+        }
+
+      for (auto& q : queues)
+        dispatcher->remove(q);
+    }
+
   std::lock_guard<std::mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
   std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
 
@@ -375,6 +445,7 @@ Configuration::unload()
     }
 
   m_cache_map.clear();
+  p_generation++;
 
     {
       std::lock_guard<std::mutex> scoped_lock3(m_else_mutex);
@@ -387,6 +458,7 @@ Configuration::unload()
 
       m_callbacks.clear();
       m_pre_callbacks.clear();
+      index_subscriptions();
 
       m_impl->unsubscribe();
 
@@ -625,6 +697,61 @@ Configuration::prefetch_all_data()
     }
 }
 
+void
+Configuration::set_cache_limit(unsigned long max_objects) noexcept
+{
+  std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+
+  if (m_impl)
+    {
+      m_impl->set_cache_limit(max_objects);
+      m_impl->shrink_cache();
+    }
+}
+
+unsigned long
+Configuration::shrink_cache() noexcept
+{
+  std::lock_guard<std::mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
+  std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
+
+  if (m_impl == nullptr || m_impl->m_cache_limit == 0)
+    return 0;
+
+  size_t num = 0;
+
+  for (const auto &j : m_cache_map)
+    num += j.second->size();
+
+  size_t excess = (num > m_impl->m_cache_limit ? num - m_impl->m_cache_limit : 0), count = 0;
+
+  // destroy objects not accessed since previous call first
+
+  for (const auto &j : m_cache_map)
+    if (count < excess)
+      count += j.second->release(excess - count, true);
+
+  for (const auto &j : m_cache_map)
+    count += j.second->release(excess - count, false);
+
+  if (count)
+    {
+      TLOG_DEBUG(2) << "destroy " << count << " template objects (cache limit is " << m_impl->m_cache_limit << ')';
+      _unread_template_objects();
+    }
+
+  m_impl->shrink_cache(true);
+
+  return count;
+}
+
+unsigned long
+Configuration::get_cache_size() const noexcept
+{
+  std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+  return (m_impl ? m_impl->get_cache_size() : 0);
+}
+
 void
 Configuration::unread_all_objects(bool unread_implementation_objs) noexcept
 {
@@ -638,6 +765,8 @@ Configuration::unread_all_objects(bool unread_implementation_objs) noexcept
 void
 Configuration::_unread_template_objects() noexcept
 {
+  p_generation++;
+
   for (auto &j : m_cache_map)
     j.second->m_functions.m_unread_object_fn(j.second);
 }
@@ -645,12 +774,15 @@ Configuration::_unread_template_objects() noexcept
 void
 Configuration::_unread_implementation_objects(daq::config::ObjectState state) noexcept
 {
+  p_generation++;
+
   for (auto &i : m_impl->m_impl_objects)
     for (auto &j : *i.second)
       {
         std::lock_guard<std::mutex> scoped_lock(j.second->m_mutex);
         j.second->clear();
         j.second->m_state = state;
+        j.second->m_generation++;
       }
 
   for (auto& x : m_impl->m_tangled_objects)
@@ -658,6 +790,7 @@ Configuration::_unread_implementation_objects(daq::config::ObjectState state) no
       std::lock_guard<std::mutex> scoped_lock(x->m_mutex);
       x->clear();
       x->m_state = state;
+      x->m_generation++;
     }
 }
 
@@ -666,10 +799,26 @@ void
 Configuration::set_subclasses() noexcept
 {
   p_subclasses.clear();
+  p_class_names.clear();
 
   for (const auto &i : p_superclasses)
-    for (const auto &j : i.second)
-      p_subclasses[j].insert(i.first);
+    {
+      p_class_names.emplace(*i.first, i.first);
+
+      for (const auto &j : i.second)
+        p_subclasses[j].insert(i.first);
+    }
+}
+
+const std::string *
+Configuration::get_class_name_ref(const std::string& class_name) const noexcept
+{
+  config::map<const std::string *>::const_iterator i = p_class_names.find(class_name);
+
+  if (i != p_class_names.end())
+    return i->second;
+
+  return &DalFactory::instance().get_known_class_name_ref(class_name);
 }
 
 
@@ -704,6 +853,7 @@ Configuration::create(const std::string& at, const std::string& class_name, cons
     {
       std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
       m_impl->create(at, class_name, id, object);
+      p_generation++;
     }
   catch (daq::config::Generic& ex)
     {
@@ -720,6 +870,7 @@ Configuration::create(const ConfigObject& at, const std::string& class_name, con
     {
       std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
       m_impl->create(at, class_name, id, object);
+      p_generation++;
     }
   catch (daq::config::Generic& ex)
     {
@@ -738,6 +889,8 @@ Configuration::destroy_obj(ConfigObject& object)
       std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
       std::lock_guard<std::mutex> scoped_lock2(m_tmpl_mutex);
       m_impl->destroy(object);
+      object.m_impl->m_generation++;
+      p_generation++;
     }
   catch (daq::config::Generic& ex)
     {
@@ -820,20 +973,19 @@ Configuration::get_class_info(const std::string& class_name, bool direct_only)
 
 //////////////////////////////////////////////////////////////////////////////////////////
 
-static void
-init_regex(std::unique_ptr<std::regex>& ptr, const std::string& str, const char * what)
+static config::Filter
+make_filter(const std::string& str, const char * what)
 {
-  if (!str.empty())
-    try
-      {
-        ptr = std::make_unique<std::regex>(str);
-      }
-    catch (const std::regex_error &ex)
-      {
-        std::ostringstream text;
-        text << "failed to create " << what << " regex \"" << str << "\": " << ex.what();
-        throw daq::config::Generic( ERS_HERE, text.str().c_str());
-      }
+  try
+    {
+      return config::Filter(str);
+    }
+  catch (const std::regex_error &ex)
+    {
+      std::ostringstream text;
+      text << "failed to create " << what << " regex \"" << str << "\": " << ex.what();
+      throw daq::config::Generic( ERS_HERE, text.str().c_str());
+    }
 }
 
 
@@ -849,19 +1001,17 @@ add_array_item(boost::property_tree::ptree &pt, const T &val)
 void
 Configuration::export_schema(boost::property_tree::ptree& pt, const std::string& classes_str, bool direct_only)
 {
-  std::unique_ptr<std::regex> classes_regex;
-
-  init_regex(classes_regex, classes_str, "classes");
+  const config::Filter classes_filter(make_filter(classes_str, "classes"));
 
   auto cmp_str_ptr = [](const std::string * s1, const std::string * s2) { return *s1 < *s2; };
   std::set<const std::string *, decltype(cmp_str_ptr)> sorted_classes(cmp_str_ptr);
 
   for (const auto &c : superclasses())
-    if (classes_str.empty() || std::regex_match(*c.first, *classes_regex.get()))
+    if (classes_filter.match(*c.first))
       sorted_classes.insert(c.first);
 
   for (const auto &c : sorted_classes)
-    if (classes_str.empty() || std::regex_match(*c, *classes_regex.get()))
+    if (classes_filter.match(*c))
       {
         const daq::config::class_t& info(get_class_info(*c, direct_only));
 
@@ -919,7 +1069,7 @@ Configuration::export_schema(boost::property_tree::ptree& pt, const std::string&
 
                 relationship.put("type", x.p_type);
                 relationship.put("cardinality", daq::config::relationship_t::card2str(x.p_cardinality));
-                if (!x.p_is_aggregation)
+                if (x.p_is_aggregation)
                   relationship.put("is-aggregation", x.p_is_aggregation);
                 if (!x.p_description.empty())
                   relationship.put("description", x.p_description);
@@ -934,332 +1084,878 @@ Configuration::export_schema(boost::property_tree::ptree& pt, const std::string&
       }
 }
 
+  // convert value to string in the same way as boost::property_tree
+
+template<class T>
+static std::string
+export_value(const T& val)
+{
+  if constexpr (std::is_same<T, std::string>::value)
+    return val;
+  else if constexpr (std::is_same<T, bool>::value)
+    return (val ? "true" : "false");
+  else if constexpr (std::is_floating_point<T>::value)
+    {
+      std::ostringstream s;
+      s.precision(std::numeric_limits<T>::max_digits10);
+      s << val;
+      return s.str();
+    }
+  else
+    return std::to_string(val);
+}
+
 template<class T>
 static void
-add_data(boost::property_tree::ptree &pt, const ConfigObject &obj, const daq::config::attribute_t &attribute, const std::string &empty_array_item)
+add_data(config::DataWriter& writer, const ConfigObject &obj, const daq::config::attribute_t &attribute)
 {
   auto &o = const_cast<ConfigObject&>(obj);
   if (!attribute.p_is_multi_value)
     {
       T val;
-      const_cast<ConfigObject&>(obj).get(attribute.p_name, val);
-      pt.put(attribute.p_name, val);
+      o.get(attribute.p_name, val);
+      writer.add_value(attribute.p_name, export_value(val));
     }
   else
     {
       std::vector<T> values;
       o.get(attribute.p_name, values);
 
-      boost::property_tree::ptree children;
+      std::vector<std::string> items;
+      items.reserve(values.size());
 
-      if (!values.empty())
-        for (const auto &v : values)
-          add_array_item(children, v);
-
-      else if (!empty_array_item.empty())
-        add_array_item(children, empty_array_item);
+      for (const auto &v : values)
+        {
+          // items of multi-value boolean are exported as numbers, as by previous versions
+          if constexpr (std::is_same<T, bool>::value)
+            items.emplace_back(v ? "1" : "0");
+          else
+            items.emplace_back(export_value(v));
+        }
 
-      pt.add_child(attribute.p_name, children);
+      writer.add_array(attribute.p_name, items);
     }
 }
 
 static void
-add_data(boost::property_tree::ptree &pt, const ConfigObject &obj, const daq::config::relationship_t &relationship, const std::string &empty_array_item)
+add_data(config::DataWriter& writer, const ConfigObject &obj, const daq::config::relationship_t &relationship)
 {
   if (relationship.p_cardinality == daq::config::zero_or_many || relationship.p_cardinality == daq::config::one_or_many)
     {
       std::vector<ConfigObject> values;
       const_cast<ConfigObject&>(obj).get(relationship.p_name, values);
 
-      boost::property_tree::ptree children;
+      std::vector<std::string> items;
+      items.reserve(values.size());
 
-      if (!values.empty())
-        for (const auto &v : values)
-          add_array_item(children, v.full_name());
+      for (const auto &v : values)
+        items.emplace_back(v.full_name());
 
-      else if (!empty_array_item.empty())
-        add_array_item(children, empty_array_item);
-
-      pt.add_child(relationship.p_name, children);
+      writer.add_array(relationship.p_name, items);
     }
   else
     {
       ConfigObject val;
       const_cast<ConfigObject&>(obj).get(relationship.p_name, val);
-      pt.put(relationship.p_name, !val.is_null() ? val.full_name() : "");
+      writer.add_value(relationship.p_name, !val.is_null() ? val.full_name() : "");
     }
 }
 
 void
 Configuration::export_data(boost::property_tree::ptree& pt, const std::string& classes_str, const std::string& objects_str, const std::string& files_str, const std::string& empty_array_item)
 {
-  std::unique_ptr<std::regex> classes_regex, objects_regex, files_regex;
-
-  init_regex(classes_regex, classes_str, "classes");
-  init_regex(objects_regex, objects_str, "objects");
-  init_regex(files_regex, files_str, "files");
-
-  auto cmp_str_ptr = [](const std::string * s1, const std::string * s2) { return *s1 < *s2; };
-  std::set<const std::string *, decltype(cmp_str_ptr)> sorted_classes(cmp_str_ptr);
-
-  for (const auto &c : superclasses())
-    if (classes_str.empty() || std::regex_match(*c.first, *classes_regex.get()))
-      sorted_classes.insert(c.first);
-
-  for (const auto &c : sorted_classes)
-    if (classes_str.empty() || std::regex_match(*c, *classes_regex.get()))
-      {
-        const daq::config::class_t& info(get_class_info(*c));
-
-        boost::property_tree::ptree pt_objects;
-
-        std::vector<ConfigObject> objects;
-        get(*c, objects);
+  export_data(*config::DataWriter::create(pt, empty_array_item), classes_str, objects_str, files_str);
+}
 
-        auto comp_obj_ptr = [](const ConfigObject * o1, const ConfigObject * o2) { return o1->UID() < o2->UID(); };
-        std::set<const ConfigObject *, decltype(comp_obj_ptr)> sorted_objects(comp_obj_ptr);
+void
+Configuration::export_data(std::ostream& s, const std::string& format, const std::string& classes_str, const std::string& objects_str, const std::string& files_str, bool fix_arrays, unsigned int num_of_threads, const std::string& since, bool with_files)
+{
+  export_data(*config::DataWriter::create(format, s, fix_arrays), classes_str, objects_str, files_str, num_of_threads, since, with_files);
 
-        for (const auto& x : objects)
-          if (objects_str.empty() || std::regex_match(x.UID(), *objects_regex.get()))
-            if (x.class_name() == *c)
-              if(files_str.empty() || std::regex_match(x.contained_in(), *files_regex.get()))
-                sorted_objects.insert(&x);
+  s.flush();
 
-        if (!sorted_objects.empty())
-          {
-            boost::property_tree::ptree pt_objects;
+  if (!s.good())
+    throw daq::config::Generic( ERS_HERE, "failed to write exported data" );
+}
 
-            for (const auto& x : sorted_objects)
-              {
-                boost::property_tree::ptree data;
+static void
+export_object(config::DataWriter& writer, const ConfigObject& obj, const daq::config::class_t& info, bool with_files)
+{
+  writer.begin_object(obj.UID());
 
-                for (const auto &a : info.p_attributes)
-                  switch (a.p_type)
-                    {
-                      case daq::config::bool_type:
-                              add_data<bool>(data, *x, a, empty_array_item);
-                              break;
-                      case daq::config::s8_type:
-                              add_data<int8_t>(data, *x, a, empty_array_item);
-                              break;
-                      case daq::config::u8_type:
-                              add_data<uint8_t>(data, *x, a, empty_array_item);
-                              break;
-                      case daq::config::s16_type:
-                              add_data<int16_t>(data, *x, a, empty_array_item);
-                              break;
-                      case daq::config::u16_type:
-                              add_data<uint16_t>(data, *x, a, empty_array_item);
-                              break;
-                      case daq::config::s32_type:
-                              add_data<int32_t>(data, *x, a, empty_array_item);
-                              break;
-                      case daq::config::u32_type:
-                              add_data<uint32_t>(data, *x, a, empty_array_item);
-                              break;
-                      case daq::config::s64_type:
-                              add_data<int64_t>(data, *x, a, empty_array_item);
-                              break;
-                      case daq::config::u64_type:
-                              add_data<uint64_t>(data, *x, a, empty_array_item);
-                              break;
-                      case daq::config::float_type:
-                              add_data<float>(data, *x, a, empty_array_item);
-                              break;
-                      case daq::config::double_type:
-                              add_data<double>(data, *x, a, empty_array_item);
-                              break;
-                      case daq::config::date_type:
-                      case daq::config::time_type:
-                      case daq::config::enum_type:
-                      case daq::config::class_type:
-                      case daq::config::string_type:
-                              add_data<std::string>(data, *x, a, empty_array_item);
-                              break;
-                      default:
-                              throw std::runtime_error("Invalid type of attribute " + a.p_name);
+  if (with_files)
+    writer.add_value(config::DataWriter::file_key, obj.contained_in());
 
-                    }
+  for (const auto &a : info.p_attributes)
+    switch (a.p_type)
+      {
+        case daq::config::bool_type:
+                add_data<bool>(writer, obj, a);
+                break;
+        case daq::config::s8_type:
+                add_data<int8_t>(writer, obj, a);
+                break;
+        case daq::config::u8_type:
+                add_data<uint8_t>(writer, obj, a);
+                break;
+        case daq::config::s16_type:
+                add_data<int16_t>(writer, obj, a);
+                break;
+        case daq::config::u16_type:
+                add_data<uint16_t>(writer, obj, a);
+                break;
+        case daq::config::s32_type:
+                add_data<int32_t>(writer, obj, a);
+                break;
+        case daq::config::u32_type:
+                add_data<uint32_t>(writer, obj, a);
+                break;
+        case daq::config::s64_type:
+                add_data<int64_t>(writer, obj, a);
+                break;
+        case daq::config::u64_type:
+                add_data<uint64_t>(writer, obj, a);
+                break;
+        case daq::config::float_type:
+                add_data<float>(writer, obj, a);
+                break;
+        case daq::config::double_type:
+                add_data<double>(writer, obj, a);
+                break;
+        case daq::config::date_type:
+        case daq::config::time_type:
+        case daq::config::enum_type:
+        case daq::config::class_type:
+        case daq::config::string_type:
+                add_data<std::string>(writer, obj, a);
+                break;
+        default:
+                throw std::runtime_error("Invalid type of attribute " + a.p_name);
 
-                for (const auto &r : info.p_relationships)
-                  add_data(data, *x, r, empty_array_item);
+      }
 
-                pt_objects.push_back(boost::property_tree::ptree::value_type(x->UID(), data));
-              }
+  for (const auto &r : info.p_relationships)
+    add_data(writer, obj, r);
 
-            pt.put_child(boost::property_tree::ptree::path_type(*c), pt_objects);
-          }
-      }
+  writer.end_object();
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////
 
-  //
-  // Methods to get versions
-  //
+namespace
+{
+    // records data of objects read by a thread to be written later in order of objects
 
-//////////////////////////////////////////////////////////////////////////////////////////
+  class DataRecorder : public config::DataWriter
+  {
 
+  public:
 
-std::vector<daq::config::Version>
-Configuration::get_changes()
-{
-  try
+    void begin_class(const std::string&) override { ; }
+    void end_class() override { ; }
+
+    void
+    begin_object(const std::string& id) override
     {
-      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
-      return m_impl->get_changes();
+      m_items.push_back(Item{Item::BeginObject, id, {}, {}});
     }
-  catch (daq::config::Generic& ex)
+
+    void
+    end_object() override
     {
-      throw daq::config::Generic( ERS_HERE, "failed to get new versions", ex );
+      m_items.push_back(Item{Item::EndObject, {}, {}, {}});
     }
-}
 
-
-std::vector<daq::config::Version>
-Configuration::get_versions(const std::string& since, const std::string& until, daq::config::Version::QueryType type, bool skip_irrelevant)
-{
-  try
+    void
+    add_value(const std::string& name, const std::string& value) override
     {
-      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
-      return m_impl->get_versions(since, until, type, skip_irrelevant);
+      m_items.push_back(Item{Item::Value, name, value, {}});
     }
-  catch (daq::config::Generic& ex)
+
+    void
+    add_array(const std::string& name, const std::vector<std::string>& values) override
     {
-      throw daq::config::Generic( ERS_HERE, "failed to get versions", ex );
+      m_items.push_back(Item{Item::Array, name, {}, values});
     }
-}
-
-//////////////////////////////////////////////////////////////////////////////////////////
 
-  //
-  // Subscription and notification methods
-  //
+    void
+    replay(config::DataWriter& writer) const
+    {
+      for (const auto& x : m_items)
+        switch (x.m_type)
+          {
+            case Item::BeginObject: writer.begin_object(x.m_name); break;
+            case Item::EndObject:   writer.end_object(); break;
+            case Item::Value:       writer.add_value(x.m_name, x.m_value); break;
+            case Item::Array:       writer.add_array(x.m_name, x.m_values); break;
+          }
+    }
 
-//////////////////////////////////////////////////////////////////////////////////////////
+    void
+    clear()
+    {
+      std::vector<Item>().swap(m_items);
+    }
 
+  private:
 
-  // The methods checks that given callback exists
+    struct Item
+    {
+      enum Type { BeginObject, EndObject, Value, Array } m_type;
+      std::string m_name;
+      std::string m_value;
+      std::vector<std::string> m_values;
+    };
 
-Configuration::CallbackSubscription *
-Configuration::find_callback(CallbackId cb_handler) const
-{
-  return ((!cb_handler || (m_callbacks.find(cb_handler) == m_callbacks.end())) ? 0 : cb_handler);
+    std::vector<Item> m_items;
+  };
 }
 
 
-Configuration::CallbackId
-Configuration::subscribe(const ::ConfigurationSubscriptionCriteria& criteria, notify user_cb, void * parameter)
-{
-  // check if there is no subscription function provided
+  // selected classes sorted by name
 
-  if (!user_cb)
-    {
-      throw daq::config::Generic( ERS_HERE, "callback function is not defined" );
-    }
+static std::vector<const std::string *>
+select_classes(Configuration& db, const config::Filter& classes)
+{
+  std::vector<const std::string *> selected;
 
-  // create callback subscription structure
+  for (const auto &c : db.superclasses())
+    if (classes.match(*c.first))
+      selected.push_back(c.first);
 
-  ::Configuration::CallbackSubscription * cs = new CallbackSubscription();
+  std::sort(selected.begin(), selected.end(), [](const std::string * s1, const std::string * s2) { return *s1 < *s2; });
 
-  cs->m_criteria = criteria;
-  cs->m_cb = user_cb;
-  cs->m_param = parameter;
+  return selected;
+}
 
-  // FIXME: bug in OksConfiguration subscribe() with enter_loop=true
-  std::lock_guard<std::mutex> scoped_lock(m_else_mutex);// TEST 2010-02-03
+  // return true, if the file is one of the files reported by versions (relative to repository root)
 
-  m_callbacks.insert(cs);
+static bool
+is_changed_file(const std::string& file, const std::vector<std::string>& changed_files)
+{
+  for (const auto& x : changed_files)
+    if (file.size() >= x.size() && file.compare(file.size() - x.size(), x.size(), x) == 0)
+      if (file.size() == x.size() || file[file.size() - x.size() - 1] == '/')
+        return true;
 
-  try
-    {
-      reset_subscription();
-      return cs;
-    }
-  catch (daq::config::Generic& ex)
-    {
-      m_callbacks.erase(cs);
-      delete cs;
-      throw daq::config::Generic( ERS_HERE, "subscription failed", ex );
-    }
+  return false;
 }
 
-Configuration::CallbackId
-Configuration::subscribe(pre_notify user_cb, void * parameter)
+  // selected objects of class sorted by id; if changed files are given, select only objects of these files
+
+static void
+select_objects(Configuration& db, const std::string& c, const config::Filter& objects, const config::Filter& files, std::vector<ConfigObject>& selected, const std::vector<std::string> * changed_files = nullptr)
 {
-  // check if there is no subscription function provided
+  std::vector<ConfigObject> all;
+  db.get(c, all);
 
-  if (!user_cb)
-    throw(daq::config::Generic( ERS_HERE, "callback function is not defined" ) );
+  config::map<bool> changed;
 
-  // create callback subscription structure
+  auto is_changed = [&](const std::string& file) -> bool {
+    auto i = changed.find(file);
 
-  CallbackPreSubscription * cs = new CallbackPreSubscription();
+    if (i == changed.end())
+      i = changed.emplace(file, is_changed_file(file, *changed_files)).first;
 
-  cs->m_cb = user_cb;
-  cs->m_param = parameter;
+    return i->second;
+  };
 
-  {
-    std::lock_guard<std::mutex> scoped_lock(m_else_mutex);
-    m_pre_callbacks.insert(cs);
-  }
+  for (const auto& x : all)
+    if (objects.match(x.UID()))
+      if (x.class_name() == c)
+        if (files.match(x.contained_in()))
+          if (changed_files == nullptr || is_changed(x.contained_in()))
+            selected.push_back(x);
 
-  return reinterpret_cast<CallbackSubscription *>(cs);
+  std::sort(selected.begin(), selected.end(), [](const ConfigObject& o1, const ConfigObject& o2) { return o1.UID() < o2.UID(); });
 }
 
 
 void
-Configuration::unsubscribe(CallbackId id)
+Configuration::export_data(config::DataWriter& writer, const std::string& classes_str, const std::string& objects_str, const std::string& files_str, unsigned int num_of_threads, const std::string& since, bool with_files)
 {
-  std::lock_guard < std::mutex > scoped_lock(m_else_mutex);
+  const config::Filter classes_filter(make_filter(classes_str, "classes"));
+  const config::Filter objects_filter(make_filter(objects_str, "objects"));
+  const config::Filter files_filter(make_filter(files_str, "files"));
 
-  if (id)
-    {
-      CallbackSet::iterator i = m_callbacks.find(id);
-      PreCallbackSet::iterator j = m_pre_callbacks.find(reinterpret_cast<CallbackPreSubscription *>(id));
+  const std::vector<const std::string *> sorted_classes(select_classes(*this, classes_filter));
 
-      if (i != m_callbacks.end())
-        {
-          delete id;
-          m_callbacks.erase(i);
-        }
-      else if (j != m_pre_callbacks.end())
-        {
-          delete reinterpret_cast<CallbackPreSubscription *>(id);
-          m_pre_callbacks.erase(j);
-        }
-      else
-        {
-          std::ostringstream text;
-          text << "unsubscription failed for CallbackId = " << (void *) id << " (no such callback id found)";
-          throw(daq::config::Generic( ERS_HERE, text.str().c_str() ) );
-        }
-    }
-  else
+  // the files modified by versions since given one
+
+  std::vector<std::string> changed_files;
+
+  if (!since.empty())
     {
-      for (auto &i : m_callbacks)
-        delete i;
+      std::set<std::string> files;
 
-      for (auto &i : m_pre_callbacks)
-        delete i;
+      for (const auto& v : get_versions(since, "", daq::config::Version::query_by_id, true))
+        files.insert(v.get_files().begin(), v.get_files().end());
 
-      m_callbacks.clear();
-      m_pre_callbacks.clear();
+      changed_files.assign(files.begin(), files.end());
     }
 
+  const std::vector<std::string> * changed(since.empty() ? nullptr : &changed_files);
+
+  // the mirror needs files of objects to apply tombstones
+
+  if (changed)
+    with_files = true;
+
+  writer.begin();
+
+  if (changed)
+    writer.add_tombstones(changed_files);
+
+  if (num_of_threads <= 1)
+    {
+      for (const auto &c : sorted_classes)
+        {
+          std::vector<ConfigObject> objects;
+          select_objects(*this, *c, objects_filter, files_filter, objects, changed);
+
+          if (!objects.empty())
+            {
+              const daq::config::class_t& info(get_class_info(*c));
+
+              writer.begin_class(*c);
+
+              for (const auto& x : objects)
+                export_object(writer, x, info, with_files);
+
+              writer.end_class();
+            }
+        }
+
+      writer.end();
+      return;
+    }
+
+  // The objects are read by threads in chunks of up to chunk_size objects of the same class; the data of each chunk are recorded
+  // and written by the calling thread in order of chunks, so the output does not depend on number of threads.
+  // To limit used memory, the threads do not read chunks which are more than window_size chunks ahead of the written one.
+
+  const size_t chunk_size = 256;
+  const size_t window_size = 4 * num_of_threads;
+
+  std::exception_ptr error;
+  std::mutex mutex;
+  std::condition_variable cond;
+
+  auto run = [&](std::function<void()> worker) {
+    std::vector<std::thread> threads;
+
+    for (unsigned int i = 0; i < num_of_threads; ++i)
+      threads.emplace_back([&, worker]() {
+        try
+          {
+            worker();
+          }
+        catch (...)
+          {
+            std::lock_guard<std::mutex> scoped_lock(mutex);
+
+            if (!error)
+              error = std::current_exception();
+
+            cond.notify_all();
+          }
+      });
+
+    return threads;
+  };
+
+  // read and sort objects of classes in parallel
+
+  std::vector<std::vector<ConfigObject>> objects(sorted_classes.size());
+  std::vector<const daq::config::class_t *> infos(sorted_classes.size());
+
+    {
+      std::atomic<size_t> next_class(0);
+
+      auto threads = run([&]() {
+        for (size_t idx = next_class++; idx < sorted_classes.size(); idx = next_class++)
+          {
+            select_objects(*this, *sorted_classes[idx], objects_filter, files_filter, objects[idx], changed);
+
+            if (!objects[idx].empty())
+              infos[idx] = &get_class_info(*sorted_classes[idx]);
+          }
+      });
+
+      for (auto& t : threads)
+        t.join();
+
+      if (error)
+        std::rethrow_exception(error);
+    }
+
+  struct Chunk
+  {
+    size_t m_class;
+    size_t m_begin;
+    size_t m_end;
+    DataRecorder m_data;
+    bool m_ready;
+  };
+
+  std::vector<Chunk> chunks;
+
+  for (size_t i = 0; i < objects.size(); ++i)
+    for (size_t j = 0; j < objects[i].size(); j += chunk_size)
+      chunks.push_back(Chunk{i, j, std::min(j + chunk_size, objects[i].size()), {}, false});
+
+  size_t next_chunk(0), written(0);
+
+  auto threads = run([&]() {
+    while (true)
+      {
+        size_t idx;
+
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&]() { return (error || next_chunk >= chunks.size() || next_chunk < written + window_size); });
+
+            if (error || next_chunk >= chunks.size())
+              return;
+
+            idx = next_chunk++;
+          }
+
+        Chunk& chunk(chunks[idx]);
+
+        for (size_t i = chunk.m_begin; i < chunk.m_end; ++i)
+          {
+            export_object(chunk.m_data, objects[chunk.m_class][i], *infos[chunk.m_class], with_files);
+          }
+
+          {
+            std::lock_guard<std::mutex> scoped_lock(mutex);
+            chunk.m_ready = true;
+          }
+
+        cond.notify_all();
+      }
+  });
+
+  try
+    {
+      for (size_t idx = 0; idx < chunks.size(); ++idx)
+        {
+          Chunk& chunk(chunks[idx]);
+
+            {
+              std::unique_lock<std::mutex> lock(mutex);
+              cond.wait(lock, [&]() { return (error || chunk.m_ready); });
+
+              if (error)
+                break;
+            }
+
+          if (idx == 0 || chunks[idx-1].m_class != chunk.m_class)
+            writer.begin_class(*sorted_classes[chunk.m_class]);
+
+          chunk.m_data.replay(writer);
+          chunk.m_data.clear();
+
+          if (idx + 1 == chunks.size() || chunks[idx+1].m_class != chunk.m_class)
+            {
+              writer.end_class();
+            }
+
+            {
+              std::lock_guard<std::mutex> scoped_lock(mutex);
+              written = idx + 1;
+            }
+
+          cond.notify_all();
+        }
+    }
+  catch (...)
+    {
+      std::lock_guard<std::mutex> scoped_lock(mutex);
+
+      if (!error)
+        error = std::current_exception();
+
+      cond.notify_all();
+    }
+
+  for (auto& t : threads)
+    t.join();
+
+  if (error)
+    std::rethrow_exception(error);
+
+  writer.end();
+}
+
+uint64_t
+Configuration::export_columns(const std::string& directory, const std::string& classes_str, const std::string& objects_str, const std::string& files_str, unsigned int num_of_threads)
+{
+  const config::Filter classes_filter(make_filter(classes_str, "classes"));
+  const config::Filter objects_filter(make_filter(objects_str, "objects"));
+  const config::Filter files_filter(make_filter(files_str, "files"));
+
+  const std::vector<const std::string *> sorted_classes(select_classes(*this, classes_filter));
+
+  std::atomic<size_t> next_class(0);
+  std::atomic<uint64_t> number_of_objects(0);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  auto worker = [&]() {
+    try
+      {
+        for (size_t idx = next_class++; idx < sorted_classes.size(); idx = next_class++)
+          {
+            const std::string& c(*sorted_classes[idx]);
+
+            std::vector<ConfigObject> objects;
+            select_objects(*this, c, objects_filter, files_filter, objects);
+
+            if (!objects.empty())
+              {
+                config::columns::write(get_class_info(c), objects, directory + '/' + c + ".columns");
+                number_of_objects += objects.size();
+              }
+          }
+      }
+    catch (...)
+      {
+        std::lock_guard<std::mutex> scoped_lock(error_mutex);
+
+        if (!error)
+          error = std::current_exception();
+
+        next_class = sorted_classes.size();
+      }
+  };
+
+  std::vector<std::thread> threads;
+
+  for (unsigned int i = 1; i < std::min<size_t>(num_of_threads, sorted_classes.size()); ++i)
+    threads.emplace_back(worker);
+
+  worker();
+
+  for (auto& t : threads)
+    t.join();
+
+  if (error)
+    std::rethrow_exception(error);
+
+  return number_of_objects;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+  //
+  // Methods to get versions
+  //
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+std::vector<daq::config::Version>
+Configuration::get_changes()
+{
+  try
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+      return m_impl->get_changes();
+    }
+  catch (daq::config::Generic& ex)
+    {
+      throw daq::config::Generic( ERS_HERE, "failed to get new versions", ex );
+    }
+}
+
+
+std::vector<daq::config::Version>
+Configuration::get_versions(const std::string& since, const std::string& until, daq::config::Version::QueryType type, bool skip_irrelevant)
+{
+  try
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+      return m_impl->get_versions(since, until, type, skip_irrelevant);
+    }
+  catch (daq::config::Generic& ex)
+    {
+      throw daq::config::Generic( ERS_HERE, "failed to get versions", ex );
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+  //
+  // Subscription and notification methods
+  //
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+
+  // The methods checks that given callback exists
+
+Configuration::CallbackSubscription *
+Configuration::find_callback(CallbackId cb_handler) const
+{
+  return ((!cb_handler || (m_callbacks.find(cb_handler) == m_callbacks.end())) ? 0 : cb_handler);
+}
+
+
+Configuration::CallbackId
+Configuration::subscribe(const ::ConfigurationSubscriptionCriteria& criteria, notify user_cb, void * parameter)
+{
+  return subscribe(criteria, user_cb, parameter, std::chrono::milliseconds(0));
+}
+
+Configuration::CallbackId
+Configuration::subscribe(const ::ConfigurationSubscriptionCriteria& criteria, notify user_cb, void * parameter, std::chrono::milliseconds window, unsigned int max_changes)
+{
+  // check if there is no subscription function provided
+
+  if (!user_cb)
+    {
+      throw daq::config::Generic( ERS_HERE, "callback function is not defined" );
+    }
+
+  return add_subscription(criteria, user_cb, nullptr, parameter, window, max_changes);
+}
+
+Configuration::CallbackId
+Configuration::subscribe(const ::ConfigurationSubscriptionCriteria& criteria, notify_view user_cb, void * parameter, std::chrono::milliseconds window, unsigned int max_changes)
+{
+  if (!user_cb)
+    {
+      throw daq::config::Generic( ERS_HERE, "callback function is not defined" );
+    }
+
+  return add_subscription(criteria, nullptr, user_cb, parameter, window, max_changes);
+}
+
+Configuration::CallbackId
+Configuration::add_subscription(const ::ConfigurationSubscriptionCriteria& criteria, notify user_cb, notify_view user_view_cb, void * parameter, std::chrono::milliseconds window, unsigned int max_changes)
+{
+  // create callback subscription structure
+
+  ::Configuration::CallbackSubscription * cs = new CallbackSubscription();
+
+  cs->m_criteria = criteria;
+  cs->m_cb = user_cb;
+  cs->m_view_cb = user_view_cb;
+  cs->m_param = parameter;
+  cs->m_window = window;
+  cs->m_max_changes = max_changes;
+
+  // FIXME: bug in OksConfiguration subscribe() with enter_loop=true
+  std::lock_guard<std::mutex> scoped_lock(m_else_mutex);// TEST 2010-02-03
+
+  m_callbacks.insert(cs);
+
+  add_queue(cs);
+
   try
     {
       reset_subscription();
+      return cs;
     }
   catch (daq::config::Generic& ex)
     {
-      throw daq::config::Generic( ERS_HERE, "unsubscription failed", ex );
+      m_callbacks.erase(cs);
+      index_subscriptions();
+      if (cs->m_queue)
+        m_dispatcher->remove(cs->m_queue);
+      delete cs;
+      throw daq::config::Generic( ERS_HERE, "subscription failed", ex );
+    }
+}
+
+Configuration::CallbackId
+Configuration::subscribe(pre_notify user_cb, void * parameter)
+{
+  // check if there is no subscription function provided
+
+  if (!user_cb)
+    throw(daq::config::Generic( ERS_HERE, "callback function is not defined" ) );
+
+  // create callback subscription structure
+
+  CallbackPreSubscription * cs = new CallbackPreSubscription();
+
+  cs->m_cb = user_cb;
+  cs->m_param = parameter;
+
+  {
+    std::lock_guard<std::mutex> scoped_lock(m_else_mutex);
+    m_pre_callbacks.insert(cs);
+  }
+
+  return reinterpret_cast<CallbackSubscription *>(cs);
+}
+
+
+void
+Configuration::unsubscribe(CallbackId id)
+{
+  std::vector<CallbackSubscription *> removed;
+  std::shared_ptr<config::NotificationDispatcher> dispatcher;
+  std::unique_ptr<daq::config::Generic> error;
+
+    {
+      std::lock_guard < std::mutex > scoped_lock(m_else_mutex);
+
+      if (id)
+        {
+          CallbackSet::iterator i = m_callbacks.find(id);
+          PreCallbackSet::iterator j = m_pre_callbacks.find(reinterpret_cast<CallbackPreSubscription *>(id));
+
+          if (i != m_callbacks.end())
+            {
+              removed.push_back(id);
+              m_callbacks.erase(i);
+            }
+          else if (j != m_pre_callbacks.end())
+            {
+              delete reinterpret_cast<CallbackPreSubscription *>(id);
+              m_pre_callbacks.erase(j);
+            }
+          else
+            {
+              std::ostringstream text;
+              text << "unsubscription failed for CallbackId = " << (void *) id << " (no such callback id found)";
+              throw(daq::config::Generic( ERS_HERE, text.str().c_str() ) );
+            }
+        }
+      else
+        {
+          removed.assign(m_callbacks.begin(), m_callbacks.end());
+
+          for (auto &i : m_pre_callbacks)
+            delete i;
+
+          m_callbacks.clear();
+          m_pre_callbacks.clear();
+        }
+
+      dispatcher = m_dispatcher;
+
+      try
+        {
+          reset_subscription();
+        }
+      catch (daq::config::Generic& ex)
+        {
+          error.reset(new daq::config::Generic( ERS_HERE, "unsubscription failed", ex ));
+        }
+    }
+
+  // remove queues of asynchronous notification without lock, since the callback in progress may use the mutex
+
+  for (auto &i : removed)
+    {
+      if (i->m_queue)
+        dispatcher->remove(i->m_queue);
+
+      delete i;
+    }
+
+  if (error)
+    throw *error;
+}
+
+
+void
+Configuration::set_async_notification(unsigned int num_of_threads, unsigned int queue_limit)
+{
+  // no notifications are queued until the new dispatcher is published
+  std::lock_guard<std::mutex> dispatch_lock(m_dispatch_mutex);
+
+  std::shared_ptr<config::NotificationDispatcher> old;
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_else_mutex);
+
+      old.swap(m_dispatcher);
+
+      m_async_threads = num_of_threads;
+      m_async_queue_limit = queue_limit;
+
+      for (auto &i : m_callbacks)
+        i->m_queue = 0;
+    }
+
+  // deliver notifications queued by previous dispatcher; do not lock the subscription mutex
+  // while waiting, since the callbacks in progress may use it
+  if (old)
+    {
+      old->stop();
+    }
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_else_mutex);
+
+      // the subscriptions added meanwhile already have queues
+      for (auto &i : m_callbacks)
+        if (i->m_queue == 0)
+          add_queue(i);
     }
 }
 
+
+void
+Configuration::add_queue(CallbackSubscription * cs)
+{
+  if (m_async_threads == 0 && cs->m_window.count() == 0)
+    return;
+
+  if (!m_dispatcher)
+    m_dispatcher = std::make_shared<config::NotificationDispatcher>(std::max(m_async_threads, 1U), m_async_queue_limit);
+
+  cs->m_queue = m_dispatcher->add(cs->m_window, cs->m_max_changes);
+}
+
+
+bool
+Configuration::get_notification_metrics(CallbackId id, config::NotificationMetrics& metrics) const
+{
+  std::lock_guard<std::mutex> scoped_lock(m_else_mutex);
+
+  const CallbackSubscription * cs = find_callback(id);
+
+  return (m_dispatcher && cs && cs->m_queue && m_dispatcher->get_metrics(cs->m_queue, metrics));
+}
+
+void
+Configuration::get_notification_latency(config::NotificationLatency& latency) const
+{
+  std::lock_guard<std::mutex> scoped_lock(m_latency_mutex);
+  latency = m_latency;
+}
+
+bool
+Configuration::get_callback_latency(CallbackId id, config::LatencyHistogram& latency) const
+{
+  std::lock_guard<std::mutex> scoped_lock(m_else_mutex);
+
+  const CallbackSubscription * cs = find_callback(id);
+
+  if (cs == nullptr)
+    return false;
+
+  latency = cs->m_latency;
+
+  config::NotificationMetrics metrics;
+
+  if (m_dispatcher && cs->m_queue && m_dispatcher->get_metrics(cs->m_queue, metrics))
+    latency.merge(metrics.m_duration);
+
+  return true;
+}
+
 void
 Configuration::reset_subscription()
 {
+  index_subscriptions();
+
   // check that there is no at least one subscription
   // if NO, then unsubscribe
 
@@ -1326,6 +2022,7 @@ Configuration::update_impl_objects(config::pmap<config::map<ConfigObjectImpl *>
                   std::lock_guard<std::mutex> scoped_lock(j->second->m_mutex);
                   j->second->m_state = daq::config::Deleted;
                   j->second->clear();
+                  j->second->m_generation++;
                 }
             }
         }
@@ -1346,6 +2043,7 @@ Configuration::update_impl_objects(config::pmap<config::map<ConfigObjectImpl *>
 
                   std::lock_guard<std::mutex> scoped_lock(j->second->m_mutex);
                   j->second->reset(); // it does not matter what the state was, always reset
+                  j->second->m_generation++;
                 }
             }
         }
@@ -1370,6 +2068,8 @@ Configuration::update_impl_objects(config::pmap<config::map<ConfigObjectImpl *>
                     j->second->reset();
                   else
                     j->second->clear();
+
+                  j->second->m_generation++;
                 }
             }
         }
@@ -1384,31 +2084,14 @@ Configuration::update_cache(std::vector<ConfigurationChange *>& changes) noexcep
 {
   TLOG_DEBUG(3) << "*** Enter Configuration::update_cache() with changes:\n" << changes;
 
-  // Remove deleted and update modified implementation objects first
-  for (const auto& i : changes)
-    {
-      const std::string * class_name = &DalFactory::instance().get_known_class_name_ref(i->get_class_name());
-
-      update_impl_objects(m_impl->m_impl_objects, *i, class_name);
-
-      // delete/update implementation objects defined in superclasses
-      config::fmap<config::fset>::const_iterator sc = p_superclasses.find(class_name);
-
-      if (sc != p_superclasses.end())
-        for (const auto &c : sc->second)
-          update_impl_objects(m_impl->m_impl_objects, *i, c);
+  // Remove deleted and update modified implementation objects (including ones defined in superclasses and subclasses) first
+  m_impl->update_impl_objects(changes);
 
-      // delete/update implementation objects defined in subclasses
-      sc = p_subclasses.find(class_name);
-
-      if (sc != p_subclasses.end())
-        for (const auto &c : sc->second)
-          update_impl_objects(m_impl->m_impl_objects, *i, c);
-    }
+  p_generation++;
 
   for (const auto& i : changes)
     {
-      const std::string * class_name = &DalFactory::instance().get_known_class_name_ref(i->get_class_name()); // FIXME: optimise with above
+      const std::string * class_name = get_class_name_ref(i->get_class_name());
 
       // invoke configuration update if there are template objects of given class
 
@@ -1428,44 +2111,135 @@ Configuration::update_cache(std::vector<ConfigurationChange *>& changes) noexcep
         {
           config::fmap<config::fset>::const_iterator sc = p_superclasses.find(class_name);
 
-          if (sc != p_superclasses.end())
-            {
-              for (const auto& c : sc->second)
-                {
-                  config::fmap<CacheBase*>::iterator j = m_cache_map.find(c);
+          if (sc != p_superclasses.end())
+            {
+              for (const auto& c : sc->second)
+                {
+                  config::fmap<CacheBase*>::iterator j = m_cache_map.find(c);
+
+                  if (j != m_cache_map.end())
+                    {
+                      TLOG_DEBUG(3) << " * call update on \'" << j->first << "\' template objects (as super-class of \'" << *class_name << "\')";
+                      j->second->m_functions.m_update_fn(*this, i);
+                    }
+                }
+            }
+        }
+
+
+      // invoke configuration update if there are template objects in sub-classes
+
+        {
+          config::fmap<config::fset>::const_iterator sc = p_subclasses.find(class_name);
+
+          if (sc != p_subclasses.end())
+            {
+              for (const auto& c : sc->second)
+                {
+                  config::fmap<CacheBase*>::iterator j = m_cache_map.find(c);
+
+                  if (j != m_cache_map.end())
+                    {
+                      TLOG_DEBUG(3) << " * call update on \'" << j->first << "\' template objects (as sub-class of \'" << *class_name << "\')";
+                      j->second->m_functions.m_update_fn(*this, i);
+                    }
+                }
+            }
+        }
+
+    }
+
+}
+
+
+void
+Configuration::index_subscriptions()
+{
+  m_subscribe_all.clear();
+  m_class_subscriptions.clear();
+  m_object_subscriptions.clear();
+
+  for (const auto &i : m_callbacks)
+    {
+      if (i->m_criteria.get_classes_subscription().empty() && i->m_criteria.get_objects_subscription().empty())
+        {
+          m_subscribe_all.push_back(i);
+          continue;
+        }
+
+      for (const auto &j : i->m_criteria.get_classes_subscription())
+        m_class_subscriptions[j].push_back(i);
+
+      for (const auto &j : i->m_criteria.get_objects_subscription())
+        {
+          config::map<std::vector<CallbackSubscription *>>& objs(m_object_subscriptions[j.first]);
+
+          for (const auto &k : j.second)
+            objs[k].push_back(i);
+        }
+    }
+}
+
+
+void
+Configuration::route_changes(const std::shared_ptr<const ConfigurationChangeSet>& changes, RoutedChanges& result) const
+{
+  // get view of changes for subscription; the view is created on first match, so it is never empty
+
+  auto get = [&result, &changes](CallbackSubscription * cs) -> ConfigurationChangeView& {
+    auto it = result.find(cs);
+
+    if (it == result.end())
+      it = result.emplace(cs, ConfigurationChangeView(changes)).first;
+
+    return it->second;
+  };
+
+  for (uint32_t idx = 0; idx < changes->get_changes().size(); ++idx)
+    {
+      const ConfigurationChange * i = changes->get_changes()[idx];
+      const std::string &cname = i->get_class_name();
+
+      auto add_all = [&get, idx](CallbackSubscription * cs) {
+        get(cs).add(idx);
+      };
+
+      if (i->m_modified.empty() && i->m_created.empty() && i->m_removed.empty())
+        continue;
 
-                  if (j != m_cache_map.end())
-                    {
-                      TLOG_DEBUG(3) << " * call update on \'" << j->first << "\' template objects (as super-class of \'" << *class_name << "\')";
-                      j->second->m_functions.m_update_fn(*this, i);
-                    }
-                }
-            }
-        }
+      for (const auto &cs : m_subscribe_all)
+        if (cs->m_queue)
+          add_all(cs);
 
+      auto p = m_class_subscriptions.find(cname);
 
-      // invoke configuration update if there are template objects in sub-classes
+      if (p != m_class_subscriptions.end())
+        for (const auto &cs : p->second)
+          add_all(cs);
 
+      auto q = m_object_subscriptions.find(cname);
+
+      if (q != m_object_subscriptions.end())
         {
-          config::fmap<config::fset>::const_iterator sc = p_subclasses.find(class_name);
+          for (uint32_t obj = 0; obj < i->m_modified.size(); ++obj)
+            {
+              auto r = q->second.find(i->m_modified[obj]);
 
-          if (sc != p_subclasses.end())
+              if (r != q->second.end())
+                for (const auto &cs : r->second)
+                  get(cs).add_modified(idx, obj);
+            }
+
+          for (uint32_t obj = 0; obj < i->m_removed.size(); ++obj)
             {
-              for (const auto& c : sc->second)
-                {
-                  config::fmap<CacheBase*>::iterator j = m_cache_map.find(c);
+              auto r = q->second.find(i->m_removed[obj]);
 
-                  if (j != m_cache_map.end())
-                    {
-                      TLOG_DEBUG(3) << " * call update on \'" << j->first << "\' template objects (as sub-class of \'" << *class_name << "\')";
-                      j->second->m_functions.m_update_fn(*this, i);
-                    }
-                }
+              if (r != q->second.end())
+                for (const auto &cs : r->second)
+                  get(cs).add_removed(idx, obj);
             }
         }
-
     }
-
 }
 
 
@@ -1478,6 +2252,8 @@ Configuration::system_cb(std::vector<ConfigurationChange *>& changes, Configurat
     "*** Number of user subscriptions: " << conf->m_callbacks.size()
   ;
 
+  const std::chrono::steady_clock::time_point started(std::chrono::steady_clock::now());
+
   // call config actions if any
   {
     std::lock_guard<std::mutex> scoped_lock(conf->m_impl_mutex);
@@ -1486,6 +2262,7 @@ Configuration::system_cb(std::vector<ConfigurationChange *>& changes, Configurat
       i->notify(changes);
   }
 
+  const std::chrono::steady_clock::time_point actions_done(std::chrono::steady_clock::now());
 
   // update template objects in cache
   {
@@ -1494,148 +2271,152 @@ Configuration::system_cb(std::vector<ConfigurationChange *>& changes, Configurat
     conf->update_cache(changes);
   }
 
+  const std::chrono::steady_clock::time_point cache_done(std::chrono::steady_clock::now());
+
+  // add durations of stages to histograms
+  auto done = [&]() {
+    const std::chrono::steady_clock::time_point now(std::chrono::steady_clock::now());
+
+    std::lock_guard<std::mutex> scoped_lock(conf->m_latency_mutex);
+    conf->m_latency.m_actions.add(actions_done - started);
+    conf->m_latency.m_cache_update.add(cache_done - actions_done);
+    conf->m_latency.m_callbacks.add(now - cache_done);
+    conf->m_latency.m_total.add(now - started);
+  };
+
+  // always take ownership of the changes (see ConfigurationImpl::notify) to share them by subscribers;
+  // the asynchronous ones may access them later, otherwise the changes are destroyed on return
+  std::shared_ptr<const ConfigurationChangeSet> shared(std::make_shared<ConfigurationChangeSet>(changes));
 
   // user removed all subscriptions
-  if(conf->m_callbacks.empty()) return;
+  if(conf->m_callbacks.empty())
+    {
+      done();
+      return;
+    }
+
+  auto complete_view = [&shared]() {
+    ConfigurationChangeView view(shared);
+
+    for (uint32_t i = 0; i < shared->get_changes().size(); ++i)
+      view.add(i);
+
+    return view;
+  };
+
+  // the dispatcher cannot be replaced until the notifications are queued (see set_async_notification())
+  std::lock_guard<std::mutex> dispatch_lock(conf->m_dispatch_mutex);
 
   // note, one cannot lock m_tmpl_mutex or m_impl_mutex here,
   // since user callback may call arbitrary get() methods to access config
   // and template objects locking above two mutexes
-  std::lock_guard<std::mutex> scoped_lock(conf->m_else_mutex);
+  std::unique_lock<std::mutex> lock(conf->m_else_mutex);
 
-  // check if there is only one subscription
-  if (conf->m_callbacks.size() == 1)
+  // check if there is only one synchronous subscription
+  if (conf->m_callbacks.size() == 1 && (*conf->m_callbacks.begin())->m_queue == 0)
     {
       auto j = *conf->m_callbacks.begin();
-      (*(j->m_cb))(changes, j->m_param);
+
+      const std::chrono::steady_clock::time_point invoked(std::chrono::steady_clock::now());
+
+      if (j->m_view_cb)
+        (*(j->m_view_cb))(complete_view(), j->m_param);
+      else
+        (*(j->m_cb))(shared->get_changes(), j->m_param);
+
+      j->m_latency.add(std::chrono::steady_clock::now() - invoked);
+
+      done();
+
+      TLOG_DEBUG(3) <<"*** Leave Configuration::system_cb()";
+      return;
     }
-  // may need to calculate the changes for each subscription
-  else
-    {
-      for (const auto &j : conf->m_callbacks)
-        {
 
-          if (ers::debug_level() >= 3)
-            {
-              std::ostringstream text;
+  // calculate the views of changes for each subscription using index of subscriptions;
+  // the synchronous subscriptions on any changes use all changes
+  RoutedChanges routed;
+  conf->route_changes(shared, routed);
 
-              text <<
-                  "*** Process subscription " << (void*) j << "\n"
-                  " class subscription done for " << j->m_criteria.get_classes_subscription().size() << " classes:\n";
+  std::unique_ptr<ConfigurationChangeView> all;
 
-              for (const auto &i1 : j->m_criteria.get_classes_subscription())
-                text << " * class \"" << i1 << "\"\n";
+  struct Notification
+  {
+    uint64_t m_queue;
+    notify m_cb;
+    notify_view m_view_cb;
+    void * m_param;
+    ConfigurationChangeView m_changes;
+  };
 
-              text << " object subscription done in " << j->m_criteria.get_objects_subscription().size() << " classes:\n";
+  std::vector<Notification> notifications;
 
-              for (const auto &i2 : j->m_criteria.get_objects_subscription())
-                {
-                  text << " * class \"" << (i2.first) << "\":\n";
-                  for (const auto &i3 : i2.second)
-                    text << "  - \"" << i3 << "\"\n";
-                }
+  for (const auto &j : conf->m_callbacks)
+    {
+      const bool subscribe_all(j->m_criteria.get_classes_subscription().empty() && j->m_criteria.get_objects_subscription().empty());
 
-              TLOG_DEBUG(3) << text.str();
-            }
+      auto it = routed.find(j);
 
-          if (j->m_criteria.get_classes_subscription().empty() && j->m_criteria.get_objects_subscription().empty())
-            {
-              try
-                {
-                  TLOG_DEBUG(3) << "*** Invoke callback " << (void *)j << " with\n" << changes;
-                  (*(j->m_cb))(changes, j->m_param);
-                }
-              catch (const ers::Issue &ex)
-                {
-                  ers::error(daq::config::Generic( ERS_HERE, "user callback thrown ers exception", ex));
-                }
-              catch (const std::exception &ex)
-                {
-                  ers::error(daq::config::Generic( ERS_HERE, "user callback thrown std exception", ex));
-                }
-              catch (...)
-                {
-                  ers::error(daq::config::Generic( ERS_HERE, "user callback thrown unknown exception"));
-                }
-            }
-          else
-            {
-              std::vector<ConfigurationChange*> changes1;
+      if (it == routed.end() && (j->m_queue || !subscribe_all))
+        continue;
 
-              for (const auto &i : changes)
-                {
-                  const std::string &cname = i->get_class_name();
-                  ConfigurationChange *class_changes = nullptr;
+      // queue changes, if the notification of subscription is asynchronous
+      if (j->m_queue)
+        {
+          notifications.push_back(Notification { j->m_queue, j->m_cb, j->m_view_cb, j->m_param, std::move(it->second) });
+          continue;
+        }
 
-                  ::ConfigurationSubscriptionCriteria::ObjectMap::const_iterator p = j->m_criteria.get_objects_subscription().find(cname);
-                  const bool found_obj_subscription(p != j->m_criteria.get_objects_subscription().end());
-                  const bool found_class_subscription(j->m_criteria.get_classes_subscription().find(cname) != j->m_criteria.get_classes_subscription().end());
+      if (subscribe_all && !all)
+        all.reset(new ConfigurationChangeView(complete_view()));
 
-                  if (found_class_subscription || found_obj_subscription)
-                    class_changes = new ConfigurationChange(cname);
+      invoke(j, subscribe_all ? *all : it->second);
+    }
 
-                  if (found_class_subscription)
-                    {
-                      for (const auto &k : i->m_modified)
-                        class_changes->m_modified.push_back(k);
+  if (!notifications.empty())
+    {
+      std::shared_ptr<config::NotificationDispatcher> dispatcher(conf->m_dispatcher);
 
-                      for (const auto &k : i->m_created)
-                        class_changes->m_created.push_back(k);
+      // the queue of slow subscriber can be full, so do not block subscription mutex while waiting
+      lock.unlock();
 
-                      for (const auto &k : i->m_removed)
-                        class_changes->m_removed.push_back(k);
-                    }
+      for (auto &n : notifications)
+        dispatcher->push(n.m_queue, n.m_cb, n.m_view_cb, n.m_param, std::move(n.m_changes));
+    }
 
-                  if (found_obj_subscription)
-                    {
-                      for (const auto &obj_id : i->m_modified)
-                        if (p->second.find(obj_id) != p->second.end())
-                          class_changes->m_modified.push_back(obj_id);
+  done();
 
-                      for (const auto &obj_id : i->m_removed)
-                        if (p->second.find(obj_id) != p->second.end())
-                          class_changes->m_removed.push_back(obj_id);
-                    }
+  TLOG_DEBUG(3) <<"*** Leave Configuration::system_cb()";
+}
 
-                  // the changes for given class can be empty if there is subscription on objects of given class, but no such objects were modified
-                  if (class_changes)
-                    {
-                      if (class_changes->m_modified.empty() && class_changes->m_created.empty() && class_changes->m_removed.empty())
-                        delete class_changes;
-                      else
-                        changes1.push_back(class_changes);
-                    }
-                }
 
-              if (!changes1.empty())
-                {
-                  TLOG_DEBUG(3) << "*** Invoke callback " << (void *)j << " with\n" << changes1;
+void
+Configuration::invoke(CallbackSubscription * cs, const ConfigurationChangeView& changes) noexcept
+{
+  TLOG_DEBUG(3) << "*** Invoke callback " << (void *)cs << " with\n" << changes;
 
-                  try
-                    {
-                      (*(j->m_cb))(changes1, j->m_param);
-                    }
-                  catch (const ers::Issue &ex)
-                    {
-                      ers::error(daq::config::Generic( ERS_HERE, "user callback thrown ers exception", ex));
-                    }
-                  catch (const std::exception &ex)
-                    {
-                      ers::error(daq::config::Generic( ERS_HERE, "user callback thrown std exception", ex));
-                    }
-                  catch (...)
-                    {
-                      ers::error(daq::config::Generic( ERS_HERE, "user callback thrown unknown exception"));
-                    }
+  const std::chrono::steady_clock::time_point invoked(std::chrono::steady_clock::now());
 
-                  for (const auto &i : changes1)
-                    delete i;
-                }
-            }
-        }
+  try
+    {
+      if (cs->m_view_cb)
+        (*(cs->m_view_cb))(changes, cs->m_param);
+      else
+        (*(cs->m_cb))(changes.get_changes(), cs->m_param);
+    }
+  catch (const ers::Issue &ex)
+    {
+      ers::error(daq::config::Generic( ERS_HERE, "user callback thrown ers exception", ex));
+    }
+  catch (const std::exception &ex)
+    {
+      ers::error(daq::config::Generic( ERS_HERE, "user callback thrown std exception", ex));
+    }
+  catch (...)
+    {
+      ers::error(daq::config::Generic( ERS_HERE, "user callback thrown unknown exception"));
     }
 
-  TLOG_DEBUG(3) <<"*** Leave Configuration::system_cb()";
+  cs->m_latency.add(std::chrono::steady_clock::now() - invoked);
 }
 
 
@@ -1644,29 +2425,60 @@ Configuration::system_pre_cb(Configuration * conf) noexcept
 {
   TLOG_DEBUG(3) <<"*** Enter Configuration::system_pre_cb()";
 
-  std::lock_guard<std::mutex> scoped_lock(conf->m_else_mutex);
+  const std::chrono::steady_clock::time_point started(std::chrono::steady_clock::now());
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(conf->m_else_mutex);
+
+      for(auto& j : conf->m_pre_callbacks)
+        {
+          TLOG_DEBUG(3) << "*** Invoke callback " << (void *)(j);
+          (*(j->m_cb))(j->m_param);
+        }
+    }
 
-  for(auto& j : conf->m_pre_callbacks)
     {
-      TLOG_DEBUG(3) << "*** Invoke callback " << (void *)(j);
-      (*(j->m_cb))(j->m_param);
+      std::lock_guard<std::mutex> scoped_lock(conf->m_latency_mutex);
+      conf->m_latency.m_pre_notify.add(std::chrono::steady_clock::now() - started);
     }
 
   TLOG_DEBUG(3) <<"*** Leave Configuration::system_pre_cb()";
 }
 
 
+static ConfigurationChange *
+find_class_changes(std::vector<ConfigurationChange*> &changes, const std::string &class_name)
+{
+  for (const auto &c : changes)
+    if (class_name == c->get_class_name())
+      return c;
+
+  return nullptr;
+}
+
 void
 ConfigurationChange::add(std::vector<ConfigurationChange*> &changes, const std::string &class_name, const std::string &obj_name, const char action)
 {
-  ConfigurationChange *class_changes = nullptr;
+  ConfigurationChange *class_changes = find_class_changes(changes, class_name);
 
-  for (const auto &c : changes)
-    if (class_name == c->get_class_name())
-      {
-        class_changes = c;
-        break;
-      }
+  if (!class_changes)
+    {
+      class_changes = new ConfigurationChange(class_name);
+      changes.push_back(class_changes);
+    }
+
+  if (action == '+')
+    class_changes->m_created.push_back(obj_name);
+  else if (action == '-')
+    class_changes->m_removed.push_back(obj_name);
+  else
+    class_changes->add_modified(obj_name, nullptr, true);
+}
+
+void
+ConfigurationChange::add(std::vector<ConfigurationChange*> &changes, const std::string &class_name, const std::string &obj_name, const std::vector<std::string>& names)
+{
+  ConfigurationChange *class_changes = find_class_changes(changes, class_name);
 
   if (!class_changes)
     {
@@ -1674,13 +2486,45 @@ ConfigurationChange::add(std::vector<ConfigurationChange*> &changes, const std::
       changes.push_back(class_changes);
     }
 
-  std::vector<std::string>& clist = (
-    action == '+' ? class_changes->m_created :
-    action == '-' ? class_changes->m_removed :
-    class_changes->m_modified
+  const bool is_new = (
+    class_changes->m_modified_attributes.find(obj_name) == class_changes->m_modified_attributes.end() &&
+    std::find(class_changes->m_modified.begin(), class_changes->m_modified.end(), obj_name) == class_changes->m_modified.end()
   );
 
-  clist.push_back(obj_name);
+  class_changes->add_modified(obj_name, &names, is_new);
+}
+
+  // the names of object added as modified without names are unknown
+
+void
+ConfigurationChange::add_modified(const std::string &obj_name, const std::vector<std::string> * names, bool is_new)
+{
+  if (is_new)
+    {
+      m_modified.push_back(obj_name);
+
+      if (names)
+        m_modified_attributes[obj_name] = *names;
+      else if (!m_modified_attributes.empty())
+        m_modified_attributes.erase(obj_name);
+
+      return;
+    }
+
+  config::map<std::vector<std::string>>::iterator i = m_modified_attributes.find(obj_name);
+
+  if (i == m_modified_attributes.end())
+    return;
+
+  if (!names)
+    {
+      m_modified_attributes.erase(i);
+      return;
+    }
+
+  for (const auto &x : *names)
+    if (std::find(i->second.begin(), i->second.end(), x) == i->second.end())
+      i->second.push_back(x);
 }
 
 
@@ -1694,6 +2538,172 @@ ConfigurationChange::clear(std::vector<ConfigurationChange*> &changes)
 }
 
 
+ConfigurationChangeBuilder::~ConfigurationChangeBuilder()
+{
+  ConfigurationChange::clear(m_changes);
+}
+
+
+ConfigurationChangeBuilder::ClassChanges&
+ConfigurationChangeBuilder::get(const std::string &class_name)
+{
+  ClassChanges& c = m_classes[class_name];
+
+  if (!c.m_change)
+    {
+      c.m_change = new ConfigurationChange(class_name);
+      m_changes.push_back(c.m_change);
+    }
+
+  return c;
+}
+
+
+void
+ConfigurationChangeBuilder::add(const std::string &class_name, const std::string &obj_name, const char action)
+{
+  ClassChanges& c = get(class_name);
+
+  if (action == '+')
+    {
+      if (c.m_created.insert(obj_name).second)
+        c.m_change->m_created.push_back(obj_name);
+    }
+  else if (action == '-')
+    {
+      if (c.m_removed.insert(obj_name).second)
+        c.m_change->m_removed.push_back(obj_name);
+    }
+  else
+    {
+      c.m_change->add_modified(obj_name, nullptr, c.m_modified.insert(obj_name).second);
+    }
+}
+
+
+void
+ConfigurationChangeBuilder::add(const std::string &class_name, const std::string &obj_name, const std::vector<std::string>& names)
+{
+  ClassChanges& c = get(class_name);
+  c.m_change->add_modified(obj_name, &names, c.m_modified.insert(obj_name).second);
+}
+
+
+void
+ConfigurationChangeBuilder::build(std::vector<ConfigurationChange*> &changes)
+{
+  if (changes.empty())
+    changes.swap(m_changes);
+  else
+    changes.insert(changes.end(), m_changes.begin(), m_changes.end());
+
+  m_changes.clear();
+  m_classes.clear();
+}
+
+
+ConfigurationChangeView::ConfigurationChangeView(std::vector<ConfigurationChange*> &changes) :
+  m_set(std::make_shared<ConfigurationChangeSet>(changes))
+{
+  for (uint32_t i = 0; i < m_set->get_changes().size(); ++i)
+    add(i);
+}
+
+
+ConfigurationChangeView::~ConfigurationChangeView()
+{
+  clear_adapted();
+}
+
+
+void
+ConfigurationChangeView::clear_adapted()
+{
+  ConfigurationChange::clear(m_owned);
+  m_changes.clear();
+  m_adapted = false;
+}
+
+
+ConfigurationChangeView::ClassView *
+ConfigurationChangeView::get(uint32_t cls)
+{
+  if (m_adapted)
+    clear_adapted();
+
+  if (m_classes.empty() || m_classes.back().m_class != cls)
+    m_classes.push_back(ClassView { cls, false, {}, {} });
+
+  return &m_classes.back();
+}
+
+
+void
+ConfigurationChangeView::add(uint32_t cls)
+{
+  ClassView * v = get(cls);
+
+  v->m_complete = true;
+  v->m_modified.clear();
+  v->m_removed.clear();
+}
+
+
+void
+ConfigurationChangeView::add_modified(uint32_t cls, uint32_t obj)
+{
+  ClassView * v = get(cls);
+
+  if (!v->m_complete)
+    v->m_modified.push_back(obj);
+}
+
+
+void
+ConfigurationChangeView::add_removed(uint32_t cls, uint32_t obj)
+{
+  ClassView * v = get(cls);
+
+  if (!v->m_complete)
+    v->m_removed.push_back(obj);
+}
+
+
+const std::vector<ConfigurationChange *>&
+ConfigurationChangeView::get_changes() const
+{
+  if (!m_adapted)
+    {
+      m_changes.reserve(m_classes.size());
+
+      for (const auto &v : m_classes)
+        {
+          ConfigurationChange * c = m_set->get_changes()[v.m_class];
+
+          if (!v.m_complete)
+            {
+              ConfigurationChange * p = new ConfigurationChange(c->m_class_name);
+              m_owned.push_back(p);
+
+              for (const auto &x : v.m_modified)
+                p->add_modified(c->m_modified[x], c->get_modified_attributes(c->m_modified[x]), true);
+
+              for (const auto &x : v.m_removed)
+                p->m_removed.push_back(c->m_removed[x]);
+
+              c = p;
+            }
+
+          m_changes.push_back(c);
+        }
+
+      m_adapted = true;
+    }
+
+  return m_changes;
+}
+
+
 static void
 print_svect(std::ostream& s, const std::vector<std::string>& v, const char * name)
 {
@@ -1715,6 +2725,14 @@ operator<<(std::ostream &s, const ConfigurationChange &c)
   s << " changes for class \'" << c.get_class_name() << "\' include:\n";
 
   print_svect(s, c.get_modified_objs(), " modified object(s)");
+
+  for (const auto &i : c.get_modified_objs())
+    if (const std::vector<std::string> * names = c.get_modified_attributes(i))
+      {
+        s << "  ";
+        print_svect(s, *names, (" modified attribute(s) and relationship(s) of \"" + i + '\"').c_str());
+      }
+
   print_svect(s, c.get_created_objs(), " created object(s)");
   print_svect(s, c.get_removed_objs(), " removed object(s)");
 
@@ -1733,6 +2751,13 @@ operator<<(std::ostream &s, const std::vector<ConfigurationChange*> &v)
   return s;
 }
 
+
+std::ostream&
+operator<<(std::ostream &s, const ConfigurationChangeView &v)
+{
+  return (s << v.get_changes());
+}
+
 void
 Configuration::print(std::ostream &s) const noexcept
 {
@@ -1,7 +1,10 @@
 #include <stdlib.h>
+#include <algorithm>
 
+#include "config/Change.hpp"
 #include "config/Configuration.hpp"
 #include "config/ConfigurationImpl.hpp"
+#include "config/DalFactory.hpp"
 #include "config/Schema.hpp"
 
 namespace daq {
@@ -80,6 +83,27 @@ namespace daq {
       }
     }
 
+    type_t attribute_t::str2type(const std::string& type)
+    {
+      for (int t = bool_type; t <= class_type; ++t)
+        if (type == attribute_t::type(static_cast<type_t>(t)))
+          return static_cast<type_t>(t);
+
+      throw Generic(ERS_HERE, std::string("bad attribute type \'" + type + '\'').c_str());
+    }
+
+    int_format_t attribute_t::str2format(const std::string& format)
+    {
+      for (int f = oct_int_format; f <= hex_int_format; ++f)
+        if (format == format2str(static_cast<int_format_t>(f)))
+          return static_cast<int_format_t>(f);
+
+      if (format.empty())
+        return na_int_format;
+
+      throw Generic(ERS_HERE, std::string("bad integer format \'" + format + '\'').c_str());
+    }
+
     void attribute_t::print(std::ostream& out, const std::string& prefix) const
     {
       out
@@ -132,6 +156,15 @@ namespace daq {
       }
     }
 
+    cardinality_t relationship_t::str2card(const std::string& cardinality)
+    {
+      for (int c = zero_or_one; c <= one_or_many; ++c)
+        if (cardinality == card2str(static_cast<cardinality_t>(c)))
+          return static_cast<cardinality_t>(c);
+
+      throw Generic(ERS_HERE, std::string("bad relationship cardinality \'" + cardinality + '\'').c_str());
+    }
+
     void relationship_t::print(std::ostream& out, const std::string& prefix) const
     {
       out
@@ -222,9 +255,14 @@ namespace daq {
 
 
 ConfigurationImpl::ConfigurationImpl() noexcept :
-  p_number_of_cache_hits  (0),
-  p_number_of_object_read (0),
-  m_conf                  (0)
+  p_number_of_cache_hits      (0),
+  p_number_of_object_read     (0),
+  p_number_of_evicted_objects (0),
+  m_cache_limit               (0),
+  m_cache_threshold           (0),
+  m_cache_clock_hand          (0),
+  m_conf                      (0),
+  m_resolver                  (nullptr)
 {
 }
 
@@ -240,6 +278,120 @@ ConfigurationImpl::print_cache_info() noexcept
     "Configuration implementation profiler report:\n"
     "  number of read objects: " << p_number_of_object_read << "\n"
     "  number of cache hits: " << p_number_of_cache_hits << std::endl;
+
+  if (m_cache_limit)
+    std::cout <<
+      "  cache limit: " << m_cache_limit << " objects\n"
+      "  number of evicted objects: " << p_number_of_evicted_objects << std::endl;
+}
+
+
+void
+ConfigurationImpl::set_cache_limit(unsigned long limit) noexcept
+{
+  std::lock_guard<std::mutex> scoped_lock(m_cache_clock_mutex);
+
+  m_cache_limit = limit;
+  m_cache_threshold = limit;
+
+  m_cache_clock.clear();
+  m_cache_clock_hand = 0;
+
+  // put already loaded objects under control of the clock
+
+  if (m_cache_limit)
+    for (auto& i : m_impl_objects)
+      for (auto& j : *i.second)
+        m_cache_clock.push_back(j.second);
+}
+
+
+unsigned long
+ConfigurationImpl::get_cache_size() const noexcept
+{
+  unsigned long num = 0;
+
+  for (const auto& i : m_impl_objects)
+    num += i.second->size();
+
+  return num;
+}
+
+
+void
+ConfigurationImpl::track_impl_object(ConfigObjectImpl * obj) noexcept
+{
+  if (m_cache_limit == 0)
+    return;
+
+  std::lock_guard<std::mutex> scoped_lock(m_cache_clock_mutex);
+
+  if (m_cache_limit)
+    {
+      obj->m_referenced = true;
+      m_cache_clock.push_back(obj);
+    }
+}
+
+
+  // The implementation objects used by ConfigObject (including ones of template objects) are pinned and skipped.
+  // An evicted object is removed from cache and destroyed; it is re-read by the plug-in on next access.
+  // The sweep is called under the implementation mutex, so no new config object can take unpinned object meanwhile.
+  // If the limit cannot be reached because of pinned objects, next sweep is delayed to amortize the scan.
+
+void
+ConfigurationImpl::shrink_cache(bool force) noexcept
+{
+  if (m_cache_limit == 0)
+    return;
+
+  unsigned long num = 0;
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_cache_clock_mutex);
+
+      if (m_cache_clock.size() <= (force ? m_cache_limit : m_cache_threshold))
+        return;
+
+      for (auto budget = 2 * m_cache_clock.size(); budget > 0 && m_cache_clock.size() > m_cache_limit; --budget)
+        {
+          if (m_cache_clock_hand >= m_cache_clock.size())
+            m_cache_clock_hand = 0;
+
+          ConfigObjectImpl * obj = m_cache_clock[m_cache_clock_hand];
+
+          // skip objects in use and give second chance to recently accessed objects
+          if (obj->m_pins.load(std::memory_order_acquire) != 0 || obj->m_referenced.exchange(false, std::memory_order_relaxed))
+            {
+              ++m_cache_clock_hand;
+              continue;
+            }
+
+          m_cache_clock[m_cache_clock_hand] = m_cache_clock.back();
+          m_cache_clock.pop_back();
+
+          // the tangled objects (replaced by rename) are not in cache and are destroyed with it
+          auto i = m_impl_objects.find(obj->m_class_name);
+
+          if (i != m_impl_objects.end())
+            {
+              auto j = i->second->find(obj->m_id);
+
+              if (j != i->second->end() && j->second == obj)
+                {
+                  i->second->erase(j);
+                  delete obj;
+                  num++;
+                }
+            }
+        }
+
+      m_cache_threshold = (m_cache_clock.size() > m_cache_limit) ? m_cache_clock.size() + std::max(m_cache_limit / 8, 64UL) : m_cache_limit;
+    }
+
+  p_number_of_evicted_objects += num;
+
+  TLOG_DEBUG(2) << "evict " << num << " implementation objects (cache limit is " << m_cache_limit << ", " << m_cache_clock.size() << " objects in cache)";
 }
 
 
@@ -268,6 +420,7 @@ ConfigurationImpl::get_impl_object(const std::string& name, const std::string& i
 
     if(j != i->second->end()) {
       p_number_of_cache_hits++;
+      j->second->m_referenced = true;
       TLOG_DEBUG(4) << "\n  * found the object with id = \'" << id << "\' in class \'" << name << '\'' ;
       return j->second;
     }
@@ -308,6 +461,7 @@ ConfigurationImpl::get_impl_object(const std::string& name, const std::string& i
 
           if(j != i->second->end()) {
             p_number_of_cache_hits++;
+            j->second->m_referenced = true;
   	    CONFIG_ADD_DEBUG_MSG( dbg_text , "  * found the object with id = \'" << id << "\' in class \'" << *k << '\'' )
 	      TLOG_DEBUG(4) << dbg_text->str() ;
             return j->second;
@@ -365,6 +519,8 @@ ConfigurationImpl::put_impl_object(const std::string& name, const std::string& i
     m_impl_objects[obj->m_class_name] = m;
     (*m)[id] = obj;
   }
+
+  track_impl_object(obj);
 }
 
 void
@@ -394,13 +550,38 @@ ConfigurationImpl::rename_impl_object(const std::string * class_name, const std:
     }
 }
 
+  // The object still used by a ConfigObject of user code (e.g. destroyed after the configuration object) cannot be deleted,
+  // since the config object destructor unpins it. Such object is cleared and left in deleted state.
+
+void
+ConfigurationImpl::destroy_impl_object(ConfigObjectImpl * obj) noexcept
+{
+  if (obj->m_pins.load(std::memory_order_acquire) == 0)
+    {
+      delete obj;
+    }
+  else
+    {
+      TLOG_DEBUG(1) << "implementation " << (void *)obj << " of object \'" << obj->m_id << "\' is in use and is not deleted";
+      obj->clear();
+      obj->m_state = daq::config::Deleted;
+    }
+}
+
 void
 ConfigurationImpl::clean() noexcept
 {
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_cache_clock_mutex);
+      m_cache_clock.clear();
+      m_cache_clock_hand = 0;
+      m_cache_threshold = m_cache_limit;
+    }
+
   for (auto& i : m_impl_objects)
     {
       for (auto& j : *i.second)
-        delete j.second;
+        destroy_impl_object(j.second);
 
       delete i.second;
     }
@@ -408,7 +589,7 @@ ConfigurationImpl::clean() noexcept
   m_impl_objects.clear();
 
   for (auto& x : m_tangled_objects)
-    delete x;
+    destroy_impl_object(x);
 
   m_tangled_objects.clear();
 }
@@ -419,6 +600,74 @@ ConfigurationImpl::get_conf_impl_mutex() const
   return m_conf->m_impl_mutex;
 }
 
+ConfigurationImpl *
+ConfigurationImpl::get_impl(Configuration * db) noexcept
+{
+  return db->m_impl;
+}
+
+ConfigurationImpl *
+ConfigurationImpl::get_impl(const ConfigObjectImpl * obj) noexcept
+{
+  return obj->m_impl;
+}
+
+void
+ConfigurationImpl::rename_impl(ConfigObjectImpl * obj, const std::string& new_id)
+{
+  std::lock_guard<std::mutex> scoped_lock(obj->m_mutex);
+
+  const std::string old_id(obj->m_id);
+
+  obj->throw_if_deleted();
+  obj->rename(new_id);
+  obj->m_id = new_id;
+  rename_impl_object(obj->m_class_name, old_id, new_id);
+}
+
+void
+ConfigurationImpl::update_impl_objects(std::vector<ConfigurationChange *>& changes) noexcept
+{
+  for (const auto& i : changes)
+    {
+      const std::string * class_name = m_conf->get_class_name_ref(i->get_class_name());
+
+      Configuration::update_impl_objects(m_impl_objects, *i, class_name);
+
+      config::fmap<config::fset>::const_iterator sc = m_conf->p_superclasses.find(class_name);
+
+      if (sc != m_conf->p_superclasses.end())
+        for (const auto &c : sc->second)
+          Configuration::update_impl_objects(m_impl_objects, *i, c);
+
+      sc = m_conf->p_subclasses.find(class_name);
+
+      if (sc != m_conf->p_subclasses.end())
+        for (const auto &c : sc->second)
+          Configuration::update_impl_objects(m_impl_objects, *i, c);
+    }
+}
+
+void
+ConfigurationImpl::unread_impl_objects() noexcept
+{
+  for (auto &i : m_impl_objects)
+    for (auto &j : *i.second)
+      {
+        std::lock_guard<std::mutex> scoped_lock(j.second->m_mutex);
+        j.second->clear();
+        j.second->m_state = daq::config::Unknown;
+        j.second->m_generation++;
+      }
+
+  for (auto& x : m_tangled_objects)
+    {
+      std::lock_guard<std::mutex> scoped_lock(x->m_mutex);
+      x->clear();
+      x->m_state = daq::config::Unknown;
+    }
+}
+
 void
 ConfigObjectImpl::convert(bool& value, const ConfigObject& obj, const std::string& attr_name) noexcept
 {
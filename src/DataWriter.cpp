@@ -0,0 +1,612 @@
+#include <boost/property_tree/ptree.hpp>
+
+#include "ers/ers.hpp"
+
+#include "config/DataWriter.hpp"
+#include "config/Errors.hpp"
+
+
+namespace config
+{
+
+    // the writers below reproduce formatting of boost::property_tree json, xml and info writers (indentation of 4 spaces)
+
+  static void
+  indent(std::ostream& s, unsigned int level)
+  {
+    for (unsigned int i = 0; i < level; ++i)
+      s.write("    ", 4);
+  }
+
+
+  class JsonWriter : public DataWriter
+  {
+
+  public:
+
+    JsonWriter(std::ostream& s, bool fix_arrays) : m_s(s), m_fix_arrays(fix_arrays) {}
+
+    void
+    begin() override
+    {
+      m_s << "{\n";
+    }
+
+    void
+    end() override
+    {
+      if (!m_first_class)
+        m_s << '\n';
+
+      m_s << "}\n";
+    }
+
+    void
+    add_tombstones(const std::vector<std::string>& files) override
+    {
+      if (!m_first_class)
+        m_s << ",\n";
+
+      indent(m_s, 1);
+      write_string(tombstones_key);
+      m_s << ": ";
+      write_array(files, 1);
+
+      m_first_class = false;
+    }
+
+    void
+    begin_class(const std::string& name) override
+    {
+      if (!m_first_class)
+        m_s << ",\n";
+
+      indent(m_s, 1);
+      write_string(name);
+      m_s << ": {\n";
+
+      m_first_class = false;
+      m_first_object = true;
+    }
+
+    void
+    end_class() override
+    {
+      m_s << '\n';
+      indent(m_s, 1);
+      m_s << '}';
+    }
+
+    void
+    begin_object(const std::string& id) override
+    {
+      if (!m_first_object)
+        m_s << ",\n";
+
+      indent(m_s, 2);
+      write_string(id);
+      m_s << ": ";
+
+      m_first_object = false;
+      m_first_value = true;
+    }
+
+    void
+    end_object() override
+    {
+      // an object without values is an empty string
+      if (m_first_value)
+        m_s << "\"\"";
+      else
+        {
+          m_s << '\n';
+          indent(m_s, 2);
+          m_s << '}';
+        }
+    }
+
+    void
+    add_value(const std::string& name, const std::string& value) override
+    {
+      write_name(name);
+      write_string(value);
+    }
+
+    void
+    add_array(const std::string& name, const std::vector<std::string>& values) override
+    {
+      write_name(name);
+      write_array(values, 3);
+    }
+
+  private:
+
+    void
+    write_array(const std::vector<std::string>& values, unsigned int level)
+    {
+      if (values.empty())
+        m_s << (m_fix_arrays ? "[]" : "\"\"");
+      else
+        {
+          m_s << "[\n";
+
+          for (auto i = values.begin(); i != values.end(); ++i)
+            {
+              if (i != values.begin())
+                m_s << ",\n";
+
+              indent(m_s, level + 1);
+              write_string(*i);
+            }
+
+          m_s << '\n';
+          indent(m_s, level);
+          m_s << ']';
+        }
+    }
+
+    void
+    write_name(const std::string& name)
+    {
+      if (m_first_value)
+        m_s << "{\n";
+      else
+        m_s << ",\n";
+
+      indent(m_s, 3);
+      write_string(name);
+      m_s << ": ";
+
+      m_first_value = false;
+    }
+
+    void
+    write_string(const std::string& str)
+    {
+      static const char * hexdigits = "0123456789ABCDEF";
+
+      m_s << '\"';
+
+      for (const char ch : str)
+        {
+          const unsigned char c(ch);
+
+          if (c == 0x20 || c == 0x21 || (c >= 0x23 && c <= 0x2E) || (c >= 0x30 && c <= 0x5B) || c >= 0x5D)
+            m_s << ch;
+          else if (c == '\b') m_s << "\\b";
+          else if (c == '\f') m_s << "\\f";
+          else if (c == '\n') m_s << "\\n";
+          else if (c == '\r') m_s << "\\r";
+          else if (c == '\t') m_s << "\\t";
+          else if (c == '/') m_s << "\\/";
+          else if (c == '\"') m_s << "\\\"";
+          else if (c == '\\') m_s << "\\\\";
+          else
+            m_s << "\\u00" << hexdigits[c / 16] << hexdigits[c % 16];
+        }
+
+      m_s << '\"';
+    }
+
+    std::ostream& m_s;
+    const bool m_fix_arrays;
+    bool m_first_class = true;
+    bool m_first_object = true;
+    bool m_first_value = true;
+  };
+
+
+  class XmlWriter : public DataWriter
+  {
+
+  public:
+
+    XmlWriter(std::ostream& s, bool fix_arrays) : m_s(s), m_fix_arrays(fix_arrays) {}
+
+    void
+    begin() override
+    {
+      m_s << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+    }
+
+    void
+    add_tombstones(const std::vector<std::string>& files) override
+    {
+      write_array(tombstones_key, files, 0);
+    }
+
+    void
+    begin_class(const std::string& name) override
+    {
+      m_class = name;
+      m_s << '<' << m_class << ">\n";
+    }
+
+    void
+    end_class() override
+    {
+      m_s << "</" << m_class << ">\n";
+    }
+
+    void
+    begin_object(const std::string& id) override
+    {
+      m_object = id;
+      m_first_value = true;
+    }
+
+    void
+    end_object() override
+    {
+      indent(m_s, 1);
+
+      if (m_first_value)
+        m_s << '<' << m_object << "/>\n";
+      else
+        m_s << "</" << m_object << ">\n";
+    }
+
+    void
+    add_value(const std::string& name, const std::string& value) override
+    {
+      write_object_tag();
+      indent(m_s, 2);
+
+      if (value.empty())
+        m_s << '<' << name << "/>\n";
+      else
+        {
+          m_s << '<' << name << '>';
+          write_text(value);
+          m_s << "</" << name << ">\n";
+        }
+    }
+
+    void
+    add_array(const std::string& name, const std::vector<std::string>& values) override
+    {
+      write_object_tag();
+      write_array(name, values, 2);
+    }
+
+  private:
+
+    void
+    write_array(const std::string& name, const std::vector<std::string>& values, unsigned int level)
+    {
+      indent(m_s, level);
+
+      if (values.empty())
+        m_s << '<' << name << "/>\n";
+      else
+        {
+          m_s << '<' << name << ">\n";
+
+          for (const auto& x : values)
+            {
+              indent(m_s, level + 1);
+
+              if (x.empty())
+                m_s << "</>";
+              else if (m_fix_arrays)
+                write_text(x);
+              else
+                {
+                  m_s << "<>";
+                  write_text(x);
+                  m_s << "</>";
+                }
+
+              m_s << '\n';
+            }
+
+          indent(m_s, level);
+          m_s << "</" << name << ">\n";
+        }
+    }
+
+    void
+    write_object_tag()
+    {
+      if (m_first_value)
+        {
+          indent(m_s, 1);
+          m_s << '<' << m_object << ">\n";
+          m_first_value = false;
+        }
+    }
+
+    void
+    write_text(const std::string& str)
+    {
+      // the text containing spaces only is encoded to be preserved
+      if (str.find_first_not_of(' ') == std::string::npos)
+        {
+          m_s << "&#32;";
+          m_s.write(str.data(), str.size() - 1);
+          return;
+        }
+
+      for (const char c : str)
+        switch (c)
+          {
+            case '<':  m_s << "&lt;"; break;
+            case '>':  m_s << "&gt;"; break;
+            case '&':  m_s << "&amp;"; break;
+            case '\"': m_s << "&quot;"; break;
+            case '\'': m_s << "&apos;"; break;
+            default:   m_s << c; break;
+          }
+    }
+
+    std::ostream& m_s;
+    const bool m_fix_arrays;
+    std::string m_class;
+    std::string m_object;
+    bool m_first_value = true;
+  };
+
+
+  class InfoWriter : public DataWriter
+  {
+
+  public:
+
+    InfoWriter(std::ostream& s) : m_s(s) {}
+
+    void
+    add_tombstones(const std::vector<std::string>& files) override
+    {
+      write_key(tombstones_key);
+      write_array(files, 0);
+    }
+
+    void
+    begin_class(const std::string& name) override
+    {
+      write_key(name);
+      m_s << "\n{\n";
+    }
+
+    void
+    end_class() override
+    {
+      m_s << "}\n";
+    }
+
+    void
+    begin_object(const std::string& id) override
+    {
+      indent(m_s, 1);
+      write_key(id);
+      m_first_value = true;
+    }
+
+    void
+    end_object() override
+    {
+      if (m_first_value)
+        m_s << " \"\"\n";
+      else
+        {
+          indent(m_s, 1);
+          m_s << "}\n";
+        }
+    }
+
+    void
+    add_value(const std::string& name, const std::string& value) override
+    {
+      write_object_brace();
+      indent(m_s, 2);
+      write_key(name);
+      write_data(value);
+    }
+
+    void
+    add_array(const std::string& name, const std::vector<std::string>& values) override
+    {
+      write_object_brace();
+      indent(m_s, 2);
+      write_key(name);
+      write_array(values, 2);
+    }
+
+  private:
+
+    void
+    write_array(const std::vector<std::string>& values, unsigned int level)
+    {
+      if (values.empty())
+        m_s << " \"\"\n";
+      else
+        {
+          m_s << '\n';
+          indent(m_s, level);
+          m_s << "{\n";
+
+          for (const auto& x : values)
+            {
+              indent(m_s, level + 1);
+              m_s << "\"\"";
+              write_data(x);
+            }
+
+          indent(m_s, level);
+          m_s << "}\n";
+        }
+    }
+
+    void
+    write_object_brace()
+    {
+      if (m_first_value)
+        {
+          m_s << '\n';
+          indent(m_s, 1);
+          m_s << "{\n";
+          m_first_value = false;
+        }
+    }
+
+    static std::string
+    create_escapes(const std::string& str)
+    {
+      std::string result;
+      result.reserve(str.size());
+
+      for (const char c : str)
+        switch (c)
+          {
+            case '\0': result += "\\0"; break;
+            case '\a': result += "\\a"; break;
+            case '\b': result += "\\b"; break;
+            case '\f': result += "\\f"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\v': result += "\\v"; break;
+            case '\"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            default:   result += c; break;
+          }
+
+      return result;
+    }
+
+    static bool
+    is_simple(const std::string& str)
+    {
+      return (!str.empty() && str.find_first_of(" \t{};\n\"") == std::string::npos);
+    }
+
+    void
+    write_key(const std::string& key)
+    {
+      const std::string str(create_escapes(key));
+
+      if (is_simple(str))
+        m_s << str;
+      else
+        m_s << '\"' << str << '\"';
+    }
+
+    void
+    write_data(const std::string& data)
+    {
+      const std::string str(create_escapes(data));
+
+      if (is_simple(str))
+        m_s << ' ' << str << '\n';
+      else
+        m_s << " \"" << str << "\"\n";
+    }
+
+    std::ostream& m_s;
+    bool m_first_value = true;
+  };
+
+
+  class PtreeWriter : public DataWriter
+  {
+
+  public:
+
+    PtreeWriter(boost::property_tree::ptree& tree, const std::string& empty_array_item) : m_tree(tree), m_empty_array_item(empty_array_item) {}
+
+    void
+    add_tombstones(const std::vector<std::string>& files) override
+    {
+      m_tree.put_child(boost::property_tree::ptree::path_type(tombstones_key), make_array(files));
+    }
+
+    void
+    begin_class(const std::string& name) override
+    {
+      m_class = &m_tree.put_child(boost::property_tree::ptree::path_type(name), boost::property_tree::ptree());
+    }
+
+    void
+    end_class() override
+    {
+      m_class = nullptr;
+    }
+
+    void
+    begin_object(const std::string& id) override
+    {
+      m_object = &m_class->push_back(boost::property_tree::ptree::value_type(id, boost::property_tree::ptree()))->second;
+    }
+
+    void
+    end_object() override
+    {
+      m_object = nullptr;
+    }
+
+    void
+    add_value(const std::string& name, const std::string& value) override
+    {
+      m_object->put(name, value);
+    }
+
+    void
+    add_array(const std::string& name, const std::vector<std::string>& values) override
+    {
+      m_object->add_child(name, make_array(values));
+    }
+
+  private:
+
+    boost::property_tree::ptree
+    make_array(const std::vector<std::string>& values) const
+    {
+      boost::property_tree::ptree children;
+
+      for (const auto& x : values)
+        add_array_item(children, x);
+
+      if (values.empty() && !m_empty_array_item.empty())
+        add_array_item(children, m_empty_array_item);
+
+      return children;
+    }
+
+    static void
+    add_array_item(boost::property_tree::ptree& pt, const std::string& value)
+    {
+      boost::property_tree::ptree child;
+      child.put("", value);
+      pt.push_back(std::make_pair("", child));
+    }
+
+    boost::property_tree::ptree& m_tree;
+    const std::string m_empty_array_item;
+    boost::property_tree::ptree * m_class = nullptr;
+    boost::property_tree::ptree * m_object = nullptr;
+  };
+
+
+  const char * const DataWriter::tombstones_key = "#tombstones";
+  const char * const DataWriter::file_key = "#file";
+
+
+  std::unique_ptr<DataWriter>
+  DataWriter::create(const std::string& format, std::ostream& s, bool fix_arrays)
+  {
+    if (format == "json")
+      return std::make_unique<JsonWriter>(s, fix_arrays);
+    else if (format == "xml")
+      return std::make_unique<XmlWriter>(s, fix_arrays);
+    else if (format == "info")
+      return std::make_unique<InfoWriter>(s);
+
+    throw daq::config::Generic( ERS_HERE, ("unsupported export format \"" + format + '\"').c_str() );
+  }
+
+  std::unique_ptr<DataWriter>
+  DataWriter::create(boost::property_tree::ptree& tree, const std::string& empty_array_item)
+  {
+    return std::make_unique<PtreeWriter>(tree, empty_array_item);
+  }
+
+}
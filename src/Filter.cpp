@@ -0,0 +1,213 @@
+#include <string.h>
+
+#include <algorithm>
+
+#include "config/Filter.hpp"
+
+
+namespace config
+{
+
+    // the characters with special meaning in ECMAScript regular expressions
+
+  static const char s_syntax_characters[] = "^$\\.*+?()[]{}|";
+
+
+    // the "." does not match line terminators
+
+  static inline bool
+  is_any(char c) noexcept
+  {
+    return (c != '\n' && c != '\r');
+  }
+
+  static inline bool
+  has_line_terminator(const char * s, size_t len) noexcept
+  {
+    return (memchr(s, '\n', len) != nullptr || memchr(s, '\r', len) != nullptr);
+  }
+
+  static inline bool
+  is_syntax_character(char c) noexcept
+  {
+    return (c != 0 && strchr(s_syntax_characters, c) != nullptr);
+  }
+
+  static bool
+  is_escaped(const std::string& s, std::string::size_type pos) noexcept
+  {
+    unsigned int count = 0;
+
+    while (pos > 0 && s[--pos] == '\\')
+      count++;
+
+    return (count % 2);
+  }
+
+
+  Filter::Filter(const std::string& pattern) : m_type(All)
+  {
+    if (pattern.empty())
+      return;
+
+    // the anchors are redundant, since whole string has to match
+
+    std::string::size_type begin(0), end(pattern.size());
+
+    if (pattern[0] == '^')
+      begin++;
+
+    if (end > begin && pattern[end - 1] == '$' && !is_escaped(pattern, end - 1))
+      end--;
+
+    std::string chars, wildcards;
+    bool is_glob(true);
+
+    for (std::string::size_type i = begin; i < end && is_glob; ++i)
+      {
+        const char c(pattern[i]);
+        const char next(i + 1 < end ? pattern[i + 1] : 0);
+
+        if (c == '\\')
+          {
+            if (is_syntax_character(next))
+              {
+                chars.push_back(next);
+                wildcards.push_back(0);
+                ++i;
+              }
+            else
+              is_glob = false;
+          }
+        else if (c == '.')
+          {
+            if (next == '*' || next == '+')
+              {
+                if (next == '+')
+                  {
+                    chars.push_back('.');
+                    wildcards.push_back('.');
+                  }
+
+                if (wildcards.empty() || wildcards.back() != '*')
+                  {
+                    chars.push_back('*');
+                    wildcards.push_back('*');
+                  }
+
+                ++i;
+              }
+            else if (next == '?' || next == '{')
+              is_glob = false;
+            else
+              {
+                chars.push_back('.');
+                wildcards.push_back('.');
+              }
+          }
+        else if (c == 0 || c == '\n' || c == '\r' || is_syntax_character(c))
+          is_glob = false;
+        else
+          {
+            chars.push_back(c);
+            wildcards.push_back(0);
+          }
+      }
+
+    if (!is_glob)
+      {
+        m_type = Regex;
+        m_regex = std::make_unique<std::regex>(pattern);
+        return;
+      }
+
+    const auto num_of_stars = std::count(wildcards.begin(), wildcards.end(), '*');
+    const auto num_of_dots = std::count(wildcards.begin(), wildcards.end(), '.');
+
+    if (num_of_dots == 0 && num_of_stars == 0)
+      {
+        m_type = Literal;
+        m_literal = chars;
+      }
+    else if (num_of_dots == 0 && num_of_stars == 1 && wildcards.back() == '*')
+      {
+        m_type = Prefix;
+        m_literal = chars.substr(0, chars.size() - 1);
+      }
+    else if (num_of_dots == 0 && num_of_stars == 1 && wildcards.front() == '*')
+      {
+        m_type = Suffix;
+        m_literal = chars.substr(1);
+      }
+    else if (num_of_dots == 0 && num_of_stars == 2 && wildcards.front() == '*' && wildcards.back() == '*')
+      {
+        m_type = Substring;
+        m_literal = chars.substr(1, chars.size() - 2);
+      }
+    else
+      {
+        m_type = Glob;
+        m_literal = chars;
+        m_wildcards = wildcards;
+      }
+  }
+
+  bool
+  Filter::match_prefix(const std::string& str) const noexcept
+  {
+    const size_t len = m_literal.size();
+    return (str.size() >= len && memcmp(str.data(), m_literal.data(), len) == 0 && !has_line_terminator(str.data() + len, str.size() - len));
+  }
+
+  bool
+  Filter::match_suffix(const std::string& str) const noexcept
+  {
+    const size_t len = m_literal.size();
+    return (str.size() >= len && memcmp(str.data() + str.size() - len, m_literal.data(), len) == 0 && !has_line_terminator(str.data(), str.size() - len));
+  }
+
+  bool
+  Filter::match_substring(const std::string& str) const noexcept
+  {
+    return (str.find(m_literal) != std::string::npos && !has_line_terminator(str.data(), str.size()));
+  }
+
+    // match with backtracking to the last "*" only; the literal characters never match line terminators,
+    // so a line terminator in the string cannot be skipped by an earlier "*" either
+
+  bool
+  Filter::match_glob(const std::string& str) const noexcept
+  {
+    const size_t len = m_wildcards.size();
+    const size_t no_star = std::string::npos;
+
+    size_t s = 0, p = 0, star = no_star, star_s = 0;
+
+    while (s < str.size())
+      {
+        if (p < len && m_wildcards[p] != '*' && (m_wildcards[p] == '.' ? is_any(str[s]) : m_literal[p] == str[s]))
+          {
+            ++s;
+            ++p;
+          }
+        else if (p < len && m_wildcards[p] == '*')
+          {
+            star = p++;
+            star_s = s;
+          }
+        else if (star != no_star && is_any(str[star_s]))
+          {
+            p = star + 1;
+            s = ++star_s;
+          }
+        else
+          return false;
+      }
+
+    while (p < len && m_wildcards[p] == '*')
+      ++p;
+
+    return (p == len);
+  }
+
+}
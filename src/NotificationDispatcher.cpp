@@ -0,0 +1,464 @@
+#include <algorithm>
+#include <exception>
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include "config/Change.hpp"
+#include "config/Errors.hpp"
+#include "config/NotificationDispatcher.hpp"
+
+
+namespace config
+{
+
+  NotificationDispatcher::NotificationDispatcher(unsigned int num_of_threads, unsigned int queue_limit) :
+    m_queue_limit(queue_limit ? queue_limit : 1),
+    m_last_key(0),
+    m_stop(false)
+  {
+    for (unsigned int i = 0; i < num_of_threads; ++i)
+      m_threads.emplace_back(&NotificationDispatcher::run, this);
+
+    TLOG_DEBUG(1) << "start " << num_of_threads << " notification threads (queue limit " << m_queue_limit << ')';
+  }
+
+  NotificationDispatcher::~NotificationDispatcher()
+  {
+    stop();
+  }
+
+    // the threads exit when there are no ready queues, so the queued and merged notifications are delivered before
+
+  void
+  NotificationDispatcher::stop() noexcept
+  {
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+      for (auto& q : m_queues)
+        flush(q.second, true);
+
+      m_stop = true;
+    }
+
+    m_ready_cond.notify_all();
+
+    for (auto& t : m_threads)
+      if (t.joinable())
+        t.join();
+  }
+
+  uint64_t
+  NotificationDispatcher::add(std::chrono::milliseconds window, unsigned int max_changes)
+  {
+    std::shared_ptr<Queue> q(std::make_shared<Queue>());
+
+    if (window.count())
+      q->m_coalescing.reset(new Coalescing(window, max_changes));
+
+    std::lock_guard<std::mutex> scoped_lock(m_mutex);
+    m_queues.emplace(++m_last_key, q);
+    return m_last_key;
+  }
+
+  void
+  NotificationDispatcher::remove(uint64_t subscriber) noexcept
+  {
+    std::deque<Notification> dropped;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      auto it = m_queues.find(subscriber);
+
+      if (it == m_queues.end())
+        return;
+
+      std::shared_ptr<Queue> q(it->second);
+      m_queues.erase(it);
+
+      q->m_removed = true;
+      dropped.swap(q->m_notifications);
+
+      m_done_cond.notify_all();
+
+      if (q->m_running && q->m_thread != std::this_thread::get_id())
+        m_done_cond.wait(lock, [&q]() { return !q->m_running; });
+    }
+
+    // the dropped changes are released outside the lock
+  }
+
+  void
+  NotificationDispatcher::push(uint64_t subscriber, notify cb, notify_view view_cb, void * parameter, ConfigurationChangeView&& changes) noexcept
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      auto it = m_queues.find(subscriber);
+
+      if (it != m_queues.end())
+        {
+          std::shared_ptr<Queue> q(it->second);
+
+          if (Coalescing * c = q->m_coalescing.get())
+            {
+              const bool first(c->empty());
+
+              if (first)
+                {
+                  c->m_queued = std::chrono::steady_clock::now();
+                  c->m_deadline = c->m_queued + c->m_window;
+                }
+              else
+                {
+                  q->m_metrics.m_number_of_coalesced++;
+                }
+
+              c->m_cb = cb;
+              c->m_view_cb = view_cb;
+              c->m_parameter = parameter;
+              c->merge(changes);
+
+              if (c->m_max_changes && c->m_number_of_changes >= c->m_max_changes)
+                flush(q, false);
+              else if (first)
+                m_ready_cond.notify_all();  // wake up a thread waiting without deadline
+
+              return;
+            }
+
+          if (q->m_notifications.size() >= m_queue_limit)
+            {
+              q->m_metrics.m_number_of_waits++;
+              m_done_cond.wait(lock, [this, &q]() { return q->m_removed || q->m_notifications.size() < m_queue_limit; });
+            }
+
+          if (!q->m_removed)
+            {
+              q->m_notifications.push_back(Notification { cb, view_cb, parameter, std::move(changes), std::chrono::steady_clock::now() });
+
+              if (q->m_notifications.size() > q->m_metrics.m_max_queue_depth)
+                q->m_metrics.m_max_queue_depth = q->m_notifications.size();
+
+              if (!q->m_running && q->m_notifications.size() == 1)
+                {
+                  m_ready.push_back(q);
+                  m_ready_cond.notify_one();
+                }
+
+              return;
+            }
+        }
+    }
+
+    // there is no such subscriber anymore; the changes are released by caller
+  }
+
+  void
+  NotificationDispatcher::run() noexcept
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+      {
+        if (m_ready.empty())
+          {
+            if (m_stop)
+              return;
+
+            const std::chrono::steady_clock::time_point deadline(flush_expired());
+
+            if (m_ready.empty())
+              {
+                if (deadline == std::chrono::steady_clock::time_point::max())
+                  m_ready_cond.wait(lock);
+                else
+                  m_ready_cond.wait_until(lock, deadline);
+
+                continue;
+              }
+          }
+
+        std::shared_ptr<Queue> q(m_ready.front());
+        m_ready.pop_front();
+
+        if (q->m_removed || q->m_notifications.empty())
+          continue;
+
+        q->m_running = true;
+        q->m_thread = std::this_thread::get_id();
+
+        std::chrono::nanoseconds duration;
+
+          {
+            Notification n(std::move(q->m_notifications.front()));
+            q->m_notifications.pop_front();
+
+            const std::chrono::nanoseconds lag(std::chrono::steady_clock::now() - n.m_queued);
+            q->m_metrics.m_total_lag += lag;
+            if (lag > q->m_metrics.m_max_lag)
+              q->m_metrics.m_max_lag = lag;
+
+            m_done_cond.notify_all();
+
+            lock.unlock();
+
+            const std::chrono::steady_clock::time_point started(std::chrono::steady_clock::now());
+
+            try
+              {
+                TLOG_DEBUG(3) << "*** Invoke callback with\n" << n.m_changes;
+
+                if (n.m_view_cb)
+                  (*n.m_view_cb)(n.m_changes, n.m_parameter);
+                else
+                  (*n.m_cb)(n.m_changes.get_changes(), n.m_parameter);
+              }
+            catch (const ers::Issue &ex)
+              {
+                ers::error(daq::config::Generic( ERS_HERE, "user callback thrown ers exception", ex));
+              }
+            catch (const std::exception &ex)
+              {
+                ers::error(daq::config::Generic( ERS_HERE, "user callback thrown std exception", ex));
+              }
+            catch (...)
+              {
+                ers::error(daq::config::Generic( ERS_HERE, "user callback thrown unknown exception"));
+              }
+
+            duration = std::chrono::steady_clock::now() - started;
+          }
+
+        // the changes are released before locking
+
+        lock.lock();
+
+        q->m_metrics.m_duration.add(duration);
+
+        q->m_running = false;
+        q->m_thread = std::thread::id();
+        q->m_metrics.m_number_of_notifications++;
+
+        // the merged changes could not be queued when the window was expired, since the queue was full
+        if (!q->m_removed && q->m_coalescing && !q->m_coalescing->empty() && q->m_coalescing->m_deadline <= std::chrono::steady_clock::now())
+          flush(q, false);
+
+        if (!q->m_removed && !q->m_notifications.empty())
+          {
+            m_ready.push_back(q);
+            m_ready_cond.notify_one();
+          }
+
+        m_done_cond.notify_all();
+      }
+  }
+
+  bool
+  NotificationDispatcher::flush(const std::shared_ptr<Queue>& q, bool force) noexcept
+  {
+    Coalescing * c = q->m_coalescing.get();
+
+    if (!c || c->empty())
+      return true;
+
+    if (!force && q->m_notifications.size() >= m_queue_limit)
+      return false;
+
+    std::vector<ConfigurationChange *> changes;
+    c->build(changes);
+
+    // the changes may annihilate, e.g. when an object was created and removed
+    if (changes.empty())
+      return true;
+
+    q->m_notifications.push_back(Notification { c->m_cb, c->m_view_cb, c->m_parameter, ConfigurationChangeView(changes), c->m_queued });
+
+    if (q->m_notifications.size() > q->m_metrics.m_max_queue_depth)
+      q->m_metrics.m_max_queue_depth = q->m_notifications.size();
+
+    if (!q->m_running && q->m_notifications.size() == 1)
+      {
+        m_ready.push_back(q);
+        m_ready_cond.notify_one();
+      }
+
+    return true;
+  }
+
+  std::chrono::steady_clock::time_point
+  NotificationDispatcher::flush_expired() noexcept
+  {
+    const std::chrono::steady_clock::time_point now(std::chrono::steady_clock::now());
+    std::chrono::steady_clock::time_point deadline(std::chrono::steady_clock::time_point::max());
+
+    for (const auto& x : m_queues)
+      if (const Coalescing * c = x.second->m_coalescing.get())
+        if (!c->empty())
+          {
+            // the full queue is flushed by the thread taking its notification
+            if (c->m_deadline > now)
+              deadline = std::min(deadline, c->m_deadline);
+            else
+              flush(x.second, false);
+          }
+
+    return deadline;
+  }
+
+    // the object changes are merged in order created, modified, removed;
+    // created + removed annihilate, removed + created become modified;
+    // the names of modified attributes are known, if all modifications report them
+
+  void
+  NotificationDispatcher::Coalescing::merge(ClassChanges& c, const std::string& id, char action, const std::vector<std::string> * names)
+  {
+    auto it = c.m_actions.find(id);
+
+    if (it == c.m_actions.end())
+      {
+        c.m_actions.emplace(id, action);
+        c.m_ids.push_back(id);
+        m_number_of_changes++;
+
+        if (names)
+          c.m_attributes.emplace(id, *names);
+
+        return;
+      }
+
+    char& prev(it->second);
+
+    if (prev == '+')
+      {
+        if (action == '-')
+          {
+            c.m_actions.erase(it);
+            m_number_of_changes--;
+          }
+      }
+    else if (prev == '-')
+      {
+        if (action != '-')
+          prev = '~';
+      }
+    else
+      {
+        auto a = c.m_attributes.find(id);
+
+        if (a != c.m_attributes.end())
+          {
+            if (action == '~' && names)
+              {
+                for (const auto& x : *names)
+                  if (std::find(a->second.begin(), a->second.end(), x) == a->second.end())
+                    a->second.push_back(x);
+              }
+            else
+              {
+                c.m_attributes.erase(a);
+              }
+          }
+
+        if (action == '-')
+          prev = '-';
+      }
+  }
+
+  void
+  NotificationDispatcher::Coalescing::merge(const ConfigurationChangeView& changes)
+  {
+    for (size_t i = 0; i < changes.size(); ++i)
+      {
+        const ConfigurationChange& change(changes.get_change(i));
+
+        auto it = m_changes.find(change.get_class_name());
+
+        if (it == m_changes.end())
+          {
+            m_classes.push_back(change.get_class_name());
+            it = m_changes.emplace(change.get_class_name(), ClassChanges()).first;
+          }
+
+        changes.for_each_object(i, [this, &it, &change](const std::string& id, char action) {
+          merge(it->second, id, action, (action == '~' ? change.get_modified_attributes(id) : nullptr));
+        });
+      }
+  }
+
+  void
+  NotificationDispatcher::Coalescing::build(std::vector<ConfigurationChange *>& changes)
+  {
+    ConfigurationChangeBuilder builder;
+
+    for (const auto& name : m_classes)
+      {
+        const ClassChanges& c(m_changes[name]);
+
+        for (const auto& id : c.m_ids)
+          {
+            auto it = c.m_actions.find(id);
+            if (it != c.m_actions.end())
+              {
+                auto a = (it->second == '~' ? c.m_attributes.find(id) : c.m_attributes.end());
+
+                if (a != c.m_attributes.end())
+                  builder.add(name, id, a->second);
+                else
+                  builder.add(name, id, it->second);
+              }
+          }
+      }
+
+    builder.build(changes);
+
+    m_classes.clear();
+    m_changes.clear();
+    m_number_of_changes = 0;
+  }
+
+  bool
+  NotificationDispatcher::get_metrics(uint64_t subscriber, NotificationMetrics& metrics) const noexcept
+  {
+    std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+    auto it = m_queues.find(subscriber);
+
+    if (it == m_queues.end())
+      return false;
+
+    const Queue& q(*it->second);
+
+    metrics = q.m_metrics;
+    metrics.m_queue_depth = q.m_notifications.size();
+    metrics.m_lag = (q.m_notifications.empty() ? std::chrono::nanoseconds(0) : std::chrono::steady_clock::now() - q.m_notifications.front().m_queued);
+
+    return true;
+  }
+
+  void
+  NotificationDispatcher::print(std::ostream& s) const noexcept
+  {
+    std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+    s << "  number of notification threads: " << m_threads.size() << "\n"
+         "  notification queue limit: " << m_queue_limit << "\n";
+
+    for (const auto& x : m_queues)
+      {
+        const NotificationMetrics& m(x.second->m_metrics);
+
+        s << "  subscription #" << x.first << ": " << m.m_number_of_notifications << " notifications (" << m.m_number_of_coalesced << " coalesced), queue depth "
+          << x.second->m_notifications.size() << " (max " << m.m_max_queue_depth << "), " << m.m_number_of_waits << " waits, lag "
+          << (m.m_number_of_notifications ? m.m_total_lag.count() / m.m_number_of_notifications / 1e6 : 0.) << " ms (max "
+          << m.m_max_lag.count() / 1e6 << " ms)\n"
+             "    callback duration: ";
+
+        m.m_duration.print(s);
+        s << std::endl;
+      }
+  }
+
+}
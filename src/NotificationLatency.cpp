@@ -0,0 +1,67 @@
+#include "config/NotificationLatency.hpp"
+
+namespace config
+{
+
+  void
+  LatencyHistogram::add(std::chrono::nanoseconds duration) noexcept
+  {
+    const uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+
+    unsigned int bin = 0;
+
+    while (bin < s_number_of_bins - 1 && us >= get_bin_limit(bin))
+      ++bin;
+
+    m_bins[bin]++;
+    m_count++;
+    m_total += duration;
+
+    if (duration > m_max)
+      m_max = duration;
+  }
+
+  void
+  LatencyHistogram::merge(const LatencyHistogram& other) noexcept
+  {
+    for (unsigned int i = 0; i < s_number_of_bins; ++i)
+      m_bins[i] += other.m_bins[i];
+
+    m_count += other.m_count;
+    m_total += other.m_total;
+
+    if (other.m_max > m_max)
+      m_max = other.m_max;
+  }
+
+  void
+  LatencyHistogram::print(std::ostream& s) const noexcept
+  {
+    s << m_count << " times, average " << (m_count ? m_total.count() / m_count / 1e6 : 0.) << " ms, max " << m_max.count() / 1e6 << " ms";
+
+    if (m_count)
+      {
+        s << " (";
+
+        bool first = true;
+
+        for (unsigned int i = 0; i < s_number_of_bins; ++i)
+          if (m_bins[i])
+            {
+              if (!first)
+                s << ", ";
+
+              if (i < s_number_of_bins - 1)
+                s << '<' << get_bin_limit(i) << " us: ";
+              else
+                s << ">=" << get_bin_limit(i - 1) << " us: ";
+
+              s << m_bins[i];
+              first = false;
+            }
+
+        s << ')';
+      }
+  }
+
+}
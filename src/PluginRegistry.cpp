@@ -0,0 +1,100 @@
+#include <dlfcn.h>
+
+#include <sstream>
+
+#include "ers/ers.hpp"
+#include "ers/internal/SingletonCreator.hpp"
+#include "logging/Logging.hpp"
+
+#include "config/Errors.hpp"
+#include "config/PluginRegistry.hpp"
+
+
+PluginRegistry &
+PluginRegistry::instance()
+{
+  static PluginRegistry * instance = ers::SingletonCreator<PluginRegistry>::create();
+  return *instance;
+}
+
+void
+PluginRegistry::register_plugin(const std::string& name, creator_fn creator) noexcept
+{
+  std::lock_guard<std::recursive_mutex> scoped_lock(m_mutex);
+
+  TLOG_DEBUG(1) << "register plug-in " << name;
+
+  if (m_creators.emplace(name, creator).second == false)
+    {
+      TLOG_DEBUG(0) << "plug-in " << name << " was already registered";
+    }
+}
+
+PluginRegistry::creator_fn
+PluginRegistry::get(const std::string& name)
+{
+  std::lock_guard<std::recursive_mutex> scoped_lock(m_mutex);
+
+  auto i = m_creators.find(name);
+
+  if (i != m_creators.end())
+    return i->second;
+
+  std::string plugin_name = std::string("lib") + name + ".so";
+  std::string impl_creator = std::string("_") + name + "_creator_";
+
+  // load plug-in; it is never unloaded, since the creator is cached
+
+  void * shlib_h = dlopen(plugin_name.c_str(), RTLD_LAZY | RTLD_GLOBAL);
+
+  if (!shlib_h)
+    {
+      std::ostringstream text;
+      text << "failed to load implementation plug-in \'" << plugin_name << "\': \"" << dlerror() << '\"';
+      throw(daq::config::Generic( ERS_HERE, text.str().c_str() ) );
+    }
+
+  // search in plug-in implementation creator function
+
+  dlerror();
+
+  creator_fn f = reinterpret_cast<creator_fn>(dlsym(shlib_h, impl_creator.c_str()));
+
+  if (const char * error = dlerror())
+    {
+      std::ostringstream text;
+      text << "failed to find implementation creator function \'" << impl_creator << "\' in plug-in \'" << plugin_name << "\': \"" << error << '\"';
+      throw(daq::config::Generic( ERS_HERE, text.str().c_str() ) );
+    }
+
+  TLOG_DEBUG(1) << "loaded plug-in " << plugin_name;
+
+  m_creators[name] = f;
+
+  return f;
+}
+
+ConfigurationImpl *
+PluginRegistry::create(const std::string& spec)
+{
+  std::string::size_type idx = spec.find_first_of(':');
+
+  if (idx == std::string::npos)
+    return (*get(spec))("");
+  else
+    return (*get(spec.substr(0, idx)))(spec.substr(idx + 1));
+}
+
+std::vector<std::string>
+PluginRegistry::get_names() const
+{
+  std::lock_guard<std::recursive_mutex> scoped_lock(m_mutex);
+
+  std::vector<std::string> names;
+  names.reserve(m_creators.size());
+
+  for (const auto& x : m_creators)
+    names.push_back(x.first);
+
+  return names;
+}
@@ -0,0 +1,212 @@
+#include <mutex>
+
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+#include "config/ProxyConfigObject.hpp"
+#include "config/ProxyConfiguration.hpp"
+
+using namespace config::proxy;
+
+
+ProxyConfigObject::ProxyConfigObject(ConfigObjectImpl * obj, ConfigurationImpl * impl) noexcept :
+  ConfigObjectImpl(impl, obj->UID()),
+  m_obj(obj)
+{
+}
+
+ProxyConfigObject::~ProxyConfigObject() noexcept
+{
+}
+
+void
+ProxyConfigObject::check() const
+{
+  std::lock_guard<std::mutex> scoped_lock(m_mutex);
+  throw_if_deleted();
+}
+
+const std::string
+ProxyConfigObject::contained_in() const
+{
+  check();
+
+  std::string value;
+  db()->call(config::proxy::contained_in, *m_class_name, m_id, "", [&]() { value = m_obj->contained_in(); return size_of(value); });
+  return value;
+}
+
+template<class T>
+void
+ProxyConfigObject::get_value(const std::string& name, T& value)
+{
+  check();
+  db()->call(get_attribute, *m_class_name, m_id, name, [&]() { m_obj->get(name, value); return size_of(value); });
+}
+
+template<class T>
+void
+ProxyConfigObject::set_value(const std::string& name, const T& value)
+{
+  check();
+  db()->call(set_attribute, *m_class_name, m_id, name, [&]() { m_obj->set(name, value); return 0; });
+}
+
+void
+ProxyConfigObject::get(const std::string& name, ConfigObject& value)
+{
+  check();
+  db()->call(get_relationship, *m_class_name, m_id, name, [&]() { m_obj->get(name, value); return size_of(value); });
+
+  std::lock_guard<std::mutex> scoped_lock(db()->get_conf_impl_mutex());
+  db()->wrap(value);
+}
+
+void
+ProxyConfigObject::get(const std::string& name, std::vector<ConfigObject>& value)
+{
+  check();
+  db()->call(get_relationship, *m_class_name, m_id, name, [&]() { m_obj->get(name, value); return size_of(value); });
+
+  std::lock_guard<std::mutex> scoped_lock(db()->get_conf_impl_mutex());
+  db()->wrap(value);
+}
+
+bool
+ProxyConfigObject::rel(const std::string& name, std::vector<ConfigObject>& value)
+{
+  check();
+
+  bool result;
+  db()->call(get_rel, *m_class_name, m_id, name, [&]() { result = m_obj->rel(name, value); return size_of(value); });
+
+  if (result)
+    {
+      std::lock_guard<std::mutex> scoped_lock(db()->get_conf_impl_mutex());
+      db()->wrap(value);
+    }
+
+  return result;
+}
+
+void
+ProxyConfigObject::referenced_by(std::vector<ConfigObject>& value, const std::string& association, bool check_composite_only, unsigned long rlevel, const std::vector<std::string> * rclasses) const
+{
+  check();
+  db()->call(config::proxy::referenced_by, *m_class_name, m_id, association, [&]() { m_obj->referenced_by(value, association, check_composite_only, rlevel, rclasses); return size_of(value); });
+
+  std::lock_guard<std::mutex> scoped_lock(db()->get_conf_impl_mutex());
+  db()->wrap(value);
+}
+
+
+void
+ProxyConfigObject::set_enum(const std::string& name, const std::string& value)
+{
+  check();
+  db()->call(set_attribute, *m_class_name, m_id, name, [&]() { m_obj->set_enum(name, value); return 0; });
+}
+
+void
+ProxyConfigObject::set_date(const std::string& name, const std::string& value)
+{
+  check();
+  db()->call(set_attribute, *m_class_name, m_id, name, [&]() { m_obj->set_date(name, value); return 0; });
+}
+
+void
+ProxyConfigObject::set_time(const std::string& name, const std::string& value)
+{
+  check();
+  db()->call(set_attribute, *m_class_name, m_id, name, [&]() { m_obj->set_time(name, value); return 0; });
+}
+
+void
+ProxyConfigObject::set_class(const std::string& name, const std::string& value)
+{
+  check();
+  db()->call(set_attribute, *m_class_name, m_id, name, [&]() { m_obj->set_class(name, value); return 0; });
+}
+
+void
+ProxyConfigObject::set_enum(const std::string& name, const std::vector<std::string>& value)
+{
+  check();
+  db()->call(set_attribute, *m_class_name, m_id, name, [&]() { m_obj->set_enum(name, value); return 0; });
+}
+
+void
+ProxyConfigObject::set_date(const std::string& name, const std::vector<std::string>& value)
+{
+  check();
+  db()->call(set_attribute, *m_class_name, m_id, name, [&]() { m_obj->set_date(name, value); return 0; });
+}
+
+void
+ProxyConfigObject::set_time(const std::string& name, const std::vector<std::string>& value)
+{
+  check();
+  db()->call(set_attribute, *m_class_name, m_id, name, [&]() { m_obj->set_time(name, value); return 0; });
+}
+
+void
+ProxyConfigObject::set_class(const std::string& name, const std::vector<std::string>& value)
+{
+  check();
+  db()->call(set_attribute, *m_class_name, m_id, name, [&]() { m_obj->set_class(name, value); return 0; });
+}
+
+void
+ProxyConfigObject::set(const std::string& name, const ConfigObject * value, bool skip_non_null_check)
+{
+  check();
+
+  ConfigObject obj;
+
+  if (value)
+    obj = db()->unwrap(*value);
+
+  db()->call(set_relationship, *m_class_name, m_id, name, [&]() { m_obj->set(name, (value ? &obj : nullptr), skip_non_null_check); return 0; });
+}
+
+void
+ProxyConfigObject::set(const std::string& name, const std::vector<const ConfigObject*>& value, bool skip_non_null_check)
+{
+  check();
+
+  std::vector<ConfigObject> objs;
+  objs.reserve(value.size());
+
+  for (const auto& x : value)
+    objs.push_back(db()->unwrap(*x));
+
+  std::vector<const ConfigObject*> ptrs;
+  ptrs.reserve(objs.size());
+
+  for (const auto& x : objs)
+    ptrs.push_back(&x);
+
+  db()->call(set_relationship, *m_class_name, m_id, name, [&]() { m_obj->set(name, ptrs, skip_non_null_check); return 0; });
+}
+
+void
+ProxyConfigObject::move(const std::string& at)
+{
+  check();
+  db()->call(config::proxy::move, *m_class_name, m_id, at, [&]() { m_obj->move(at); return 0; });
+}
+
+  // the caller (Configuration::rename_object) locks this object and changes its ID
+
+void
+ProxyConfigObject::rename(const std::string& new_id)
+{
+  db()->call(config::proxy::rename, *m_class_name, m_id, new_id, [&]() { db()->rename_inner(m_obj, new_id); return 0; });
+}
+
+  // the proxied object is already updated by the ProxyConfiguration::notify_cb() or abort()
+
+void
+ProxyConfigObject::reset()
+{
+  m_state = (m_obj->is_deleted() ? daq::config::Deleted : daq::config::Valid);
+}
@@ -0,0 +1,410 @@
+#include <iostream>
+#include <mutex>
+#include <sstream>
+
+#include "ers/ers.hpp"
+#include "logging/Logging.hpp"
+
+#include "config/Change.hpp"
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+#include "config/PluginRegistry.hpp"
+#include "config/ProxyConfigObject.hpp"
+#include "config/ProxyConfiguration.hpp"
+#include "config/Schema.hpp"
+
+using namespace config::proxy;
+
+
+const char *
+config::proxy::call2str(CallType type) noexcept
+{
+  switch (type)
+    {
+      case get_object:        return "get object";
+      case get_objects:       return "get objects";
+      case get_path:          return "get path";
+      case test_object:       return "test object";
+      case get_class:         return "get class";
+      case get_superclasses:  return "get superclasses";
+      case create_db:         return "create db";
+      case is_writable:       return "is writable";
+      case add_include:       return "add include";
+      case remove_include:    return "remove include";
+      case get_includes:      return "get includes";
+      case get_updated_dbs:   return "get updated dbs";
+      case create_object:     return "create object";
+      case destroy_object:    return "destroy object";
+      case commit:            return "commit";
+      case abort:             return "abort";
+      case get_changes:       return "get changes";
+      case get_versions:      return "get versions";
+      case prefetch_all_data: return "prefetch all data";
+      case get_attribute:     return "get attribute";
+      case get_relationship:  return "get relationship";
+      case get_rel:           return "get rel";
+      case referenced_by:     return "referenced by";
+      case contained_in:      return "contained in";
+      case set_attribute:     return "set attribute";
+      case set_relationship:  return "set relationship";
+      case move:              return "move";
+      case rename:            return "rename";
+      default:                return "unknown";
+    }
+}
+
+
+ProxyConfiguration::ProxyConfiguration() noexcept :
+  m_cb(nullptr)
+{
+}
+
+ProxyConfiguration::~ProxyConfiguration()
+{
+  close_db();
+}
+
+void
+ProxyConfiguration::called(CallType, const std::string&, const std::string&, const std::string&, uint64_t, std::chrono::steady_clock::time_point, std::chrono::nanoseconds, bool) noexcept
+{
+}
+
+void
+ProxyConfiguration::open_db(const std::string& spec)
+{
+  close_db();
+
+  m_inner.reset(PluginRegistry::instance().create(spec));
+
+  if (!m_inner)
+    {
+      std::ostringstream text;
+      text << "cannot create implementation of proxied database \"" << spec << '\"';
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  if (m_conf)
+    m_inner->set(m_conf);
+
+  if (m_resolver)
+    m_inner->set_resolver(m_resolver);
+
+  m_spec = spec;
+
+  TLOG_DEBUG(1) << "open proxied database \"" << spec << '\"';
+}
+
+void
+ProxyConfiguration::close_db()
+{
+  // proxy objects refer objects of proxied implementation
+  clean();
+
+  m_inner.reset();
+  m_spec.clear();
+}
+
+void
+ProxyConfiguration::set(Configuration * db) noexcept
+{
+  ConfigurationImpl::set(db);
+
+  if (m_inner)
+    m_inner->set(db);
+}
+
+void
+ProxyConfiguration::set_resolver(ConfigurationImpl * impl) noexcept
+{
+  ConfigurationImpl::set_resolver(impl);
+
+  if (m_inner)
+    m_inner->set_resolver(impl);
+}
+
+bool
+ProxyConfiguration::loaded() const noexcept
+{
+  return (m_inner && m_inner->loaded());
+}
+
+
+bool
+ProxyConfiguration::is_inner(const ConfigurationImpl * impl) const noexcept
+{
+  return (impl == m_inner.get());
+}
+
+void
+ProxyConfiguration::wrap(ConfigObject& obj) noexcept
+{
+  if (!obj.is_null() && is_inner(get_impl(obj.implementation())))
+    {
+      ConfigObjectImpl * impl = const_cast<ConfigObjectImpl *>(obj.implementation());
+      obj = insert_object<ProxyConfigObject>(impl, impl->UID(), impl->class_name());
+    }
+}
+
+void
+ProxyConfiguration::wrap(std::vector<ConfigObject>& objs) noexcept
+{
+  for (auto& x : objs)
+    wrap(x);
+}
+
+ConfigObject
+ProxyConfiguration::unwrap(const ConfigObject& obj) const
+{
+  if (obj.is_null())
+    return obj;
+
+  const ProxyConfigObject * impl = dynamic_cast<const ProxyConfigObject *>(obj.implementation());
+
+  if (impl == nullptr || impl->m_impl != this)
+    {
+      std::ostringstream text;
+      text << "object " << obj.UID() << '@' << obj.class_name() << " does not belong to the proxy of database \"" << m_spec << '\"';
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  return ConfigObject(impl->m_obj);
+}
+
+void
+ProxyConfiguration::rename_inner(ConfigObjectImpl * obj, const std::string& new_id)
+{
+  get_impl(obj)->rename_impl(obj, new_id);
+}
+
+
+void
+ProxyConfiguration::create(const std::string& db_name, const std::list<std::string>& includes)
+{
+  call(create_db, "", "", db_name, [&]() { m_inner->create(db_name, includes); return 0; });
+}
+
+bool
+ProxyConfiguration::is_writable(const std::string& db_name)
+{
+  bool result;
+  call(config::proxy::is_writable, "", "", db_name, [&]() { result = m_inner->is_writable(db_name); return size_of(result); });
+  return result;
+}
+
+void
+ProxyConfiguration::add_include(const std::string& db_name, const std::string& include)
+{
+  call(config::proxy::add_include, "", "", db_name, [&]() { m_inner->add_include(db_name, include); return 0; });
+}
+
+void
+ProxyConfiguration::remove_include(const std::string& db_name, const std::string& include)
+{
+  call(config::proxy::remove_include, "", "", db_name, [&]() { m_inner->remove_include(db_name, include); return 0; });
+}
+
+void
+ProxyConfiguration::get_includes(const std::string& db_name, std::list<std::string>& includes) const
+{
+  const_cast<ProxyConfiguration *>(this)->call(config::proxy::get_includes, "", "", db_name, [&]() {
+    m_inner->get_includes(db_name, includes);
+    uint64_t size = 0;
+    for (const auto& x : includes)
+      size += size_of(x);
+    return size;
+  });
+}
+
+void
+ProxyConfiguration::get_updated_dbs(std::list<std::string>& dbs) const
+{
+  const_cast<ProxyConfiguration *>(this)->call(config::proxy::get_updated_dbs, "", "", "", [&]() {
+    m_inner->get_updated_dbs(dbs);
+    uint64_t size = 0;
+    for (const auto& x : dbs)
+      size += size_of(x);
+    return size;
+  });
+}
+
+void
+ProxyConfiguration::set_commit_credentials(const std::string& user, const std::string& password)
+{
+  m_inner->set_commit_credentials(user, password);
+}
+
+void
+ProxyConfiguration::commit(const std::string& log_message)
+{
+  call(config::proxy::commit, "", "", log_message, [&]() { m_inner->commit(log_message); return 0; });
+}
+
+  // the caller (Configuration::abort) unreads proxy objects; unread objects of proxied implementation as well
+
+void
+ProxyConfiguration::abort()
+{
+  call(config::proxy::abort, "", "", "", [&]() { m_inner->abort(); return 0; });
+  m_inner->unread_impl_objects();
+}
+
+void
+ProxyConfiguration::prefetch_all_data()
+{
+  call(config::proxy::prefetch_all_data, "", "", "", [&]() { m_inner->prefetch_all_data(); return 0; });
+}
+
+std::vector<daq::config::Version>
+ProxyConfiguration::get_changes()
+{
+  std::vector<daq::config::Version> result;
+  call(config::proxy::get_changes, "", "", "", [&]() { result = m_inner->get_changes(); return size_of(result); });
+  return result;
+}
+
+std::vector<daq::config::Version>
+ProxyConfiguration::get_versions(const std::string& since, const std::string& until, daq::config::Version::QueryType type, bool skip_irrelevant)
+{
+  std::vector<daq::config::Version> result;
+  call(config::proxy::get_versions, "", "", since, [&]() { result = m_inner->get_versions(since, until, type, skip_irrelevant); return size_of(result); });
+  return result;
+}
+
+
+  // the caller (Configuration) locks configuration implementation mutex
+
+void
+ProxyConfiguration::get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long rlevel, const std::vector<std::string> * rclasses)
+{
+  call(get_object, class_name, id, "", [&]() { m_inner->get(class_name, id, object, rlevel, rclasses); return size_of(object); });
+  wrap(object);
+}
+
+void
+ProxyConfiguration::get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses)
+{
+  call(get_objects, class_name, "", query, [&]() { m_inner->get(class_name, objects, query, rlevel, rclasses); return size_of(objects); });
+  wrap(objects);
+}
+
+void
+ProxyConfiguration::get(const ConfigObject& obj_from, const std::string& query, std::vector<ConfigObject>& objects, unsigned long rlevel, const std::vector<std::string> * rclasses)
+{
+  const ConfigObject obj(unwrap(obj_from));
+  call(get_path, obj_from.class_name(), obj_from.UID(), query, [&]() { m_inner->get(obj, query, objects, rlevel, rclasses); return size_of(objects); });
+  wrap(objects);
+}
+
+bool
+ProxyConfiguration::test_object(const std::string& class_name, const std::string& id, unsigned long rlevel, const std::vector<std::string> * rclasses)
+{
+  bool result;
+  call(config::proxy::test_object, class_name, id, "", [&]() { result = m_inner->test_object(class_name, id, rlevel, rclasses); return size_of(result); });
+  return result;
+}
+
+void
+ProxyConfiguration::create(const std::string& at, const std::string& class_name, const std::string& id, ConfigObject& object)
+{
+  call(create_object, class_name, id, at, [&]() { m_inner->create(at, class_name, id, object); return 0; });
+  wrap(object);
+}
+
+void
+ProxyConfiguration::create(const ConfigObject& at, const std::string& class_name, const std::string& id, ConfigObject& object)
+{
+  const ConfigObject obj(unwrap(at));
+  call(create_object, class_name, id, at.UID(), [&]() { m_inner->create(obj, class_name, id, object); return 0; });
+  wrap(object);
+}
+
+void
+ProxyConfiguration::destroy(ConfigObject& object)
+{
+  ConfigObject obj(unwrap(object));
+  call(destroy_object, object.class_name(), object.UID(), "", [&]() { m_inner->destroy(obj); return 0; });
+
+  // the proxied implementation may also destroy composite children; proxy objects check the state of proxied ones on next access
+  unread_impl_objects();
+}
+
+daq::config::class_t *
+ProxyConfiguration::get(const std::string& class_name, bool direct_only)
+{
+  daq::config::class_t * result;
+  call(get_class, class_name, "", "", [&]() { result = m_inner->get(class_name, direct_only); return 0; });
+  return result;
+}
+
+void
+ProxyConfiguration::get_superclasses(config::fmap<config::fset>& schema)
+{
+  call(config::proxy::get_superclasses, "", "", "", [&]() { m_inner->get_superclasses(schema); return 0; });
+}
+
+
+  // the proxied implementation notifies the proxy, that updates cache of proxied implementation(s) and calls the Configuration
+
+void
+ProxyConfiguration::subscribe(const std::set<std::string>& class_names, const std::map< std::string, std::set<std::string> >& objs, ConfigurationImpl::notify cb, ConfigurationImpl::pre_notify pre_cb)
+{
+  m_cb = cb;
+  m_inner->subscribe(class_names, objs, notify_cb, pre_cb);
+}
+
+void
+ProxyConfiguration::unsubscribe()
+{
+  m_inner->unsubscribe();
+  m_cb = nullptr;
+}
+
+void
+ProxyConfiguration::notify_cb(std::vector<ConfigurationChange *>& changes, Configuration * db) noexcept
+{
+  // in case of nested proxies the callback is invoked by the innermost implementation; the configuration implementation is the outermost proxy
+
+  ProxyConfiguration * proxy = dynamic_cast<ProxyConfiguration *>(get_impl(db));
+
+  if (proxy == nullptr)
+    {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(proxy->get_conf_impl_mutex());
+      proxy->update_inner_objects(changes);
+    }
+
+  if (proxy->m_cb)
+    proxy->m_cb(changes, db);
+}
+
+void
+ProxyConfiguration::update_inner_objects(std::vector<ConfigurationChange *>& changes) noexcept
+{
+  if (m_inner)
+    update_objects(m_inner.get(), changes);
+}
+
+void
+ProxyConfiguration::update_objects(ConfigurationImpl * impl, std::vector<ConfigurationChange *>& changes) noexcept
+{
+  impl->update_impl_objects(changes);
+
+  if (ProxyConfiguration * proxy = dynamic_cast<ProxyConfiguration *>(impl))
+    proxy->update_inner_objects(changes);
+}
+
+
+void
+ProxyConfiguration::print_profiling_info() noexcept
+{
+  std::cout << "Proxied database \"" << m_spec << "\":\n";
+
+  if (m_inner)
+    {
+      m_inner->print_cache_info();
+      m_inner->print_profiling_info();
+    }
+}
@@ -0,0 +1,583 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <type_traits>
+
+#include "ers/ers.hpp"
+
+#include "config/ConfigObject.hpp"
+#include "config/Configuration.hpp"
+#include "config/Errors.hpp"
+#include "config/Snapshot.hpp"
+
+
+namespace config
+{
+  namespace snapshot
+  {
+
+    uint64_t
+    checksum(const void * data, uint64_t size) noexcept
+    {
+      const unsigned char * p = static_cast<const unsigned char *>(data);
+      uint64_t hash = 0xcbf29ce484222325ULL;
+
+      for (uint64_t i = 0; i < size; ++i)
+        {
+          hash ^= p[i];
+          hash *= 0x100000001b3ULL;
+        }
+
+      return hash;
+    }
+
+
+    namespace
+    {
+
+        // 8-bytes aligned output buffer; the records are addressed by offsets since the buffer may grow
+
+      class Buffer
+      {
+
+      public:
+
+        uint64_t
+        allocate(uint64_t size)
+        {
+          uint64_t offset = (m_data.size() + 7) & ~static_cast<uint64_t>(7);
+          m_data.resize(offset + size, 0);
+          return offset;
+        }
+
+        template<class T>
+        T *
+        at(uint64_t offset) noexcept
+        {
+          return reinterpret_cast<T *>(m_data.data() + offset);
+        }
+
+        template<class T>
+        void
+        put(uint64_t offset, const T& value) noexcept
+        {
+          memcpy(m_data.data() + offset, &value, sizeof(T));
+        }
+
+        std::vector<char> m_data;
+
+      };
+
+
+        // the string table; equal strings are stored once
+
+      class Strings
+      {
+
+      public:
+
+        uint32_t
+        add(const std::string& s)
+        {
+          auto i = m_index.find(s);
+
+          if (i != m_index.end())
+            return i->second;
+
+          if (m_data.size() + sizeof(uint32_t) + s.size() + 1 > UINT32_MAX)
+            throw daq::config::Generic(ERS_HERE, "string table exceeds 4GB");
+
+          const uint32_t offset = m_data.size();
+          const uint32_t len = s.size();
+
+          m_data.append(reinterpret_cast<const char *>(&len), sizeof(len));
+          m_data.append(s.c_str(), s.size() + 1);
+
+          m_index.emplace(s, offset);
+
+          return offset;
+        }
+
+        std::string m_data;
+
+      private:
+
+        config::map<uint32_t> m_index;
+
+      };
+
+    }
+
+
+    Writer::Writer(Configuration& db) :
+      m_number_of_objects(0),
+      m_number_of_dangling_references(0)
+    {
+      std::set<std::string> names;
+
+      for (const auto& c : db.superclasses())
+        names.insert(*c.first);
+
+      m_classes.reserve(names.size());
+
+      for (const auto& c : names)
+        {
+          m_class_index.emplace(c, m_classes.size());
+          m_classes.emplace_back(new ClassData(db.get_class_info(c, false), db.get_class_info(c, true)));
+        }
+    }
+
+    Writer::~Writer()
+    {
+    }
+
+
+    template<class T>
+    static void
+    add_value(ConfigObject& obj, const daq::config::attribute_t& a, std::vector<Value>& values)
+    {
+      if (a.p_is_multi_value)
+        {
+          std::vector<T> value;
+          obj.get(a.p_name, value);
+          values.emplace_back(std::move(value));
+        }
+      else
+        {
+          T value;
+          obj.get(a.p_name, value);
+          values.emplace_back(std::move(value));
+        }
+    }
+
+    void
+    Writer::add(const ConfigObject& object)
+    {
+      auto i = m_class_index.find(object.class_name());
+
+      if (i == m_class_index.end())
+        {
+          std::ostringstream text;
+          text << "cannot add object " << object.full_name() << " to snapshot: unknown class";
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      ClassData& c(*m_classes[i->second]);
+
+      ConfigObject& obj(const_cast<ConfigObject&>(object));
+
+      ObjectData data;
+
+      data.m_id = obj.UID();
+      data.m_file = obj.contained_in();
+      data.m_attributes.reserve(c.m_info.p_attributes.size());
+      data.m_relationships.reserve(c.m_info.p_relationships.size());
+
+      for (const auto& a : c.m_info.p_attributes)
+        switch (a.p_type)
+          {
+            case daq::config::bool_type:   add_value<bool>(obj, a, data.m_attributes);     break;
+            case daq::config::s8_type:     add_value<int8_t>(obj, a, data.m_attributes);   break;
+            case daq::config::u8_type:     add_value<uint8_t>(obj, a, data.m_attributes);  break;
+            case daq::config::s16_type:    add_value<int16_t>(obj, a, data.m_attributes);  break;
+            case daq::config::u16_type:    add_value<uint16_t>(obj, a, data.m_attributes); break;
+            case daq::config::s32_type:    add_value<int32_t>(obj, a, data.m_attributes);  break;
+            case daq::config::u32_type:    add_value<uint32_t>(obj, a, data.m_attributes); break;
+            case daq::config::s64_type:    add_value<int64_t>(obj, a, data.m_attributes);  break;
+            case daq::config::u64_type:    add_value<uint64_t>(obj, a, data.m_attributes); break;
+            case daq::config::float_type:  add_value<float>(obj, a, data.m_attributes);    break;
+            case daq::config::double_type: add_value<double>(obj, a, data.m_attributes);   break;
+            default:                       add_value<std::string>(obj, a, data.m_attributes);
+          }
+
+      for (const auto& r : c.m_info.p_relationships)
+        {
+          data.m_relationships.emplace_back();
+          auto& refs(data.m_relationships.back());
+
+          if (r.p_cardinality == daq::config::zero_or_many || r.p_cardinality == daq::config::one_or_many)
+            {
+              std::vector<ConfigObject> values;
+              obj.get(r.p_name, values);
+
+              refs.reserve(values.size());
+
+              for (const auto& x : values)
+                refs.emplace_back(x.class_name(), x.UID());
+            }
+          else
+            {
+              ConfigObject value;
+              obj.get(r.p_name, value);
+
+              if (!value.is_null())
+                refs.emplace_back(value.class_name(), value.UID());
+            }
+        }
+
+        {
+          std::lock_guard<std::mutex> scoped_lock(c.m_mutex);
+          c.m_objects.push_back(std::move(data));
+        }
+
+      m_number_of_objects++;
+    }
+
+
+      // write single value or array of values into 8-bytes slot
+
+    template<class T>
+    static uint64_t
+    put_value(const T& value, Buffer& buf, Strings& strings)
+    {
+      uint64_t slot = 0;
+
+      if constexpr (std::is_same<T, std::string>::value)
+        {
+          uint32_t ref = strings.add(value);
+          memcpy(&slot, &ref, sizeof(ref));
+        }
+      else if constexpr (std::is_arithmetic<T>::value)
+        {
+          typedef typename std::conditional<std::is_same<T, bool>::value, uint8_t, T>::type S;
+          S v = value;
+          memcpy(&slot, &v, sizeof(v));
+        }
+      else
+        {
+          typedef typename T::value_type I;
+          typedef typename std::conditional<std::is_same<I, bool>::value, uint8_t, typename std::conditional<std::is_same<I, std::string>::value, uint32_t, I>::type>::type S;
+
+          if (!value.empty())
+            {
+              std::vector<S> items;
+              items.reserve(value.size());
+
+              for (const auto& x : value)
+                {
+                  if constexpr (std::is_same<I, std::string>::value)
+                    items.push_back(strings.add(x));
+                  else
+                    items.push_back(x);
+                }
+
+              slot = buf.allocate(sizeof(uint64_t) + sizeof(S) * items.size());
+              buf.put<uint64_t>(slot, items.size());
+              memcpy(buf.at<char>(slot + sizeof(uint64_t)), items.data(), sizeof(S) * items.size());
+            }
+        }
+
+      return slot;
+    }
+
+    std::vector<char>
+    Writer::serialize(const std::string& name)
+    {
+      // sort objects by id and remove duplicates
+
+      for (auto& c : m_classes)
+        {
+          std::sort(c->m_objects.begin(), c->m_objects.end(), [](const ObjectData& o1, const ObjectData& o2) { return o1.m_id < o2.m_id; });
+          c->m_objects.erase(std::unique(c->m_objects.begin(), c->m_objects.end(), [](const ObjectData& o1, const ObjectData& o2) { return o1.m_id == o2.m_id; }), c->m_objects.end());
+        }
+
+      auto find_object = [this](const std::pair<std::string, std::string>& ref, uint64_t& value) -> bool {
+        auto c = m_class_index.find(ref.first);
+
+        if (c == m_class_index.end())
+          return false;
+
+        const auto& objs(m_classes[c->second]->m_objects);
+        auto o = std::lower_bound(objs.begin(), objs.end(), ref.second, [](const ObjectData& x, const std::string& id) { return x.m_id < id; });
+
+        if (o == objs.end() || o->m_id != ref.second)
+          return false;
+
+        value = make_ref(c->second, o - objs.begin());
+        return true;
+      };
+
+      Buffer buf;
+      Strings strings;
+      std::vector<uint32_t> files;
+      config::map<uint32_t> files_index;
+
+      m_number_of_dangling_references = 0;
+
+      buf.allocate(sizeof(Header));
+
+      const uint64_t classes = buf.allocate(sizeof(Class) * m_classes.size());
+
+      uint64_t number_of_objects = 0;
+
+      for (uint32_t idx = 0; idx < m_classes.size(); ++idx)
+        {
+          const ClassData& c(*m_classes[idx]);
+
+          Class rec;
+          memset(&rec, 0, sizeof(rec));
+
+          rec.m_name = strings.add(c.m_info.p_name);
+          rec.m_description = strings.add(c.m_info.p_description);
+          rec.m_flags = (c.m_info.p_abstract ? Class::abstract_flag : 0);
+
+          auto put_classes = [&](const std::vector<std::string>& all, const std::vector<std::string>& direct, uint32_t& count) -> uint64_t {
+            std::vector<uint32_t> items;
+
+            for (const auto& x : all)
+              {
+                auto i = m_class_index.find(x);
+                if (i != m_class_index.end())
+                  items.push_back(i->second | (std::find(direct.begin(), direct.end(), x) != direct.end() ? direct_class_bit : 0));
+              }
+
+            count = items.size();
+
+            if (items.empty())
+              return 0;
+
+            uint64_t offset = buf.allocate(sizeof(uint32_t) * items.size());
+            memcpy(buf.at<char>(offset), items.data(), sizeof(uint32_t) * items.size());
+            return offset;
+          };
+
+          rec.m_superclasses = put_classes(c.m_info.p_superclasses, c.m_direct.p_superclasses, rec.m_superclasses_count);
+          rec.m_subclasses = put_classes(c.m_info.p_subclasses, c.m_direct.p_subclasses, rec.m_subclasses_count);
+
+          rec.m_attributes_count = c.m_info.p_attributes.size();
+          rec.m_attributes = buf.allocate(sizeof(Attribute) * rec.m_attributes_count);
+
+          for (uint32_t i = 0; i < rec.m_attributes_count; ++i)
+            {
+              const daq::config::attribute_t& a(c.m_info.p_attributes[i]);
+
+              Attribute x;
+              memset(&x, 0, sizeof(x));
+
+              x.m_name = strings.add(a.p_name);
+              x.m_range = strings.add(a.p_range);
+              x.m_default_value = strings.add(a.p_default_value);
+              x.m_description = strings.add(a.p_description);
+              x.m_type = a.p_type;
+              x.m_int_format = a.p_int_format;
+              x.m_flags = (a.p_is_not_null ? Attribute::not_null_flag : 0) | (a.p_is_multi_value ? Attribute::multi_value_flag : 0) |
+                          (std::any_of(c.m_direct.p_attributes.begin(), c.m_direct.p_attributes.end(), [&a](const daq::config::attribute_t& d) { return d.p_name == a.p_name; }) ? Attribute::direct_flag : 0);
+
+              buf.put(rec.m_attributes + i * sizeof(Attribute), x);
+            }
+
+          rec.m_relationships_count = c.m_info.p_relationships.size();
+          rec.m_relationships = buf.allocate(sizeof(Relationship) * rec.m_relationships_count);
+
+          for (uint32_t i = 0; i < rec.m_relationships_count; ++i)
+            {
+              const daq::config::relationship_t& r(c.m_info.p_relationships[i]);
+
+              auto type = m_class_index.find(r.p_type);
+
+              if (type == m_class_index.end())
+                {
+                  std::ostringstream text;
+                  text << "cannot find class \"" << r.p_type << "\" of relationship \"" << r.p_name << "\" of class \"" << c.m_info.p_name << '\"';
+                  throw daq::config::Generic(ERS_HERE, text.str().c_str());
+                }
+
+              Relationship x;
+              memset(&x, 0, sizeof(x));
+
+              x.m_name = strings.add(r.p_name);
+              x.m_type = type->second;
+              x.m_description = strings.add(r.p_description);
+              x.m_cardinality = r.p_cardinality;
+              x.m_flags = (r.p_is_aggregation ? Relationship::aggregation_flag : 0) |
+                          (std::any_of(c.m_direct.p_relationships.begin(), c.m_direct.p_relationships.end(), [&r](const daq::config::relationship_t& d) { return d.p_name == r.p_name; }) ? Relationship::direct_flag : 0);
+
+              buf.put(rec.m_relationships + i * sizeof(Relationship), x);
+            }
+
+          rec.m_objects_count = c.m_objects.size();
+          rec.m_objects = buf.allocate(sizeof(Object) * rec.m_objects_count);
+
+          for (uint32_t i = 0; i < rec.m_objects_count; ++i)
+            {
+              const ObjectData& o(c.m_objects[i]);
+              const uint32_t num_of_slots = o.m_attributes.size() + o.m_relationships.size();
+
+              Object x;
+              memset(&x, 0, sizeof(x));
+
+              x.m_id = strings.add(o.m_id);
+
+              auto f = files_index.find(o.m_file);
+              if (f == files_index.end())
+                {
+                  f = files_index.emplace(o.m_file, files.size()).first;
+                  files.push_back(strings.add(o.m_file));
+                }
+
+              x.m_file = f->second;
+              x.m_data = buf.allocate(sizeof(uint64_t) * num_of_slots);
+
+              buf.put(rec.m_objects + i * sizeof(Object), x);
+
+              uint32_t slot = 0;
+
+              for (const auto& a : o.m_attributes)
+                {
+                  uint64_t value = std::visit([&buf, &strings](const auto& v) { return put_value(v, buf, strings); }, a);
+                  buf.put(x.m_data + sizeof(uint64_t) * slot++, value);
+                }
+
+              for (const auto& r : o.m_relationships)
+                {
+                  std::vector<uint64_t> refs;
+                  refs.reserve(r.size());
+
+                  for (const auto& ref : r)
+                    {
+                      uint64_t value;
+
+                      if (find_object(ref, value))
+                        refs.push_back(value);
+                      else
+                        m_number_of_dangling_references++;
+                    }
+
+                  uint64_t value = 0;
+
+                  if (!refs.empty())
+                    {
+                      value = buf.allocate(sizeof(uint64_t) * (refs.size() + 1));
+                      buf.put<uint64_t>(value, refs.size());
+                      memcpy(buf.at<char>(value + sizeof(uint64_t)), refs.data(), sizeof(uint64_t) * refs.size());
+                    }
+
+                  buf.put(x.m_data + sizeof(uint64_t) * slot++, value);
+                }
+            }
+
+          number_of_objects += rec.m_objects_count;
+
+          buf.put(classes + idx * sizeof(Class), rec);
+        }
+
+      if (m_number_of_dangling_references)
+        {
+          std::ostringstream text;
+          text << "snapshot \"" << name << "\" ignores " << m_number_of_dangling_references << " references to objects, which were not added";
+          ers::warning(daq::config::Generic(ERS_HERE, text.str().c_str()));
+        }
+
+      Header header;
+      memset(&header, 0, sizeof(header));
+
+      header.m_files_count = files.size();
+      header.m_files = buf.allocate(sizeof(uint32_t) * files.size());
+      if (!files.empty())
+        memcpy(buf.at<char>(header.m_files), files.data(), sizeof(uint32_t) * files.size());
+
+      header.m_strings_size = strings.m_data.size();
+      header.m_strings = buf.allocate(strings.m_data.size());
+      memcpy(buf.at<char>(header.m_strings), strings.m_data.data(), strings.m_data.size());
+
+      buf.allocate(0);  // align size
+
+      memcpy(header.m_magic, magic, sizeof(magic));
+      header.m_version = format_version;
+      header.m_byte_order = byte_order_mark;
+      header.m_size = buf.m_data.size();
+      header.m_checksum = checksum(buf.m_data.data() + sizeof(Header), buf.m_data.size() - sizeof(Header));
+      header.m_created = time(nullptr);
+      header.m_classes_count = m_classes.size();
+      header.m_classes = classes;
+      header.m_objects_count = number_of_objects;
+
+      buf.put(0, header);
+
+      return std::move(buf.m_data);
+    }
+
+    void
+    Writer::write(const std::string& file_name)
+    {
+      const std::vector<char> data(serialize(file_name));
+
+      // write to temporary file and rename, so readers never see incomplete snapshot
+
+      const std::string tmp_name(file_name + ".tmp." + std::to_string(getpid()));
+
+      std::ofstream f(tmp_name, std::ios::binary | std::ios::trunc);
+
+      if (f)
+        f.write(data.data(), data.size());
+
+      f.close();
+
+      if (!f || rename(tmp_name.c_str(), file_name.c_str()) != 0)
+        {
+          unlink(tmp_name.c_str());
+          std::ostringstream text;
+          text << "cannot write snapshot file \"" << file_name << '\"';
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+    }
+
+    void
+    Writer::publish(const std::string& shm_name)
+    {
+      const std::vector<char> data(serialize(shm_name));
+
+      auto error = [&shm_name](const char * what) {
+        std::ostringstream text;
+        text << "cannot " << what << " shared memory segment \"" << shm_name << "\": " << strerror(errno);
+        throw daq::config::Generic(ERS_HERE, text.str().c_str());
+      };
+
+      // the processes, which already attached previous segment, continue to use it
+
+      if (shm_unlink(shm_name.c_str()) != 0 && errno != ENOENT)
+        error("remove");
+
+      int fd = shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+
+      if (fd < 0)
+        error("create");
+
+      if (ftruncate(fd, data.size()) != 0)
+        {
+          ::close(fd);
+          shm_unlink(shm_name.c_str());
+          error("resize");
+        }
+
+      void * p = mmap(nullptr, data.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+      ::close(fd);
+
+      if (p == MAP_FAILED)
+        {
+          shm_unlink(shm_name.c_str());
+          error("map");
+        }
+
+      // copy magic last: the readers attaching the segment before it is written wait for it (see shmconfig)
+
+      memcpy(static_cast<char *>(p) + sizeof(Header::m_magic), data.data() + sizeof(Header::m_magic), data.size() - sizeof(Header::m_magic));
+      std::atomic_thread_fence(std::memory_order_release);
+      memcpy(p, data.data(), sizeof(Header::m_magic));
+
+      munmap(p, data.size());
+    }
+
+  }
+}
@@ -0,0 +1,213 @@
+#include <string.h>
+#include <time.h>
+
+#include <sstream>
+
+#include "ers/ers.hpp"
+
+#include "config/Errors.hpp"
+#include "config/Trace.hpp"
+
+
+namespace config
+{
+  namespace trace
+  {
+
+    Writer::Writer(const std::string& file_name, const std::string& spec) :
+      m_file_name(file_name),
+      m_file(file_name, std::ios::binary | std::ios::trunc),
+      m_failed(false),
+      m_origin(std::chrono::steady_clock::now()),
+      m_number_of_calls(0)
+    {
+      Header header;
+      memcpy(header.m_magic, magic, sizeof(magic));
+      header.m_version = format_version;
+      header.m_byte_order = byte_order_mark;
+      header.m_created = time(nullptr);
+      header.m_spec_length = spec.size();
+      header.m_reserved = 0;
+
+      m_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      m_file.write(spec.data(), spec.size());
+
+      if (!m_file)
+        {
+          std::ostringstream text;
+          text << "cannot create trace file \"" << file_name << '\"';
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      m_strings.emplace(std::string(), 0);
+    }
+
+    Writer::~Writer()
+    {
+      flush();
+    }
+
+    void
+    Writer::check() noexcept
+    {
+      if (!m_file && !m_failed)
+        {
+          m_failed = true;
+          std::ostringstream text;
+          text << "cannot write trace file \"" << m_file_name << "\", the following calls are not recorded";
+          ers::error(daq::config::Generic(ERS_HERE, text.str().c_str()));
+        }
+    }
+
+    uint32_t
+    Writer::get_string(const std::string& s)
+    {
+      auto it = m_strings.emplace(s, m_strings.size());
+
+      if (it.second)
+        {
+          const uint32_t len = s.size();
+          m_file.put(string_tag);
+          m_file.write(reinterpret_cast<const char *>(&len), sizeof(len));
+          m_file.write(s.data(), len);
+        }
+
+      return it.first->second;
+    }
+
+    void
+    Writer::add(config::proxy::CallType type, const std::string& class_name, const std::string& id, const std::string& name,
+                uint64_t result_size, std::chrono::steady_clock::time_point start, std::chrono::nanoseconds duration, bool failed) noexcept
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+      if (m_failed)
+        return;
+
+      Call call;
+      call.m_start = std::chrono::duration_cast<std::chrono::nanoseconds>(start - m_origin).count();
+      call.m_duration = duration.count();
+      call.m_result_size = result_size;
+      call.m_class_name = get_string(class_name);
+      call.m_id = get_string(id);
+      call.m_name = get_string(name);
+      call.m_thread = m_threads.emplace(std::this_thread::get_id(), m_threads.size()).first->second;
+      call.m_type = type;
+      call.m_failed = failed;
+
+      m_file.put(call_tag);
+      m_file.write(reinterpret_cast<const char *>(&call), sizeof(call));
+
+      m_number_of_calls++;
+
+      check();
+    }
+
+    void
+    Writer::flush() noexcept
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+      if (!m_failed)
+        {
+          m_file.flush();
+          check();
+        }
+    }
+
+
+    Reader::Reader(const std::string& file_name) :
+      m_file_name(file_name),
+      m_file(file_name, std::ios::binary)
+    {
+      if (!m_file)
+        {
+          std::ostringstream text;
+          text << "cannot open trace file \"" << file_name << '\"';
+          throw daq::config::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      Header header;
+
+      if (!m_file.read(reinterpret_cast<char *>(&header), sizeof(header)) || memcmp(header.m_magic, magic, sizeof(magic)) != 0)
+        throw_corrupted("bad signature");
+
+      if (header.m_byte_order != byte_order_mark)
+        throw_corrupted("byte order mismatch");
+
+      if (header.m_version != format_version)
+        throw_corrupted("unsupported format version");
+
+      m_created = header.m_created;
+      m_spec.resize(header.m_spec_length);
+
+      if (!m_file.read(&m_spec[0], header.m_spec_length))
+        throw_corrupted("unexpected end of file");
+
+      m_strings.emplace_back();
+    }
+
+    void
+    Reader::throw_corrupted(const char * reason) const
+    {
+      std::ostringstream text;
+      text << "bad trace file \"" << m_file_name << "\": " << reason;
+      throw daq::config::Generic(ERS_HERE, text.str().c_str());
+    }
+
+    bool
+    Reader::next(Record& record)
+    {
+      while (true)
+        {
+          const int tag = m_file.get();
+
+          if (tag == std::char_traits<char>::eof())
+            return false;
+
+          if (tag == string_tag)
+            {
+              uint32_t len;
+
+              if (!m_file.read(reinterpret_cast<char *>(&len), sizeof(len)))
+                throw_corrupted("unexpected end of file");
+
+              m_strings.emplace_back(len, '\0');
+
+              if (!m_file.read(&m_strings.back()[0], len))
+                throw_corrupted("unexpected end of file");
+            }
+          else if (tag == call_tag)
+            {
+              Call call;
+
+              if (!m_file.read(reinterpret_cast<char *>(&call), sizeof(call)))
+                throw_corrupted("unexpected end of file");
+
+              if (call.m_class_name >= m_strings.size() || call.m_id >= m_strings.size() || call.m_name >= m_strings.size())
+                throw_corrupted("bad string reference");
+
+              if (call.m_type >= config::proxy::number_of_call_types)
+                throw_corrupted("bad call type");
+
+              record.m_type = static_cast<config::proxy::CallType>(call.m_type);
+              record.m_failed = call.m_failed;
+              record.m_thread = call.m_thread;
+              record.m_class_name = &m_strings[call.m_class_name];
+              record.m_id = &m_strings[call.m_id];
+              record.m_name = &m_strings[call.m_name];
+              record.m_result_size = call.m_result_size;
+              record.m_start = call.m_start;
+              record.m_duration = call.m_duration;
+
+              return true;
+            }
+          else
+            {
+              throw_corrupted("bad record tag");
+            }
+        }
+    }
+
+  }
+}
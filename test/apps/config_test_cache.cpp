@@ -0,0 +1,180 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "config/Configuration.hpp"
+#include "config/ConfigObject.hpp"
+
+ERS_DECLARE_ISSUE(
+  config_test_cache,
+  BadCommandLine,
+  "bad command line: " << reason,
+  ((const char*)reason)
+)
+
+ERS_DECLARE_ISSUE(
+  config_test_cache,
+  ConfigException,
+  "caught daq::config::Exception exception",
+)
+
+static void
+usage()
+{
+  std::cout <<
+    "Usage: config_test_cache -d | --database dbspec\n"
+    "                         [-l | --cache-limit number]\n"
+    "\n"
+    "Options/Arguments:\n"
+    "       -d dbspec    database specification in format plugin-name:parameters\n"
+    "       -l number    limit of implementation objects in cache (default 2)\n"
+    "\n"
+    "Description:\n"
+    "       The utility reads all objects one by one using bounded cache and tests\n"
+    "       the number of objects in cache does not exceed the limit, while objects\n"
+    "       in use are not evicted.\n\n";
+}
+
+static void
+no_param(const char * s)
+{
+  std::ostringstream text;
+  text << "no parameter for " << s << " provided";
+  ers::fatal(config_test_cache::BadCommandLine(ERS_HERE, text.str().c_str()));
+  exit(EXIT_FAILURE);
+}
+
+
+int main(int argc, char *argv[])
+{
+  const char * db_name = 0;
+  unsigned long limit = 2;
+
+  for(int i = 1; i < argc; i++) {
+    const char * cp = argv[i];
+
+    if(!strcmp(cp, "-h") || !strcmp(cp, "--help")) {
+      usage();
+      return 0;
+    }
+    else if(!strcmp(cp, "-d") || !strcmp(cp, "--database")) {
+      if(++i == argc) { no_param(cp); } else { db_name = argv[i]; }
+    }
+    else if(!strcmp(cp, "-l") || !strcmp(cp, "--cache-limit")) {
+      if(++i == argc) { no_param(cp); } else { limit = strtoul(argv[i], nullptr, 0); }
+    }
+    else {
+      std::ostringstream text;
+      text << "unexpected parameter: \'" << cp << "\'; run command with --help to see valid command line options.";
+      ers::fatal(config_test_cache::BadCommandLine(ERS_HERE, text.str().c_str()));
+      return (EXIT_FAILURE);
+    }
+  }
+
+  if(!db_name) {
+    ers::fatal(config_test_cache::BadCommandLine(ERS_HERE, "no database name given"));
+    return (EXIT_FAILURE);
+  }
+
+  if(limit < 2) {
+    ers::fatal(config_test_cache::BadCommandLine(ERS_HERE, "the cache limit has to be at least 2 to keep pinned and read objects"));
+    return (EXIT_FAILURE);
+  }
+
+  unsigned int errors = 0;
+
+  try {
+    Configuration db(db_name);
+
+      // collect ids of all objects; the objects are not used after this block
+
+    std::vector<std::pair<std::string, std::string>> ids;
+
+    for(const auto& c : db.superclasses()) {
+      std::vector<ConfigObject> objects;
+      db.get(*c.first, objects);
+
+      for(const auto& x : objects) {
+        if(x.class_name() == *c.first) {
+          ids.emplace_back(x.class_name(), x.UID());
+        }
+      }
+    }
+
+    if(ids.size() <= limit) {
+      std::cerr << "ERROR: the database has " << ids.size() << " objects, that is not enough to test cache limit " << limit << std::endl;
+      return (EXIT_FAILURE);
+    }
+
+    std::cout << "TEST read " << ids.size() << " objects without cache limit: " << db.get_cache_size() << " objects in cache\n";
+
+    db.set_cache_limit(limit);
+
+    if(db.get_cache_size() > limit) {
+      std::cerr << "ERROR: " << db.get_cache_size() << " objects in cache after set_cache_limit(" << limit << ')' << std::endl;
+      errors++;
+    }
+
+      // the pinned object has to stay in cache while other objects are read
+
+    ConfigObject pinned;
+    db.get(ids[0].first, ids[0].second, pinned);
+
+    unsigned long max_size = 0;
+
+    for(const auto& x : ids) {
+      ConfigObject obj;
+      db.get(x.first, x.second, obj);
+
+      if(obj.UID() != x.second || obj.class_name() != x.first) {
+        std::cerr << "ERROR: read object " << &obj << " instead of \'" << x.second << '@' << x.first << '\'' << std::endl;
+        errors++;
+      }
+
+      max_size = std::max(max_size, db.get_cache_size());
+    }
+
+    if(max_size > limit) {
+      std::cerr << "ERROR: " << max_size << " objects in cache exceed the limit " << limit << std::endl;
+      errors++;
+    }
+    else {
+      std::cout << "TEST maximum number of objects in cache is " << max_size << " (limit " << limit << "): OK\n";
+    }
+
+    ConfigObject again;
+    db.get(ids[0].first, ids[0].second, again);
+
+    if(again.implementation() != pinned.implementation() || pinned.UID() != ids[0].second) {
+      std::cerr << "ERROR: pinned object " << &pinned << " was evicted" << std::endl;
+      errors++;
+    }
+    else {
+      std::cout << "TEST pinned object " << &pinned << " was not evicted: OK\n";
+    }
+
+      // the evicted object is re-read
+
+    ConfigObject evicted;
+    db.get(ids[1].first, ids[1].second, evicted);
+
+    if(evicted.UID() != ids[1].second) {
+      std::cerr << "ERROR: cannot re-read evicted object \'" << ids[1].second << '@' << ids[1].first << '\'' << std::endl;
+      errors++;
+    }
+    else {
+      std::cout << "TEST evicted object " << &evicted << " was re-read: OK\n";
+    }
+  }
+  catch (daq::config::Exception & ex) {
+    ers::fatal(config_test_cache::ConfigException(ERS_HERE, ex));
+    return (EXIT_FAILURE);
+  }
+
+  return (errors ? EXIT_FAILURE : EXIT_SUCCESS);
+}
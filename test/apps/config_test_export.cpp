@@ -0,0 +1,709 @@
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+
+#include "config/Columns.hpp"
+#include "config/Configuration.hpp"
+#include "config/ConfigObject.hpp"
+#include "config/DataWriter.hpp"
+#include "config/Filter.hpp"
+
+ERS_DECLARE_ISSUE(
+  config_test_export,
+  BadCommandLine,
+  "bad command line: " << reason,
+  ((const char*)reason)
+)
+
+ERS_DECLARE_ISSUE(
+  config_test_export,
+  ConfigException,
+  "caught daq::config::Exception exception",
+)
+
+static void
+usage()
+{
+  std::cout <<
+    "Usage: config_test_export -d | --database dbspec\n"
+    "                          -o | --output-directory directory\n"
+    "\n"
+    "Options/Arguments:\n"
+    "       -d dbspec        database specification in format plugin-name:parameters\n"
+    "       -o directory     directory for exported files (created, if does not exist)\n"
+    "\n"
+    "Description:\n"
+    "       The utility tests the filters of classes, objects and files used by export of data,\n"
+    "       reads exported data back comparing them with the database and compares output of\n"
+    "       export of data with output of boost::property_tree writers. The test objects are\n"
+    "       created in memory, so the database has to use memconfig plug-in and test schema.\n\n";
+}
+
+static void
+no_param(const char * s)
+{
+  std::ostringstream text;
+  text << "no parameter for " << s << " provided";
+  ers::fatal(config_test_export::BadCommandLine(ERS_HERE, text.str().c_str()));
+  exit(EXIT_FAILURE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  // the filter detects type of pattern
+
+static unsigned int
+test_filter_types()
+{
+  const struct {
+    const char * m_pattern;
+    config::Filter::Type m_type;
+  } patterns[] = {
+    { "",              config::Filter::All       },
+    { "ROS-1",         config::Filter::Literal   },
+    { "^ROS-1$",       config::Filter::Literal   },
+    { "ROS\\.1",       config::Filter::Literal   },
+    { "ROS-.*",        config::Filter::Prefix    },
+    { ".*-1",          config::Filter::Suffix    },
+    { ".*-1.*",        config::Filter::Substring },
+    { "ROS-..-.*-1.",  config::Filter::Glob      },
+    { "ROS-.+",        config::Filter::Glob      },
+    { "ROS-(1|2)",     config::Filter::Regex     },
+    { "ROS-[0-9]+",    config::Filter::Regex     },
+    { "ROS-\\d",       config::Filter::Regex     }
+  };
+
+  unsigned int errors = 0;
+
+  for (const auto& x : patterns)
+    {
+      config::Filter f(x.m_pattern);
+
+      if (f.get_type() != x.m_type)
+        {
+          std::cerr << "ERROR: type of filter \"" << x.m_pattern << "\" is " << f.get_type() << " instead of " << x.m_type << std::endl;
+          errors++;
+        }
+    }
+
+  if (errors == 0)
+    std::cout << "TEST types of " << sizeof(patterns) / sizeof(patterns[0]) << " filters: OK\n";
+
+  return errors;
+}
+
+
+  // the filter and std::regex_match() have the same results on random patterns and strings
+
+static unsigned int
+test_filter_as_regex()
+{
+  const char * tokens[] = { "a", "b", ".", ".*", ".+", "\\.", "-", "^", "$", "\\-", "a|b", "[ab]", "(a)", "\\d", "\\\\", "\\$", "\\*" };
+  const char alphabet[] = "ab.-_\n";
+
+  std::mt19937 rng(42);
+
+  unsigned int num_of_patterns = 0, num_of_matches = 0, errors = 0;
+
+  for (unsigned int i = 0; i < 20000; ++i)
+    {
+      std::string pattern;
+
+      for (unsigned int j = rng() % 6; j > 0; --j)
+        pattern += tokens[rng() % (sizeof(tokens) / sizeof(tokens[0]))];
+
+      std::unique_ptr<std::regex> regex;
+
+      try
+        {
+          regex.reset(new std::regex(pattern));
+        }
+      catch (std::regex_error&)
+        {
+          try
+            {
+              config::Filter f(pattern);
+              std::cerr << "ERROR: no exception for bad pattern \"" << pattern << "\"\n";
+              errors++;
+            }
+          catch (std::regex_error&)
+            {
+              ;
+            }
+
+          continue;
+        }
+
+      config::Filter f(pattern);
+      num_of_patterns++;
+
+      for (unsigned int j = 0; j < 50; ++j)
+        {
+          std::string str;
+
+          for (unsigned int k = rng() % 9; k > 0; --k)
+            str.push_back(alphabet[rng() % (sizeof(alphabet) - 1)]);
+
+          const bool expected(pattern.empty() || std::regex_match(str, *regex));
+
+          num_of_matches++;
+
+          if (f.match(str) != expected)
+            {
+              if (errors++ < 10)
+                std::cerr << "ERROR: filter \"" << pattern << "\" of type " << f.get_type() << " returns " << !expected << " for \"" << str << "\"\n";
+            }
+        }
+    }
+
+  if (errors == 0)
+    std::cout << "TEST filter and std::regex_match() results on " << num_of_patterns << " patterns and " << num_of_matches << " strings are equal: OK\n";
+
+  return errors;
+}
+
+
+  // return i-th value of columnar file column
+
+template<class T>
+static T
+get_value(const config::columns::Reader& reader, const config::columns::Column& column, uint64_t i)
+{
+  if constexpr (std::is_same<T, std::string>::value)
+    return reader.get_string(column, i);
+  else if constexpr (std::is_same<T, bool>::value)
+    return (reader.get_values<uint8_t>(column)[i] != 0);
+  else
+    return reader.get_values<T>(column)[i];
+}
+
+  // compare values of attribute column with values of objects
+
+template<class T>
+static bool
+check_attribute(const config::columns::Reader& reader, const config::columns::Column& column, const std::vector<ConfigObject>& objects, const daq::config::attribute_t& a)
+{
+  if (column.m_type != a.p_type || ((column.m_flags & config::columns::Column::multi_value_flag) != 0) != a.p_is_multi_value)
+    return false;
+
+  for (uint64_t i = 0; i < objects.size(); ++i)
+    {
+      auto &o = const_cast<ConfigObject&>(objects[i]);
+
+      if (!a.p_is_multi_value)
+        {
+          T value;
+          o.get(a.p_name, value);
+
+          if (get_value<T>(reader, column, i) != value)
+            return false;
+        }
+      else
+        {
+          std::vector<T> values;
+          o.get(a.p_name, values);
+
+          const uint64_t * rows = reader.get_rows(column);
+
+          if (rows[i + 1] - rows[i] != values.size())
+            return false;
+
+          for (uint64_t j = 0; j < values.size(); ++j)
+            if (get_value<T>(reader, column, rows[i] + j) != values[j])
+              return false;
+        }
+    }
+
+  return true;
+}
+
+static bool
+check_attribute(const config::columns::Reader& reader, const config::columns::Column& column, const std::vector<ConfigObject>& objects, const daq::config::attribute_t& a)
+{
+  switch (a.p_type)
+    {
+      case daq::config::bool_type:   return check_attribute<bool>(reader, column, objects, a);
+      case daq::config::s8_type:     return check_attribute<int8_t>(reader, column, objects, a);
+      case daq::config::u8_type:     return check_attribute<uint8_t>(reader, column, objects, a);
+      case daq::config::s16_type:    return check_attribute<int16_t>(reader, column, objects, a);
+      case daq::config::u16_type:    return check_attribute<uint16_t>(reader, column, objects, a);
+      case daq::config::s32_type:    return check_attribute<int32_t>(reader, column, objects, a);
+      case daq::config::u32_type:    return check_attribute<uint32_t>(reader, column, objects, a);
+      case daq::config::s64_type:    return check_attribute<int64_t>(reader, column, objects, a);
+      case daq::config::u64_type:    return check_attribute<uint64_t>(reader, column, objects, a);
+      case daq::config::float_type:  return check_attribute<float>(reader, column, objects, a);
+      case daq::config::double_type: return check_attribute<double>(reader, column, objects, a);
+      default:                       return check_attribute<std::string>(reader, column, objects, a);
+    }
+}
+
+  // compare table of relationship with references of objects
+
+static bool
+check_relationship(const config::columns::Reader& reader, const config::columns::Table& table, const std::vector<ConfigObject>& objects, const daq::config::relationship_t& r)
+{
+  const config::columns::Column * source = reader.find_column(table, "source");
+  const config::columns::Column * target = reader.find_column(table, "target");
+  const config::columns::Column * target_class = reader.find_column(table, "target_class");
+
+  if (!source || !target || !target_class)
+    return false;
+
+  uint64_t row = 0;
+
+  for (const auto& x : objects)
+    {
+      auto &o = const_cast<ConfigObject&>(x);
+
+      std::vector<ConfigObject> values;
+
+      if (r.p_cardinality == daq::config::zero_or_many || r.p_cardinality == daq::config::one_or_many)
+        {
+          o.get(r.p_name, values);
+        }
+      else
+        {
+          ConfigObject value;
+          o.get(r.p_name, value);
+
+          if (!value.is_null())
+            values.push_back(value);
+        }
+
+      for (const auto& v : values)
+        {
+          if (row >= table.m_rows ||
+              reader.get_string(*source, row) != x.UID() ||
+              reader.get_string(*target, row) != v.UID() ||
+              reader.get_string(*target_class, row) != v.class_name())
+            return false;
+
+          row++;
+        }
+    }
+
+  return (row == table.m_rows);
+}
+
+  // the columnar files contain tables and columns described by config/Columns.hpp
+
+static unsigned int
+test_columns(Configuration& db, const std::string& directory)
+{
+  const uint64_t num_of_objects = db.export_columns(directory);
+
+  unsigned int errors = 0;
+  uint64_t num_of_read_objects = 0;
+
+  for (const auto& c : db.superclasses())
+    {
+      const std::string& class_name(*c.first);
+
+      std::vector<ConfigObject> objects, all;
+      db.get(class_name, all);
+
+      for (const auto& x : all)
+        if (x.class_name() == class_name)
+          objects.push_back(x);
+
+      if (objects.empty())
+        continue;
+
+      std::sort(objects.begin(), objects.end(), [](const ConfigObject& o1, const ConfigObject& o2) { return o1.UID() < o2.UID(); });
+
+      const std::string file_name(directory + '/' + class_name + ".columns");
+      const daq::config::class_t& info(db.get_class_info(class_name));
+
+      config::columns::Reader reader(file_name);
+
+      auto error = [&errors, &file_name](const std::string& what) {
+        std::cerr << "ERROR: " << what << " in file \"" << file_name << "\"\n";
+        errors++;
+      };
+
+      if (reader.get_tables_count() != 1 + info.p_relationships.size())
+        error("unexpected number of tables");
+
+      const config::columns::Table * table = reader.find_table(class_name);
+
+      if (table == nullptr || table != &reader.get_table(0) || table->m_rows != objects.size())
+        {
+          error("no table of class with a row per object");
+          continue;
+        }
+
+      num_of_read_objects += table->m_rows;
+
+      const config::columns::Column * ids = reader.find_column(*table, "#id");
+      const config::columns::Column * files = reader.find_column(*table, "#file");
+
+      if (ids == nullptr || files == nullptr)
+        {
+          error("no #id or #file columns");
+          continue;
+        }
+
+      for (uint64_t i = 0; i < objects.size(); ++i)
+        if (reader.get_string(*ids, i) != objects[i].UID() || reader.get_string(*files, i) != objects[i].contained_in())
+          error("bad id or file of object \'" + objects[i].UID() + '\'');
+
+      if (table->m_columns_count != 2 + info.p_attributes.size())
+        error("unexpected number of columns");
+
+      for (const auto& a : info.p_attributes)
+        {
+          const config::columns::Column * column = reader.find_column(*table, a.p_name);
+
+          if (column == nullptr || !check_attribute(reader, *column, objects, a))
+            error("bad column of attribute \"" + a.p_name + '\"');
+        }
+
+      for (const auto& r : info.p_relationships)
+        {
+          const config::columns::Table * t = reader.find_table(class_name + '.' + r.p_name);
+
+          if (t == nullptr || !check_relationship(reader, *t, objects, r))
+            error("bad table of relationship \"" + r.p_name + '\"');
+        }
+    }
+
+  if (num_of_read_objects != num_of_objects)
+    {
+      std::cerr << "ERROR: read " << num_of_read_objects << " objects instead of " << num_of_objects << " exported ones\n";
+      errors++;
+    }
+
+  if (errors == 0)
+    std::cout << "TEST columnar files of " << num_of_objects << " objects: OK\n";
+
+  return errors;
+}
+
+
+  // the exported objects contain their data files; the tombstones are not in namespace of classes
+
+static unsigned int
+test_files(Configuration& db)
+{
+  unsigned int errors = 0;
+
+  for (unsigned int num_of_threads : {1, 2})
+    {
+      std::stringstream s;
+      db.export_data(s, "json", "", "", "", false, num_of_threads, "", true);
+
+      boost::property_tree::ptree tree;
+      boost::property_tree::json_parser::read_json(s, tree);
+
+      unsigned int num_of_objects = 0;
+
+      for (const auto& c : tree)
+        for (const auto& x : c.second)
+          {
+            ConfigObject obj;
+            db.get(c.first, x.first, obj);
+
+            num_of_objects++;
+
+            if (x.second.empty() || x.second.front().first != config::DataWriter::file_key || x.second.front().second.data() != obj.contained_in())
+              {
+                std::cerr << "ERROR: no file \"" << obj.contained_in() << "\" of object " << &obj << " exported by " << num_of_threads << " threads\n";
+                errors++;
+              }
+          }
+
+      if (errors == 0)
+        std::cout << "TEST files of " << num_of_objects << " objects exported by " << num_of_threads << " threads: OK\n";
+    }
+
+    // the implementation without versions history reports no changes
+
+  std::stringstream s;
+  db.export_data(s, "json", "", "", "", true, 1, "HEAD");
+
+  boost::property_tree::ptree tree;
+  boost::property_tree::json_parser::read_json(s, tree);
+
+  if (tree.size() != 1 || tree.front().first != config::DataWriter::tombstones_key || !tree.front().second.empty())
+    {
+      std::cerr << "ERROR: incremental export without versions history is not empty tombstones:\n" << s.str();
+      errors++;
+    }
+  else if (std::any_of(db.superclasses().begin(), db.superclasses().end(), [](const auto& c) { return *c.first == config::DataWriter::tombstones_key; }))
+    {
+      std::cerr << "ERROR: tombstones key \"" << config::DataWriter::tombstones_key << "\" is a class name\n";
+      errors++;
+    }
+  else
+    {
+      std::cout << "TEST incremental export without versions history contains empty \"" << config::DataWriter::tombstones_key << "\" only: OK\n";
+    }
+
+  return errors;
+}
+
+
+  // write ptree filled by export of data using boost::property_tree writers and post-process it as
+  // config_export_data did before the streaming writers, when the fix of arrays was requested
+
+static std::string
+write_ptree(Configuration& db, const std::string& format, bool fix_arrays, const std::string& classes)
+{
+  const std::string fix_empty_arrays((fix_arrays && format == "json") ? "<-- empty-p3-element -->" : "");
+
+  boost::property_tree::ptree pt;
+  db.export_data(pt, classes, "", "", fix_empty_arrays);
+
+  std::ostringstream buf;
+
+  if (format == "json")
+    boost::property_tree::json_parser::write_json(buf, pt);
+  else if (format == "xml")
+    boost::property_tree::xml_parser::write_xml(buf, pt, boost::property_tree::xml_writer_make_settings<std::string>(' ', 4));
+  else
+    boost::property_tree::info_parser::write_info(buf, pt, boost::property_tree::info_writer_make_settings(' ', 4));
+
+  const std::string in(buf.str());
+
+  if (!fix_arrays || format == "info")
+    return in;
+
+  std::string out;
+  std::string::size_type pos = 0, fix_pos;
+
+  if (format == "json")
+    {
+      // remove marks of empty arrays: replace "[ "<-- empty-p3-element -->" ]" by "[]"
+      while ((fix_pos = in.find(fix_empty_arrays, pos)) != std::string::npos)
+        {
+          std::string::size_type start = in.rfind('[', fix_pos);
+          std::string::size_type end = in.find(']', fix_pos);
+
+          if (start == std::string::npos || end == std::string::npos)
+            break;
+
+          out.append(in, pos, start + 1 - pos);
+          pos = end;
+        }
+    }
+  else
+    {
+      // remove unnamed xml tags: replace "<>FOO</>" by "FOO"
+      while ((fix_pos = in.find("<>", pos)) != std::string::npos)
+        {
+          std::string::size_type next = in.find("</>", fix_pos);
+
+          if (next == std::string::npos)
+            break;
+
+          out.append(in, pos, fix_pos - pos);
+          out.append(in, fix_pos + 2, next - fix_pos - 2);
+          pos = next + 3;
+        }
+    }
+
+  out.append(in, pos);
+
+  return out;
+}
+
+  // the streaming writers produce the same output as boost::property_tree writers
+
+static unsigned int
+test_writers(Configuration& db)
+{
+  std::vector<ConfigObject> objects;
+  db.get("Dummy", objects);
+
+  if (objects.empty())
+    {
+      std::cerr << "ERROR: no objects of class Dummy to find data file\n";
+      return 1;
+    }
+
+  const std::string file(objects.front().contained_in());
+
+  // objects with values to be quoted and escaped, with empty and space-only values and with empty arrays
+
+  const std::vector<std::string> strings { "", " ", "   ", "a b", "\"quoted\"", "back\\slash", "/slash/", "<tag attr='x'>&amp;</tag>", "{ braces; }", "tab\tnew\nline\r", std::string("nul\0char", 8), "\x01\x1f\x7f", "utf-8 \xc3\xa9" };
+
+  for (unsigned int i = 0; i < strings.size(); ++i)
+    {
+      ConfigObject o;
+      db.create(file, "Dummy", "writers#" + std::to_string(i), o);
+      o.set_by_ref("string", strings[i]);
+
+      if (i % 2)
+        o.set_by_ref("string_vector", strings);
+    }
+
+  ConfigObject o;
+  db.create(file, "Dummy", "writers \"quoted\" & <id>", o);
+
+  db.commit("test application (config/test/config_test_export.cpp): create objects to test writers");
+
+  unsigned int errors = 0, num_of_tests = 0;
+
+  for (const char * format : { "json", "xml", "info" })
+    for (bool fix_arrays : { false, true })
+      for (const char * classes : { "", "NoSuchClass" })
+        {
+          std::ostringstream s;
+          db.export_data(s, format, classes, "", "", fix_arrays, 1);
+
+          num_of_tests++;
+
+          if (s.str() != write_ptree(db, format, fix_arrays, classes))
+            {
+              std::cerr << "ERROR: " << format << " output of " << (*classes ? "empty" : "whole") << " database " << (fix_arrays ? "with" : "without") << " fix of arrays differs from boost::property_tree output\n";
+              errors++;
+            }
+        }
+
+  if (errors == 0)
+    std::cout << "TEST json, xml and info output is equal to output of boost::property_tree writers in " << num_of_tests << " cases: OK\n";
+
+  return errors;
+}
+
+
+  // the output of export of data by several threads is the same as by single thread
+
+static unsigned int
+test_threads(Configuration& db)
+{
+  std::vector<ConfigObject> objects;
+  db.get("Dummy", objects);
+
+  if (objects.empty())
+    {
+      std::cerr << "ERROR: no objects of class Dummy to find data file\n";
+      return 1;
+    }
+
+  const std::string file(objects.front().contained_in());
+
+  // the objects are read by chunks of 256 objects; create many chunks of two classes to exceed the window of chunks read ahead
+
+  const struct {
+    const char * m_class;
+    unsigned int m_count;
+  } classes[] = {
+    { "Dummy",  3000 },
+    { "Second", 1000 }
+  };
+
+  for (const auto& c : classes)
+    for (unsigned int i = 0; i < c.m_count; ++i)
+      {
+        ConfigObject o;
+        db.create(file, c.m_class, std::string("threads-") + c.m_class + '#' + std::to_string(i), o);
+        o.set_by_val<uint32_t>("uint32", i);
+        o.set_by_val<std::string>("string", std::string(i % 7, 'x'));
+      }
+
+  db.commit("test application (config/test/config_test_export.cpp): create objects to test threads");
+
+  unsigned int errors = 0;
+
+  for (const char * format : { "json", "xml", "info" })
+    {
+      std::ostringstream serial;
+      db.export_data(serial, format, "", "", "", false, 1, "", true);
+
+      for (unsigned int num_of_threads : { 2, 4, 8 })
+        {
+          std::ostringstream parallel;
+          db.export_data(parallel, format, "", "", "", false, num_of_threads, "", true);
+
+          if (parallel.str() != serial.str())
+            {
+              std::cerr << "ERROR: " << format << " output of " << num_of_threads << " threads differs from output of single thread\n";
+              errors++;
+            }
+        }
+    }
+
+  if (errors == 0)
+    std::cout << "TEST json, xml and info output of 2, 4 and 8 threads is equal to output of single thread: OK\n";
+
+  return errors;
+}
+
+
+int main(int argc, char *argv[])
+{
+  const char * db_name = 0;
+  const char * directory = 0;
+
+  for(int i = 1; i < argc; i++) {
+    const char * cp = argv[i];
+
+    if(!strcmp(cp, "-h") || !strcmp(cp, "--help")) {
+      usage();
+      return 0;
+    }
+    else if(!strcmp(cp, "-d") || !strcmp(cp, "--database")) {
+      if(++i == argc) { no_param(cp); } else { db_name = argv[i]; }
+    }
+    else if(!strcmp(cp, "-o") || !strcmp(cp, "--output-directory")) {
+      if(++i == argc) { no_param(cp); } else { directory = argv[i]; }
+    }
+    else {
+      std::ostringstream text;
+      text << "unexpected parameter: \'" << cp << "\'; run command with --help to see valid command line options.";
+      ers::fatal(config_test_export::BadCommandLine(ERS_HERE, text.str().c_str()));
+      return (EXIT_FAILURE);
+    }
+  }
+
+  if(!db_name) {
+    ers::fatal(config_test_export::BadCommandLine(ERS_HERE, "no database name given"));
+    return (EXIT_FAILURE);
+  }
+
+  if(!directory) {
+    ers::fatal(config_test_export::BadCommandLine(ERS_HERE, "no output directory given"));
+    return (EXIT_FAILURE);
+  }
+
+  if(mkdir(directory, 0755) != 0 && errno != EEXIST) {
+    std::cerr << "ERROR: cannot create directory \"" << directory << "\": " << strerror(errno) << std::endl;
+    return (EXIT_FAILURE);
+  }
+
+  unsigned int errors = 0;
+
+  errors += test_filter_types();
+  errors += test_filter_as_regex();
+
+  try {
+    Configuration db(db_name);
+
+    errors += test_columns(db, directory);
+    errors += test_files(db);
+    errors += test_writers(db);
+    errors += test_threads(db);
+  }
+  catch (daq::config::Exception & ex) {
+    ers::fatal(config_test_export::ConfigException(ERS_HERE, ex));
+    return (EXIT_FAILURE);
+  }
+
+  return (errors ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -0,0 +1,663 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "config/Change.hpp"
+#include "config/Configuration.hpp"
+#include "config/ConfigObject.hpp"
+#include "config/SubscriptionCriteria.hpp"
+
+ERS_DECLARE_ISSUE(
+  config_test_notify,
+  BadCommandLine,
+  "bad command line: " << reason,
+  ((const char*)reason)
+)
+
+ERS_DECLARE_ISSUE(
+  config_test_notify,
+  ConfigException,
+  "caught daq::config::Exception exception",
+)
+
+static void
+usage()
+{
+  std::cout <<
+    "Usage: config_test_notify -d | --data-name data_name\n"
+    "                          -s | --schema-name schema_name\n"
+    "\n"
+    "Options/Arguments:\n"
+    "       -d data_name      name of creating data file\n"
+    "       -s schema_name    name of including schema file (e.g. config/test/test.schema.xml exported to json)\n"
+    "\n"
+    "Description:\n"
+    "       The utility creates objects of the test schema using memconfig plug-in and tests\n"
+    "       notification of subscribers on committed changes.\n\n";
+}
+
+static void
+no_param(const char * s)
+{
+  std::ostringstream text;
+  text << "no parameter for " << s << " provided";
+  ers::fatal(config_test_notify::BadCommandLine(ERS_HERE, text.str().c_str()));
+  exit(EXIT_FAILURE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  // print changes as "class:+created,~modified,-removed" separated by space
+
+static std::string
+to_string(const std::vector<ConfigurationChange *>& changes)
+{
+  std::ostringstream s;
+
+  for (const auto& c : changes)
+    {
+      if (s.tellp() > 0)
+        s << ' ';
+
+      s << c->get_class_name() << ':';
+
+      const char * separator = "";
+
+      for (const auto& x : c->get_created_objs())
+        {
+          s << separator << '+' << x;
+          separator = ",";
+        }
+
+      for (const auto& x : c->get_modified_objs())
+        {
+          s << separator << '~' << x;
+          separator = ",";
+        }
+
+      for (const auto& x : c->get_removed_objs())
+        {
+          s << separator << '-' << x;
+          separator = ",";
+        }
+    }
+
+  return s.str();
+}
+
+  // notifications received by a subscriber
+
+struct Received
+{
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::vector<std::string> m_changes;
+  std::atomic<int> m_active {0};
+  std::atomic<bool> m_overlap {false};
+
+  void
+  add(const std::string& changes)
+  {
+    std::lock_guard<std::mutex> scoped_lock(m_mutex);
+    m_changes.push_back(changes);
+    m_cond.notify_all();
+  }
+
+    // wait given number of notifications (at most 10 seconds)
+
+  bool
+  wait(size_t count)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_cond.wait_for(lock, std::chrono::seconds(10), [&]() { return m_changes.size() >= count; });
+  }
+};
+
+static void
+record(const std::vector<ConfigurationChange *>& changes, void * parameter)
+{
+  Received * r = static_cast<Received *>(parameter);
+
+  if (r->m_active++ != 0)
+    r->m_overlap = true;
+
+  r->add(to_string(changes));
+
+  r->m_active--;
+}
+
+  // record sorted names of modified attributes and relationships of modified objects as "class:id=name,name"
+
+static void
+record_attributes(const std::vector<ConfigurationChange *>& changes, void * parameter)
+{
+  std::ostringstream s;
+
+  for (const auto& c : changes)
+    for (const auto& x : c->get_modified_objs())
+      {
+        if (s.tellp() > 0)
+          s << ' ';
+
+        s << c->get_class_name() << ':' << x << '=';
+
+        if (const std::vector<std::string> * names = c->get_modified_attributes(x))
+          {
+            std::vector<std::string> sorted(*names);
+            std::sort(sorted.begin(), sorted.end());
+
+            const char * separator = "";
+
+            for (const auto& n : sorted)
+              {
+                s << separator << n;
+                separator = ",";
+              }
+          }
+        else
+          {
+            s << '?';
+          }
+      }
+
+  static_cast<Received *>(parameter)->add(s.str());
+}
+
+  // changes received by subscriber and address of the first of them, that is the same for all subscribers sharing the changes
+
+struct Shared
+{
+  Received m_received;
+  const ConfigurationChange * m_change = nullptr;
+};
+
+static void
+record_shared(const std::vector<ConfigurationChange *>& changes, void * parameter)
+{
+  Shared * r = static_cast<Shared *>(parameter);
+
+  if (!changes.empty())
+    r->m_change = changes.front();
+
+  r->m_received.add(to_string(changes));
+}
+
+static void
+record_view(const ConfigurationChangeView& changes, void * parameter)
+{
+  Shared * r = static_cast<Shared *>(parameter);
+
+  std::ostringstream s;
+
+  for (size_t i = 0; i < changes.size(); ++i)
+    {
+      if (i)
+        s << ' ';
+
+      s << changes.get_class_name(i) << ':';
+
+      const char * separator = "";
+
+      changes.for_each_object(i, [&s, &separator](const std::string& id, char action) {
+        s << separator << action << id;
+        separator = ",";
+      });
+
+      s << (changes.is_complete(i) ? " (complete)" : " (partial)");
+    }
+
+  if (!changes.empty())
+    r->m_change = &changes.get_change(0);
+
+  r->m_received.add(s.str());
+}
+
+static void
+record_slowly(const std::vector<ConfigurationChange *>& changes, void * parameter)
+{
+  Received * r = static_cast<Received *>(parameter);
+
+  if (r->m_active++ != 0)
+    r->m_overlap = true;
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  r->add(to_string(changes));
+
+  r->m_active--;
+}
+
+static unsigned int
+check(const char * test, const std::vector<std::string>& received, const std::vector<std::string>& expected)
+{
+  if (received == expected)
+    {
+      std::cout << "TEST " << test << ": OK\n";
+      return 0;
+    }
+
+  std::cerr << "ERROR: " << test << " received " << received.size() << " notification(s):\n";
+  for (const auto& x : received)
+    std::cerr << "  \"" << x << "\"\n";
+
+  std::cerr << "expected " << expected.size() << " notification(s):\n";
+  for (const auto& x : expected)
+    std::cerr << "  \"" << x << "\"\n";
+
+  return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  // notifications of a subscription are delivered in order and one by one, while the dispatcher is replaced
+
+static unsigned int
+test_async_order(Configuration& db, const std::string& data_name)
+{
+  const unsigned int num_of_commits = 100;
+  const unsigned int threads[] = { 2, 0, 1, 3 };
+
+  Received r;
+  std::vector<std::string> expected;
+
+  Configuration::CallbackId id = db.subscribe(ConfigurationSubscriptionCriteria(), record_slowly, &r);
+
+  for (unsigned int i = 0; i < num_of_commits; ++i)
+    {
+      if (i % 5 == 0)
+        db.set_async_notification(threads[(i / 5) % 4], 2);
+
+      const std::string obj_id(std::string("async#") + std::to_string(i));
+
+      ConfigObject o;
+      db.create(data_name, "Dummy", obj_id, o);
+      db.commit("test application (config/test/config_test_notify.cpp): create object");
+
+      expected.push_back(std::string("Dummy:+") + obj_id);
+    }
+
+  r.wait(num_of_commits);
+
+  db.set_async_notification(0);
+  db.unsubscribe(id);
+
+  unsigned int errors = check("asynchronous notifications in order", r.m_changes, expected);
+
+  if (r.m_overlap)
+    {
+      std::cerr << "ERROR: concurrent invocation of callback of one subscription\n";
+      errors++;
+    }
+
+  return errors;
+}
+
+  // the subscriptions on classes and objects receive only changes they are subscribed on
+
+static unsigned int
+test_routing(Configuration& db, const std::string& data_name, unsigned int num_of_threads)
+{
+  db.set_async_notification(num_of_threads);
+
+  Received all, by_class, by_object, none;
+
+  ConfigurationSubscriptionCriteria class_criteria;
+  class_criteria.add("Dummy");
+
+  ConfigurationSubscriptionCriteria object_criteria;
+  object_criteria.add("Dummy", "#1");
+
+  ConfigurationSubscriptionCriteria none_criteria;
+  none_criteria.add("Dummy", "nonexistent");
+  none_criteria.add("Second");
+
+  db.subscribe(ConfigurationSubscriptionCriteria(), record, &all);
+  db.subscribe(class_criteria, record, &by_class);
+  db.subscribe(object_criteria, record, &by_object);
+  db.subscribe(none_criteria, record, &none);
+
+  const std::string obj_id(std::string("route#") + std::to_string(num_of_threads));
+
+  ConfigObject o;
+  db.get("Dummy", "#1", o);
+  o.set_by_val<std::string>("string", obj_id);
+
+  ConfigObject n;
+  db.create(data_name, "Dummy", obj_id, n);
+
+  db.commit("test application (config/test/config_test_notify.cpp): route changes");
+
+  all.wait(1);
+  by_class.wait(1);
+  by_object.wait(1);
+
+  // give a chance to deliver wrongly routed changes
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  db.unsubscribe();
+  db.set_async_notification(0);
+
+  const std::string suffix(num_of_threads ? " (asynchronous)" : " (synchronous)");
+  const std::vector<std::string> expected(1, std::string("Dummy:+") + obj_id + ",~#1");
+
+  return (
+    check(("routing of subscription on any changes" + suffix).c_str(), all.m_changes, expected) +
+    check(("routing of subscription on class" + suffix).c_str(), by_class.m_changes, expected) +
+    check(("routing of subscription on object" + suffix).c_str(), by_object.m_changes, { "Dummy:~#1" }) +
+    check(("routing of subscription on other objects and classes" + suffix).c_str(), none.m_changes, { })
+  );
+}
+
+  // the builder ignores duplicated objects and keeps order of classes and objects
+
+static unsigned int
+test_builder()
+{
+  ConfigurationChangeBuilder builder;
+
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+      builder.add("Dummy", "a", '~');
+      builder.add("Dummy", "b", '+');
+      builder.add("Second", "c", '-');
+      builder.add("Dummy", "d", '-');
+    }
+
+  std::vector<ConfigurationChange *> changes;
+  builder.build(changes);
+
+  unsigned int errors = check("builder ignores duplicated objects", { to_string(changes) }, { "Dummy:+b,~a,-d Second:-c" });
+
+  ConfigurationChange::clear(changes);
+
+  if (!builder.empty())
+    {
+      std::cerr << "ERROR: the builder is not empty after build()\n";
+      errors++;
+    }
+
+  // large number of changes
+
+  const unsigned int num_of_objects = 100000;
+
+  for (unsigned int i = 0; i < 2; ++i)
+    for (unsigned int j = 0; j < num_of_objects; ++j)
+      builder.add("Third", std::to_string(j), '~');
+
+  builder.build(changes);
+
+  bool in_order = (changes.size() == 1 && changes[0]->get_modified_objs().size() == num_of_objects);
+
+  for (unsigned int j = 0; in_order && j < num_of_objects; ++j)
+    if (changes[0]->get_modified_objs()[j] != std::to_string(j))
+      in_order = false;
+
+  ConfigurationChange::clear(changes);
+
+  if (in_order)
+    {
+      std::cout << "TEST builder ignores duplicated objects of large change set: OK\n";
+    }
+  else
+    {
+      std::cerr << "ERROR: builder reports wrong changes of " << num_of_objects << " objects added twice\n";
+      errors++;
+    }
+
+  return errors;
+}
+
+  // the changes of commits during coalescing window are merged and delivered once
+
+static unsigned int
+test_coalescing(Configuration& db, const std::string& data_name)
+{
+  const char * description = "test application (config/test/config_test_notify.cpp): coalesce changes";
+
+  ConfigurationSubscriptionCriteria criteria;
+  criteria.add("Dummy");
+
+  unsigned int errors = 0;
+
+    {
+      Received r;
+
+      db.subscribe(criteria, record, &r, std::chrono::seconds(1));
+
+      ConfigObject o1, o2, o3;
+
+      db.create(data_name, "Dummy", "coalesce#1", o1);
+      db.get("Dummy", "#2", o2);
+      o2.set_by_val<std::string>("string", "coalesce#1");
+      db.commit(description);
+
+      db.destroy_obj(o1);
+      db.get("Dummy", "#3", o3);
+      db.destroy_obj(o3);
+      db.commit(description);
+
+      db.create(data_name, "Dummy", "#3", o3);
+      o2.set_by_val<std::string>("string", "coalesce#2");
+      db.commit(description);
+
+      r.wait(1);
+
+      // give a chance to deliver not merged changes
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+      db.unsubscribe();
+
+      // created and removed object is not reported, removed and created is reported as modified
+      errors += check("coalescing of changes during window", r.m_changes, { "Dummy:~#2,~#3" });
+    }
+
+    {
+      Received r;
+
+      db.subscribe(criteria, record, &r, std::chrono::minutes(1), 2);
+
+      ConfigObject o1, o2;
+
+      db.get("Dummy", "#1", o1);
+      o1.set_by_val<std::string>("string", "coalesce#3");
+      db.commit(description);
+
+      db.create(data_name, "Dummy", "coalesce#2", o2);
+      db.commit(description);
+
+      r.wait(1);
+
+      db.unsubscribe();
+
+      errors += check("coalesced changes delivered when maximum number of changes is reached", r.m_changes, { "Dummy:+coalesce#2,~#1" });
+    }
+
+  return errors;
+}
+
+  // the names of modified attributes and relationships are reported and merged by coalescing
+
+static unsigned int
+test_modified_attributes(Configuration& db)
+{
+  const char * description = "test application (config/test/config_test_notify.cpp): modify attributes";
+
+  ConfigurationSubscriptionCriteria criteria;
+  criteria.add("Dummy");
+
+  unsigned int errors = 0;
+
+    {
+      Received r;
+
+      db.subscribe(criteria, record_attributes, &r);
+
+      ConfigObject o;
+      db.get("Dummy", "#1", o);
+      o.set_by_val<std::string>("string", "attributes#1");
+      o.set_by_val<uint32_t>("uint32", 1);
+      db.commit(description);
+
+      r.wait(1);
+
+      db.unsubscribe();
+
+      errors += check("names of modified attributes", r.m_changes, { "Dummy:#1=string,uint32" });
+    }
+
+    {
+      Received r;
+
+      db.subscribe(criteria, record_attributes, &r, std::chrono::seconds(1));
+
+      ConfigObject o;
+      db.get("Dummy", "#2", o);
+      o.set_by_val<std::string>("string", "attributes#2");
+      db.commit(description);
+
+      o.set_by_val<bool>("bool", true);
+      db.commit(description);
+
+      r.wait(1);
+
+      db.unsubscribe();
+
+      errors += check("names of modified attributes merged by coalescing", r.m_changes, { "Dummy:#2=bool,string" });
+    }
+
+  return errors;
+}
+
+  // the subscribers get views into the same changes
+
+static unsigned int
+test_shared_changes(Configuration& db, unsigned int num_of_threads)
+{
+  db.set_async_notification(num_of_threads);
+
+  ConfigurationSubscriptionCriteria object_criteria;
+  object_criteria.add("Dummy", "#1");
+
+  Shared all, by_object, vector;
+
+  db.subscribe(ConfigurationSubscriptionCriteria(), record_view, &all);
+  db.subscribe(object_criteria, record_view, &by_object);
+  db.subscribe(ConfigurationSubscriptionCriteria(), record_shared, &vector);
+
+  ConfigObject o1, o2;
+  db.get("Dummy", "#1", o1);
+  db.get("Dummy", "#2", o2);
+  o1.set_by_val<std::string>("string", "shared#1");
+  o2.set_by_val<std::string>("string", "shared#1");
+
+  db.commit("test application (config/test/config_test_notify.cpp): share changes");
+
+  all.m_received.wait(1);
+  by_object.m_received.wait(1);
+  vector.m_received.wait(1);
+
+  db.unsubscribe();
+  db.set_async_notification(0);
+
+  const std::string suffix(num_of_threads ? " (asynchronous)" : " (synchronous)");
+
+  unsigned int errors =
+    check(("view of all changes" + suffix).c_str(), all.m_received.m_changes, { "Dummy:~#1,~#2 (complete)" }) +
+    check(("view of changes of object" + suffix).c_str(), by_object.m_received.m_changes, { "Dummy:~#1 (partial)" }) +
+    check(("vector of all changes" + suffix).c_str(), vector.m_received.m_changes, { "Dummy:~#1,~#2" });
+
+  if (all.m_change == nullptr || all.m_change != by_object.m_change || all.m_change != vector.m_change)
+    {
+      std::cerr << "ERROR: the subscribers do not share changes" << suffix << std::endl;
+      errors++;
+    }
+  else
+    {
+      std::cout << "TEST subscribers share changes" << suffix << ": OK\n";
+    }
+
+  return errors;
+}
+
+
+int main(int argc, char *argv[])
+{
+  const char * data_name = 0;
+  const char * schema_name = 0;
+
+  for(int i = 1; i < argc; i++) {
+    const char * cp = argv[i];
+
+    if(!strcmp(cp, "-h") || !strcmp(cp, "--help")) {
+      usage();
+      return 0;
+    }
+    else if(!strcmp(cp, "-d") || !strcmp(cp, "--data-name")) {
+      if(++i == argc) { no_param(cp); } else { data_name = argv[i]; }
+    }
+    else if(!strcmp(cp, "-s") || !strcmp(cp, "--schema-name")) {
+      if(++i == argc) { no_param(cp); } else { schema_name = argv[i]; }
+    }
+    else {
+      std::ostringstream text;
+      text << "unexpected parameter: \'" << cp << "\'; run command with --help to see valid command line options.";
+      ers::fatal(config_test_notify::BadCommandLine(ERS_HERE, text.str().c_str()));
+      return (EXIT_FAILURE);
+    }
+  }
+
+  if(!data_name) {
+    ers::fatal(config_test_notify::BadCommandLine(ERS_HERE, "no data filename given"));
+    return (EXIT_FAILURE);
+  }
+
+  if(!schema_name) {
+    ers::fatal(config_test_notify::BadCommandLine(ERS_HERE, "no schema filename given"));
+    return (EXIT_FAILURE);
+  }
+
+  unsigned int errors = 0;
+
+  try {
+    Configuration db("memconfig");
+
+    db.create(data_name, std::list<std::string>(1, schema_name));
+
+    for (const char * id : { "#1", "#2", "#3" })
+      {
+        ConfigObject o;
+        db.create(data_name, "Dummy", id, o);
+      }
+
+    ConfigObject o;
+    db.create(data_name, "Second", "#4", o);
+
+    db.commit("test application (config/test/config_test_notify.cpp): create data");
+
+    errors += test_async_order(db, data_name);
+    errors += test_routing(db, data_name, 0);
+    errors += test_routing(db, data_name, 2);
+    errors += test_builder();
+    errors += test_coalescing(db, data_name);
+    errors += test_modified_attributes(db);
+    errors += test_shared_changes(db, 0);
+    errors += test_shared_changes(db, 2);
+  }
+  catch (daq::config::Exception & ex) {
+    ers::fatal(config_test_notify::ConfigException(ERS_HERE, ex));
+    return (EXIT_FAILURE);
+  }
+
+  return (errors ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -29,7 +29,7 @@ usage()
     "Options/Arguments:\n"
     "       -d data_name      name of creating data file\n"
     "       -s schema_name    name of including schema file\n"
-    "       -p plugin_spec    config plugin specification (oksconfig | rdbconfig:server-name)\n"
+    "       -p plugin_spec    config plugin specification (oksconfig | rdbconfig:server-name | memconfig)\n"
     "\n"
     "Description:\n"
     "       The utility tests creation of files and objects using different plugins.\n\n";
@@ -198,7 +198,7 @@ int main(int argc, char *argv[])
   }
 
   if(!plugin_name) {
-    ers::fatal(config_test_rw::BadCommandLine(ERS_HERE, "no plugin specification given (oksconfig, rdbconfig:server-name)"));
+    ers::fatal(config_test_rw::BadCommandLine(ERS_HERE, "no plugin specification given (oksconfig, rdbconfig:server-name, memconfig)"));
     return (EXIT_FAILURE);
   }
 
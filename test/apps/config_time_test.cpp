@@ -5,8 +5,10 @@
 #include <chrono>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
 
+#include "config/Change.hpp"
 #include "config/Configuration.hpp"
 #include "config/ConfigObject.hpp"
 #include "config/Schema.hpp"
@@ -45,17 +47,19 @@ int main(int argc, char *argv[])
 {
   const char * db_name = 0;
   bool verbose = false;
+  unsigned long num_of_changes = 0;
 
   for(int i = 1; i < argc; i++) {
     const char * cp = argv[i];
 
     if(!strcmp(cp, "-h") || !strcmp(cp, "--help")) {
       std::cout << 
-        "Usage: config_time_test -d dbspec [-c | -C [class_name]] [-o | -O [object_id]] [-n]\n"
+        "Usage: config_time_test -d dbspec [-c | -C [class_name]] [-o | -O [object_id]] [-n] [-u number]\n"
         "\n"
         "Options/Arguments:\n"
         "  -d | --database dbspec        database specification in format plugin-name:parameters\n"
         "  -v | --verbose                print details\n"
+        "  -u | --update-cache number    test update of cache by given number of modified objects (e.g. 10000 or 100000)\n"
         "\n"
         "Description:\n"
         "  The utility reports results of time tests.\n"
@@ -67,6 +71,9 @@ int main(int argc, char *argv[])
     else if(!strcmp(cp, "-v") || !strcmp(cp, "--verbose")) {
       verbose = true;
     }
+    else if(!strcmp(cp, "-u") || !strcmp(cp, "--update-cache")) {
+      if(++i == argc) { no_param(cp); } else { num_of_changes = strtoul(argv[i], nullptr, 0); }
+    }
   }
 
   if(!db_name) {
@@ -184,6 +191,33 @@ int main(int argc, char *argv[])
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+    if(num_of_changes && !all_objects.empty()) {
+
+        // the objects are reported as modified; the IDs of missing objects are used when there are not enough objects
+
+      ConfigurationChangeBuilder builder;
+
+      for(unsigned long i = 0; i < num_of_changes; ++i) {
+        const ConfigObject& o(all_objects[i % all_objects.size()]);
+        builder.add(o.class_name(), (i < all_objects.size() ? o.UID() : o.UID() + '-' + std::to_string(i)), '~');
+      }
+
+      std::vector<ConfigurationChange *> changes;
+      builder.build(changes);
+
+      tp = std::chrono::steady_clock::now();
+
+      conf.update_cache(changes);
+
+      std::ostringstream text;
+      text << "updating cache for " << num_of_changes << " modified objects";
+      stop_and_report(tp, text.str().c_str());
+
+      ConfigurationChange::clear(changes);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
     return 0;
   }
   catch (daq::config::Exception & ex) {
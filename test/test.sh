@@ -87,11 +87,271 @@ else
   exit 1
 fi
 
+echo ''
+echo ''
+echo '**********************************************************************'
+echo '*************** config_snapshot and snapconfig plug-in ***************'
+echo '**********************************************************************'
+echo ''
+
+snapshot_file="${data_file}.snapshot"
+
+echo "${1}/config_snapshot -d oksconfig:${data_file} -o ${snapshot_file}"
+echo "${1}/config_export_data -d snapconfig:${snapshot_file}"
+echo ''
+
+if ${1}/config_snapshot -d "oksconfig:${data_file}" -o ${snapshot_file} && \
+   ${1}/config_export_data -d "oksconfig:${data_file}" -o ${data_file}.oks.json && \
+   ${1}/config_export_data -d "snapconfig:${snapshot_file}" -o ${data_file}.snap.json && \
+   cmp ${data_file}.oks.json ${data_file}.snap.json
+then
+  echo '' 
+  echo 'snapconfig test passed' 
+else
+  echo '' 
+  echo 'snapconfig test failed'
+  exit 1
+fi
+
+echo ''
+echo ''
+echo '**********************************************************************'
+echo '********************** jsonconfig plug-in test ***********************'
+echo '**********************************************************************'
+echo ''
+
+echo "${1}/config_export_schema -d oksconfig:${schema_file} -o ${data_file}.schema.json"
+echo "${1}/config_export_data -d jsonconfig:${data_file}.schema.json:${data_file}.oks.json"
+echo ''
+
+if ${1}/config_export_schema -d "oksconfig:${schema_file}" -o ${data_file}.schema.json && \
+   ${1}/config_export_data -d "jsonconfig:${data_file}.schema.json:${data_file}.oks.json" -o ${data_file}.json.json && \
+   cmp ${data_file}.oks.json ${data_file}.json.json
+then
+  echo '' 
+  echo 'jsonconfig test passed' 
+else
+  echo '' 
+  echo 'jsonconfig test failed'
+  exit 1
+fi
+
+echo ''
+echo ''
+echo '**********************************************************************'
+echo '********************** cacheconfig plug-in test **********************'
+echo '**********************************************************************'
+echo ''
+
+export TDAQ_DB_CACHE_DIR="${data_file}.cache"
+
+echo "${1}/config_export_data -d cacheconfig:oksconfig:${data_file}"
+echo ''
+
+if ${1}/config_export_data -d "cacheconfig:oksconfig:${data_file}" -o ${data_file}.miss.json && \
+   ${1}/config_export_data -d "cacheconfig:oksconfig:${data_file}" -o ${data_file}.hit.json && \
+   cmp ${data_file}.oks.json ${data_file}.miss.json && \
+   cmp ${data_file}.oks.json ${data_file}.hit.json
+then
+  echo '' 
+  echo 'cacheconfig test passed' 
+else
+  echo '' 
+  echo 'cacheconfig test failed'
+  exit 1
+fi
+
+unset TDAQ_DB_CACHE_DIR
+
+echo ''
+echo ''
+echo '**********************************************************************'
+echo '*********************** shmconfig plug-in test ***********************'
+echo '**********************************************************************'
+echo ''
+
+shm_name="/config-test-$$"
+
+echo "${1}/config_snapshot -d oksconfig:${data_file} -s ${shm_name}"
+echo "${1}/config_export_data -d shmconfig:${shm_name}"
+echo ''
+
+if ${1}/config_snapshot -d "oksconfig:${data_file}" -s ${shm_name} && \
+   ${1}/config_export_data -d "shmconfig:${shm_name}" -o ${data_file}.shm.json && \
+   cmp ${data_file}.oks.json ${data_file}.shm.json
+then
+  rm -f /dev/shm${shm_name}
+  echo '' 
+  echo 'shmconfig test passed' 
+else
+  rm -f /dev/shm${shm_name}
+  echo '' 
+  echo 'shmconfig test failed'
+  exit 1
+fi
+
+echo ''
+echo ''
+echo '**********************************************************************'
+echo '******************* recordconfig and config_replay test **************'
+echo '**********************************************************************'
+echo ''
+
+export TDAQ_DB_TRACE_FILE="${data_file}.trace"
+
+echo "${1}/config_export_data -d recordconfig:oksconfig:${data_file}"
+echo "${1}/config_replay -t ${data_file}.trace -d jsonconfig:${data_file}.schema.json:${data_file}.oks.json"
+echo ''
+
+if ${1}/config_export_data -d "recordconfig:oksconfig:${data_file}" -o ${data_file}.rec.json && \
+   cmp ${data_file}.oks.json ${data_file}.rec.json && \
+   ${1}/config_replay -t ${data_file}.trace -d "jsonconfig:${data_file}.schema.json:${data_file}.oks.json"
+then
+  echo '' 
+  echo 'recordconfig test passed' 
+else
+  echo '' 
+  echo 'recordconfig test failed'
+  exit 1
+fi
+
+unset TDAQ_DB_TRACE_FILE
+
+echo ''
+echo ''
+echo '**********************************************************************'
+echo '********************* latencyconfig plug-in test *********************'
+echo '**********************************************************************'
+echo ''
+
+echo "${1}/config_export_data -d latencyconfig:jsonconfig:${data_file}.schema.json:${data_file}.oks.json?rtt=1ms&jitter=100us&bw=10M"
+echo ''
+
+if ${1}/config_export_data -d "latencyconfig:jsonconfig:${data_file}.schema.json:${data_file}.oks.json?rtt=1ms&jitter=100us&bw=10M" -o ${data_file}.latency.json && \
+   cmp ${data_file}.oks.json ${data_file}.latency.json
+then
+  echo '' 
+  echo 'latencyconfig test passed' 
+else
+  echo '' 
+  echo 'latencyconfig test failed'
+  exit 1
+fi
+
+echo ''
+echo ''
+echo '**********************************************************************'
+echo '*********************** fedconfig plug-in test ***********************'
+echo '**********************************************************************'
+echo ''
+
+echo "${1}/config_export_data -d fedconfig:jsonconfig:${data_file}.schema.json:${data_file}.oks.json|memconfig:${data_file}.schema.json:${data_file}.oks.json"
+echo ''
+
+if ${1}/config_export_data -d "fedconfig:jsonconfig:${data_file}.schema.json:${data_file}.oks.json|memconfig:${data_file}.schema.json:${data_file}.oks.json" -o ${data_file}.fed.json && \
+   cmp ${data_file}.oks.json ${data_file}.fed.json
+then
+  echo '' 
+  echo 'fedconfig test passed' 
+else
+  echo '' 
+  echo 'fedconfig test failed'
+  exit 1
+fi
+
+echo ''
+echo ''
+echo '**********************************************************************'
+echo '************************* bounded cache test *************************'
+echo '**********************************************************************'
+echo ''
+
+echo "${1}/config_test_cache -d memconfig:${data_file}.schema.json:${data_file}.oks.json -l 2"
+echo ''
+
+if ${1}/config_test_cache -d "memconfig:${data_file}.schema.json:${data_file}.oks.json" -l 2
+then
+  echo '' 
+  echo 'config_test_cache test passed' 
+else
+  echo '' 
+  echo 'config_test_cache test failed'
+  exit 1
+fi
+
+echo ''
+echo ''
+echo '**********************************************************************'
+echo '*********************** notification of changes **********************'
+echo '**********************************************************************'
+echo ''
+
+echo "${1}/config_test_notify -d ${data_file}.notify.json -s ${data_file}.schema.json"
+echo ''
+
+if ${1}/config_test_notify -d ${data_file}.notify.json -s ${data_file}.schema.json
+then
+  echo '' 
+  echo 'config_test_notify test passed' 
+else
+  echo '' 
+  echo 'config_test_notify test failed'
+  exit 1
+fi
+
+echo ''
+echo ''
+echo '**********************************************************************'
+echo '*************************** export of data ***************************'
+echo '**********************************************************************'
+echo ''
+
+echo "${1}/config_test_export -d memconfig:${data_file}.schema.json:${data_file}.oks.json -o ${data_file}.columns"
+echo ''
+
+if ${1}/config_test_export -d "memconfig:${data_file}.schema.json:${data_file}.oks.json" -o ${data_file}.columns
+then
+  echo '' 
+  echo 'config_test_export test passed' 
+else
+  echo '' 
+  echo 'config_test_export test failed'
+  exit 1
+fi
+
 rm -rf ${data_file}*
 
 echo '' 
 echo '**********************************************************************'
 
+json_schema_file="/tmp/test.schema.$$.json"
+
+echo ''
+echo ''
+echo '**********************************************************************'
+echo '************* config_test_rw test using memconfig plug-in ************'
+echo '**********************************************************************'
+echo ''
+
+echo "${1}/config_export_schema -d oksconfig:${schema_file} -o ${json_schema_file}"
+echo "${1}/config_test_rw -d ${data_file} -s ${json_schema_file} -p memconfig"
+echo ''
+
+if ${1}/config_export_schema -d "oksconfig:${schema_file}" -o ${json_schema_file} && ${1}/config_test_rw -d ${data_file} -s ${json_schema_file} -p memconfig
+then
+  echo '' 
+  echo 'config_test_rw test passed' 
+else
+  echo '' 
+  echo 'config_test_rw test failed'
+  exit 1
+fi
+
+rm -f ${json_schema_file}
+
+echo '' 
+echo '**********************************************************************'
+
 echo ''
 echo ''
 echo '**********************************************************************'